@@ -53,6 +53,7 @@ FeatureNode.register(gtlib)
 FeatureIndex.register(gtlib)
 FeatureStream.register(gtlib)
 FeatureIndexMemory.register(gtlib)
+FeatureIndexMapped.register(gtlib)
 FeatureNodeIterator.register(gtlib)
 GenomeNode.register(gtlib)
 GenomeStream.register(gtlib)
@@ -67,6 +67,19 @@ class FeatureIndex:
         if rval != 0:
             gterror(err)
 
+    def write_mapped(self, filename):
+        err = Error()
+        rval = gtlib.gt_feature_index_mapped_write(self.fi,
+                                                   filename.encode('UTF-8'), err)
+        if rval != 0:
+            gterror(err)
+
+    def freeze(self):
+        err = Error()
+        rval = gtlib.gt_feature_index_freeze(self.fi, err)
+        if rval != 0:
+            gterror(err)
+
     def has_seqid(self, seqid):
         from ctypes import c_int, byref
         val = c_int()
@@ -144,10 +157,15 @@ class FeatureIndex:
                                                      c_char_p, c_void_p]
         gtlib.gt_feature_index_get_range_for_seqid.restype = c_int
         gtlib.gt_feature_index_get_range_for_seqid.argtypes = [c_void_p,
-                                                               POINTER(Range), c_char_p]
+                                                               POINTER(Range), c_char_p, c_void_p]
         gtlib.gt_feature_index_get_features_for_range.restype = c_int
         gtlib.gt_feature_index_get_features_for_range.argtypes = [c_void_p,
                                                                   c_void_p, c_char_p, POINTER(Range), c_void_p]
+        gtlib.gt_feature_index_mapped_write.restype = c_int
+        gtlib.gt_feature_index_mapped_write.argtypes = [c_void_p, c_char_p,
+                                                        c_void_p]
+        gtlib.gt_feature_index_freeze.restype = c_int
+        gtlib.gt_feature_index_freeze.argtypes = [c_void_p, c_void_p]
         gtlib.gt_feature_index_delete.restype = None
         gtlib.gt_feature_index_delete.argtypes = [c_void_p]
 
@@ -175,6 +193,31 @@ class FeatureIndexMemory(FeatureIndex):
     register = classmethod(register)
 
 
+class FeatureIndexMapped(FeatureIndex):
+
+    def __init__(self, filename):
+        err = Error()
+        self.fi = gtlib.gt_feature_index_mapped_new(filename.encode('UTF-8'),
+                                                    err)
+        if not self.fi:
+            gterror(err)
+        self._as_parameter_ = self.fi
+
+    def from_param(cls, obj):
+        if not isinstance(obj, FeatureIndexMapped):
+            raise TypeError("argument must be a FeatureIndexMapped")
+        return obj._as_parameter_
+
+    from_param = classmethod(from_param)
+
+    def register(cls, gtlib):
+        from ctypes import c_void_p, c_char_p
+        gtlib.gt_feature_index_mapped_new.restype = c_void_p
+        gtlib.gt_feature_index_mapped_new.argtypes = [c_char_p, c_void_p]
+
+    register = classmethod(register)
+
+
 class FeatureIndexFromPtr(FeatureIndex):
 
     def __init__(self, ptr):
@@ -0,0 +1,435 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "annotationsketch/block.h"
+#include "annotationsketch/custom_track_density.h"
+#include "annotationsketch/custom_track_rep.h"
+#include "annotationsketch/diagram.h"
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/unused_api.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+
+/* length of the sequence windows in which features are read from the feature
+   index while building the histogram */
+#define GT_CUSTOM_TRACK_DENSITY_WINDOW  1048576UL
+
+struct GtCustomTrackDensity {
+  const GtCustomTrack parent_instance;
+  GtUword binsize,
+          height,
+          nof_bins,
+          *coverage_sums, /* prefix sums of the per-bin coverage */
+          *start_sums;    /* prefix sums of the per-bin feature starts */
+  GtRange seqrange;
+  char *type;
+  GtStr *title;
+};
+
+#define gt_custom_track_density_cast(ct)\
+        gt_custom_track_cast(gt_custom_track_density_class(), ct)
+
+static GtUword density_bin(const GtCustomTrackDensity *ctd, GtUword pos)
+{
+  if (pos < ctd->seqrange.start)
+    return 0;
+  if (pos > ctd->seqrange.end)
+    return ctd->nof_bins - 1;
+  return (pos - ctd->seqrange.start) / ctd->binsize;
+}
+
+static void density_add_feature(GtCustomTrackDensity *ctd, GtWord *diff,
+                                GtUword *starts, GtFeatureNode *fn)
+{
+  GtRange rng;
+  GtUword first, last;
+  rng = gt_genome_node_get_range((GtGenomeNode*) fn);
+  first = density_bin(ctd, rng.start);
+  last = density_bin(ctd, rng.end);
+  diff[first]++;
+  diff[last + 1]--;
+  starts[first]++;
+}
+
+/* Adds the features of type <ctd->type> below <root> (or <root> itself if all
+   top-level features are counted) to the histogram. */
+static void density_add_root(GtCustomTrackDensity *ctd, GtWord *diff,
+                             GtUword *starts, GtFeatureNode *root)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn;
+  if (!ctd->type && !gt_feature_node_is_pseudo(root)) {
+    density_add_feature(ctd, diff, starts, root);
+    return;
+  }
+  if (ctd->type)
+    fni = gt_feature_node_iterator_new(root);
+  else
+    fni = gt_feature_node_iterator_new_direct(root);
+  while ((fn = gt_feature_node_iterator_next(fni))) {
+    if (gt_feature_node_is_pseudo(fn))
+      continue;
+    if (!ctd->type || gt_feature_node_has_type(fn, ctd->type))
+      density_add_feature(ctd, diff, starts, fn);
+  }
+  gt_feature_node_iterator_delete(fni);
+}
+
+static int density_build(GtCustomTrackDensity *ctd,
+                         GtFeatureIndex *feature_index, const char *seqid,
+                         GtError *err)
+{
+  GtArray *features;
+  GtWord *diff;
+  GtUword i, *starts, coverage = 0;
+  GtRange window, rng;
+  int had_err = 0;
+  gt_error_check(err);
+
+  ctd->nof_bins = (gt_range_length(&ctd->seqrange) + ctd->binsize - 1)
+                    / ctd->binsize;
+  diff = gt_calloc(ctd->nof_bins + 1, sizeof (GtWord));
+  starts = gt_calloc(ctd->nof_bins, sizeof (GtUword));
+  features = gt_array_new(sizeof (GtFeatureNode*));
+
+  /* read the features window by window to keep the number of features held
+     at once small, each feature is counted in the window it starts in */
+  for (window.start = ctd->seqrange.start;
+       !had_err && window.start <= ctd->seqrange.end;
+       window.start = window.end + 1) {
+    window.end = window.start
+                   + MIN(GT_CUSTOM_TRACK_DENSITY_WINDOW - 1,
+                         ctd->seqrange.end - window.start);
+    gt_array_reset(features);
+    had_err = gt_feature_index_get_features_for_range(feature_index, features,
+                                                      seqid, &window, err);
+    for (i = 0; !had_err && i < gt_array_size(features); i++) {
+      GtFeatureNode *root = *(GtFeatureNode**) gt_array_get(features, i);
+      rng = gt_genome_node_get_range((GtGenomeNode*) root);
+      if (rng.start >= window.start
+            || (window.start == ctd->seqrange.start
+                  && rng.start < window.start)) {
+        density_add_root(ctd, diff, starts, root);
+      }
+    }
+    if (window.end == ctd->seqrange.end)
+      break;
+  }
+
+  if (!had_err) {
+    ctd->coverage_sums = gt_calloc(ctd->nof_bins + 1, sizeof (GtUword));
+    ctd->start_sums = gt_calloc(ctd->nof_bins + 1, sizeof (GtUword));
+    for (i = 0; i < ctd->nof_bins; i++) {
+      coverage += diff[i];
+      ctd->coverage_sums[i + 1] = ctd->coverage_sums[i] + coverage;
+      ctd->start_sums[i + 1] = ctd->start_sums[i] + starts[i];
+    }
+  }
+  gt_array_delete(features);
+  gt_free(starts);
+  gt_free(diff);
+  return had_err;
+}
+
+/* Returns the average number of features overlapping a position in the bins
+   from <first> to <last>. */
+static double density_get_coverage(const GtCustomTrackDensity *ctd,
+                                   GtUword first, GtUword last)
+{
+  gt_assert(first <= last && last < ctd->nof_bins);
+  return (double) (ctd->coverage_sums[last + 1] - ctd->coverage_sums[first])
+           / (last - first + 1);
+}
+
+int gt_custom_track_density_sketch(GtCustomTrack *ct, GtGraphics *graphics,
+                                   unsigned int start_ypos,
+                                   GtRange viewrange,
+                                   GtStyle *style, GtError *err)
+{
+  GtCustomTrackDensity *ctd;
+  GtColor color, grey;
+  GtUword i, nof_pixels, first, last;
+  double margins, step, max = 0.0, *data, barheight;
+  gt_assert(ct && graphics && viewrange.start <= viewrange.end);
+
+  ctd = gt_custom_track_density_cast(ct);
+  margins = gt_graphics_get_xmargins(graphics);
+  gt_assert(gt_double_smaller_double(0, gt_graphics_get_image_width(graphics)
+                                          - 2 * margins));
+
+  if (gt_style_get_color(style, ctd->type ? ctd->type : "density", "fill",
+                         &color, NULL, err) == GT_STYLE_QUERY_ERROR) {
+    return -1;
+  }
+  grey.red = grey.blue = grey.green = 0.8;
+  grey.alpha = 0.9;
+
+  /* one histogram value per pixel column, read from the prefix sums */
+  nof_pixels = gt_graphics_get_image_width(graphics) - 2 * margins;
+  step = (double) gt_range_length(&viewrange) / nof_pixels;
+  data = gt_calloc(nof_pixels, sizeof (double));
+  for (i = 0; i < nof_pixels; i++) {
+    GtUword from = viewrange.start + (GtUword) (i * step),
+            to = viewrange.start + (GtUword) ((i + 1) * step);
+    if (to > from)
+      to--;
+    if (to < ctd->seqrange.start || from > ctd->seqrange.end)
+      continue;
+    first = density_bin(ctd, from);
+    last = density_bin(ctd, to);
+    data[i] = density_get_coverage(ctd, first, last);
+    max = MAX(max, data[i]);
+  }
+
+  gt_graphics_draw_horizontal_line(graphics, margins,
+                                   start_ypos + ctd->height, grey,
+                                   nof_pixels, 1.0);
+  if (gt_double_smaller_double(0, max)) {
+    for (i = 0; i < nof_pixels; i++) {
+      if (!gt_double_smaller_double(0, data[i]))
+        continue;
+      barheight = data[i] / max * ctd->height;
+      gt_graphics_draw_vertical_line(graphics, margins + i + 0.5,
+                                     start_ypos + ctd->height - barheight,
+                                     color, barheight, 1.0);
+    }
+  }
+  gt_free(data);
+  return 0;
+}
+
+GtUword gt_custom_track_density_get_height(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  return ctd->height;
+}
+
+const char* gt_custom_track_density_get_title(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  return gt_str_get(ctd->title);
+}
+
+GtUword gt_custom_track_density_get_number_of_features(GtCustomTrack *ct,
+                                                       const GtRange *range)
+{
+  GtCustomTrackDensity *ctd;
+  gt_assert(ct && range && range->start <= range->end);
+  ctd = gt_custom_track_density_cast(ct);
+  if (range->end < ctd->seqrange.start || range->start > ctd->seqrange.end)
+    return 0;
+  return ctd->start_sums[density_bin(ctd, range->end) + 1]
+           - ctd->start_sums[density_bin(ctd, range->start)];
+}
+
+const char* gt_custom_track_density_get_type(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  ctd = gt_custom_track_density_cast(ct);
+  return ctd->type;
+}
+
+void gt_custom_track_density_delete(GtCustomTrack *ct)
+{
+  GtCustomTrackDensity *ctd;
+  if (!ct) return;
+  ctd = gt_custom_track_density_cast(ct);
+  gt_free(ctd->coverage_sums);
+  gt_free(ctd->start_sums);
+  gt_free(ctd->type);
+  gt_str_delete(ctd->title);
+}
+
+const GtCustomTrackClass* gt_custom_track_density_class(void)
+{
+  static const GtCustomTrackClass *ctc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!ctc)
+  {
+    ctc = gt_custom_track_class_new(sizeof (GtCustomTrackDensity),
+                                    gt_custom_track_density_sketch,
+                                    gt_custom_track_density_get_height,
+                                    gt_custom_track_density_get_title,
+                                    gt_custom_track_density_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return ctc;
+}
+
+GtCustomTrack* gt_custom_track_density_new(GtFeatureIndex *feature_index,
+                                           const char *seqid,
+                                           const char *type,
+                                           GtUword binsize,
+                                           GtUword height,
+                                           GtError *err)
+{
+  GtCustomTrackDensity *ctd;
+  GtCustomTrack *ct;
+  GtRange seqrange;
+  bool has_seqid = false;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(feature_index && seqid);
+
+  if (binsize == 0) {
+    gt_error_set(err, "bin size must be positive");
+    return NULL;
+  }
+  had_err = gt_feature_index_has_seqid(feature_index, &has_seqid, seqid, err);
+  if (!had_err && !has_seqid) {
+    gt_error_set(err, "sequence region '%s' does not exist in feature index",
+                 seqid);
+    had_err = -1;
+  }
+  if (!had_err) {
+    had_err = gt_feature_index_get_range_for_seqid(feature_index, &seqrange,
+                                                   seqid, err);
+  }
+  if (had_err)
+    return NULL;
+
+  ct = gt_custom_track_create(gt_custom_track_density_class());
+  ctd = gt_custom_track_density_cast(ct);
+  ctd->binsize = binsize;
+  ctd->height = height;
+  ctd->seqrange = seqrange;
+  ctd->type = type ? gt_cstr_dup(type) : NULL;
+  ctd->title = gt_str_new_cstr(type ? type : "feature");
+  gt_str_append_cstr(ctd->title, " density (bin size ");
+  gt_str_append_uword(ctd->title, binsize);
+  gt_str_append_cstr(ctd->title, ")");
+  if (density_build(ctd, feature_index, seqid, err)) {
+    gt_custom_track_delete(ct);
+    return NULL;
+  }
+  return ct;
+}
+
+static void density_test_track_selector(GtBlock *block, GtStr *result,
+                                        GT_UNUSED void *data)
+{
+  gt_str_set(result, gt_block_get_type(block));
+}
+
+int gt_custom_track_density_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtFeatureIndex *fi;
+  GtGenomeNode *gn;
+  GtCustomTrack *genes = NULL, *exons = NULL, *all = NULL;
+  GtArray *tracks;
+  GtDiagram *d;
+  GtHashmap *blocks;
+  GtStyle *sty;
+  GtRange rng = {1, 10000}, rng2 = {9500, 10000}, rng3 = {1000, 1099};
+  gt_error_check(err);
+
+  gn = gt_feature_node_new_standard_gene();
+  fi = gt_feature_index_memory_new();
+  sty = gt_style_new(err);
+  gt_ensure(sty != NULL);
+  if (!had_err)
+    had_err = gt_feature_index_add_feature_node(fi, gt_feature_node_cast(gn),
+                                                err);
+  gt_genome_node_delete(gn);
+
+  /* features are counted once per bin they start in */
+  if (!had_err) {
+    gt_ensure((genes = gt_custom_track_density_new(fi, "ctg123", "gene", 100,
+                                                   30, err)) != NULL);
+  }
+  if (!had_err) {
+    gt_ensure((exons = gt_custom_track_density_new(fi, "ctg123", "exon", 100,
+                                                   30, err)) != NULL);
+  }
+  if (!had_err) {
+    gt_ensure((all = gt_custom_track_density_new(fi, "ctg123", NULL, 7, 30,
+                                                 err)) != NULL);
+  }
+  if (!had_err) {
+    gt_ensure(gt_custom_track_density_get_number_of_features(genes, &rng)
+                == 1);
+    gt_ensure(gt_custom_track_density_get_number_of_features(genes, &rng2)
+                == 0);
+    gt_ensure(gt_custom_track_density_get_number_of_features(genes, &rng3)
+                == 1);
+    gt_ensure(gt_custom_track_density_get_number_of_features(all, &rng) == 1);
+    gt_ensure(gt_custom_track_density_get_number_of_features(exons, &rng)
+                > 1);
+    gt_ensure(!strcmp(gt_custom_track_density_get_type(genes), "gene"));
+    gt_ensure(gt_custom_track_density_get_type(all) == NULL);
+  }
+
+  /* unknown sequence regions are rejected */
+  if (!had_err) {
+    gt_ensure(gt_custom_track_density_new(fi, "foo", NULL, 100, 30, err)
+                == NULL);
+    gt_ensure(gt_error_is_set(err));
+    gt_error_unset(err);
+  }
+
+  /* dense types are summarized, others are kept */
+  if (!had_err) {
+    tracks = gt_array_new(sizeof (GtCustomTrack*));
+    gt_array_add(tracks, exons);
+    gt_array_add(tracks, genes);
+    d = gt_diagram_new_summarized(fi, "ctg123", &rng, sty, tracks, 1000, 0.005,
+                                  err);
+    gt_ensure(d != NULL);
+    if (!had_err) {
+      gt_diagram_set_track_selector_func(d, density_test_track_selector, NULL);
+      gt_ensure(gt_array_size(gt_diagram_get_custom_tracks(d)) == 1);
+      gt_ensure(*(GtCustomTrack**) gt_array_get(gt_diagram_get_custom_tracks(d),
+                                                 0) == exons);
+      gt_ensure((blocks = gt_diagram_get_blocks(d, err)) != NULL);
+      if (!had_err) {
+        gt_ensure(gt_hashmap_get(blocks, "exon") == NULL);
+        gt_ensure(gt_hashmap_get(blocks, "gene") != NULL);
+      }
+    }
+    gt_diagram_delete(d);
+    gt_array_reset(tracks);
+    gt_array_add(tracks, all);
+    d = gt_diagram_new_summarized(fi, "ctg123", &rng, sty, tracks, 1000, 0.0,
+                                  err);
+    gt_ensure(d != NULL);
+    if (!had_err) {
+      gt_diagram_set_track_selector_func(d, density_test_track_selector, NULL);
+      gt_ensure(gt_array_size(gt_diagram_get_custom_tracks(d)) == 1);
+      gt_ensure((blocks = gt_diagram_get_blocks(d, err)) != NULL);
+      if (!had_err)
+        gt_ensure(gt_hashmap_get(blocks, "gene") == NULL);
+    }
+    gt_diagram_delete(d);
+    gt_array_delete(tracks);
+  }
+
+  gt_custom_track_delete(genes);
+  gt_custom_track_delete(exons);
+  gt_custom_track_delete(all);
+  gt_feature_index_delete(fi);
+  gt_style_delete(sty);
+  return had_err;
+}
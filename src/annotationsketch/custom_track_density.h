@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef CUSTOM_TRACK_DENSITY_H
+#define CUSTOM_TRACK_DENSITY_H
+
+#include "annotationsketch/custom_track.h"
+#include "annotationsketch/custom_track_density_api.h"
+#include "core/range_api.h"
+
+const GtCustomTrackClass* gt_custom_track_density_class(void);
+
+/* Returns the number of features counted by <ct> which start in a bin
+   overlapping <range>. */
+GtUword     gt_custom_track_density_get_number_of_features(GtCustomTrack *ct,
+                                                           const GtRange
+                                                             *range);
+/* Returns the feature type counted by <ct>, or NULL if all top-level features
+   are counted. */
+const char* gt_custom_track_density_get_type(GtCustomTrack *ct);
+
+int         gt_custom_track_density_unit_test(GtError *err);
+
+#endif
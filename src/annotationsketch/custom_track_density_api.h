@@ -0,0 +1,45 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef CUSTOM_TRACK_DENSITY_API_H
+#define CUSTOM_TRACK_DENSITY_API_H
+
+#include "annotationsketch/custom_track_api.h"
+#include "core/error_api.h"
+#include "extended/feature_index_api.h"
+
+/* Implements the <GtCustomTrack> interface. This custom track draws a
+   histogram of the number of features overlapping each position of the
+   displayed range. It is meant as a replacement for tracks which are too
+   dense to be drawn feature by feature in zoomed-out views (see
+   <gt_diagram_new_summarized()>). The histogram is precomputed once for the
+   complete sequence region in bins of fixed size, so drawing takes time
+   proportional to the image width, independent of the number of features. */
+typedef struct GtCustomTrackDensity GtCustomTrackDensity;
+
+/* Creates a new <GtCustomTrackDensity> of height <height> for the features of
+   type <type> on sequence <seqid> in <feature_index>, counting them in bins of
+   <binsize> nucleotides. If <type> is NULL, all top-level features are
+   counted. The features are read window by window from <feature_index>, which
+   is not needed anymore after construction. Returns NULL and sets <err> on
+   error. */
+GtCustomTrack* gt_custom_track_density_new(GtFeatureIndex *feature_index,
+                                           const char *seqid,
+                                           const char *type,
+                                           GtUword binsize,
+                                           GtUword height,
+                                           GtError *err);
+#endif
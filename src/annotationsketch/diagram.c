@@ -19,6 +19,7 @@
 
 #include "annotationsketch/canvas.h"
 #include "annotationsketch/canvas_cairo_file.h"
+#include "annotationsketch/custom_track_density.h"
 #include "annotationsketch/diagram.h"
 #include "extended/feature_index_memory_api.h"
 #include "annotationsketch/line_breaker_captions.h"
@@ -56,6 +57,11 @@ struct GtDiagram {
   GtArray *features,
           *custom_tracks;
   GtRange range;
+  /* length of the sequence region visible at once, used for the
+     'max_show_width' and 'max_capt_show_width' thresholds */
+  GtUword view_width;
+  /* feature types represented by density tracks instead of blocks */
+  GtHashmap *summarized_types;
   void *ptr;
   GtTrackSelectorFunc select_func;
   GtRWLock *lock;
@@ -203,10 +209,10 @@ static int get_caption_display_status(GtDiagram *d, const char *gft,
           gt_assert(tmp != GT_UNDEF_DOUBLE);
           threshold = tmp;
           gt_assert(tmp != GT_UNDEF_UWORD);
-          *status = (gt_range_length(&d->range) <= threshold);
+          *status = (d->view_width <= threshold);
           break;
       }
-        *status = (gt_range_length(&d->range) <= threshold);
+        *status = (d->view_width <= threshold);
     }
     gt_hashmap_add(d->caption_display_status, (void*) gft, status);
   }
@@ -455,6 +461,11 @@ static int process_node(GtDiagram *d, GtFeatureNode *node,
   if (!gt_range_overlap(&d->range, &elem_range))
     return 0;
 
+  /* discard elements summarized in a density track */
+  if (d->summarized_types
+        && gt_hashmap_get(d->summarized_types, feature_type))
+    return 0;
+
   /* get maximal view widths in nucleotides to show this type */
   rval = gt_style_get_num(d->style, feature_type, "max_show_width", &tmp, NULL,
                           err);
@@ -496,7 +507,7 @@ static int process_node(GtDiagram *d, GtFeatureNode *node,
 
   /* check if this type is to be displayed at all */
   if (max_show_width != GT_UNDEF_UWORD &&
-      gt_range_length(&d->range) > max_show_width)
+      d->view_width > max_show_width)
   {
     return 0;
   }
@@ -504,7 +515,14 @@ static int process_node(GtDiagram *d, GtFeatureNode *node,
   /* disregard parent node if it is configured not to be shown */
   if (parent
         && par_max_show_width != GT_UNDEF_UWORD
-        && gt_range_length(&d->range) > par_max_show_width)
+        && d->view_width > par_max_show_width)
+  {
+    parent = NULL;
+  }
+
+  /* disregard parent node if it is summarized in a density track */
+  if (parent && parent_gft && d->summarized_types
+        && gt_hashmap_get(d->summarized_types, parent_gft))
   {
     parent = NULL;
   }
@@ -818,6 +836,7 @@ static GtDiagram* gt_diagram_new_generic(GtArray *features,
   diagram->style = style;
   diagram->lock = gt_rwlock_new();
   diagram->range = *range;
+  diagram->view_width = gt_range_length(range);
   if (ref_features)
     diagram->features = gt_array_ref(features);
   else
@@ -857,6 +876,75 @@ GtDiagram* gt_diagram_new(GtFeatureIndex *feature_index, const char *seqid,
   return diagram;
 }
 
+GtDiagram* gt_diagram_new_summarized(GtFeatureIndex *feature_index,
+                                     const char *seqid, const GtRange *range,
+                                     GtStyle *style, GtArray *density_tracks,
+                                     unsigned int width,
+                                     double max_features_per_pixel,
+                                     GtError *err)
+{
+  GtDiagram *diagram;
+  GtArray *selected;
+  GtHashmap *summarized_types;
+  GtCustomTrack *ct;
+  GtUword i, nof_types = 0;
+  bool summarize_all = false;
+  const char *type;
+  gt_assert(feature_index && seqid && range && style && density_tracks);
+  gt_assert(width > 0);
+
+  /* select the density tracks of all types which are too dense to be shown
+     feature by feature */
+  selected = gt_array_new(sizeof (GtCustomTrack*));
+  summarized_types = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  for (i = 0; i < gt_array_size(density_tracks); i++) {
+    ct = *(GtCustomTrack**) gt_array_get(density_tracks, i);
+    if ((double) gt_custom_track_density_get_number_of_features(ct, range)
+          / width <= max_features_per_pixel) {
+      continue;
+    }
+    if ((type = gt_custom_track_density_get_type(ct))) {
+      gt_hashmap_add(summarized_types, (void*) type, (void*) type);
+      nof_types++;
+    }
+    else
+      summarize_all = true;
+    gt_array_add(selected, ct);
+  }
+
+  if (summarize_all) {
+    /* no features are drawn at all, so do not retrieve them */
+    if (range->start == range->end)
+    {
+      gt_error_set(err, "range start must not be equal to range end");
+      diagram = NULL;
+    }
+    else {
+      diagram = gt_diagram_new_generic(gt_array_new(sizeof (GtGenomeNode*)),
+                                       range, style, false);
+    }
+  }
+  else {
+    /* the feature index cannot filter by type, so summarized features are
+       retrieved as well and discarded while the diagram is built */
+    diagram = gt_diagram_new(feature_index, seqid, range, style, err);
+  }
+
+  if (diagram) {
+    if (nof_types > 0) {
+      diagram->summarized_types = summarized_types;
+      summarized_types = NULL;
+    }
+    for (i = 0; i < gt_array_size(selected); i++) {
+      gt_array_add(diagram->custom_tracks,
+                   *(GtCustomTrack**) gt_array_get(selected, i));
+    }
+  }
+  gt_hashmap_delete(summarized_types);
+  gt_array_delete(selected);
+  return diagram;
+}
+
 GtDiagram* gt_diagram_new_from_array(GtArray *features, const GtRange *range,
                                      GtStyle *style)
 {
@@ -914,6 +1002,27 @@ GtHashmap* gt_diagram_get_blocks(GtDiagram *diagram, GtError *err)
   return ret;
 }
 
+void gt_diagram_set_view_width(GtDiagram *diagram, GtUword view_width)
+{
+  gt_assert(diagram && view_width > 0);
+  gt_rwlock_wrlock(diagram->lock);
+  diagram->view_width = view_width;
+  /* visibility of blocks and captions may change -> discard current blocks */
+  gt_hashmap_delete(diagram->blocks);
+  diagram->blocks = NULL;
+  gt_rwlock_unlock(diagram->lock);
+}
+
+GtUword gt_diagram_get_view_width(const GtDiagram *diagram)
+{
+  GtUword ret;
+  gt_assert(diagram);
+  gt_rwlock_rdlock(diagram->lock);
+  ret = diagram->view_width;
+  gt_rwlock_unlock(diagram->lock);
+  return ret;
+}
+
 GtArray* gt_diagram_get_custom_tracks(const GtDiagram *diagram)
 {
   GtArray *ret;
@@ -1008,6 +1117,7 @@ void gt_diagram_delete(GtDiagram *diagram)
   gt_hashmap_delete(diagram->collapsingtypes);
   gt_hashmap_delete(diagram->groupedtypes);
   gt_hashmap_delete(diagram->caption_display_status);
+  gt_hashmap_delete(diagram->summarized_types);
   gt_array_delete(diagram->custom_tracks);
   gt_rwlock_unlock(diagram->lock);
   gt_rwlock_delete(diagram->lock);
@@ -26,6 +26,14 @@
 
 GtHashmap* gt_diagram_get_blocks(GtDiagram *diagram, GtError *err);
 GtArray*   gt_diagram_get_custom_tracks(const GtDiagram *diagram);
+/* Sets the length of the sequence region which is visible at once to
+   <view_width>. This length is used instead of the length of the diagram range
+   to decide whether blocks and captions are shown (see the 'max_show_width'
+   and 'max_capt_show_width' style options), e.g. if only a part of the diagram
+   is rendered at a time. */
+void       gt_diagram_set_view_width(GtDiagram *diagram, GtUword view_width);
+/* Returns the length of the sequence region which is visible at once. */
+GtUword    gt_diagram_get_view_width(const GtDiagram *diagram);
 void       gt_diagram_reset(GtDiagram *diagram);
 int        gt_diagram_unit_test(GtError*);
 
@@ -45,6 +45,25 @@ typedef void (*GtTrackSelectorFunc)(GtBlock*, GtStr*, void*);
    layout process. */
 GtDiagram* gt_diagram_new(GtFeatureIndex *feature_index, const char *seqid,
                           const GtRange *range, GtStyle *style, GtError*);
+/* Like <gt_diagram_new()>, but features of types which are too dense to be
+   shown individually are replaced by density tracks. <density_tracks> is an
+   array of <GtCustomTrack*> created with <gt_custom_track_density_new()> for
+   the same <feature_index> and <seqid>. Each of them which counts more than
+   <max_features_per_pixel> features per pixel of the target image width
+   <width> within <range> is added to the diagram, and the features of its type
+   are left out of the diagram. This saves layout and drawing time, but not
+   retrieval time: the features of summarized types are still read from
+   <feature_index> and discarded, unless a track counting all top-level
+   features is selected, in which case no features are retrieved at all.
+   Summarization is opt-in, neither <gt_diagram_new()> nor the gt sketch tool
+   use it. The density tracks are not copied and must exist as long as the
+   diagram is used. */
+GtDiagram* gt_diagram_new_summarized(GtFeatureIndex *feature_index,
+                                     const char *seqid, const GtRange *range,
+                                     GtStyle *style, GtArray *density_tracks,
+                                     unsigned int width,
+                                     double max_features_per_pixel,
+                                     GtError *err);
 /* Create a new <GtDiagram> object representing the feature nodes in
    <features>. The features must overlap with <range>. The <GtStyle>
    object <style> will be used to determine collapsing options during the
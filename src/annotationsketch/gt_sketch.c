@@ -25,13 +25,18 @@
 #include "core/option_api.h"
 #include "core/output_file_api.h"
 #include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/parseutils_api.h"
 #include "core/splitter.h"
+#include "core/str.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/versionfunc.h"
 #include "core/warning_api.h"
 #include "extended/add_introns_stream_api.h"
 #include "extended/bed_in_stream.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
@@ -46,6 +51,7 @@
 #include "annotationsketch/image_info.h"
 #include "annotationsketch/layout.h"
 #include "annotationsketch/style.h"
+#include "annotationsketch/text_width_calculator_cairo.h"
 
 typedef struct {
   bool pipe,
@@ -56,7 +62,7 @@ typedef struct {
        unsafe,
        force,
        use_streams;
-  GtStr *seqid, *format, *stylefile, *input;
+  GtStr *seqid, *format, *stylefile, *input, *regions;
   GtUword start,
                 end;
   unsigned int width;
@@ -69,6 +75,7 @@ static void* gt_sketch_arguments_new(void)
   arguments->format = gt_str_new();
   arguments->input = gt_str_new();
   arguments->stylefile = gt_str_new();
+  arguments->regions = gt_str_new();
   return arguments;
 }
 
@@ -80,6 +87,7 @@ static void gt_sketch_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->format);
   gt_str_delete(arguments->input);
   gt_str_delete(arguments->stylefile);
+  gt_str_delete(arguments->regions);
   gt_free(arguments);
 }
 
@@ -87,7 +95,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
 {
   GtSketchArguments *arguments = tool_arguments;
   GtOptionParser *op;
-  GtOption *option, *option2;
+  GtOption *option, *option2, *regions_option;
   static const char *formats[] = { "png",
 #ifdef CAIRO_HAS_PDF_SURFACE
     "pdf",
@@ -104,6 +112,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
     "gff",
     "bed",
     "gtf",
+    "mapped",
     NULL
   };
   gt_assert(arguments);
@@ -111,7 +120,9 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
   /* init */
   op = gt_option_parser_new("[option ...] image_file [GFF3_file ...]",
                             "Create graphical representation of GFF3 "
-                            "annotation files.");
+                            "annotation files.\n"
+                            "With -regions, image_file is the directory the "
+                            "images are written to.");
 
   /* -pipe */
   option = gt_option_new_bool("pipe", "use pipe mode (i.e., show all gff3 "
@@ -124,12 +135,25 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
                               "description", &arguments->flattenfiles, false);
   gt_option_parser_add_option(op, option);
 
+  /* -regions */
+  regions_option = gt_option_new_filename("regions", "create one image for "
+                                          "each region listed in the given "
+                                          "file, either in BED format (the "
+                                          "optional name column is used as "
+                                          "image file name) or one "
+                                          "'seqid:start-end' per line\n"
+                                          "the images are created in parallel "
+                                          "if -j is used",
+                                          arguments->regions);
+  gt_option_parser_add_option(op, regions_option);
+
   /* -seqid */
   option = gt_option_new_string("seqid", "sequence region identifier\n"
                                       "default: first one in file",
                             arguments->seqid, NULL);
   gt_option_parser_add_option(op, option);
   gt_option_hide_default(option);
+  gt_option_exclude(regions_option, option);
 
   /* -start */
   option = gt_option_new_uword_min("start", "start position\n"
@@ -146,6 +170,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
   gt_option_imply(option, option2);
   gt_option_imply(option2, option);
   gt_option_hide_default(option2);
+  gt_option_exclude(regions_option, option);
 
   /* -width */
   option = gt_option_new_uint_min("width", "target image width (in pixel)",
@@ -177,7 +202,9 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
 
   /* -input */
   option = gt_option_new_choice("input", "input data format\n"
-                                       "choose from gff|bed|gtf",
+                                       "choose from gff|bed|gtf|mapped "
+                                       "(a feature index file written by "
+                                       "'gt mkfeatureindex -backend mapped')",
                              arguments->input, inputs[0], inputs);
   gt_option_parser_add_option(op, option);
 
@@ -198,6 +225,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
                               &arguments->showrecmaps, false);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
+  gt_option_exclude(regions_option, option);
 
   /* -streams */
   option = gt_option_new_bool("streams", "use streams to write data to file",
@@ -219,7 +247,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
   return op;
 }
 
-static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
+static int gt_sketch_arguments_check(int rest_argc,
                                      void *tool_arguments,
                                      GT_UNUSED GtError *err)
 {
@@ -237,6 +265,19 @@ static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
     had_err = -1;
   }
 
+  if (!had_err && strcmp(gt_str_get(arguments->input), "mapped") == 0) {
+    if (rest_argc != 2) {
+      gt_error_set(err, "option -input mapped requires exactly one feature "
+                        "index file");
+      had_err = -1;
+    }
+    else if (arguments->addintrons || arguments->pipe) {
+      gt_error_set(err, "options -addintrons and -pipe cannot be used with "
+                        "-input mapped");
+      had_err = -1;
+    }
+  }
+
   return had_err;
 }
 
@@ -250,6 +291,331 @@ static void flattened_file_track_selector(GtBlock *block, GtStr *result,
   gt_str_append_cstr(result, gt_block_get_type(block));
 }
 
+/* Renders the features of <features> on <seqid> within <range> to the image
+   file <file>. If <twc> is NULL, the layout uses its own text width
+   calculator. */
+static int sketch_region(GtSketchArguments *arguments,
+                         GtFeatureIndex *features, GtStyle *sty,
+                         GtTextWidthCalculator *twc, const char *seqid,
+                         const GtRange *range, const char *file, GtError *err)
+{
+  GtDiagram *d = NULL;
+  GtLayout *l = NULL;
+  GtImageInfo* ii = NULL;
+  GtCanvas *canvas = NULL;
+  GtUword height;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!(d = gt_diagram_new(features, seqid, range, sty, err)))
+    had_err = -1;
+  if (!had_err && arguments->flattenfiles)
+    gt_diagram_set_track_selector_func(d, flattened_file_track_selector,
+                                       NULL);
+  if (!had_err) {
+    if (twc)
+      l = gt_layout_new_with_twc(d, arguments->width, sty, twc, err);
+    else
+      l = gt_layout_new(d, arguments->width, sty, err);
+    if (!l)
+      had_err = -1;
+  }
+  if (!had_err)
+    had_err = gt_layout_get_height(l, &height, err);
+  if (!had_err) {
+    ii = gt_image_info_new();
+
+    if (strcmp(gt_str_get(arguments->format),"pdf")==0) {
+      canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PDF,
+                                        arguments->width,
+                                        height, ii, err);
+    }
+    else if (strcmp(gt_str_get(arguments->format),"ps")==0) {
+      canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PS,
+                                        arguments->width,
+                                        height, ii, err);
+    }
+    else if (strcmp(gt_str_get(arguments->format),"svg")==0) {
+      canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_SVG,
+                                        arguments->width,
+                                        height, ii, err);
+    }
+    else {
+      canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PNG,
+                                        arguments->width,
+                                        height, ii, err);
+    }
+    if (!canvas)
+      had_err = -1;
+    if (!had_err) {
+      had_err = gt_layout_sketch(l, canvas, err);
+    }
+    if (!had_err) {
+      if (arguments->showrecmaps) {
+        GtUword i;
+        const GtRecMap *rm;
+        for (i = 0; i < gt_image_info_num_of_rec_maps(ii) ;i++) {
+          char buf[BUFSIZ];
+          rm = gt_image_info_get_rec_map(ii, i);
+          (void) gt_rec_map_format_html_imagemap_coords(rm, buf, BUFSIZ);
+          printf("%s, %s\n",
+                 buf,
+                 gt_feature_node_get_type(gt_rec_map_get_genome_feature(rm)));
+        }
+      }
+      if (arguments->use_streams) {
+        GtFile *outfile;
+        GtStr *str = gt_str_new();
+        gt_canvas_cairo_file_to_stream((GtCanvasCairoFile*) canvas, str);
+        outfile = gt_file_open(GT_FILE_MODE_UNCOMPRESSED, file, "w+", err);
+        if (outfile) {
+          gt_file_xwrite(outfile, gt_str_get_mem(str), gt_str_length(str));
+          gt_file_delete(outfile);
+        } else {
+          had_err = -1;
+        }
+        gt_str_delete(str);
+      } else {
+        had_err = gt_canvas_cairo_file_to_file((GtCanvasCairoFile*) canvas,
+                                               file,
+                                               err);
+      }
+    }
+  }
+
+  gt_canvas_delete(canvas);
+  gt_layout_delete(l);
+  gt_image_info_delete(ii);
+  gt_diagram_delete(d);
+  return had_err;
+}
+
+typedef struct {
+  GtStr *seqid,
+        *file;
+  GtRange range;
+} GtSketchBatchJob;
+
+typedef struct {
+  GtSketchArguments *arguments;
+  GtFeatureIndex *features;
+  GtStyle *style;
+  GtArray *jobs;
+  GtUword next_job,
+          failed_job;
+  GtError *err;
+  GtMutex *mutex;
+} GtSketchBatchInfo;
+
+/* Parses one line of the region file <filename> into <job>. Lines are either
+   BED (0-based, half-open coordinates, optional name column) or of the form
+   'seqid:start-end' (1-based, inclusive). */
+static int sketch_batch_parse_line(GtSketchBatchJob *job, char *line,
+                                   GtSplitter *splitter, const char *outdir,
+                                   const char *format, unsigned int line_number,
+                                   const char *filename, GtError *err)
+{
+  GtUword bed_start, bed_end;
+  const char *name = NULL;
+  char *sep, *dash;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gt_splitter_reset(splitter);
+  gt_splitter_split_non_empty(splitter, line, strlen(line), '\t');
+  if (gt_splitter_size(splitter) >= 3) {
+    gt_str_set(job->seqid, gt_splitter_get_token(splitter, 0));
+    if (gt_parse_uword(&bed_start, gt_splitter_get_token(splitter, 1))
+          || gt_parse_uword(&bed_end, gt_splitter_get_token(splitter, 2))
+          || bed_start >= bed_end) {
+      gt_error_set(err, "could not parse BED region on line %u in file '%s'",
+                   line_number, filename);
+      had_err = -1;
+    }
+    if (!had_err) {
+      job->range.start = bed_start + 1;
+      job->range.end = bed_end;
+      if (gt_splitter_size(splitter) >= 4)
+        name = gt_splitter_get_token(splitter, 3);
+    }
+  }
+  else {
+    if (!(sep = strrchr(line, ':')) || !(dash = strchr(sep, '-'))) {
+      gt_error_set(err, "region on line %u in file '%s' is neither BED nor "
+                        "'seqid:start-end'", line_number, filename);
+      had_err = -1;
+    }
+    if (!had_err) {
+      *sep = *dash = '\0';
+      gt_str_set(job->seqid, line);
+      had_err = gt_parse_range(&job->range, sep + 1, dash + 1, line_number,
+                               filename, err);
+    }
+    if (!had_err && job->range.start == job->range.end) {
+      gt_error_set(err, "region on line %u in file '%s' has length 1",
+                   line_number, filename);
+      had_err = -1;
+    }
+  }
+
+  if (!had_err) {
+    gt_str_set(job->file, outdir);
+    gt_str_append_char(job->file, '/');
+    if (name)
+      gt_str_append_cstr(job->file, name);
+    else {
+      gt_str_append_str(job->file, job->seqid);
+      gt_str_append_char(job->file, '_');
+      gt_str_append_uword(job->file, job->range.start);
+      gt_str_append_char(job->file, '-');
+      gt_str_append_uword(job->file, job->range.end);
+    }
+    gt_str_append_char(job->file, '.');
+    gt_str_append_cstr(job->file, format);
+  }
+  return had_err;
+}
+
+static int sketch_batch_read_regions(GtArray *jobs, const char *filename,
+                                     const char *outdir, const char *format,
+                                     GtError *err)
+{
+  GtSketchBatchJob job;
+  GtSplitter *splitter;
+  GtFile *file;
+  GtStr *line;
+  unsigned int line_number = 0;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!(file = gt_file_new(filename, "r", err)))
+    return -1;
+  line = gt_str_new();
+  splitter = gt_splitter_new();
+  while (!had_err && gt_str_read_next_line_generic(line, file) != EOF) {
+    line_number++;
+    /* skip empty lines, comments and BED headers */
+    if (gt_str_length(line) == 0
+          || gt_str_get(line)[0] == '#'
+          || strncmp(gt_str_get(line), "track", 5) == 0
+          || strncmp(gt_str_get(line), "browser", 7) == 0) {
+      gt_str_reset(line);
+      continue;
+    }
+    job.seqid = gt_str_new();
+    job.file = gt_str_new();
+    had_err = sketch_batch_parse_line(&job, gt_str_get(line), splitter,
+                                      outdir, format, line_number, filename,
+                                      err);
+    gt_array_add(jobs, job);
+    gt_str_reset(line);
+  }
+  gt_splitter_delete(splitter);
+  gt_str_delete(line);
+  gt_file_delete(file);
+  return had_err;
+}
+
+/* Records the error <err> of job number <job_number>, keeping the error of the
+   first failing job in file order to make error reporting deterministic. */
+static void sketch_batch_set_error(GtSketchBatchInfo *info,
+                                   GtUword job_number, GtError *err)
+{
+  gt_mutex_lock(info->mutex);
+  if (info->failed_job == GT_UNDEF_UWORD || job_number < info->failed_job) {
+    gt_error_set(info->err, "%s", gt_error_get(err));
+    info->failed_job = job_number;
+  }
+  gt_mutex_unlock(info->mutex);
+}
+
+static void* sketch_batch_thread(void *data)
+{
+  GtSketchBatchInfo *info = data;
+  GtTextWidthCalculator *twc;
+  GtSketchBatchJob *job;
+  GtUword job_number;
+  GtError *err;
+  gt_assert(info);
+
+  err = gt_error_new();
+  /* every worker measures text widths on its own cairo surface, and the
+     layouts are done serially within the worker */
+  if (!(twc = gt_text_width_calculator_cairo_new(NULL, info->style, err)))
+    sketch_batch_set_error(info, 0, err);
+  while (twc) {
+    gt_mutex_lock(info->mutex);
+    if (info->next_job == gt_array_size(info->jobs)
+          || info->failed_job != GT_UNDEF_UWORD) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    job_number = info->next_job++;
+    gt_mutex_unlock(info->mutex);
+    job = gt_array_get(info->jobs, job_number);
+    if (sketch_region(info->arguments, info->features, info->style, twc,
+                      gt_str_get(job->seqid), &job->range,
+                      gt_str_get(job->file), err)) {
+      sketch_batch_set_error(info, job_number, err);
+      gt_error_unset(err);
+    }
+  }
+  gt_text_width_calculator_delete(twc);
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* Renders an image for every region listed in the region file into directory
+   <outdir>, using <gt_jobs> worker threads. The annotation and the style are
+   shared by all workers. */
+static int sketch_batch(GtSketchArguments *arguments, GtFeatureIndex *features,
+                        GtStyle *sty, const char *outdir, GtError *err)
+{
+  GtSketchBatchInfo info;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  info.arguments = arguments;
+  info.features = features;
+  info.style = sty;
+  info.jobs = gt_array_new(sizeof (GtSketchBatchJob));
+  info.next_job = 0;
+  info.failed_job = GT_UNDEF_UWORD;
+  info.err = err;
+  info.mutex = gt_mutex_new();
+
+  if (!gt_file_exists(outdir)) {
+    gt_error_set(err, "output directory '%s' does not exist", outdir);
+    had_err = -1;
+  }
+  if (!had_err) {
+    had_err = sketch_batch_read_regions(info.jobs,
+                                        gt_str_get(arguments->regions), outdir,
+                                        gt_str_get(arguments->format), err);
+  }
+  /* queries on a frozen index do not need to synchronize */
+  if (!had_err)
+    had_err = gt_feature_index_freeze(features, err);
+  if (!had_err)
+    had_err = gt_multithread(sketch_batch_thread, &info, err);
+  if (!had_err && info.failed_job != GT_UNDEF_UWORD)
+    had_err = -1;
+  if (!had_err && arguments->verbose) {
+    fprintf(stderr, "created "GT_WU" images in '%s'\n",
+            gt_array_size(info.jobs), outdir);
+  }
+
+  for (i = 0; i < gt_array_size(info.jobs); i++) {
+    GtSketchBatchJob *job = gt_array_get(info.jobs, i);
+    gt_str_delete(job->seqid);
+    gt_str_delete(job->file);
+  }
+  gt_array_delete(info.jobs);
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+
 static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
                               void *tool_arguments, GT_UNUSED GtError *err)
 {
@@ -264,15 +630,10 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   const char *file;
   char *seqid = NULL;
   GtRange qry_range, sequence_region_range;
-  GtArray *results = NULL;
   GtStyle *sty = NULL;
   GtStr *prog, *defaultstylefile = NULL;
-  GtDiagram *d = NULL;
-  GtLayout *l = NULL;
-  GtImageInfo* ii = NULL;
-  GtCanvas *canvas = NULL;
-  GtUword height;
-  bool has_seqid;
+  bool has_seqid = false,
+       batch = false;
   int had_err = 0;
   gt_error_check(err);
   gt_assert(arguments);
@@ -289,7 +650,12 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   file = argv[parsed_args];
-  if (!had_err) {
+  if (!had_err && strcmp(gt_str_get(arguments->input), "mapped") == 0) {
+    /* the features are read from the mapped index on demand */
+    if (!(features = gt_feature_index_mapped_new(argv[parsed_args + 1], err)))
+      had_err = -1;
+  }
+  else if (!had_err) {
     /* create feature index */
     features = gt_feature_index_memory_new();
     parsed_args++;
@@ -342,7 +708,10 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
     gt_node_stream_delete(in_stream);
   }
 
-  if (!had_err) {
+  if (!had_err && gt_str_length(arguments->regions) > 0) {
+    batch = true;
+  }
+  else if (!had_err) {
     had_err = gt_feature_index_has_seqid(features,
                                          &has_seqid,
                                          gt_str_get(arguments->seqid),
@@ -350,29 +719,28 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   /* if seqid is empty, take first one added to index */
-  if (!had_err && strcmp(gt_str_get(arguments->seqid),"") == 0) {
+  if (!had_err && !batch && strcmp(gt_str_get(arguments->seqid),"") == 0) {
     seqid = gt_feature_index_get_first_seqid(features, err);
     if (seqid == NULL) {
       gt_error_set(err, "GFF input file must contain a sequence region!");
       had_err = -1;
     }
   }
-  else if (!had_err && !has_seqid) {
+  else if (!had_err && !batch && !has_seqid) {
     gt_error_set(err, "sequence region '%s' does not exist in GFF input file",
                  gt_str_get(arguments->seqid));
     had_err = -1;
   }
-  else if (!had_err)
+  else if (!had_err && !batch)
     seqid = gt_cstr_dup(gt_str_get(arguments->seqid));
 
-  results = gt_array_new(sizeof (GtGenomeNode*));
-  if (!had_err) {
+  if (!had_err && !batch) {
     had_err = gt_feature_index_get_range_for_seqid(features,
                                                    &sequence_region_range,
                                                    seqid,
                                                    err);
   }
-  if (!had_err) {
+  if (!had_err && !batch) {
     qry_range.start = (arguments->start == GT_UNDEF_UWORD ?
                          sequence_region_range.start :
                          arguments->start);
@@ -382,9 +750,6 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   if (!had_err) {
-    if (arguments->verbose)
-      fprintf(stderr, "# of results: "GT_WU"\n", gt_array_size(results));
-
     /* find and load style file */
     if (!(sty = gt_style_new(err)))
       had_err = -1;
@@ -406,87 +771,17 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
       had_err = gt_style_load_file(sty, gt_str_get(arguments->stylefile), err);
   }
 
-  if (!had_err) {
+  if (!had_err && batch)
+    had_err = sketch_batch(arguments, features, sty, file, err);
+  else if (!had_err) {
     /* create and write image file */
-    if (!(d = gt_diagram_new(features, seqid, &qry_range, sty, err)))
-      had_err = -1;
-    if (!had_err && arguments->flattenfiles)
-      gt_diagram_set_track_selector_func(d, flattened_file_track_selector,
-                                         NULL);
-    if (had_err || !(l = gt_layout_new(d, arguments->width, sty, err)))
-      had_err = -1;
-    if (!had_err)
-      had_err = gt_layout_get_height(l, &height, err);
-    if (!had_err) {
-      ii = gt_image_info_new();
-
-      if (strcmp(gt_str_get(arguments->format),"pdf")==0) {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PDF,
-                                          arguments->width,
-                                          height, ii, err);
-      }
-      else if (strcmp(gt_str_get(arguments->format),"ps")==0) {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PS,
-                                          arguments->width,
-                                          height, ii, err);
-      }
-      else if (strcmp(gt_str_get(arguments->format),"svg")==0) {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_SVG,
-                                          arguments->width,
-                                          height, ii, err);
-      }
-      else {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PNG,
-                                          arguments->width,
-                                          height, ii, err);
-      }
-      if (!canvas)
-        had_err = -1;
-      if (!had_err) {
-        had_err = gt_layout_sketch(l, canvas, err);
-      }
-      if (!had_err) {
-        if (arguments->showrecmaps) {
-          GtUword i;
-          const GtRecMap *rm;
-          for (i = 0; i < gt_image_info_num_of_rec_maps(ii) ;i++) {
-            char buf[BUFSIZ];
-            rm = gt_image_info_get_rec_map(ii, i);
-            (void) gt_rec_map_format_html_imagemap_coords(rm, buf, BUFSIZ);
-            printf("%s, %s\n",
-                   buf,
-                   gt_feature_node_get_type(gt_rec_map_get_genome_feature(rm)));
-          }
-        }
-        if (arguments->use_streams) {
-          GtFile *outfile;
-          GtStr *str = gt_str_new();
-          gt_canvas_cairo_file_to_stream((GtCanvasCairoFile*) canvas, str);
-          outfile = gt_file_open(GT_FILE_MODE_UNCOMPRESSED, file, "w+", err);
-          if (outfile) {
-            gt_file_xwrite(outfile, gt_str_get_mem(str), gt_str_length(str));
-            gt_file_delete(outfile);
-          } else {
-            had_err = -1;
-          }
-          gt_str_delete(str);
-        } else {
-          had_err = gt_canvas_cairo_file_to_file((GtCanvasCairoFile*) canvas,
-                                                 file,
-                                                 err);
-        }
-      }
-    }
+    had_err = sketch_region(arguments, features, sty, NULL, seqid, &qry_range,
+                            file, err);
   }
 
   /* free */
   gt_free(seqid);
-  gt_canvas_delete(canvas);
-  gt_layout_delete(l);
-  gt_image_info_delete(ii);
   gt_style_delete(sty);
-  gt_diagram_delete(d);
-  gt_array_delete(results);
   gt_str_delete(defaultstylefile);
   gt_feature_index_delete(features);
 
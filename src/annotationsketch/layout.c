@@ -34,6 +34,7 @@
 #include "core/mathsupport.h"
 #include "core/minmax.h"
 #include "core/msort.h"
+#include "core/multithread_api.h"
 #include "core/str.h"
 #include "core/thread_api.h"
 #include "core/undef_api.h"
@@ -56,6 +57,21 @@ typedef struct {
   GtStyle *style;
 } GtTracklineInfo;
 
+typedef struct {
+  const char *key;
+  GtArray *blocks;
+  GtTrack *track;
+  GtError *err;
+  int had_err;
+} GtLayoutTrackJob;
+
+typedef struct {
+  GtLayout *layout;
+  GtArray *jobs;
+  GtUword next_job;
+  GtMutex *mutex;
+} GtLayoutThreadInfo;
+
 struct GtLayout {
   GtStyle *style;
   GtTextWidthCalculator *twc;
@@ -65,7 +81,8 @@ struct GtLayout {
   GtHashmap *tracks,
             *blocks;
   GtRange viewrange;
-  GtUword nof_tracks;
+  GtUword nof_tracks,
+          view_width;
   unsigned int width;
   GtRWLock *lock;
   GtTrackOrderingFunc track_ordering_func;
@@ -95,39 +112,41 @@ static int add_tracklines(GT_UNUSED void *key, void *value,
   return 0;
 }
 
-static int layout_tracks(void *key, void *value, void *data,
-                         GtError *err)
+/* Builds the track for the blocks in <list>, measuring captions with <twc>.
+   Only touches <list> and the new track, so that different tracks can be laid
+   out concurrently as long as each thread uses its own <twc>. */
+static int layout_build_track(GtLayout *layout, GtTextWidthCalculator *twc,
+                              const char *key, GtArray *list,
+                              GtTrack **result, GtError *err)
 {
   GtUword i,
                 max = 50;
   GtTrack *track = NULL;
-  GtLayoutTraverseInfo *lti = (GtLayoutTraverseInfo*) data;
-  GtArray *list = (GtArray*) value;
   GtStr *gt_track_key;
   GtBlock *block;
   int had_err = 0;
   bool split = true;
-  double tmp = 50;
-  gt_assert(list);
+  double tmp = 50,
+         max_split_width;
+  gt_assert(layout && twc && key && list && result);
 
   /* to get a deterministic layout, we sort the GtBlocks for each type */
-  if (lti->layout->block_ordering_func) {
-    gt_array_sort_stable_with_data(list, blocklist_block_compare,
-                                   lti->layout);
+  if (layout->block_ordering_func) {
+    gt_array_sort_stable_with_data(list, blocklist_block_compare, layout);
   }
 
   /* XXX: get first block for track property lookups, this should be reworked
      to allow arbitrary track keys! */
   block = *(GtBlock**) gt_array_get(list, 0);
-  gt_track_key = gt_str_new_cstr((char*) key);
+  gt_track_key = gt_str_new_cstr(key);
 
   /* obtain default settings*/
-  if (gt_style_get_bool(lti->layout->style, "format", "split_lines", &split,
+  if (gt_style_get_bool(layout->style, "format", "split_lines", &split,
                          NULL, err) == GT_STYLE_QUERY_ERROR) {
     had_err = 1;
   }
   if (!had_err) {
-    if (gt_style_get_num(lti->layout->style,
+    if (gt_style_get_num(layout->style,
                          "format", "max_num_lines",
                          &tmp, NULL, err) == GT_STYLE_QUERY_ERROR) {
       had_err = 1;
@@ -136,45 +155,153 @@ static int layout_tracks(void *key, void *value, void *data,
   /* obtain track-specific settings, should be changed to query arbitrary
      track keys! */
   if (!had_err) {
-    if (gt_style_get_bool(lti->layout->style, gt_block_get_type(block),
+    if (gt_style_get_bool(layout->style, gt_block_get_type(block),
                           "split_lines",  &split, NULL,
                           err) == GT_STYLE_QUERY_ERROR) {
       had_err = 1;
     }
   }
   if (!had_err) {
-    if (gt_style_get_num(lti->layout->style, gt_block_get_type(block),
+    if (gt_style_get_num(layout->style, gt_block_get_type(block),
                          "max_num_lines", &tmp, NULL,
                          err) == GT_STYLE_QUERY_ERROR) {
       had_err = 1;
     }
   }
+  /* aggregate dense tracks into a single line if the view is too wide */
+  if (!had_err && split) {
+    switch (gt_style_get_num(layout->style, gt_block_get_type(block),
+                             "max_split_width", &max_split_width, NULL, err)) {
+      case GT_STYLE_QUERY_ERROR:
+        had_err = 1;
+        break;
+      case GT_STYLE_QUERY_OK:
+        if (gt_double_smaller_double(max_split_width,
+                                     (double) layout->view_width)) {
+          split = false;
+        }
+        break;
+      default:
+        break;
+    }
+  }
 
   if (!had_err) {
     max = (GtUword) tmp;
     track = gt_track_new(gt_track_key, max, split,
-                         gt_line_breaker_captions_new(lti->layout,
-                                                      lti->layout->width,
-                                                      lti->layout->style));
-    lti->layout->nof_tracks++;
+                         gt_line_breaker_captions_new(layout, twc,
+                                                      layout->width,
+                                                      layout->style));
     for (i = 0; !had_err && i < gt_array_size(list); i++) {
       block = *(GtBlock**) gt_array_get(list, i);
       had_err = gt_track_insert_block(track, block, err);
     }
   }
-  if (!had_err) {
-    gt_hashmap_add(lti->layout->tracks, gt_cstr_dup(gt_str_get(gt_track_key)),
-                   track);
-  }
+  if (!had_err)
+    *result = track;
   else
-  {
     gt_track_delete(track);
-  }
 
   gt_str_delete(gt_track_key);
   return had_err;
 }
 
+static int layout_tracks(void *key, void *value, void *data,
+                         GtError *err)
+{
+  GtLayoutTraverseInfo *lti = (GtLayoutTraverseInfo*) data;
+  GtTrack *track = NULL;
+  int had_err = 0;
+  gt_assert(lti && value);
+  had_err = layout_build_track(lti->layout, lti->twc, (const char*) key,
+                               (GtArray*) value, &track, err);
+  if (!had_err) {
+    lti->layout->nof_tracks++;
+    gt_hashmap_add(lti->layout->tracks, gt_cstr_dup((const char*) key), track);
+  }
+  return had_err;
+}
+
+static int add_track_job(void *key, void *value, void *data,
+                         GT_UNUSED GtError *err)
+{
+  GtLayoutTrackJob job;
+  job.key = (const char*) key;
+  job.blocks = (GtArray*) value;
+  job.track = NULL;
+  job.err = gt_error_new();
+  job.had_err = 0;
+  gt_array_add((GtArray*) data, job);
+  return 0;
+}
+
+static void* layout_tracks_thread(void *data)
+{
+  GtLayoutThreadInfo *info = (GtLayoutThreadInfo*) data;
+  GtTextWidthCalculator *twc = NULL;
+  GtLayoutTrackJob *job;
+  gt_assert(info);
+
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    if (info->next_job == gt_array_size(info->jobs)) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    job = (GtLayoutTrackJob*) gt_array_get(info->jobs, info->next_job++);
+    gt_mutex_unlock(info->mutex);
+    /* text is measured on a private cairo context per thread, set up exactly
+       like the one of the layout to obtain identical line breaks */
+    if (!twc && !(twc = gt_text_width_calculator_cairo_new(NULL,
+                                                           info->layout->style,
+                                                           job->err))) {
+      job->had_err = -1;
+      continue;
+    }
+    job->had_err = layout_build_track(info->layout, twc, job->key,
+                                      job->blocks, &job->track, job->err);
+  }
+  gt_text_width_calculator_delete(twc);
+  return NULL;
+}
+
+/* Lays out the tracks using <gt_jobs> threads. Tracks are added to the layout
+   in key order afterwards, and the first error in that order is reported. */
+static int layout_all_tracks_parallel(GtLayout *layout, GtError *err)
+{
+  GtLayoutThreadInfo info;
+  GtLayoutTrackJob *job;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+
+  info.layout = layout;
+  info.jobs = gt_array_new(sizeof (GtLayoutTrackJob));
+  info.next_job = 0;
+  info.mutex = gt_mutex_new();
+  had_err = gt_hashmap_foreach_in_key_order(layout->blocks, add_track_job,
+                                            info.jobs, err);
+  if (!had_err)
+    had_err = gt_multithread(layout_tracks_thread, &info, err);
+  for (i = 0; i < gt_array_size(info.jobs); i++) {
+    job = (GtLayoutTrackJob*) gt_array_get(info.jobs, i);
+    if (!had_err && job->had_err) {
+      gt_error_set(err, "%s", gt_error_get(job->err));
+      had_err = -1;
+    }
+    if (!had_err && job->track) {
+      layout->nof_tracks++;
+      gt_hashmap_add(layout->tracks, gt_cstr_dup(job->key), job->track);
+    }
+    else
+      gt_track_delete(job->track);
+    gt_error_delete(job->err);
+  }
+  gt_mutex_delete(info.mutex);
+  gt_array_delete(info.jobs);
+  return had_err;
+}
+
 static int layout_all_tracks(GtLayout *layout, GtError *err)
 {
   int had_err = 0;
@@ -183,9 +310,18 @@ static int layout_all_tracks(GtLayout *layout, GtError *err)
   gt_error_check(err);
 
   if (!layout->layout_done) {
-    lti.layout = layout;
-    lti.twc = layout->twc;
-    had_err = gt_hashmap_foreach(layout->blocks, layout_tracks, &lti, err);
+    /* tracks are laid out in parallel only if each thread can measure text
+       with its own copy of the text width calculator, and no user-defined
+       block ordering callback has to be called concurrently */
+    if (gt_jobs > 1 && layout->own_twc
+          && (!layout->block_ordering_func
+                || layout->block_ordering_func == gt_block_compare)) {
+      had_err = layout_all_tracks_parallel(layout, err);
+    } else {
+      lti.layout = layout;
+      lti.twc = layout->twc;
+      had_err = gt_hashmap_foreach(layout->blocks, layout_tracks, &lti, err);
+    }
     layout->layout_done = true;
   }
   return had_err;
@@ -275,6 +411,7 @@ GtLayout* gt_layout_new_with_twc(GtDiagram *diagram,
   layout->width = width;
   layout->blocks = NULL;
   layout->viewrange = gt_diagram_get_range(diagram);
+  layout->view_width = gt_diagram_get_view_width(diagram);
   layout->nof_tracks = 0;
   layout->track_ordering_func = NULL;
   layout->block_ordering_func = gt_block_compare;
@@ -356,6 +493,26 @@ int gt_layout_sketch(GtLayout *layout, GtCanvas *target_canvas, GtError *err)
   return had_err ? -1 : 0;
 }
 
+int gt_layout_sketch_range(GtLayout *layout, GtCanvas *target_canvas,
+                           const GtRange *range, GtError *err)
+{
+  int had_err = 0;
+  GtRange viewrange;
+  gt_assert(layout && target_canvas && range && range->start <= range->end);
+
+  /* line breaking must be done on the complete view range */
+  gt_rwlock_wrlock(layout->lock);
+  had_err = layout_all_tracks(layout, err);
+  if (!had_err) {
+    viewrange = layout->viewrange;
+    layout->viewrange = *range;
+    had_err = gt_layout_sketch(layout, target_canvas, err);
+    layout->viewrange = viewrange;
+  }
+  gt_rwlock_unlock(layout->lock);
+  return had_err;
+}
+
 void gt_layout_set_track_ordering_func(GtLayout *layout,
                                        GtTrackOrderingFunc track_ordering_func,
                                        void *data)
@@ -37,5 +37,13 @@ void                   gt_layout_unset_block_ordering_func(GtLayout*);
 GtRange                gt_layout_get_range(const GtLayout*);
 /* Returns the TextWidthCalculator object used in the layout. */
 GtTextWidthCalculator* gt_layout_get_twc(const GtLayout*);
+/* Renders the part of <layout> within <range> on <target_canvas>, using the
+   lines computed for the complete interval of <layout>. The canvas width
+   determines the scale, so that parts of equal length rendered on canvases of
+   the same width fit together seamlessly if no margins are set. */
+int                    gt_layout_sketch_range(GtLayout *layout,
+                                              GtCanvas *target_canvas,
+                                              const GtRange *range,
+                                              GtError *err);
 
 #endif
@@ -43,7 +43,9 @@ typedef int (*GtTrackOrderingFunc)(const char *s1, const char *s2, void *data);
 
 /* Creates a new <GtLayout> object for the contents of <diagram>.
    The layout is done for a target image width of <width> and using the rules in
-   <GtStyle> object <style>. */
+   <GtStyle> object <style>. If more than one job is used (see <gt_jobs>), the
+   tracks are laid out in parallel, with the same result as a sequential
+   layout. */
 GtLayout*     gt_layout_new(GtDiagram *diagram, unsigned int width, GtStyle*,
                             GtError*);
 /* Like <gt_layout_new()>, but allows use of a different <GtTextWidthCalculator>
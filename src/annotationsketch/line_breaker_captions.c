@@ -30,6 +30,7 @@
 struct GtLineBreakerCaptions {
   const GtLineBreaker parent_instance;
   GtLayout *layout;
+  GtTextWidthCalculator *twc;
   GtUword width;
   double margins;
   GtHashmap *linepositions;
@@ -51,7 +52,7 @@ int calculate_drawing_range(GtLineBreakerCaptions *lbc, GtDrawingRange *rng,
   if (gt_block_get_caption(block))
   {
     textwidth = gt_text_width_calculator_get_text_width(
-                                      gt_layout_get_twc(lbc->layout),
+                                      lbc->twc,
                                       gt_str_get(gt_block_get_caption(block)),
                                       err);
     if (gt_double_smaller_double(textwidth, 0))
@@ -130,15 +131,17 @@ const GtLineBreakerClass* gt_line_breaker_captions_class(void)
 }
 
 GtLineBreaker* gt_line_breaker_captions_new(GtLayout *layout,
+                                            GtTextWidthCalculator *twc,
                                             GtUword width,
                                             GtStyle *style)
 {
   GtLineBreakerCaptions *lbcap;
   GtLineBreaker *lb;
-  gt_assert(layout);
+  gt_assert(layout && twc);
   lb = gt_line_breaker_create(gt_line_breaker_captions_class());
   lbcap = gt_line_breaker_captions_cast(lb);
   lbcap->layout = layout;
+  lbcap->twc = twc;
   lbcap->width = width;
   if (!gt_style_get_num(style, "format", "margins", &lbcap->margins,
                         NULL, NULL)) {
@@ -23,6 +23,7 @@
 #include "annotationsketch/layout.h"
 #include "annotationsketch/line_breaker.h"
 #include "annotationsketch/style.h"
+#include "annotationsketch/text_width_calculator.h"
 
 /* Implements the GtLineBreaker interface; returns new lines if captions
    overlap. */
@@ -30,6 +31,7 @@ typedef struct GtLineBreakerCaptions GtLineBreakerCaptions;
 
 const GtLineBreakerClass* gt_line_breaker_captions_class(void);
 GtLineBreaker*            gt_line_breaker_captions_new(GtLayout*,
+                                                       GtTextWidthCalculator*,
                                                        GtUword width,
                                                        GtStyle*);
 
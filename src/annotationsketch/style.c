@@ -26,6 +26,7 @@
 #include "core/assert_api.h"
 #include "core/cstr_api.h"
 #include "core/ensure.h"
+#include "core/hashmap_api.h"
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/thread_api.h"
@@ -80,8 +81,45 @@ struct GtStyle
   GtRWLock *lock, *clone_lock;
   bool unsafe;
   char *filename;
+  GtHashmap *cache; /* section -> key -> GtStyleValue, NULL if disabled */
 };
 
+/* Snapshot of an entry of the style table, taken when a (section, key) pair is
+   queried for the first time so that subsequent queries do not have to go
+   through the Lua state. Callback functions have to be evaluated for each
+   feature and are only marked as such. */
+typedef enum {
+  GT_STYLE_VALUE_NOT_SET,
+  GT_STYLE_VALUE_BOOLEAN,
+  GT_STYLE_VALUE_SCALAR,
+  GT_STYLE_VALUE_COLOR,
+  GT_STYLE_VALUE_CALLBACK
+} GtStyleValueType;
+
+typedef struct {
+  GtStyleValueType type;
+  bool boolean,
+       is_number; /* number or string convertible to a number */
+  double number;
+  char *string;   /* string or number converted to a string */
+  GtColor color;
+} GtStyleValue;
+
+static void style_value_delete(GtStyleValue *value)
+{
+  if (!value) return;
+  gt_free(value->string);
+  gt_free(value);
+}
+
+/* Must be called with the write lock held whenever the style table may have
+   been changed. */
+static void style_cache_reset(GtStyle *sty)
+{
+  if (sty->cache)
+    gt_hashmap_reset(sty->cache);
+}
+
 static void style_lua_new_table(lua_State *L, const char *key)
 {
   lua_pushstring(L, key);
@@ -141,6 +179,9 @@ GtStyle* gt_style_new(GtError *err)
   sty->lock = gt_rwlock_new();
   sty->unsafe = false;
   sty->clone_lock = gt_rwlock_new();
+  /* the style table is private to this object, so lookups can be cached */
+  sty->cache = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                              (GtFree) gt_hashmap_delete);
 
   default_formats = gt_str_new_cstr(gt_default_format_style);
   had_err = gt_style_load_str(sty, default_formats, err);
@@ -157,6 +198,8 @@ GtStyle* gt_style_new_with_state(lua_State *L)
   sty->L = L;
   sty->unsafe = true;
   sty->lock = gt_rwlock_new();
+  /* the style table can be changed directly in <L>, so do not cache lookups */
+  sty->cache = NULL;
   return sty;
 }
 
@@ -253,6 +296,7 @@ int gt_style_load_file(GtStyle *sty, const char *filename, GtError *err)
     lua_pop(sty->L, 1);
   }
   gt_assert(lua_gettop(sty->L) == stack_size);
+  style_cache_reset(sty);
   gt_rwlock_unlock(sty->lock);
   return had_err;
 }
@@ -311,6 +355,114 @@ static int style_find_section_for_getting(const GtStyle *sty,
   return depth;
 }
 
+/* Reads the color components from the table at the top of the Lua stack into
+   <color>, leaving components which are not given untouched. */
+static void style_table_to_color(lua_State *L, GtColor *color)
+{
+  lua_getfield(L, -1, "red");
+  if (!lua_isnil(L, -1) && lua_isnumber(L, -1))
+    color->red = lua_tonumber(L,-1);
+  lua_pop(L, 1);
+  lua_getfield(L, -1, "green");
+  if (!lua_isnil(L, -1) && lua_isnumber(L, -1))
+    color->green = lua_tonumber(L,-1);
+  lua_pop(L, 1);
+  lua_getfield(L, -1, "blue");
+  if (!lua_isnil(L, -1) && lua_isnumber(L, -1))
+    color->blue = lua_tonumber(L,-1);
+  lua_pop(L, 1);
+  lua_getfield(L, -1, "alpha");
+  if (!lua_isnil(L, -1) && lua_isnumber(L, -1))
+    color->alpha = lua_tonumber(L,-1);
+  lua_pop(L, 1);
+}
+
+static GtStyleValue* style_value_new(const GtStyle *sty, const char *section,
+                                     const char *key)
+{
+  GtStyleValue *value;
+  int i;
+  value = gt_calloc(1, sizeof (GtStyleValue));
+  value->type = GT_STYLE_VALUE_NOT_SET;
+  if ((i = style_find_section_for_getting(sty, section)) < 0)
+    return value;
+  lua_getfield(sty->L, -1, key);
+  i++;
+  switch (lua_type(sty->L, -1)) {
+    case LUA_TBOOLEAN:
+      value->type = GT_STYLE_VALUE_BOOLEAN;
+      value->boolean = lua_toboolean(sty->L, -1);
+      break;
+    case LUA_TNUMBER:
+    case LUA_TSTRING:
+      value->type = GT_STYLE_VALUE_SCALAR;
+      if ((value->is_number = lua_isnumber(sty->L, -1)))
+        value->number = lua_tonumber(sty->L, -1);
+      value->string = gt_cstr_dup(lua_tostring(sty->L, -1));
+      break;
+    case LUA_TTABLE:
+      value->type = GT_STYLE_VALUE_COLOR;
+      value->color.red = value->color.green = value->color.blue =
+        value->color.alpha = 0.5;
+      style_table_to_color(sty->L, &value->color);
+      break;
+    case LUA_TFUNCTION:
+      value->type = GT_STYLE_VALUE_CALLBACK;
+      break;
+    default:
+      break;
+  }
+  lua_pop(sty->L, i);
+  return value;
+}
+
+static GtStyleValue* style_cache_get(const GtStyle *sty, const char *section,
+                                     const char *key)
+{
+  GtHashmap *keys;
+  if (!(keys = gt_hashmap_get(sty->cache, section)))
+    return NULL;
+  return gt_hashmap_get(keys, key);
+}
+
+static void style_cache_add(const GtStyle *sty, const char *section,
+                            const char *key, GtStyleValue *value)
+{
+  GtHashmap *keys;
+  if (!(keys = gt_hashmap_get(sty->cache, section))) {
+    keys = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                          (GtFree) style_value_delete);
+    gt_hashmap_add(sty->cache, gt_cstr_dup(section), keys);
+  }
+  gt_hashmap_add(keys, gt_cstr_dup(key), value);
+}
+
+/* Locks <sty> and returns the cached value of <key> in <section>, resolving it
+   from the Lua state on first access. If the returned value is not a callback,
+   it can be used directly and only the read lock may be held. Otherwise (or if
+   caching is disabled and NULL is returned) the write lock is held and the
+   caller has to evaluate the entry on the Lua state. In any case, the caller
+   must release the lock with gt_rwlock_unlock(). */
+static const GtStyleValue* style_value_lock(const GtStyle *sty,
+                                            const char *section,
+                                            const char *key)
+{
+  GtStyleValue *value = NULL;
+  if (sty->cache) {
+    gt_rwlock_rdlock(sty->lock);
+    value = style_cache_get(sty, section, key);
+    if (value && value->type != GT_STYLE_VALUE_CALLBACK)
+      return value;
+    gt_rwlock_unlock(sty->lock);
+  }
+  gt_rwlock_wrlock(sty->lock);
+  if (sty->cache && !(value = style_cache_get(sty, section, key))) {
+    value = style_value_new(sty, section, key);
+    style_cache_add(sty, section, key, value);
+  }
+  return value;
+}
+
 GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
                                                  const char *section,
                                                  const char *key,
@@ -323,14 +475,25 @@ GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  const GtStyleValue *value;
+  GtStyleQueryStatus status;
   gt_assert(sty && section && key && color);
   gt_error_check(err);
-  gt_rwlock_wrlock(sty->lock);
+  /* set default colors */
+  color->red = 0.5; color->green = 0.5; color->blue = 0.5; color->alpha = 0.5;
+  value = style_value_lock(sty, section, key);
+  if (value && value->type != GT_STYLE_VALUE_CALLBACK) {
+    status = GT_STYLE_QUERY_NOT_SET;
+    if (value->type == GT_STYLE_VALUE_COLOR) {
+      *color = value->color;
+      status = GT_STYLE_QUERY_OK;
+    }
+    gt_rwlock_unlock(sty->lock);
+    return status;
+  }
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
-  /* set default colors */
-  color->red = 0.5; color->green = 0.5; color->blue = 0.5; color->alpha = 0.5;
   /* get section */
   i = style_find_section_for_getting(sty, section);
   /* could not get section, return default */
@@ -372,22 +535,7 @@ GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
     return GT_STYLE_QUERY_NOT_SET;
   } else i++;
   /* update color struct */
-  lua_getfield(sty->L, -1, "red");
-  if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
-    color->red = lua_tonumber(sty->L,-1);
-  lua_pop(sty->L, 1);
-  lua_getfield(sty->L, -1, "green");
-  if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
-    color->green = lua_tonumber(sty->L,-1);
-  lua_pop(sty->L, 1);
-  lua_getfield(sty->L, -1, "blue");
-  if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
-    color->blue = lua_tonumber(sty->L,-1);
-  lua_pop(sty->L, 1);
-  lua_getfield(sty->L, -1, "alpha");
-  if (!lua_isnil(sty->L, -1) && lua_isnumber(sty->L, -1))
-    color->alpha = lua_tonumber(sty->L,-1);
-  lua_pop(sty->L, 1);
+  style_table_to_color(sty->L, color);
   /* reset stack to original state for subsequent calls */
   lua_pop(sty->L, i);
   gt_assert(lua_gettop(sty->L) == stack_size);
@@ -437,6 +585,7 @@ void gt_style_set_color(GtStyle *sty, const char *section, const char *key,
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
   gt_assert(lua_gettop(sty->L) == stack_size);
+  style_cache_reset(sty);
   gt_rwlock_unlock(sty->lock);
 }
 
@@ -451,9 +600,20 @@ GtStyleQueryStatus gt_style_get_str_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  const GtStyleValue *value;
+  GtStyleQueryStatus status;
   gt_assert(sty && key && section);
   gt_error_check(err);
-  gt_rwlock_wrlock(sty->lock);
+  value = style_value_lock(sty, section, key);
+  if (value && value->type != GT_STYLE_VALUE_CALLBACK) {
+    status = GT_STYLE_QUERY_NOT_SET;
+    if (value->string) {
+      gt_str_set(text, value->string);
+      status = GT_STYLE_QUERY_OK;
+    }
+    gt_rwlock_unlock(sty->lock);
+    return status;
+  }
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
@@ -531,6 +691,7 @@ void gt_style_set_str(GtStyle *sty, const char *section, const char *key,
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
   gt_assert(lua_gettop(sty->L) == stack_size);
+  style_cache_reset(sty);
   gt_rwlock_unlock(sty->lock);
 }
 
@@ -545,9 +706,20 @@ GtStyleQueryStatus gt_style_get_num_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  const GtStyleValue *value;
+  GtStyleQueryStatus status;
   gt_assert(sty && key && section && val);
   gt_error_check(err);
-  gt_rwlock_wrlock(sty->lock);
+  value = style_value_lock(sty, section, key);
+  if (value && value->type != GT_STYLE_VALUE_CALLBACK) {
+    status = GT_STYLE_QUERY_NOT_SET;
+    if (value->is_number) {
+      *val = value->number;
+      status = GT_STYLE_QUERY_OK;
+    }
+    gt_rwlock_unlock(sty->lock);
+    return status;
+  }
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
@@ -630,6 +802,7 @@ void gt_style_set_num(GtStyle *sty, const char *section, const char *key,
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
   gt_assert(lua_gettop(sty->L) == stack_size);
+  style_cache_reset(sty);
   gt_rwlock_unlock(sty->lock);
 }
 
@@ -644,9 +817,20 @@ GtStyleQueryStatus gt_style_get_bool_with_track(const GtStyle *sty,
   int stack_size;
 #endif
   int i = 0;
+  const GtStyleValue *value;
+  GtStyleQueryStatus status;
   gt_assert(sty && key && section);
   gt_error_check(err);
-  gt_rwlock_wrlock(sty->lock);
+  value = style_value_lock(sty, section, key);
+  if (value && value->type != GT_STYLE_VALUE_CALLBACK) {
+    status = GT_STYLE_QUERY_NOT_SET;
+    if (value->type == GT_STYLE_VALUE_BOOLEAN) {
+      *val = value->boolean;
+      status = GT_STYLE_QUERY_OK;
+    }
+    gt_rwlock_unlock(sty->lock);
+    return status;
+  }
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
@@ -724,6 +908,7 @@ void gt_style_set_bool(GtStyle *sty, const char *section, const char *key,
   lua_settable(sty->L, -3);
   lua_pop(sty->L, i);
   gt_assert(lua_gettop(sty->L) == stack_size);
+  style_cache_reset(sty);
   gt_rwlock_unlock(sty->lock);
 }
 
@@ -751,6 +936,7 @@ void gt_style_unset(GtStyle *sty, const char *section, const char *key)
   }
   lua_pop(sty->L, 1);
   gt_assert(lua_gettop(sty->L) == stack_size);
+  style_cache_reset(sty);
   gt_rwlock_unlock(sty->lock);
 }
 
@@ -802,6 +988,7 @@ int gt_style_load_str(GtStyle *sty, GtStr *instr, GtError *err)
     lua_pop(sty->L, 1);
   }
   gt_assert(lua_gettop(sty->L) == stack_size);
+  style_cache_reset(sty);
   gt_rwlock_unlock(sty->lock);
   return had_err;
 }
@@ -938,6 +1125,33 @@ int gt_style_unit_test(GtError *err)
                                    testerr) != GT_STYLE_QUERY_ERROR);
   gt_ensure((strcmp(gt_str_get(str),"")==0));
 
+  /* cached values are invalidated by unsetting and loading */
+  gt_style_unset(sty, "format", "foo");
+  gt_ensure(gt_style_get_num(sty, "format", "foo", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_str_set(sty_buffer, "style.format.foo = \"3\"\n"
+                         "n = 0\n"
+                         "style.format.bar = function() n = n + 1 return n end");
+  gt_ensure(!gt_style_load_str(sty, sty_buffer, testerr));
+  gt_ensure(gt_style_get_num(sty, "format", "foo", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 3.0);
+  gt_str_reset(str);
+  gt_ensure(gt_style_get_str(sty, "format", "margins", str, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(strcmp(gt_str_get(str), "11") == 0);
+
+  /* callbacks are evaluated on every query */
+  gt_ensure(gt_style_get_num(sty, "format", "bar", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 1.0);
+  gt_ensure(gt_style_get_num(sty, "format", "bar", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 2.0);
+  gt_ensure(gt_style_get_bool(sty, "format", "bar", &val, NULL,
+                              testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_ensure(!gt_error_is_set(testerr));
+
   /* mem cleanup */
   gt_error_delete(testerr);
   gt_str_delete(test1);
@@ -960,6 +1174,7 @@ void gt_style_delete_without_state(GtStyle *sty)
     return;
   }
   gt_free(sty->filename);
+  gt_hashmap_delete(sty->cache);
   gt_rwlock_unlock(sty->lock);
   gt_rwlock_delete(sty->lock);
   gt_rwlock_delete(sty->clone_lock);
@@ -0,0 +1,449 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include "annotationsketch/canvas_cairo_file_api.h"
+#include "annotationsketch/default_formats.h"
+#include "annotationsketch/diagram.h"
+#include "annotationsketch/layout.h"
+#include "annotationsketch/tile_renderer.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/hashmap_api.h"
+#include "core/ma.h"
+#include "core/thread_api.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_node.h"
+
+/* tiles of the highest zoom level cover more than 16 Mb per pixel */
+#define GT_TILE_RENDERER_MAX_LEVEL 24
+
+/* the tiles of a zoom level are laid out in windows of this many tiles, each
+   extended by GT_TILE_RENDERER_WINDOW_OVERLAP tiles on both sides */
+#define GT_TILE_RENDERER_WINDOW_TILES   64
+#define GT_TILE_RENDERER_WINDOW_OVERLAP 8
+
+/* number of window layouts cached per zoom level */
+#define GT_TILE_RENDERER_CACHED_WINDOWS 4
+
+typedef struct {
+  GtUword window,
+          last_use, /* value of the level's use counter at the last access */
+          reference_count;
+  GtDiagram *diagram;
+  GtLayout *layout;
+  GtUword height;
+} GtTileWindow;
+
+typedef struct {
+  GtTileWindow *windows[GT_TILE_RENDERER_CACHED_WINDOWS];
+  GtUword use_counter;
+} GtTileLevel;
+
+struct GtTileRenderer {
+  GtFeatureIndex *feature_index;
+  GtStyle *style;
+  char *seqid;
+  GtRange region;
+  unsigned int tile_width;
+  double margins;
+  GtHashmap *levels; /* zoom level + 1 -> GtTileLevel */
+  GtMutex *mutex;
+};
+
+/* Drops a reference to <tw>, which is deleted with the last one. Must be
+   called with the renderer's mutex held. */
+static void tile_window_delete(GtTileWindow *tw)
+{
+  if (!tw) return;
+  if (tw->reference_count) {
+    tw->reference_count--;
+    return;
+  }
+  gt_layout_delete(tw->layout);
+  gt_diagram_delete(tw->diagram);
+  gt_free(tw);
+}
+
+static void tile_level_delete(GtTileLevel *tl)
+{
+  GtUword i;
+  if (!tl) return;
+  for (i = 0; i < GT_TILE_RENDERER_CACHED_WINDOWS; i++)
+    tile_window_delete(tl->windows[i]);
+  gt_free(tl);
+}
+
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     const char *seqid,
+                                     const GtRange *region,
+                                     unsigned int tile_width,
+                                     GtStyle *style,
+                                     GtError *err)
+{
+  GtTileRenderer *tr;
+  double margins = MARGINS_DEFAULT;
+  gt_error_check(err);
+  gt_assert(feature_index && seqid && region && style);
+
+  if (region->start >= region->end) {
+    gt_error_set(err, "range start must be smaller than range end");
+    return NULL;
+  }
+  if (gt_style_get_num(style, "format", "margins", &margins, NULL,
+                       err) == GT_STYLE_QUERY_ERROR) {
+    return NULL;
+  }
+  if (tile_width < 2 * margins + 1) {
+    gt_error_set(err, "tile width must be larger than twice the x-margin size "
+                      "(2*%.1f=%.1f) but was %u",
+                 margins, 2 * margins, tile_width);
+    return NULL;
+  }
+  tr = gt_calloc(1, sizeof (GtTileRenderer));
+  tr->feature_index = feature_index;
+  tr->style = gt_style_ref(style);
+  tr->seqid = gt_cstr_dup(seqid);
+  tr->region = *region;
+  tr->tile_width = tile_width;
+  tr->margins = margins;
+  tr->levels = gt_hashmap_new(GT_HASH_DIRECT, NULL,
+                              (GtFree) tile_level_delete);
+  tr->mutex = gt_mutex_new();
+  return tr;
+}
+
+/* Returns the number of nucleotides covered by a tile at zoom <level>. */
+static GtUword tile_renderer_tile_length(const GtTileRenderer *tr,
+                                         unsigned int level)
+{
+  gt_assert(tr && level <= GT_TILE_RENDERER_MAX_LEVEL);
+  return ((GtUword) (tr->tile_width - 2 * tr->margins)) << level;
+}
+
+GtUword gt_tile_renderer_get_number_of_tiles(const GtTileRenderer *tr,
+                                             unsigned int level)
+{
+  GtUword tile_length;
+  gt_assert(tr);
+  tile_length = tile_renderer_tile_length(tr, level);
+  return (gt_range_length(&tr->region) + tile_length - 1) / tile_length;
+}
+
+GtRange gt_tile_renderer_get_tile_range(const GtTileRenderer *tr,
+                                        unsigned int level, GtUword tile)
+{
+  GtRange rng;
+  GtUword tile_length;
+  gt_assert(tr && tile < gt_tile_renderer_get_number_of_tiles(tr, level));
+  tile_length = tile_renderer_tile_length(tr, level);
+  rng.start = tr->region.start + tile * tile_length;
+  rng.end = rng.start + tile_length - 1;
+  return rng;
+}
+
+/* Returns the layout of the window containing <tile> at zoom <level>,
+   computing it if it is not cached. The layout covers the tiles of the window
+   and the overlapping tiles of its neighbours, and its width is chosen such
+   that it has the same scale as a single tile. The returned window is
+   referenced, such that it stays valid if it is evicted from the cache, and
+   has to be released with <tile_renderer_release_window()>. */
+static GtTileWindow* tile_renderer_get_window(GtTileRenderer *tr,
+                                              unsigned int level,
+                                              GtUword tile, GtError *err)
+{
+  GtTileLevel *tl;
+  GtTileWindow *tw = NULL;
+  GtUword i, slot = 0, window, nof_tiles, first, last;
+  GtRange rng;
+  double width;
+  int had_err = 0;
+  gt_assert(tr);
+
+  if (level > GT_TILE_RENDERER_MAX_LEVEL) {
+    gt_error_set(err, "zoom level %u exceeds the maximum of %u", level,
+                 GT_TILE_RENDERER_MAX_LEVEL);
+    return NULL;
+  }
+  nof_tiles = gt_tile_renderer_get_number_of_tiles(tr, level);
+  if (tile >= nof_tiles) {
+    gt_error_set(err, "tile "GT_WU" does not exist at zoom level %u (only "
+                      GT_WU" tiles)", tile, level, nof_tiles);
+    return NULL;
+  }
+  window = tile / GT_TILE_RENDERER_WINDOW_TILES;
+
+  gt_mutex_lock(tr->mutex);
+  if (!(tl = gt_hashmap_get(tr->levels, (void*) ((GtUword) level + 1)))) {
+    tl = gt_calloc(1, sizeof (GtTileLevel));
+    gt_hashmap_add(tr->levels, (void*) ((GtUword) level + 1), tl);
+  }
+  for (i = 0; i < GT_TILE_RENDERER_CACHED_WINDOWS; i++) {
+    if (tl->windows[i] && tl->windows[i]->window == window) {
+      tw = tl->windows[i];
+      break;
+    }
+    /* replace an empty slot or the least recently used window */
+    if (tl->windows[slot] &&
+        (!tl->windows[i] ||
+         tl->windows[i]->last_use < tl->windows[slot]->last_use)) {
+      slot = i;
+    }
+  }
+  if (!tw) {
+    tw = gt_calloc(1, sizeof (GtTileWindow));
+    tw->window = window;
+    first = window * GT_TILE_RENDERER_WINDOW_TILES;
+    first = first > GT_TILE_RENDERER_WINDOW_OVERLAP
+              ? first - GT_TILE_RENDERER_WINDOW_OVERLAP : 0;
+    last = (window + 1) * GT_TILE_RENDERER_WINDOW_TILES
+             + GT_TILE_RENDERER_WINDOW_OVERLAP;
+    last = last < nof_tiles ? last - 1 : nof_tiles - 1;
+    rng.start = gt_tile_renderer_get_tile_range(tr, level, first).start;
+    rng.end = gt_tile_renderer_get_tile_range(tr, level, last).end;
+    width = (last - first + 1) * (tr->tile_width - 2 * tr->margins)
+              + 2 * tr->margins;
+    if (width > UINT_MAX) {
+      gt_error_set(err, "tile width %u is too large to lay out %u tiles at "
+                        "once", tr->tile_width,
+                   (unsigned int) (last - first + 1));
+      had_err = -1;
+    }
+    if (!had_err &&
+        !(tw->diagram = gt_diagram_new(tr->feature_index, tr->seqid, &rng,
+                                       tr->style, err))) {
+      had_err = -1;
+    }
+    if (!had_err) {
+      gt_diagram_set_view_width(tw->diagram,
+                                tile_renderer_tile_length(tr, level));
+      if (!(tw->layout = gt_layout_new(tw->diagram, (unsigned int) width,
+                                       tr->style, err))) {
+        had_err = -1;
+      }
+    }
+    if (!had_err)
+      had_err = gt_layout_get_height(tw->layout, &tw->height, err);
+    if (had_err) {
+      tile_window_delete(tw);
+      tw = NULL;
+    }
+    else {
+      tile_window_delete(tl->windows[slot]);
+      tl->windows[slot] = tw;
+    }
+  }
+  if (tw) {
+    tw->last_use = ++tl->use_counter;
+    tw->reference_count++;
+  }
+  gt_mutex_unlock(tr->mutex);
+  return tw;
+}
+
+static void tile_renderer_release_window(GtTileRenderer *tr, GtTileWindow *tw)
+{
+  gt_assert(tr && tw);
+  gt_mutex_lock(tr->mutex);
+  tile_window_delete(tw);
+  gt_mutex_unlock(tr->mutex);
+}
+
+int gt_tile_renderer_get_height(GtTileRenderer *tr, unsigned int level,
+                                GtUword tile, GtUword *height, GtError *err)
+{
+  GtTileWindow *tw;
+  gt_error_check(err);
+  gt_assert(tr && height);
+  if (!(tw = tile_renderer_get_window(tr, level, tile, err)))
+    return -1;
+  *height = tw->height;
+  tile_renderer_release_window(tr, tw);
+  return 0;
+}
+
+int gt_tile_renderer_sketch(GtTileRenderer *tr, unsigned int level,
+                            GtUword tile, GtCanvas *canvas, GtError *err)
+{
+  GtTileWindow *tw;
+  GtRange rng;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(tr && canvas);
+  if (!(tw = tile_renderer_get_window(tr, level, tile, err)))
+    return -1;
+  rng = gt_tile_renderer_get_tile_range(tr, level, tile);
+  had_err = gt_layout_sketch_range(tw->layout, canvas, &rng, err);
+  tile_renderer_release_window(tr, tw);
+  return had_err;
+}
+
+int gt_tile_renderer_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtFeatureIndex *fi;
+  GtGenomeNode *gn;
+  GtTileRenderer *tr = NULL;
+  GtStyle *sty;
+  GtCanvas *canvas;
+  GtRange region = {1, 200000}, rng, prev;
+  GtUword i, height, height2, first_height = 0, nof_tiles, window_start;
+  unsigned int level;
+  gt_error_check(err);
+
+  gn = gt_feature_node_new_standard_gene();
+  fi = gt_feature_index_memory_new();
+  sty = gt_style_new(err);
+  gt_ensure(sty != NULL);
+  if (!had_err) {
+    gt_style_set_num(sty, "format", "margins", 0.0);
+    had_err = gt_feature_index_add_feature_node(fi, gt_feature_node_cast(gn),
+                                                err);
+  }
+  if (!had_err) {
+    tr = gt_tile_renderer_new(fi, "ctg123", &region, 256, sty, err);
+    gt_ensure(tr != NULL);
+  }
+
+  /* tiles of each level are contiguous and cover the region */
+  for (level = 0; !had_err && level < 8; level++) {
+    nof_tiles = gt_tile_renderer_get_number_of_tiles(tr, level);
+    gt_ensure(nof_tiles ==
+              (200000 + (256UL << level) - 1) / (256UL << level));
+    prev = gt_tile_renderer_get_tile_range(tr, level, 0);
+    gt_ensure(prev.start == region.start);
+    gt_ensure(gt_range_length(&prev) == 256UL << level);
+    for (i = 1; !had_err && i < nof_tiles; i++) {
+      rng = gt_tile_renderer_get_tile_range(tr, level, i);
+      gt_ensure(rng.start == prev.end + 1);
+      prev = rng;
+    }
+    gt_ensure(prev.end >= region.end);
+  }
+
+  /* tiles are rendered from the layout of their window, which has the same
+     height for all tiles of the window */
+  for (level = 0; !had_err && level < 8; level += 7) {
+    nof_tiles = gt_tile_renderer_get_number_of_tiles(tr, level);
+    for (i = 0; !had_err && i < nof_tiles; i += nof_tiles / 16 + 1) {
+      window_start = i - i % GT_TILE_RENDERER_WINDOW_TILES;
+      gt_ensure(gt_tile_renderer_get_height(tr, level, i, &height, err) == 0);
+      gt_ensure(gt_tile_renderer_get_height(tr, level, window_start, &height2,
+                                            err) == 0);
+      gt_ensure(height == height2);
+      if (!had_err && level == 0 && i == 0)
+        first_height = height;
+      if (had_err)
+        break;
+      canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PNG, 256, height,
+                                        NULL, err);
+      gt_ensure(canvas != NULL);
+      if (!had_err)
+        gt_ensure(gt_tile_renderer_sketch(tr, level, i, canvas, err) == 0);
+      gt_canvas_delete(canvas);
+    }
+  }
+
+  /* a window evicted from the cache is laid out again in the same way */
+  if (!had_err) {
+    gt_ensure(gt_tile_renderer_get_number_of_tiles(tr, 0) >
+              GT_TILE_RENDERER_CACHED_WINDOWS * GT_TILE_RENDERER_WINDOW_TILES);
+    gt_ensure(gt_tile_renderer_get_height(tr, 0, 0, &height, err) == 0);
+    gt_ensure(height == first_height);
+  }
+
+  /* the least recently used window is evicted, and a window in use stays
+     valid after its eviction */
+  if (!had_err) {
+    GtTileLevel *tl;
+    GtTileWindow *tw;
+    bool cached0 = false, cached1 = false;
+    gt_ensure((tw = tile_renderer_get_window(tr, 0, 0, err)) != NULL);
+    for (i = 1; !had_err && i <= GT_TILE_RENDERER_CACHED_WINDOWS; i++) {
+      gt_ensure(gt_tile_renderer_get_height(tr, 0,
+                                            i * GT_TILE_RENDERER_WINDOW_TILES,
+                                            &height, err) == 0);
+      if (!had_err && i == GT_TILE_RENDERER_CACHED_WINDOWS - 1) {
+        /* window 0 is used again before another window is laid out */
+        gt_ensure(gt_tile_renderer_get_height(tr, 0, 0, &height, err) == 0);
+      }
+    }
+    if (!had_err) {
+      tl = gt_hashmap_get(tr->levels, (void*) 1);
+      gt_ensure(tl != NULL);
+      for (i = 0; !had_err && i < GT_TILE_RENDERER_CACHED_WINDOWS; i++) {
+        gt_ensure(tl->windows[i] != NULL);
+        if (!had_err && tl->windows[i]->window == 0)
+          cached0 = true;
+        if (!had_err && tl->windows[i]->window == 1)
+          cached1 = true;
+      }
+      gt_ensure(cached0 && !cached1);
+    }
+    if (tw) {
+      /* evict window 0 while it is still referenced */
+      for (i = 5; !had_err && i < 5 + GT_TILE_RENDERER_CACHED_WINDOWS; i++) {
+        gt_ensure(gt_tile_renderer_get_height(tr, 0,
+                                              i * GT_TILE_RENDERER_WINDOW_TILES,
+                                              &height, err) == 0);
+      }
+      if (!had_err) {
+        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PNG, 256,
+                                          tw->height, NULL, err);
+        gt_ensure(canvas != NULL);
+        rng = gt_tile_renderer_get_tile_range(tr, 0, 0);
+        if (!had_err)
+          gt_ensure(gt_layout_sketch_range(tw->layout, canvas, &rng, err) == 0);
+        gt_canvas_delete(canvas);
+      }
+      tile_renderer_release_window(tr, tw);
+    }
+  }
+
+  /* invalid tiles and levels are rejected */
+  if (!had_err) {
+    nof_tiles = gt_tile_renderer_get_number_of_tiles(tr, 0);
+    canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PNG, 256, 100, NULL,
+                                      err);
+    gt_ensure(canvas != NULL);
+    if (!had_err) {
+      gt_ensure(gt_tile_renderer_sketch(tr, 0, nof_tiles, canvas, err) == -1);
+      gt_ensure(gt_error_is_set(err));
+      gt_error_unset(err);
+      gt_ensure(gt_tile_renderer_sketch(tr, GT_TILE_RENDERER_MAX_LEVEL + 1, 0,
+                                        canvas, err) == -1);
+      gt_ensure(gt_error_is_set(err));
+      gt_error_unset(err);
+    }
+    gt_canvas_delete(canvas);
+  }
+
+  gt_tile_renderer_delete(tr);
+  gt_feature_index_delete(fi);
+  gt_genome_node_delete(gn);
+  gt_style_delete(sty);
+  return had_err;
+}
+
+void gt_tile_renderer_delete(GtTileRenderer *tr)
+{
+  if (!tr) return;
+  gt_hashmap_delete(tr->levels);
+  gt_mutex_delete(tr->mutex);
+  gt_style_delete(tr->style);
+  gt_free(tr->seqid);
+  gt_free(tr);
+}
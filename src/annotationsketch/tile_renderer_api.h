@@ -0,0 +1,88 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TILE_RENDERER_API_H
+#define TILE_RENDERER_API_H
+
+#include "annotationsketch/canvas_api.h"
+#include "annotationsketch/style_api.h"
+#include "core/error_api.h"
+#include "core/range_api.h"
+#include "extended/feature_index_api.h"
+
+/* The <GtTileRenderer> class renders a sequence region as a series of tiles of
+   fixed width, e.g. to be served to an interactive genome browser.
+   At zoom level <level>, each tile covers 2^<level> nucleotides per pixel.
+   The tiles of a zoom level are grouped into windows of 64 tiles, and a
+   <GtDiagram> and <GtLayout> are computed for each window when one of its
+   tiles is first used. The layout of a window also covers 8 tiles on each
+   side of it, so that line assignment takes neighbouring features into
+   account. The layouts of the 4 most recently used windows of each level are
+   cached. Thus the memory needed for a layout does not depend on the length
+   of the region, all tiles of a window have the same height and features keep
+   their lines across tile borders within a window. Across window borders,
+   the height and the lines of features may change.
+   Visibility of blocks and captions ('max_show_width', 'max_capt_show_width')
+   and aggregation of dense tracks into a single line ('max_split_width') are
+   decided based on the length of a single tile.
+   Tiles fit together seamlessly if the 'margins' option in the 'format'
+   section of the style is set to 0. */
+typedef struct GtTileRenderer GtTileRenderer;
+
+/* Returns a new <GtTileRenderer> object for the features in <feature_index>
+   on sequence <seqid> within <region>, rendering tiles <tile_width> pixels
+   wide using <style>. <feature_index> must exist as long as the returned
+   object is used. Returns NULL and sets <err> on error. */
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     const char *seqid,
+                                     const GtRange *region,
+                                     unsigned int tile_width,
+                                     GtStyle *style,
+                                     GtError *err);
+/* Returns the number of tiles covering the region of <tile_renderer> at zoom
+   level <level>. */
+GtUword         gt_tile_renderer_get_number_of_tiles(const GtTileRenderer
+                                                       *tile_renderer,
+                                                     unsigned int level);
+/* Returns the sequence range covered by tile number <tile> at zoom level
+   <level>. */
+GtRange         gt_tile_renderer_get_tile_range(const GtTileRenderer
+                                                  *tile_renderer,
+                                                unsigned int level,
+                                                GtUword tile);
+/* Writes the height of tile number <tile> at zoom level <level> to <height>,
+   computing the layout of its window if necessary. Returns 0 on success and
+   -1 on error, in which case <err> is set. */
+int             gt_tile_renderer_get_height(GtTileRenderer *tile_renderer,
+                                            unsigned int level,
+                                            GtUword tile,
+                                            GtUword *height,
+                                            GtError *err);
+/* Renders tile number <tile> at zoom level <level> on <canvas>, which must be
+   as wide as the tiles and as high as returned by
+   <gt_tile_renderer_get_height()> for this tile. Tiles can be rendered from
+   several threads at once, tiles of the same window are rendered one at a
+   time.
+   Returns 0 on success and -1 on error, in which case <err> is set. */
+int             gt_tile_renderer_sketch(GtTileRenderer *tile_renderer,
+                                        unsigned int level,
+                                        GtUword tile,
+                                        GtCanvas *canvas,
+                                        GtError *err);
+/* Deletes <tile_renderer> and all cached layouts. */
+void            gt_tile_renderer_delete(GtTileRenderer *tile_renderer);
+
+#endif
@@ -0,0 +1,219 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/arena.h"
+#include "core/array.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/thread_api.h"
+
+#define ARENA_CHUNK_SIZE         65536
+#define ARENA_GRANULARITY        sizeof (void*)
+#define ARENA_NUM_OF_CLASSES     (GT_ARENA_MAX_BLOCK_SIZE / ARENA_GRANULARITY)
+
+#define ARENA_CLASS(SIZE)\
+        (((SIZE) + ARENA_GRANULARITY - 1) / ARENA_GRANULARITY - 1)
+
+typedef struct ArenaFreeBlock ArenaFreeBlock;
+
+struct ArenaFreeBlock {
+  ArenaFreeBlock *next;
+};
+
+struct GtArena {
+  ArenaFreeBlock *free_lists[ARENA_NUM_OF_CLASSES];
+  char *chunk_ptr,
+       *chunk_end;
+  GtArray *chunks;
+  GtMutex *mutex;
+  GtUword blocks_in_use;
+  unsigned int reference_count;
+  bool deleted;
+};
+
+GtArena* gt_arena_new(void)
+{
+  GtArena *arena = gt_calloc(1, sizeof *arena);
+  arena->chunks = gt_array_new(sizeof (char*));
+  arena->mutex = gt_mutex_new();
+  return arena;
+}
+
+GtArena* gt_arena_ref(GtArena *arena)
+{
+  gt_assert(arena);
+  gt_mutex_lock(arena->mutex);
+  arena->reference_count++;
+  gt_mutex_unlock(arena->mutex);
+  return arena;
+}
+
+static void arena_free_chunks(GtArena *arena)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(arena->chunks); i++)
+    gt_free(*(char**) gt_array_get(arena->chunks, i));
+  gt_array_delete(arena->chunks);
+  gt_mutex_delete(arena->mutex);
+  gt_free(arena);
+}
+
+void* gt_arena_malloc(GtArena *arena, size_t size)
+{
+  ArenaFreeBlock *block;
+  GtUword class;
+  size_t block_size;
+  void *ptr;
+  gt_assert(arena && size);
+  if (size > GT_ARENA_MAX_BLOCK_SIZE)
+    return gt_malloc(size);
+  class = ARENA_CLASS(size);
+  block_size = (class + 1) * ARENA_GRANULARITY;
+  gt_mutex_lock(arena->mutex);
+  gt_assert(!arena->deleted);
+  if ((block = arena->free_lists[class])) {
+    arena->free_lists[class] = block->next;
+    ptr = block;
+  }
+  else {
+    if ((size_t) (arena->chunk_end - arena->chunk_ptr) < block_size) {
+      /* the rest of the current chunk is wasted */
+      arena->chunk_ptr = gt_malloc(ARENA_CHUNK_SIZE);
+      arena->chunk_end = arena->chunk_ptr + ARENA_CHUNK_SIZE;
+      gt_array_add(arena->chunks, arena->chunk_ptr);
+    }
+    ptr = arena->chunk_ptr;
+    arena->chunk_ptr += block_size;
+  }
+  arena->blocks_in_use++;
+  gt_mutex_unlock(arena->mutex);
+  return ptr;
+}
+
+void* gt_arena_calloc(GtArena *arena, size_t size)
+{
+  void *ptr = gt_arena_malloc(arena, size);
+  memset(ptr, 0, size);
+  return ptr;
+}
+
+void* gt_arena_realloc(GtArena *arena, void *ptr, size_t old_size,
+                       size_t new_size)
+{
+  void *new_ptr;
+  gt_assert(arena && new_size);
+  if (!ptr)
+    return gt_arena_malloc(arena, new_size);
+  gt_assert(old_size);
+  if (old_size > GT_ARENA_MAX_BLOCK_SIZE && new_size > GT_ARENA_MAX_BLOCK_SIZE)
+    return gt_realloc(ptr, new_size);
+  if (old_size <= GT_ARENA_MAX_BLOCK_SIZE &&
+      new_size <= GT_ARENA_MAX_BLOCK_SIZE &&
+      ARENA_CLASS(old_size) == ARENA_CLASS(new_size)) {
+    return ptr; /* the block is large enough already */
+  }
+  new_ptr = gt_arena_malloc(arena, new_size);
+  memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+  gt_arena_free(arena, ptr, old_size);
+  return new_ptr;
+}
+
+void gt_arena_free(GtArena *arena, void *ptr, size_t size)
+{
+  ArenaFreeBlock *block = ptr;
+  GtUword class;
+  bool release;
+  gt_assert(arena && size);
+  if (!ptr) return;
+  if (size > GT_ARENA_MAX_BLOCK_SIZE) {
+    gt_free(ptr);
+    return;
+  }
+  class = ARENA_CLASS(size);
+  gt_mutex_lock(arena->mutex);
+  gt_assert(arena->blocks_in_use);
+  block->next = arena->free_lists[class];
+  arena->free_lists[class] = block;
+  arena->blocks_in_use--;
+  release = arena->deleted && !arena->blocks_in_use;
+  gt_mutex_unlock(arena->mutex);
+  if (release)
+    arena_free_chunks(arena);
+}
+
+void gt_arena_delete(GtArena *arena)
+{
+  bool release;
+  if (!arena) return;
+  gt_mutex_lock(arena->mutex);
+  if (arena->reference_count) {
+    arena->reference_count--;
+    gt_mutex_unlock(arena->mutex);
+    return;
+  }
+  arena->deleted = true;
+  release = !arena->blocks_in_use;
+  gt_mutex_unlock(arena->mutex);
+  if (release)
+    arena_free_chunks(arena);
+}
+
+int gt_arena_unit_test(GtError *err)
+{
+  GtArena *arena;
+  char *blocks[1000];
+  size_t sizes[1000];
+  int i, had_err = 0;
+  gt_error_check(err);
+
+  arena = gt_arena_new();
+  for (i = 0; i < 1000; i++) {
+    sizes[i] = 1 + (i * 37) % GT_ARENA_MAX_BLOCK_SIZE;
+    blocks[i] = gt_arena_malloc(arena, sizes[i]);
+    memset(blocks[i], i % 128, sizes[i]);
+  }
+  /* blocks do not overlap */
+  for (i = 0; !had_err && i < 1000; i++) {
+    gt_ensure(blocks[i][0] == i % 128);
+    gt_ensure(blocks[i][sizes[i] - 1] == i % 128);
+  }
+  /* freed blocks are reused for blocks of the same size */
+  if (!had_err) {
+    char *block = blocks[0];
+    gt_arena_free(arena, block, sizes[0]);
+    blocks[0] = gt_arena_calloc(arena, sizes[0]);
+    gt_ensure(blocks[0] == block);
+    gt_ensure(blocks[0][0] == 0);
+  }
+  /* resizing keeps the contents, large blocks are supported */
+  if (!had_err) {
+    blocks[1] = gt_arena_realloc(arena, blocks[1], sizes[1], 1000);
+    gt_ensure(blocks[1][sizes[1] - 1] == 1);
+    memset(blocks[1], 1, 1000);
+    blocks[1] = gt_arena_realloc(arena, blocks[1], 1000, 3);
+    gt_ensure(blocks[1][2] == 1);
+    sizes[1] = 3;
+  }
+  /* the arena survives its deletion as long as blocks are in use */
+  gt_arena_ref(arena);
+  gt_arena_delete(arena);
+  gt_arena_delete(arena);
+  for (i = 0; i < 1000; i++)
+    gt_arena_free(arena, blocks[i], sizes[i]);
+
+  return had_err;
+}
@@ -0,0 +1,51 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdlib.h>
+#include "core/error_api.h"
+
+/* A <GtArena> hands out small memory blocks which are carved from large
+   chunks, without any per-block overhead. Freed blocks are kept in per-size
+   free lists and reused. The chunks are released in bulk once the arena has
+   been deleted and all blocks have been freed. Blocks larger than
+   <GT_ARENA_MAX_BLOCK_SIZE> are allocated with <gt_malloc()>.
+   All functions are thread-safe. */
+typedef struct GtArena GtArena;
+
+/* The maximal size of a block which is allocated from the arena chunks. */
+#define GT_ARENA_MAX_BLOCK_SIZE  256
+
+GtArena* gt_arena_new(void);
+GtArena* gt_arena_ref(GtArena *arena);
+/* Return a new memory block of <size> bytes from <arena>. */
+void*    gt_arena_malloc(GtArena *arena, size_t size);
+/* Like <gt_arena_malloc()>, but the block is initialized to zero. */
+void*    gt_arena_calloc(GtArena *arena, size_t size);
+/* Resize the block <ptr> of <old_size> bytes to <new_size> bytes. */
+void*    gt_arena_realloc(GtArena *arena, void *ptr, size_t old_size,
+                          size_t new_size);
+/* Return the block <ptr> of <size> bytes (the same size it was allocated
+   with) to <arena>. */
+void     gt_arena_free(GtArena *arena, void *ptr, size_t size);
+/* Drop a reference to <arena>. The memory of <arena> is released when the
+   last reference has been dropped and all blocks have been freed. */
+void     gt_arena_delete(GtArena *arena);
+int      gt_arena_unit_test(GtError *err);
+
+#endif
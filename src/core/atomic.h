@@ -0,0 +1,37 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+/* Atomic operations on integral variables, defined only if they are
+   available and threads are enabled. Code using them must provide a
+   lock-based alternative if <GT_ATOMIC_ENABLED> is not defined. */
+#if defined (GT_THREADS_ENABLED) && defined (__GNUC__)
+#define GT_ATOMIC_ENABLED
+
+/* Add <VAL> to <*PTR> and return the new value. */
+#define gt_atomic_add(PTR, VAL)       __sync_add_and_fetch(PTR, VAL)
+/* Subtract <VAL> from <*PTR> and return the new value. */
+#define gt_atomic_sub(PTR, VAL)       __sync_sub_and_fetch(PTR, VAL)
+/* Set <*PTR> to <NEW> if it equals <OLD>, return true if it was set. */
+#define gt_atomic_cas(PTR, OLD, NEW)  \
+        __sync_bool_compare_and_swap(PTR, OLD, NEW)
+/* Full memory barrier: no load or store is moved across it. */
+#define gt_atomic_barrier()           __sync_synchronize()
+#endif
+
+#endif
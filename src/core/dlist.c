@@ -31,6 +31,7 @@ struct GtDlist {
               *last;
   void *data;
   GtUword size;
+  GtArena *arena; /* if set, the list and its elements are allocated here */
 };
 
 struct GtDlistelem {
@@ -55,6 +56,28 @@ GtDlist* gt_dlist_new(GtCompare cmp_func)
   return dlist;
 }
 
+GtDlist* gt_dlist_new_in_arena(GtCompare cmp_func, GtArena *arena)
+{
+  GtDlist *dlist;
+  gt_assert(arena);
+  dlist = gt_arena_calloc(arena, sizeof (GtDlist));
+  if (cmp_func == NULL)
+    dlist->cmp_func = NULL;
+  else
+    dlist->cmp_func = gt_dlist_cmp_wrapper;
+  dlist->data = cmp_func;
+  dlist->arena = arena;
+  return dlist;
+}
+
+static void dlistelem_free(GtDlist *dlist, GtDlistelem *dlistelem)
+{
+  if (dlist->arena)
+    gt_arena_free(dlist->arena, dlistelem, sizeof (GtDlistelem));
+  else
+    gt_free(dlistelem);
+}
+
 GtDlist* gt_dlist_new_with_data(GtCompareWithData cmp_func, void *data)
 {
   GtDlist *dlist = gt_calloc(1, sizeof (GtDlist));
@@ -100,7 +123,10 @@ void gt_dlist_add(GtDlist *dlist, void *data)
 {
   GtDlistelem *oldelem, *newelem;
   gt_assert(dlist); /* data can be null */
-  newelem = gt_calloc(1, sizeof (GtDlistelem));
+  if (dlist->arena)
+    newelem = gt_arena_calloc(dlist->arena, sizeof (GtDlistelem));
+  else
+    newelem = gt_calloc(1, sizeof (GtDlistelem));
   newelem->data = data;
 
   if (!dlist->first) {
@@ -170,7 +196,7 @@ void gt_dlist_remove(GtDlist *dlist, GtDlistelem *dlistelem)
   if (dlistelem == dlist->last)
     dlist->last = dlistelem->previous;
   dlist->size--;
-  gt_free(dlistelem);
+  dlistelem_free(dlist, dlistelem);
 }
 
 static int intcompare(const void *a, const void *b)
@@ -256,6 +282,27 @@ int gt_dlist_unit_test(GtError *err)
          elem_a == *(int*) gt_dlistelem_get_data(gt_dlist_first(dlist)));
   gt_dlist_delete(dlist);
 
+  /* dlist allocated from an arena */
+  if (!had_err) {
+    GtArena *arena = gt_arena_new();
+    dlist = gt_dlist_new_in_arena(intcompare, arena);
+    for (j = 0; j < MAX_SIZE; j++) {
+      elems[j] = gt_rand_max(INT_MAX);
+      elems_backup[j] = elems[j];
+      gt_dlist_add(dlist, elems + j);
+    }
+    qsort(elems_backup, MAX_SIZE, sizeof (int), intcompare);
+    gt_dlist_remove(dlist, gt_dlist_first(dlist));
+    j = 1;
+    for (dlistelem = gt_dlist_first(dlist); !had_err && dlistelem != NULL;
+         dlistelem = gt_dlistelem_next(dlistelem)) {
+      gt_ensure(*(int*) gt_dlistelem_get_data(dlistelem) == elems_backup[j]);
+      j++;
+    }
+    gt_arena_delete(arena);
+    gt_dlist_delete(dlist);
+  }
+
   for (i = 0; i < NUM_OF_TESTS && !had_err; i++) {
     /* construct the random elements for the list */
     size = gt_rand_max(MAX_SIZE);
@@ -368,11 +415,16 @@ void gt_dlist_delete(GtDlist *dlist)
   if (!dlist) return;
   elem = dlist->first;
   while (elem) {
-    gt_free(elem->previous);
+    if (elem->previous)
+      dlistelem_free(dlist, elem->previous);
     elem = elem->next;
   }
-  gt_free(dlist->last);
-  gt_free(dlist);
+  if (dlist->last)
+    dlistelem_free(dlist, dlist->last);
+  if (dlist->arena)
+    gt_arena_free(dlist->arena, dlist, sizeof (GtDlist));
+  else
+    gt_free(dlist);
 }
 
 GtDlistelem* gt_dlistelem_next(const GtDlistelem *dlistelem)
@@ -42,6 +42,7 @@
 #include "core/ensure.h"
 #include "core/error.h"
 #include "core/fa.h"
+#include "core/file.h"
 #include "core/filelengthvalues.h"
 #include "core/fileutils_api.h"
 #include "core/format64.h"
@@ -53,10 +54,15 @@
 #include "core/mathsupport.h"
 #include "core/md5_encoder_api.h"
 #include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/progressbar.h"
 #include "core/sequence_buffer_fasta.h"
+#include "core/sequence_buffer_fastq.h"
 #include "core/sequence_buffer_plain.h"
+#include "core/sequence_buffer_spool.h"
 #include "core/str.h"
+#include "core/twobitenc_decode.h"
+#include "core/thread_api.h"
 #include "core/timer_api.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
@@ -716,6 +722,173 @@ static void showGtRange(const GtRange *range)
 }
 #endif
 
+/* Bulk extraction decodes the two bit encoding unit by unit and afterwards
+   overwrites the special positions of the extracted range. It is neither
+   used for mirrored sequences nor for decoding lossless sequences. */
+static void bulkpatchwildcards(const GtEncseq *encseq, GtUchar *buffer,
+                               GtUword fwdstart, GtUword len, bool reverse,
+                               GtUchar wildcard);
+
+static bool gt_encseq_bulk_extract_possible(const GtEncseq *encseq)
+{
+  return (encseq->twobitencoding != NULL && !encseq->hasmirror) ? true : false;
+}
+
+static void gt_encseq_bulk_set(GtUchar *buffer, GtUword fwdstart, GtUword len,
+                               bool reverse, GtUword pos, GtUchar cc)
+{
+  gt_assert(pos >= fwdstart && pos < fwdstart + len);
+  buffer[reverse ? fwdstart + len - 1 - pos : pos - fwdstart] = cc;
+}
+
+static void gt_encseq_bulk_patch_specials(const GtEncseq *encseq,
+                                          GtUchar *buffer,
+                                          GtUword fwdstart,
+                                          GtUword len,
+                                          bool reverse,
+                                          GtUchar wildcard,
+                                          GtUchar separator)
+{
+  GtUword pos, fwdend = fwdstart + len;
+
+  if (!encseq->has_specialranges)
+    return;
+  if (encseq->sat == GT_ACCESS_TYPE_BITACCESS) {
+    pos = fwdstart;
+    while (pos < fwdend) {
+      if (GT_MODWORDSIZE(pos) == 0 &&
+          encseq->specialbits[GT_DIVWORDSIZE(pos)] == 0) {
+        pos += GT_INTWORDSIZE;
+        continue;
+      }
+      if (GT_ISIBITSET(encseq->specialbits, pos)) {
+        GtUword twobits = EXTRACTENCODEDCHAR(encseq->twobitencoding, pos);
+
+        if (twobits <= (GtUword) GT_TWOBITS_FOR_SEPARATOR) {
+          gt_encseq_bulk_set(buffer, fwdstart, len, reverse, pos,
+                             twobits == (GtUword) GT_TWOBITS_FOR_SEPARATOR
+                               ? separator : wildcard);
+        }
+      }
+      pos++;
+    }
+    return;
+  }
+  if (encseq->sat == GT_ACCESS_TYPE_EQUALLENGTH) {
+    if (encseq->numofdbsequences > 1UL) {
+      GtUword eqlen = encseq->equallength.valueunsignedlong;
+
+      for (pos = fwdstart + eqlen - fwdstart % (eqlen + 1); pos < fwdend;
+           pos += eqlen + 1) {
+        gt_encseq_bulk_set(buffer, fwdstart, len, reverse, pos, separator);
+      }
+    }
+    return;
+  }
+  gt_assert(encseq->accesstype_via_utables);
+  if (encseq->has_wildcardranges) {
+    bulkpatchwildcards(encseq, buffer, fwdstart, len, reverse, wildcard);
+  }
+  if (encseq->numofdbsequences > 1UL) {
+    GtUword seqnum = gt_encseq_seqnum(encseq, fwdstart);
+
+    /* <fwdstart> may be the separator in front of sequence <seqnum> */
+    for (seqnum = seqnum > 0 ? seqnum - 1 : 0;
+         seqnum + 1 < encseq->numofdbsequences; seqnum++) {
+      pos = gt_encseq_seqstartpos(encseq, seqnum + 1) - 1;
+      if (pos >= fwdend)
+        break;
+      if (pos >= fwdstart)
+        gt_encseq_bulk_set(buffer, fwdstart, len, reverse, pos, separator);
+    }
+  }
+}
+
+static void gt_encseq_bulk_extract(const GtEncseq *encseq,
+                                   GtUchar *buffer,
+                                   GtReadmode readmode,
+                                   GtUword frompos,
+                                   GtUword topos,
+                                   const GtUchar map[4],
+                                   GtUchar wildcard,
+                                   GtUchar separator)
+{
+  GtUword fwdstart, len = topos - frompos + 1;
+  bool reverse = GT_ISDIRREVERSE(readmode) ? true : false;
+
+  fwdstart = reverse ? GT_REVERSEPOS(encseq->totallength, topos) : frompos;
+  gt_twobitenc_decode(buffer, encseq->twobitencoding, fwdstart, len, map,
+                      reverse);
+  gt_encseq_bulk_patch_specials(encseq, buffer, fwdstart, len, reverse,
+                                wildcard, separator);
+}
+
+void gt_encseq_extract_encoded_with_readmode(const GtEncseq *encseq,
+                                             GtUchar *buffer,
+                                             GtReadmode readmode,
+                                             GtUword frompos,
+                                             GtUword topos)
+{
+  gt_assert(frompos <= topos && encseq != NULL &&
+            topos < encseq->logicaltotallength && buffer != NULL);
+  if (gt_encseq_bulk_extract_possible(encseq)) {
+    GtUchar map[4];
+    unsigned int cc;
+
+    for (cc = 0; cc < 4U; cc++) {
+      map[cc] = GT_ISDIRCOMPLEMENT(readmode) ? GT_COMPLEMENTBASE((GtUchar) cc)
+                                             : (GtUchar) cc;
+    }
+    gt_encseq_bulk_extract(encseq, buffer, readmode, frompos, topos, map,
+                           (GtUchar) WILDCARD, (GtUchar) SEPARATOR);
+  } else {
+    GtEncseqReader *esr;
+    GtUword idx, pos;
+
+    esr = gt_encseq_create_reader_with_readmode(encseq, readmode, frompos);
+    for (pos = frompos, idx = 0; pos <= topos; pos++, idx++) {
+      buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
+    }
+    gt_encseq_reader_delete(esr);
+  }
+}
+
+void gt_encseq_extract_decoded_with_readmode(const GtEncseq *encseq,
+                                             char *buffer,
+                                             GtReadmode readmode,
+                                             GtUword frompos,
+                                             GtUword topos)
+{
+  gt_assert(frompos <= topos && encseq != NULL &&
+            topos < encseq->logicaltotallength && buffer != NULL);
+  if (gt_encseq_bulk_extract_possible(encseq) &&
+      !encseq->has_exceptiontable) {
+    GtUchar map[4];
+    unsigned int cc;
+
+    for (cc = 0; cc < 4U; cc++) {
+      map[cc] = (GtUchar) gt_alphabet_decode(encseq->alpha,
+                                             GT_ISDIRCOMPLEMENT(readmode)
+                                               ? GT_COMPLEMENTBASE((GtUchar) cc)
+                                               : (GtUchar) cc);
+    }
+    gt_encseq_bulk_extract(encseq, (GtUchar*) buffer, readmode, frompos, topos,
+                           map,
+                           (GtUchar) gt_alphabet_decode(encseq->alpha,
+                                                        (GtUchar) WILDCARD),
+                           (GtUchar) SEPARATOR);
+  } else {
+    GtEncseqReader *esr;
+    GtUword idx, pos;
+
+    esr = gt_encseq_create_reader_with_readmode(encseq, readmode, frompos);
+    for (pos = frompos, idx = 0; pos <= topos; pos++, idx++) {
+      buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
+    }
+    gt_encseq_reader_delete(esr);
+  }
+}
+
 void gt_encseq_extract_encoded_with_reader(GtEncseqReader *esr,
                                const GtEncseq *encseq,
                                GtUchar *buffer,
@@ -726,6 +899,12 @@ void gt_encseq_extract_encoded_with_reader(GtEncseqReader *esr,
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
+  if (gt_encseq_bulk_extract_possible(encseq)) {
+    gt_encseq_extract_encoded_with_readmode(encseq, buffer,
+                                            GT_READMODE_FORWARD, frompos,
+                                            topos);
+    return;
+  }
   gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
                                         frompos);
   for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
@@ -738,18 +917,8 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
                                GtUword frompos,
                                GtUword topos)
 {
-  GtEncseqReader *esr;
-  GtUword idx, pos;
-
-  gt_assert(frompos <= topos && encseq != NULL &&
-            topos < encseq->logicaltotallength && buffer != NULL);
-  esr = gt_encseq_create_reader_with_readmode(encseq,
-                                              GT_READMODE_FORWARD,
-                                              frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_encoded_char(esr);
-  }
-  gt_encseq_reader_delete(esr);
+  gt_encseq_extract_encoded_with_readmode(encseq, buffer, GT_READMODE_FORWARD,
+                                          frompos, topos);
 }
 
 void gt_encseq_extract_decoded_with_reader(GtEncseqReader *esr,
@@ -762,6 +931,13 @@ void gt_encseq_extract_decoded_with_reader(GtEncseqReader *esr,
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength && buffer != NULL);
+  if (gt_encseq_bulk_extract_possible(encseq) &&
+      !encseq->has_exceptiontable) {
+    gt_encseq_extract_decoded_with_readmode(encseq, buffer,
+                                            GT_READMODE_FORWARD, frompos,
+                                            topos);
+    return;
+  }
   gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
                                         frompos);
   for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
@@ -774,18 +950,8 @@ void gt_encseq_extract_decoded(const GtEncseq *encseq,
                                GtUword frompos,
                                GtUword topos)
 {
-  GtEncseqReader *esr;
-  GtUword idx, pos;
-
-  gt_assert(frompos <= topos && encseq != NULL &&
-            topos < encseq->logicaltotallength && buffer != NULL);
-  esr = gt_encseq_create_reader_with_readmode(encseq,
-                                              GT_READMODE_FORWARD,
-                                              frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
-  }
-  gt_encseq_reader_delete(esr);
+  gt_encseq_extract_decoded_with_readmode(encseq, buffer, GT_READMODE_FORWARD,
+                                          frompos, topos);
 }
 
 const char* gt_encseq_accessname(const GtEncseq *encseq)
@@ -2991,6 +3157,30 @@ DECLAREISSINGLEPOSITIONEXCEPTIONVIATABLESFUNCTION(
                                           checkspecialrange, has_exceptiontable,
                                           uint32)
 
+static void bulkpatchwildcards(const GtEncseq *encseq, GtUchar *buffer,
+                               GtUword fwdstart, GtUword len, bool reverse,
+                               GtUchar wildcard)
+{
+  switch (encseq->sat) {
+    case GT_ACCESS_TYPE_UCHARTABLES:
+      bulkpatchwildcards_uchar(&encseq->wildcardrangetable.st_uchar, buffer,
+                               fwdstart, len, reverse, wildcard);
+      break;
+    case GT_ACCESS_TYPE_USHORTTABLES:
+      bulkpatchwildcards_uint16(&encseq->wildcardrangetable.st_uint16, buffer,
+                                fwdstart, len, reverse, wildcard);
+      break;
+    case GT_ACCESS_TYPE_UINT32TABLES:
+      bulkpatchwildcards_uint32(&encseq->wildcardrangetable.st_uint32, buffer,
+                                fwdstart, len, reverse, wildcard);
+      break;
+    default:
+      fprintf(stderr, "bulkpatchwildcards(sat = %s is undefined)\n",
+              gt_encseq_access_type_str(encseq->sat));
+      exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+}
+
 static void advancerangeGtEncseqReader(GtEncseqReader *esr,
                                        KindofSWtable kindsw)
 {
@@ -4549,6 +4739,8 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        GtUword wildcardranges,
                                        GtUword minseqlength,
                                        GtUword maxseqlength,
+                                       GtSequenceSpool **spools,
+                                       GtUword numofspools,
                                        GtLogger *logger,
                                        GtError *err)
 {
@@ -4595,7 +4787,12 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
     encseq->subsymbolmap = subsymbolmap;
     encseq->maxsubalphasize = maxsubalphasize;
     gt_assert(filenametab != NULL);
-    if (plainformat) {
+    if (numofspools > 0) {
+      /* replay the symbols recorded while computing the key values instead
+         of parsing the input files again */
+      fb = gt_sequence_buffer_spool_new(spools, numofspools);
+    }
+    else if (plainformat) {
       fb = gt_sequence_buffer_plain_new(filenametab);
     }
     else {
@@ -4627,7 +4824,8 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        specialcharinfo.exceptioncharacters,
                            true);
     }
-    gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alphabet));
+    if (numofspools == 0)
+      gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alphabet));
     if (encodedseqfunctab[(int) sat].fillposition.function(encseq,
                                                            ssptaboutinfo,
                                                            fb, err) != 0)
@@ -5418,6 +5616,234 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
   return had_err;
 }
 
+/* The result of parsing a single input file on its own: the symbol codes
+   (and descriptions) are recorded in <spool>, the statistics which the
+   sequential pass would collect from the original characters are kept here. */
+typedef struct {
+  GtSequenceSpool *spool;
+  GtFilelengthvalues filelength;
+  GtUword *characterdistribution,
+          *originaldistribution;
+  FILE *md5fp;
+  bool fastq;
+} GtEncseqInputPart;
+
+typedef struct {
+  const GtStrArray *filenametab;
+  const GtAlphabet *alpha;
+  GtSequenceBufferNewFunc sequence_buffer_new;
+  GtEncseqInputPart *parts;
+  bool withdesc,
+       clip_desc,
+       withmd5;
+  GtUword nextfile,
+          failedfile;
+  GtError *err; /* error of the first failing file, separate from the error
+                   of the caller, which is used while threads are started */
+  GtMutex *mutex;
+} GtEncseqParseInfo;
+
+static void gt_encseq_md5_flush(GtMD5Encoder *md5enc, char *md5_blockbuf,
+                                GtUword md5_blockcount, FILE *md5fp)
+{
+  unsigned char md5_output[16];
+  char md5_outbuf[33];
+
+  gt_md5_encoder_add_block(md5enc, md5_blockbuf, md5_blockcount);
+  gt_md5_encoder_finish(md5enc, md5_output, md5_outbuf);
+  gt_xfwrite(md5_outbuf, sizeof (char), (size_t) 33, md5fp);
+  gt_md5_encoder_reset(md5enc);
+}
+
+/* Parses the input file <filename> into <part>, computing the MD5 sums of the
+   sequences in the same way as <gt_inputfiles2sequencekeyvalues()>. The file
+   is read with the buffer type guessed from the first input file, as in a
+   sequential pass. */
+static int gt_encseq_parse_input_part(GtEncseqInputPart *part,
+                                      const char *filename,
+                                      const GtEncseqParseInfo *info,
+                                      GtError *err)
+{
+  GtStrArray *filenametab;
+  GtSequenceBuffer *fb;
+  GtDescBuffer *descqueue = NULL;
+  GtMD5Encoder *md5enc = NULL;
+  GtUchar charcode;
+  GtUword md5_blockcount = 0;
+  char cc, md5_blockbuf[64];
+  int retval, had_err = 0;
+  gt_error_check(err);
+
+  filenametab = gt_str_array_new();
+  gt_str_array_add_cstr(filenametab, filename);
+  fb = info->sequence_buffer_new(filenametab);
+  part->fastq = gt_sequence_buffer_is_fastq(fb);
+  gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(info->alpha));
+  gt_sequence_buffer_set_filelengthtab(fb, &part->filelength);
+  gt_sequence_buffer_set_chardisttab(fb, part->characterdistribution);
+  if (info->withdesc) {
+    descqueue = gt_desc_buffer_new();
+    if (info->clip_desc)
+      gt_desc_buffer_set_clip_at_whitespace(descqueue);
+    gt_sequence_buffer_set_desc_buffer(fb, descqueue);
+  }
+  if (info->withmd5) {
+    md5enc = gt_md5_encoder_new();
+    part->md5fp = gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  }
+  while ((retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc,
+                                                         err)) == 1) {
+    gt_sequence_spool_add(part->spool, charcode);
+    part->originaldistribution[(int) cc]++;
+    if (charcode == (GtUchar) SEPARATOR) {
+      if (md5enc != NULL) {
+        gt_encseq_md5_flush(md5enc, md5_blockbuf, md5_blockcount, part->md5fp);
+        md5_blockcount = 0;
+      }
+      if (descqueue != NULL) {
+        gt_sequence_spool_add_description(part->spool,
+                                          gt_desc_buffer_get_next(descqueue));
+      }
+    } else if (md5enc != NULL) {
+      if (md5_blockcount == 64UL) {
+        gt_md5_encoder_add_block(md5enc, md5_blockbuf, md5_blockcount);
+        md5_blockcount = 0;
+      }
+      md5_blockbuf[md5_blockcount++]
+        = toupper(gt_alphabet_decode(info->alpha, charcode));
+    }
+  }
+  if (retval < 0)
+    had_err = -1;
+  if (!had_err) {
+    if (md5enc != NULL) {
+      gt_encseq_md5_flush(md5enc, md5_blockbuf, md5_blockcount, part->md5fp);
+      gt_xfflush(part->md5fp);
+      rewind(part->md5fp);
+    }
+    if (descqueue != NULL) {
+      gt_sequence_spool_add_description(part->spool,
+                                        gt_desc_buffer_get_next(descqueue));
+    }
+  }
+  gt_md5_encoder_delete(md5enc);
+  gt_sequence_buffer_delete(fb);
+  gt_desc_buffer_delete(descqueue);
+  gt_str_array_delete(filenametab);
+  return had_err;
+}
+
+static void* gt_encseq_parse_input_thread(void *data)
+{
+  GtEncseqParseInfo *info = data;
+  GtUword filenum;
+  GtError *err;
+  gt_assert(info);
+
+  err = gt_error_new();
+  while (true) {
+    gt_mutex_lock(info->mutex);
+    if (info->nextfile == gt_str_array_size(info->filenametab)) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    filenum = info->nextfile++;
+    gt_mutex_unlock(info->mutex);
+    if (gt_encseq_parse_input_part(info->parts + filenum,
+                                   gt_str_array_get(info->filenametab,
+                                                    filenum),
+                                   info, err) != 0) {
+      /* report the error of the first failing file */
+      gt_mutex_lock(info->mutex);
+      if (filenum < info->failedfile) {
+        info->failedfile = filenum;
+        gt_error_set(info->err, "%s", gt_error_get(err));
+      }
+      gt_mutex_unlock(info->mutex);
+      gt_error_unset(err);
+    }
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* Parses the input files in parallel on <gt_jobs> threads, recording the
+   symbols of file <i> in <spools>[<i>]. The character distributions, file
+   lengths and original character distributions are added to the given
+   tables. If <md5fp> is not NULL, the MD5 sums of all sequences are written to
+   it in input order. */
+static int gt_encseq_parse_input_parallel(const GtStrArray *filenametab,
+                                          const GtAlphabet *alpha,
+                                          GtSequenceSpool **spools,
+                                          bool withdesc,
+                                          bool clip_desc,
+                                          FILE *md5fp,
+                                          GtFilelengthvalues *filelengthtab,
+                                          GtUword *characterdistribution,
+                                          GtUword *originaldistribution,
+                                          GtError *err)
+{
+  GtEncseqParseInfo info;
+  GtUword filenum, idx, numoffiles = gt_str_array_size(filenametab),
+          numofchars = (GtUword) gt_alphabet_num_of_chars(alpha);
+  char buf[BUFSIZ];
+  size_t len;
+  int had_err;
+  gt_error_check(err);
+
+  info.filenametab = filenametab;
+  info.alpha = alpha;
+  if (!(info.sequence_buffer_new = gt_sequence_buffer_guess_type(filenametab,
+                                                                  err))) {
+    return -1;
+  }
+  info.withdesc = withdesc;
+  info.clip_desc = clip_desc;
+  info.withmd5 = md5fp != NULL;
+  info.nextfile = 0;
+  info.failedfile = GT_UNDEF_UWORD;
+  info.err = gt_error_new();
+  info.mutex = gt_mutex_new();
+  info.parts = gt_calloc((size_t) numoffiles, sizeof (*info.parts));
+  for (filenum = 0; filenum < numoffiles; filenum++) {
+    info.parts[filenum].spool = spools[filenum];
+    info.parts[filenum].characterdistribution
+      = gt_calloc((size_t) numofchars, sizeof (GtUword));
+    info.parts[filenum].originaldistribution
+      = gt_calloc((size_t) UCHAR_MAX, sizeof (GtUword));
+  }
+  had_err = gt_multithread(gt_encseq_parse_input_thread, &info, err);
+  if (!had_err && info.failedfile != GT_UNDEF_UWORD) {
+    gt_error_set(err, "%s", gt_error_get(info.err));
+    had_err = -1;
+  }
+  for (filenum = 0; filenum < numoffiles; filenum++) {
+    GtEncseqInputPart *part = info.parts + filenum;
+    if (!had_err) {
+      filelengthtab[filenum] = part->filelength;
+      /* the FASTQ buffer counts the separator between two files in the
+         effective length of the first one */
+      if (part->fastq && filenum + 1 < numoffiles)
+        filelengthtab[filenum].effectivelength++;
+      for (idx = 0; idx < numofchars; idx++)
+        characterdistribution[idx] += part->characterdistribution[idx];
+      for (idx = 0; idx < (GtUword) UCHAR_MAX; idx++)
+        originaldistribution[idx] += part->originaldistribution[idx];
+      if (md5fp != NULL) {
+        while ((len = fread(buf, sizeof (char), sizeof buf, part->md5fp)) > 0)
+          gt_xfwrite(buf, sizeof (char), len, md5fp);
+      }
+    }
+    gt_fa_xfclose(part->md5fp);
+    gt_free(part->characterdistribution);
+    gt_free(part->originaldistribution);
+  }
+  gt_free(info.parts);
+  gt_error_delete(info.err);
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+
 static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *totallength,
                                            GtSpecialcharinfo *specialcharinfo,
@@ -5445,6 +5871,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *minseqlen,
                                            GtUword *maxseqlen,
                                            bool clip_desc,
+                                           GtSequenceSpool **spools,
+                                           GtUword numofspools,
                                            GtLogger *logger,
                                            GtError *err)
 {
@@ -5458,8 +5886,11 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                 lengthofcurrentsequence = 0,
                 lengthofalphadef,
                 *originaldistribution = NULL,
-                md5_blockcount = 0;
-  bool specialprefix = true, wildcardprefix = true, haserr = false;
+                *parsedorigdist = NULL,
+                md5_blockcount = 0,
+                idx;
+  bool specialprefix = true, wildcardprefix = true, haserr = false,
+       parallel = numofspools > 1UL;
   GtDiscDistri *distspecialrangelength = NULL, *distwildcardrangelength = NULL;
   GtDescBuffer *descqueue = NULL;
   GtMD5Encoder *md5enc = NULL;
@@ -5479,14 +5910,18 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   specialcharinfo->lengthofwildcardprefix = 0;
   specialcharinfo->lengthofwildcardsuffix = 0;
 
-  if (plainformat) {
+  if (parallel) {
+    /* the files are parsed in parallel below and replayed from the spools */
+    gt_assert(!plainformat && numofspools == gt_str_array_size(filenametab));
+  }
+  else if (plainformat) {
     fb = gt_sequence_buffer_plain_new(filenametab);
     equallength->defined = false;
   }
   else {
     fb = gt_sequence_buffer_new_guess_type(filenametab, err);
   }
-  if (!fb)
+  if (!parallel && !fb)
     haserr = true;
   if (!haserr && outdestab) {
     descqueue = gt_desc_buffer_new();
@@ -5507,20 +5942,42 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
       haserr = true;
   }
   if (!haserr) {
-    char cc;
-    const GtAlphabet *a = alpha;
-    gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alpha));
     *filelengthtab = gt_calloc((size_t) gt_str_array_size(filenametab),
                                sizeof (GtFilelengthvalues));
-    gt_sequence_buffer_set_filelengthtab(fb, *filelengthtab);
+  }
+  if (!haserr && parallel) {
+    /* Parsing, symbol mapping and MD5 computation are done per file on
+       <gt_jobs> threads. The statistics below are then collected from the
+       recorded symbols, which yields the same result as a sequential pass. */
+    parsedorigdist = gt_calloc((size_t) UCHAR_MAX, sizeof (GtUword));
+    if (gt_encseq_parse_input_parallel(filenametab, alpha, spools,
+                                       descqueue != NULL, clip_desc, md5fp,
+                                       *filelengthtab, characterdistribution,
+                                       parsedorigdist, err) != 0) {
+      haserr = true;
+    }
+    for (idx = 0; !haserr && idx < numofspools; idx++) {
+      if (gt_sequence_spool_flush(spools[idx], err) != 0)
+        haserr = true;
+    }
+    if (!haserr)
+      fb = gt_sequence_buffer_spool_new(spools, numofspools);
+  }
+  if (!haserr) {
+    char cc;
+    const GtAlphabet *a = alpha;
+    if (!parallel) {
+      gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alpha));
+      gt_sequence_buffer_set_filelengthtab(fb, *filelengthtab);
+      gt_sequence_buffer_set_chardisttab(fb, characterdistribution);
+    }
     if (descqueue != NULL)
       gt_sequence_buffer_set_desc_buffer(fb, descqueue);
-    gt_sequence_buffer_set_chardisttab(fb, characterdistribution);
     distspecialrangelength = gt_disc_distri_new();
     distwildcardrangelength = gt_disc_distri_new();
     originaldistribution = gt_calloc((size_t) UCHAR_MAX,
                                      sizeof (GtUword));
-    if (md5fp != NULL)
+    if (md5fp != NULL && !parallel)
       md5enc = gt_md5_encoder_new();
     for (currentpos = 0; !haserr; currentpos++) {
 #if !(defined (_LP64) || defined (_WIN64))
@@ -5534,6 +5991,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
 #endif
       retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc, err);
       if (retval > 0) {
+        if (numofspools == 1UL)
+          gt_sequence_spool_add(spools[0], charcode);
 #define WITHEQUALLENGTH_DES_SSP
 #define WITHOISTAB
 #define WITHCOUNTMINMAX
@@ -5598,6 +6057,11 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     alphabet_to_key_values(alpha, NULL, &lengthofalphadef, NULL,
                            customalphabet);
   }
+  if (!haserr && parallel) {
+    /* the replayed symbols are no original characters */
+    memcpy(originaldistribution, parsedorigdist,
+           sizeof (*originaldistribution) * UCHAR_MAX);
+  }
   if (!haserr) {
     determine_original_subdist(alpha, maxchars, allchars, subsymbolmap,
                                maxsubalphasize, numofallchars,
@@ -5658,6 +6122,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     *maxseqlen = *minseqlen = lengthofcurrentsequence;
   }
   gt_free(originaldistribution);
+  gt_free(parsedorigdist);
   gt_fa_xfclose(desfp);
   gt_fa_xfclose(sdsfp);
   gt_disc_distri_delete(distspecialrangelength);
@@ -7500,6 +7965,43 @@ static GtUword *initcharacterdistribution(const GtAlphabet *alpha)
   return characterdistribution;
 }
 
+/* Streams like standard input can be read only once. This is enough for the
+   encoding, as the symbols are recorded during the first pass, but guessing
+   the alphabet and collecting the exception table need passes of their own. */
+static int gt_encseq_check_input_streams(const GtStrArray *filenametab,
+                                         bool guessalphabet,
+                                         bool outoistab,
+                                         GtError *err)
+{
+  GtUword idx, jdx;
+  const char *filename;
+
+  gt_error_check(err);
+  for (idx = 0; idx < gt_str_array_size(filenametab); idx++) {
+    filename = gt_str_array_get(filenametab, idx);
+    if (!gt_file_is_stream(filename))
+      continue;
+    if (guessalphabet) {
+      gt_error_set(err, "cannot guess alphabet of input stream \"%s\", use "
+                        "option -dna, -protein or -smap", filename);
+      return -1;
+    }
+    if (outoistab) {
+      gt_error_set(err, "lossless encoding is not possible for input stream "
+                        "\"%s\"", filename);
+      return -1;
+    }
+    for (jdx = 0; jdx < idx; jdx++) {
+      if (strcmp(filename, gt_str_array_get(filenametab, jdx)) == 0) {
+        gt_error_set(err, "input stream \"%s\" is given more than once",
+                     filename);
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
 static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                           const char *indexname,
                                           const GtStr *str_smap,
@@ -7535,6 +8037,8 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                 maxseqlen = GT_UNDEF_UWORD,
                 numofallchars = 0;
   GtEncseq *encseq = NULL;
+  GtSequenceSpool **spools = NULL;
+  GtUword numofspools = 0, idx;
   unsigned char subsymbolmap[UCHAR_MAX+1],
                 maxsubalphasize = 0;
   Definedunsignedlong equallength; /* is defined if all sequences are of equal
@@ -7556,6 +8060,13 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
   else {
     forcetable = 3U;
   }
+  if (!haserr &&
+      gt_encseq_check_input_streams(filenametab,
+                                    !isdna && !isprotein &&
+                                    gt_str_length(str_smap) == 0,
+                                    outoistab, err) != 0) {
+    haserr = true;
+  }
   if (!haserr) {
     if (isdna) {
       alphabet = gt_alphabet_new_dna();
@@ -7578,6 +8089,27 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     classstartpositions = gt_calloc((size_t) UCHAR_MAX,
                                     sizeof (*classstartpositions));
     memset(&subsymbolmap, 0, ((size_t) UCHAR_MAX+1) * sizeof (unsigned char));
+    /* Record the symbol codes while the input is read for the first time, so
+       that the encoding does not need to parse and decompress it again.
+       Exception tables need the original characters, which are not
+       recorded. With more than one job, multiple files are parsed in
+       parallel, each into its own spool. The spools are kept next to the
+       index. */
+    if (!outoistab) {
+      numofspools = (gt_jobs > 1U && !isplain)
+                    ? gt_str_array_size(filenametab)
+                    : 1UL;
+      spools = gt_calloc((size_t) numofspools, sizeof (*spools));
+      for (idx = 0; !haserr && idx < numofspools; idx++) {
+        spools[idx] = gt_sequence_spool_new(indexname,
+                                            gt_alphabet_num_of_chars(alphabet),
+                                            err);
+        if (spools[idx] == NULL)
+          haserr = true;
+      }
+    }
+  }
+  if (!haserr) {
     if (gt_inputfiles2sequencekeyvalues(indexname,
                                         &totallength,
                                         &specialcharinfo,
@@ -7605,6 +8137,8 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                         &minseqlen,
                                         &maxseqlen,
                                         clip_desc,
+                                        spools,
+                                        numofspools,
                                         logger,
                                         err) != 0) {
       char buf[BUFSIZ];
@@ -7614,6 +8148,10 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
       haserr = true;
     }
   }
+  for (idx = 0; !haserr && idx < numofspools; idx++) {
+    if (gt_sequence_spool_flush(spools[idx], err) != 0)
+      haserr = true;
+  }
   if (!haserr) {
     int retcode;
     GtUword lengthofalphadef;
@@ -7669,11 +8207,16 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                    wildcardranges,
                                    minseqlen,
                                    maxseqlen,
+                                   spools,
+                                   numofspools,
                                    logger,
                                    err);
     if (encseq == NULL)
       haserr = true;
   }
+  for (idx = 0; idx < numofspools; idx++)
+    gt_sequence_spool_delete(spools[idx]);
+  gt_free(spools);
   if (!haserr) {
     alphabetisbound = true;
     if (gt_encseq_flush2file(indexname, encseq, esq_no_header, err) != 0)
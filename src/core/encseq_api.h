@@ -133,6 +133,25 @@ void              gt_encseq_extract_decoded(const GtEncseq *encseq,
                                             char *buffer,
                                             GtUword frompos,
                                             GtUword topos);
+/* Like <gt_encseq_extract_encoded>, but reads the substring in <readmode>.
+   <frompos> and <topos> refer to positions in <readmode>, that is, <buffer>
+   receives the same characters as successive calls of
+   <gt_encseq_get_encoded_char> for these positions. On two bit encoded
+   sequences, whole words are decoded at once. */
+void              gt_encseq_extract_encoded_with_readmode(
+                                                       const GtEncseq *encseq,
+                                                       GtUchar *buffer,
+                                                       GtReadmode readmode,
+                                                       GtUword frompos,
+                                                       GtUword topos);
+/* Like <gt_encseq_extract_decoded>, but reads the substring in <readmode>.
+   <frompos> and <topos> refer to positions in <readmode>. */
+void              gt_encseq_extract_decoded_with_readmode(
+                                                       const GtEncseq *encseq,
+                                                       char *buffer,
+                                                       GtReadmode readmode,
+                                                       GtUword frompos,
+                                                       GtUword topos);
 /* Returns the length of the <seqnum>-th sequence in the <encseq>.
    Requires multiple sequence support enabled in <encseq>. */
 GtUword           gt_encseq_seqlength(const GtEncseq *encseq,
@@ -23,6 +23,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include "core/compat.h"
+#include "core/cstr_api.h"
 #include "core/dynalloc.h"
 #include "core/eansi.h"
 #include "core/ebzlib.h"
@@ -40,6 +41,12 @@
 #include "core/xposix.h"
 #include "core/xzlib.h"
 
+/* the advice for memory maps of files ending with <suffix> */
+typedef struct {
+  char *suffix;
+  unsigned int advice;
+} FAMapPolicy;
+
 /* the file allocator class */
 typedef struct {
   GtMutex *file_mutex,
@@ -48,6 +55,8 @@ typedef struct {
             *memory_maps;
   GtUword current_size,
                 max_size;
+  FAMapPolicy *map_policies;
+  GtUword num_of_map_policies;
   bool global_space_peak;
 } FA;
 
@@ -62,6 +71,12 @@ typedef struct {
   size_t len;
   const char *src_file;
   int src_line;
+#ifdef GT_THREADS_ENABLED
+  /* the thread reading all pages of the map for <GT_FA_MAP_WARMUP> */
+  GtThread *warmup_thread;
+  const char *addr;
+  volatile bool stop_warmup;
+#endif
 #ifdef _WIN32
   /* additional handles necessary for memory maps on Windows */
   HANDLE filehandle,
@@ -380,6 +395,157 @@ FILE* gt_xtmpfp_generic_func(GtStr *template_arg, enum tmpfp_flags flags,
   return fp;
 }
 
+/* Returns the advice for memory maps of <filename>, that is the advice of
+   the longest matching suffix. */
+static unsigned int fa_map_advice(const char *filename)
+{
+  unsigned int advice = GT_FA_MAP_NORMAL;
+  size_t length, suffixlength, matchlength = 0;
+  bool found = false;
+  GtUword idx;
+  gt_assert(fa && filename);
+  length = strlen(filename);
+  gt_mutex_lock(fa->mmap_mutex);
+  for (idx = 0; idx < fa->num_of_map_policies; idx++) {
+    suffixlength = strlen(fa->map_policies[idx].suffix);
+    if (suffixlength <= length &&
+        (!found || suffixlength > matchlength) &&
+        strcmp(filename + length - suffixlength,
+               fa->map_policies[idx].suffix) == 0) {
+      advice = fa->map_policies[idx].advice;
+      matchlength = suffixlength;
+      found = true;
+    }
+  }
+  gt_mutex_unlock(fa->mmap_mutex);
+  return advice;
+}
+
+void gt_fa_set_map_policy(const char *suffix, unsigned int advice)
+{
+  GtUword idx;
+  gt_assert(fa && suffix);
+  gt_mutex_lock(fa->mmap_mutex);
+  for (idx = 0; idx < fa->num_of_map_policies; idx++) {
+    if (strcmp(fa->map_policies[idx].suffix, suffix) == 0)
+      break;
+  }
+  if (idx == fa->num_of_map_policies) {
+    fa->map_policies = gt_realloc(fa->map_policies,
+                                  (fa->num_of_map_policies + 1) *
+                                  sizeof (*fa->map_policies));
+    fa->map_policies[idx].suffix = gt_cstr_dup(suffix);
+    fa->num_of_map_policies++;
+  }
+  fa->map_policies[idx].advice = advice;
+  gt_mutex_unlock(fa->mmap_mutex);
+}
+
+int gt_fa_set_map_policy_from_string(const char *spec, GtError *err)
+{
+  static const struct {
+    const char *name;
+    unsigned int advice;
+  } advicetab[] = {
+    {"normal", GT_FA_MAP_NORMAL},
+    {"sequential", GT_FA_MAP_SEQUENTIAL},
+    {"random", GT_FA_MAP_RANDOM},
+    {"willneed", GT_FA_MAP_WILLNEED},
+    {"hugepages", GT_FA_MAP_HUGEPAGES},
+    {"populate", GT_FA_MAP_POPULATE},
+    {"warmup", GT_FA_MAP_WARMUP}
+  };
+  const size_t numofadvice = sizeof (advicetab) / sizeof (advicetab[0]);
+  const char *advicestart, *equal;
+  unsigned int advice = GT_FA_MAP_NORMAL;
+  GtStr *suffix;
+  size_t idx, wordlength;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(spec);
+
+  suffix = gt_str_new();
+  equal = strchr(spec, '=');
+  if (equal != NULL) {
+    if (equal == spec) {
+      gt_error_set(err, "missing table before '=' in map policy \"%s\"", spec);
+      had_err = -1;
+    }
+    else {
+      gt_str_append_char(suffix, '.');
+      gt_str_append_cstr_nt(suffix, spec, (GtUword) (equal - spec));
+    }
+    advicestart = equal + 1;
+  }
+  else
+    advicestart = spec;
+  while (!had_err) {
+    wordlength = strcspn(advicestart, ",");
+    for (idx = 0; idx < numofadvice; idx++) {
+      if (strlen(advicetab[idx].name) == wordlength &&
+          strncmp(advicetab[idx].name, advicestart, wordlength) == 0) {
+        advice |= advicetab[idx].advice;
+        break;
+      }
+    }
+    if (idx == numofadvice) {
+      gt_error_set(err, "illegal advice \"%.*s\" in map policy \"%s\", use "
+                   "normal, sequential, random, willneed, hugepages, "
+                   "populate or warmup", (int) wordlength, advicestart, spec);
+      had_err = -1;
+    }
+    if (advicestart[wordlength] == '\0')
+      break;
+    advicestart += wordlength + 1;
+  }
+  if (!had_err && (advice & GT_FA_MAP_SEQUENTIAL) &&
+      (advice & GT_FA_MAP_RANDOM)) {
+    gt_error_set(err, "advice sequential and random exclude each other in "
+                 "map policy \"%s\"", spec);
+    had_err = -1;
+  }
+  if (!had_err)
+    gt_fa_set_map_policy(gt_str_get(suffix), advice);
+  gt_str_delete(suffix);
+  return had_err;
+}
+
+#ifndef _WIN32
+static void fa_madvise(void *map, size_t len, unsigned int advice)
+{
+#ifdef MADV_SEQUENTIAL
+  if (advice & GT_FA_MAP_SEQUENTIAL)
+    (void) madvise(map, len, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_RANDOM
+  if (advice & GT_FA_MAP_RANDOM)
+    (void) madvise(map, len, MADV_RANDOM);
+#endif
+#ifdef MADV_WILLNEED
+  if (advice & GT_FA_MAP_WILLNEED)
+    (void) madvise(map, len, MADV_WILLNEED);
+#endif
+#ifdef MADV_HUGEPAGE
+  if (advice & GT_FA_MAP_HUGEPAGES)
+    (void) madvise(map, len, MADV_HUGEPAGE);
+#endif
+}
+
+#ifdef GT_THREADS_ENABLED
+/* Touches one byte per page of the map, such that later accesses to the map
+   do not have to wait for the disk. */
+static void* fa_warmup_func(void *data)
+{
+  FAMapInfo *mapinfo = data;
+  const volatile char *ptr = mapinfo->addr;
+  size_t pagesize = (size_t) sysconf(_SC_PAGESIZE), pos;
+  for (pos = 0; pos < mapinfo->len && !mapinfo->stop_warmup; pos += pagesize)
+    (void) ptr[pos];
+  return NULL;
+}
+#endif
+#endif
+
 void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
                                  size_t len, GT_UNUSED size_t offset,
                                  bool mapwritable, bool hard_fail,
@@ -388,6 +554,10 @@ void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
 {
   FAMapInfo *mapinfo;
   void *map = NULL;
+#ifndef _WIN32
+  unsigned int advice;
+  int flags = MAP_SHARED;
+#endif
   gt_error_check(err);
   gt_assert(fa);
   mapinfo = gt_calloc(1, sizeof *mapinfo);
@@ -396,13 +566,24 @@ void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
   mapinfo->len = len;
 
 #ifndef _WIN32
+  advice = fa_map_advice(filename);
+#ifndef GT_THREADS_ENABLED
+  /* without a background thread, warming up would read the whole map right
+     away, so the pages are only prefetched by the operating system */
+  if (advice & GT_FA_MAP_WARMUP)
+    advice = (advice & ~GT_FA_MAP_WARMUP) | GT_FA_MAP_WILLNEED;
+#endif
+#ifdef MAP_POPULATE
+  if (advice & GT_FA_MAP_POPULATE)
+    flags |= MAP_POPULATE;
+#endif
   if (hard_fail) {
     map = gt_xmmap(0, len, PROT_READ | (mapwritable ? PROT_WRITE : 0),
-                   MAP_SHARED, fd, offset);
+                   flags, fd, offset);
   }
   else {
     if ((map = mmap(0, len, PROT_READ | (mapwritable ? PROT_WRITE : 0),
-                    MAP_SHARED, fd, offset)) == MAP_FAILED) {
+                    flags, fd, offset)) == MAP_FAILED) {
       gt_error_set(err,"cannot map file \"%s\": %s", filename, strerror(errno));
       map = NULL;
     }
@@ -456,6 +637,16 @@ void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
     if (fa->current_size > fa->max_size)
       fa->max_size = fa->current_size;
     gt_mutex_unlock(fa->mmap_mutex);
+#ifndef _WIN32
+    if (advice != GT_FA_MAP_NORMAL)
+      fa_madvise(map, len, advice);
+#ifdef GT_THREADS_ENABLED
+    if (advice & GT_FA_MAP_WARMUP) {
+      mapinfo->addr = map;
+      mapinfo->warmup_thread = gt_thread_new(fa_warmup_func, mapinfo, NULL);
+    }
+#endif
+#endif
   }
   else
     gt_free(mapinfo);
@@ -660,6 +851,13 @@ void gt_fa_xmunmap(void *addr)
   gt_mutex_lock(fa->mmap_mutex);
   mapinfo = gt_hashmap_get(fa->memory_maps, addr);
   gt_assert(mapinfo);
+#ifdef GT_THREADS_ENABLED
+  if (mapinfo->warmup_thread != NULL) {
+    mapinfo->stop_warmup = true;
+    gt_thread_join(mapinfo->warmup_thread);
+    gt_thread_delete(mapinfo->warmup_thread);
+  }
+#endif
 #ifndef _WIN32
   gt_xmunmap(addr, mapinfo->len);
 #else
@@ -824,7 +1022,11 @@ void gt_fa_show_space_peak(FILE *fp)
 
 void gt_fa_clean(void)
 {
+  GtUword idx;
   if (!fa) return;
+  for (idx = 0; idx < fa->num_of_map_policies; idx++)
+    gt_free(fa->map_policies[idx].suffix);
+  gt_free(fa->map_policies);
   gt_mutex_delete(fa->file_mutex);
   gt_mutex_delete(fa->mmap_mutex);
   gt_hashmap_delete(fa->file_pointer);
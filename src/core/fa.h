@@ -166,6 +166,38 @@ void*   gt_fa_mmap_check_size_with_suffix(const char *path, const char *suffix,
                                           GtUword expectedunits,
                                           size_t sizeofunit, GtError *err);
 
+/* Advice on how the pages of a memory map are used, see
+   gt_fa_set_map_policy(). <GT_FA_MAP_SEQUENTIAL>, <GT_FA_MAP_RANDOM>,
+   <GT_FA_MAP_WILLNEED> and <GT_FA_MAP_HUGEPAGES> are passed to madvise(2),
+   <GT_FA_MAP_POPULATE> prefaults the whole map while it is created, and
+   <GT_FA_MAP_WARMUP> reads all pages of the map in a background thread,
+   which is stopped when the map is unmapped. Without thread support
+   <GT_FA_MAP_WARMUP> is treated as <GT_FA_MAP_WILLNEED>. Advice not supported
+   by the operating system is ignored. */
+typedef enum {
+  GT_FA_MAP_NORMAL     = 0,
+  GT_FA_MAP_SEQUENTIAL = 1U << 0,
+  GT_FA_MAP_RANDOM     = 1U << 1,
+  GT_FA_MAP_WILLNEED   = 1U << 2,
+  GT_FA_MAP_HUGEPAGES  = 1U << 3,
+  GT_FA_MAP_POPULATE   = 1U << 4,
+  GT_FA_MAP_WARMUP     = 1U << 5
+} GtFaMapAdvice;
+
+/* Applies the combination <advice> of <GtFaMapAdvice> values to all
+   subsequent memory maps of files whose name ends with <suffix>, e.g. ".suf"
+   for the suffix table of an index. An empty <suffix> sets the advice for
+   all files not matched by another suffix. A later call for the same
+   <suffix> replaces the previous advice. */
+void    gt_fa_set_map_policy(const char *suffix, unsigned int advice);
+/* Parses <spec> of the form [table=]advice[,advice...], where <table> is a
+   file suffix without the leading dot (e.g. suf, lcp, esq) and <advice> is
+   one of normal, sequential, random, willneed, hugepages, populate and
+   warmup, and sets the corresponding policy with gt_fa_set_map_policy().
+   Returns 0 on success and -1 if <spec> is invalid, in which case <err> is
+   set. */
+int     gt_fa_set_map_policy_from_string(const char *spec, GtError *err);
+
 /* check if all allocated file pointer have been released, prints to stderr */
 int     gt_fa_check_fptr_leak(void);
 /* check if all allocated memory maps have been freed, prints to stderr */
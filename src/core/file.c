@@ -16,14 +16,30 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include "core/cstr_api.h"
 #include "core/fa.h"
 #include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "core/xbzlib.h"
 #include "core/xzlib.h"
 
+/* initial size of the read buffer used for line-wise reading of compressed
+   files and stdin, grows if a single line does not fit into it */
+#define GT_FILE_BUFFER_SIZE (1UL << 18)
+
+/* size of the blocks decompressed by the read-ahead thread */
+#define GT_FILE_READ_AHEAD_SIZE (1UL << 22)
+
+/* size of the independently compressed gzip members written by the
+   write-behind thread, which compresses up to <gt_jobs> of them at once */
+#define GT_FILE_DEFLATE_BLOCK_SIZE (1UL << 20)
+
 struct GtFile {
   GtFileMode mode;
   GtUword reference_count;
@@ -35,10 +51,110 @@ struct GtFile {
   char *orig_path,
        *orig_mode,
        unget_char;
+  /* after the first line-wise read all reads are served from <buffer>, which
+     is either a read buffer or a memory map of the whole file */
+  char *buffer;
+  const char *bufptr,
+             *bufend;
+  size_t buffer_size;
+  /* compressed files can be decompressed by a separate thread: while the
+     reader consumes <decoded>, <read_ahead_thread> fills <pending> */
+  GtThread *read_ahead_thread;
+  char *decoded,
+       *pending;
+  int decoded_length,
+      pending_length;
+  size_t decoded_pos;
+  /* compressed output can be compressed and written by a separate thread:
+     while the writer fills <outbuf>, <write_behind_thread> handles <flushbuf>.
+     With <deflate_blocks> the gzip output is written as a series of
+     independently compressed gzip members to a plain file pointer */
+  GtThread *write_behind_thread;
+  char *outbuf,
+       *flushbuf;
+  size_t outbuf_length,
+         outbuf_size,
+         flushbuf_length,
+         flushbuf_size;
   bool is_stdin,
-       unget_used;
+       unget_used,
+       buffered,
+       mapped,
+       eof,
+       read_ahead,
+       write_behind,
+       deflate_blocks,
+       written;
 };
 
+/* streams which have been read by gt_file_peek() and are handed out again by
+   the next gt_file_open() of the same path */
+typedef struct {
+  char *path;
+  GtFile *file;
+} FilePeeked;
+
+static GtMutex *file_mutex = NULL;
+static FilePeeked *file_peeked = NULL;
+static GtUword file_num_of_peeked = 0;
+
+void gt_file_init(void)
+{
+  if (!file_mutex)
+    file_mutex = gt_mutex_new();
+}
+
+void gt_file_clean(void)
+{
+  GtUword i;
+  for (i = 0; i < file_num_of_peeked; i++) {
+    gt_file_delete(file_peeked[i].file);
+    gt_free(file_peeked[i].path);
+  }
+  gt_free(file_peeked);
+  file_peeked = NULL;
+  file_num_of_peeked = 0;
+  gt_mutex_delete(file_mutex);
+  file_mutex = NULL;
+}
+
+static void file_lock(void)
+{
+  if (file_mutex)
+    gt_mutex_lock(file_mutex);
+}
+
+static void file_unlock(void)
+{
+  if (file_mutex)
+    gt_mutex_unlock(file_mutex);
+}
+
+/* Returns the stream peeked at under <path> and forgets about it, or NULL if
+   there is none. */
+static GtFile* file_take_peeked(const char *path)
+{
+  GtFile *file = NULL;
+  GtUword i;
+  file_lock();
+  for (i = 0; i < file_num_of_peeked; i++) {
+    if (strcmp(file_peeked[i].path, path) == 0) {
+      file = file_peeked[i].file;
+      gt_free(file_peeked[i].path);
+      file_peeked[i] = file_peeked[--file_num_of_peeked];
+      break;
+    }
+  }
+  file_unlock();
+  return file;
+}
+
+static bool file_deflate_blocks(const char *mode)
+{
+  return gt_jobs > 1 && (!strcmp(mode, "w") || !strcmp(mode, "wb") ||
+                         !strcmp(mode, "a") || !strcmp(mode, "ab"));
+}
+
 GtFileMode gt_file_mode_determine(const char *path)
 {
   size_t path_length;
@@ -104,6 +220,12 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
   GtFile *file;
   gt_error_check(err);
   gt_assert(mode);
+  if (path && mode[0] == 'r') {
+    if ((file = file_take_peeked(path)))
+      return file;
+    if (strcmp(path, "-") == 0)
+      path = NULL;
+  }
   file = gt_calloc(1, sizeof (GtFile));
   file->mode = file_mode;
   file->reference_count = 0;
@@ -115,8 +237,18 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
           gt_file_delete_without_handle(file);
           return NULL;
         }
+        file->orig_path = gt_cstr_dup(path);
         break;
       case GT_FILE_MODE_GZIP:
+        if (file_deflate_blocks(mode)) {
+          file->fileptr.file = gt_fa_fopen(path, mode, err);
+          if (!file->fileptr.file) {
+            gt_file_delete_without_handle(file);
+            return NULL;
+          }
+          file->deflate_blocks = true;
+          break;
+        }
         file->fileptr.gzfile = gt_fa_gzopen(path, mode, err);
         if (!file->fileptr.gzfile) {
           gt_file_delete_without_handle(file);
@@ -140,6 +272,12 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+#ifdef GT_THREADS_ENABLED
+  file->read_ahead = gt_jobs > 1 && file_mode != GT_FILE_MODE_UNCOMPRESSED &&
+                     mode[0] == 'r';
+#endif
+  file->write_behind = gt_jobs > 1 && file_mode != GT_FILE_MODE_UNCOMPRESSED &&
+                       (mode[0] == 'w' || mode[0] == 'a');
   return file;
 }
 
@@ -148,6 +286,12 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
 {
   GtFile *file;
   gt_assert(mode);
+  if (path && mode[0] == 'r') {
+    if ((file = file_take_peeked(path)))
+      return file;
+    if (strcmp(path, "-") == 0)
+      path = NULL;
+  }
   file = gt_calloc(1, sizeof (GtFile));
   file->mode = file_mode;
   file->reference_count = 0;
@@ -155,9 +299,15 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
     switch (file_mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
         file->fileptr.file = gt_fa_xfopen(path, mode);
+        file->orig_path = gt_cstr_dup(path);
         break;
       case GT_FILE_MODE_GZIP:
-        file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
+        if (file_deflate_blocks(mode)) {
+          file->fileptr.file = gt_fa_xfopen(path, mode);
+          file->deflate_blocks = true;
+        }
+        else
+          file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
         break;
       case GT_FILE_MODE_BZIP2:
         file->fileptr.bzfile = gt_fa_xbzopen(path, mode);
@@ -172,6 +322,12 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+#ifdef GT_THREADS_ENABLED
+  file->read_ahead = gt_jobs > 1 && file_mode != GT_FILE_MODE_UNCOMPRESSED &&
+                     mode[0] == 'r';
+#endif
+  file->write_behind = gt_jobs > 1 && file_mode != GT_FILE_MODE_UNCOMPRESSED &&
+                       (mode[0] == 'w' || mode[0] == 'a');
   return file;
 }
 
@@ -198,6 +354,249 @@ GtFileMode gt_file_mode(const GtFile *file)
   return file->mode;
 }
 
+static int file_xread_unbuffered(GtFile *file, void *buf, size_t nbytes)
+{
+  int rval = -1;
+  gt_assert(file);
+  switch (file->mode) {
+    case GT_FILE_MODE_UNCOMPRESSED:
+      rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
+      break;
+    case GT_FILE_MODE_GZIP:
+      rval = gt_xgzread(file->fileptr.gzfile, buf, nbytes);
+      break;
+    case GT_FILE_MODE_BZIP2:
+      rval = gt_xbzread(file->fileptr.bzfile, buf, nbytes);
+      break;
+    default: gt_assert(0);
+  }
+  return rval;
+}
+
+static void* file_read_ahead_func(void *data)
+{
+  GtFile *file = data;
+  file->pending_length = file_xread_unbuffered(file, file->pending,
+                                               GT_FILE_READ_AHEAD_SIZE);
+  return NULL;
+}
+
+/* Wait for the read-ahead thread to finish its block, if it is running. */
+static void file_join_read_ahead(GtFile *file)
+{
+  gt_assert(file);
+#ifdef GT_THREADS_ENABLED
+  if (file->read_ahead_thread) {
+    gt_thread_join(file->read_ahead_thread);
+    gt_thread_delete(file->read_ahead_thread);
+    file->read_ahead_thread = NULL;
+  }
+#endif
+}
+
+/* Like file_xread_unbuffered(), but the data is taken from the block which
+   has been decompressed by the read-ahead thread in the meantime. Once a block
+   is used up, the next one is handed over and the thread is restarted for the
+   block after it. */
+static int file_xread_decoded(GtFile *file, void *buf, size_t nbytes)
+{
+  size_t available;
+  char *tmp;
+  gt_assert(file && file->read_ahead);
+  if (!file->decoded) {
+    file->decoded = gt_malloc(GT_FILE_READ_AHEAD_SIZE * sizeof (char));
+    file->pending = gt_malloc(GT_FILE_READ_AHEAD_SIZE * sizeof (char));
+  }
+  if (file->decoded_pos == (size_t) file->decoded_length) {
+    /* the first block (or any block for which no thread could be created) is
+       read directly */
+    if (file->read_ahead_thread)
+      file_join_read_ahead(file);
+    else
+      file_read_ahead_func(file);
+    if (file->pending_length <= 0)
+      return 0;
+    tmp = file->decoded;
+    file->decoded = file->pending;
+    file->pending = tmp;
+    file->decoded_length = file->pending_length;
+    file->decoded_pos = 0;
+#ifdef GT_THREADS_ENABLED
+    file->read_ahead_thread = gt_thread_new(file_read_ahead_func, file, NULL);
+#endif
+  }
+  available = file->decoded_length - file->decoded_pos;
+  if (available > nbytes)
+    available = nbytes;
+  memcpy(buf, file->decoded + file->decoded_pos, available);
+  file->decoded_pos += available;
+  return available;
+}
+
+/* Memory map the remainder of an uncompressed regular <file>. Returns false if
+   the file cannot be mapped. */
+static bool file_map(GtFile *file)
+{
+  struct stat sb;
+  size_t len;
+  long offset;
+  char *map;
+  gt_assert(file && !file->buffered);
+  if (file->mode != GT_FILE_MODE_UNCOMPRESSED || file->is_stdin ||
+      !file->orig_path || fstat(fileno(file->fileptr.file), &sb) ||
+      !S_ISREG(sb.st_mode) || sb.st_size == 0 ||
+      (offset = ftell(file->fileptr.file)) < 0) {
+    return false;
+  }
+  if (!(map = gt_fa_mmap_read(file->orig_path, &len, NULL)))
+    return false;
+  /* an unget character has already been read from the file pointer */
+  if (file->unget_used)
+    offset--;
+  if (offset < 0 || (size_t) offset > len ||
+      (file->unget_used &&
+       ((size_t) offset == len || map[offset] != file->unget_char))) {
+    gt_fa_xmunmap(map);
+    return false;
+  }
+  file->buffer = map;
+  file->buffer_size = len;
+  file->bufptr = map + offset;
+  file->bufend = map + len;
+  file->unget_used = false;
+  file->mapped = true;
+  return true;
+}
+
+static void file_init_buffer(GtFile *file)
+{
+  gt_assert(file && !file->buffered);
+  if (!file_map(file)) {
+    file->buffer_size = GT_FILE_BUFFER_SIZE;
+    file->buffer = gt_malloc(file->buffer_size * sizeof (char));
+    file->bufptr = file->bufend = file->buffer;
+    if (file->unget_used) {
+      file->buffer[0] = file->unget_char;
+      file->bufend++;
+      file->unget_used = false;
+    }
+  }
+  file->buffered = true;
+}
+
+/* Move the unread part of the buffer to its beginning and append the next
+   block of <file>. Returns false if nothing could be added. */
+static bool file_fill_buffer(GtFile *file)
+{
+  size_t remaining;
+  int rval;
+  gt_assert(file && file->buffered);
+  if (file->mapped || file->eof)
+    return false;
+  remaining = file->bufend - file->bufptr;
+  if (remaining && file->bufptr != file->buffer)
+    memmove(file->buffer, file->bufptr, remaining);
+  if (remaining == file->buffer_size) {
+    file->buffer_size *= 2;
+    file->buffer = gt_realloc(file->buffer, file->buffer_size * sizeof (char));
+  }
+  if (file->read_ahead) {
+    rval = file_xread_decoded(file, file->buffer + remaining,
+                              file->buffer_size - remaining);
+  }
+  else {
+    rval = file_xread_unbuffered(file, file->buffer + remaining,
+                                 file->buffer_size - remaining);
+  }
+  file->bufptr = file->buffer;
+  file->bufend = file->buffer + remaining;
+  if (rval <= 0) {
+    file->eof = true;
+    return false;
+  }
+  file->bufend += rval;
+  return true;
+}
+
+bool gt_file_is_stream(const char *path)
+{
+  struct stat sb;
+  gt_assert(path);
+  if (strcmp(path, "-") == 0)
+    return true;
+  if (stat(path, &sb) != 0)
+    return false;
+#ifndef _WIN32
+  return S_ISFIFO(sb.st_mode) || S_ISCHR(sb.st_mode) || S_ISSOCK(sb.st_mode);
+#else
+  return S_ISCHR(sb.st_mode);
+#endif
+}
+
+int gt_file_peek(const char *path, void *buf, size_t nbytes, GtError *err)
+{
+  GtFile *file;
+  size_t available;
+  gt_error_check(err);
+  gt_assert(path && buf);
+  if (!(file = gt_file_new(path, "rb", err)))
+    return -1;
+  if (!gt_file_is_stream(path)) {
+    int rval = gt_file_xread(file, buf, nbytes);
+    gt_file_delete(file);
+    return rval;
+  }
+  /* keep the prefix in the read buffer and the stream open, so that the next
+     reader of <path> gets the whole stream */
+  if (!file->buffered)
+    file_init_buffer(file);
+  while ((size_t) (file->bufend - file->bufptr) < nbytes &&
+         file_fill_buffer(file))
+    /* Nothing */;
+  available = file->bufend - file->bufptr;
+  if (available > nbytes)
+    available = nbytes;
+  memcpy(buf, file->bufptr, available);
+  file_lock();
+  file_peeked = gt_realloc(file_peeked,
+                           (file_num_of_peeked + 1) * sizeof (*file_peeked));
+  file_peeked[file_num_of_peeked].path = gt_cstr_dup(path);
+  file_peeked[file_num_of_peeked++].file = file;
+  file_unlock();
+  return (int) available;
+}
+
+int gt_file_xread_line(GtFile *file, const char **line, GtUword *length)
+{
+  const char *newline;
+  size_t scanned = 0;
+  gt_assert(file && line && length);
+  if (!file->buffered)
+    file_init_buffer(file);
+  gt_assert(!file->unget_used);
+  for (;;) {
+    /* memchr() scans word- or vector-wise on all common platforms */
+    newline = memchr(file->bufptr + scanned, '\n',
+                     file->bufend - file->bufptr - scanned);
+    if (newline) {
+      *line = file->bufptr;
+      *length = newline + 1 - file->bufptr;
+      file->bufptr = newline + 1;
+      return 0;
+    }
+    scanned = file->bufend - file->bufptr;
+    if (!file_fill_buffer(file))
+      break;
+  }
+  if (file->bufptr == file->bufend)
+    return EOF;
+  /* last line without newline */
+  *line = file->bufptr;
+  *length = file->bufend - file->bufptr;
+  file->bufptr = file->bufend;
+  return 0;
+}
+
 int gt_file_xfgetc(GtFile *file)
 {
   int c = -1;
@@ -206,6 +605,13 @@ int gt_file_xfgetc(GtFile *file)
       c = file->unget_char;
       file->unget_used = false;
     }
+    else if (file->buffered || file->read_ahead) {
+      if (!file->buffered)
+        file_init_buffer(file);
+      if (file->bufptr == file->bufend && !file_fill_buffer(file))
+        return EOF;
+      c = (unsigned char) *file->bufptr++;
+    }
     else {
       switch (file->mode) {
         case GT_FILE_MODE_UNCOMPRESSED:
@@ -230,6 +636,12 @@ void gt_file_unget_char(GtFile *file, char c)
 {
   if (file) {
     gt_assert(!file->unget_used); /* only one char can be unget at a time */
+    if (file->buffered && file->bufptr > file->buffer &&
+        file->bufptr[-1] == c) {
+      /* the character was read from the buffer, just step back */
+      file->bufptr--;
+      return;
+    }
     file->unget_char = c;
     file->unget_used = true;
   }
@@ -237,6 +649,201 @@ void gt_file_unget_char(GtFile *file, char c)
     gt_xungetc(c, stdin);
 }
 
+typedef struct {
+  const char *data;
+  size_t length;
+  unsigned char *deflated;
+  size_t deflated_length;
+  int status;
+} FileDeflateBlock;
+
+typedef struct {
+  FileDeflateBlock *blocks;
+  GtUword num_of_blocks,
+          next_block;
+  GtMutex *mutex;
+} FileDeflateInfo;
+
+/* Compress <block> into a single gzip member. Returns the zlib status, which
+   is Z_STREAM_END on success. */
+static int file_deflate_block(FileDeflateBlock *block)
+{
+  z_stream strm;
+  size_t bound;
+  int rval;
+  gt_assert(block);
+  memset(&strm, 0, sizeof strm);
+  /* a window size of 15 + 16 produces a gzip member instead of zlib data */
+  rval = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                      Z_DEFAULT_STRATEGY);
+  if (rval != Z_OK)
+    return rval;
+  bound = deflateBound(&strm, block->length);
+  block->deflated = gt_malloc(bound * sizeof (unsigned char));
+  strm.next_in = (Bytef*) block->data;
+  strm.avail_in = block->length;
+  strm.next_out = block->deflated;
+  strm.avail_out = bound;
+  rval = deflate(&strm, Z_FINISH);
+  block->deflated_length = strm.total_out;
+  (void) deflateEnd(&strm);
+  return rval;
+}
+
+static void* file_deflate_blocks_func(void *data)
+{
+  FileDeflateInfo *info = data;
+  FileDeflateBlock *block;
+  gt_assert(info);
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    if (info->next_block == info->num_of_blocks) {
+      gt_mutex_unlock(info->mutex);
+      return NULL;
+    }
+    block = info->blocks + info->next_block++;
+    gt_mutex_unlock(info->mutex);
+    block->status = file_deflate_block(block);
+  }
+  return NULL;
+}
+
+/* Compress the blocks of <flushbuf> in parallel and write them in order as
+   concatenated gzip members, which gzip and zlib read as a single file. */
+static void file_write_deflated(GtFile *file)
+{
+  FileDeflateInfo info;
+  GtUword i;
+  gt_assert(file && file->deflate_blocks);
+  info.num_of_blocks = (file->flushbuf_length + GT_FILE_DEFLATE_BLOCK_SIZE - 1)
+                       / GT_FILE_DEFLATE_BLOCK_SIZE;
+  if (!info.num_of_blocks)
+    info.num_of_blocks = 1; /* an empty member for empty output */
+  info.blocks = gt_calloc(info.num_of_blocks, sizeof (FileDeflateBlock));
+  for (i = 0; i < info.num_of_blocks; i++) {
+    info.blocks[i].data = file->flushbuf + i * GT_FILE_DEFLATE_BLOCK_SIZE;
+    info.blocks[i].length = i + 1 < info.num_of_blocks
+                            ? GT_FILE_DEFLATE_BLOCK_SIZE
+                            : file->flushbuf_length
+                              - i * GT_FILE_DEFLATE_BLOCK_SIZE;
+  }
+  info.next_block = 0;
+  info.mutex = gt_mutex_new();
+  if (gt_multithread(file_deflate_blocks_func, &info, NULL))
+    file_deflate_blocks_func(&info); /* no threads available */
+  gt_mutex_delete(info.mutex);
+  for (i = 0; i < info.num_of_blocks; i++) {
+    if (info.blocks[i].status != Z_STREAM_END) {
+      fprintf(stderr, "cannot write to compressed file: %s\n",
+              zError(info.blocks[i].status));
+      exit(EXIT_FAILURE);
+    }
+    gt_xfwrite(info.blocks[i].deflated, 1, info.blocks[i].deflated_length,
+               file->fileptr.file);
+    gt_free(info.blocks[i].deflated);
+  }
+  gt_free(info.blocks);
+}
+
+static void* file_write_behind_func(void *data)
+{
+  GtFile *file = data;
+  gt_assert(file && file->write_behind);
+  if (file->deflate_blocks)
+    file_write_deflated(file);
+  else if (file->mode == GT_FILE_MODE_GZIP)
+    gt_xgzwrite(file->fileptr.gzfile, file->flushbuf, file->flushbuf_length);
+  else {
+    gt_assert(file->mode == GT_FILE_MODE_BZIP2);
+    gt_xbzwrite(file->fileptr.bzfile, file->flushbuf, file->flushbuf_length);
+  }
+  return NULL;
+}
+
+/* Wait for the write-behind thread to finish its buffer, if it is running. */
+static void file_join_write_behind(GtFile *file)
+{
+  gt_assert(file);
+#ifdef GT_THREADS_ENABLED
+  if (file->write_behind_thread) {
+    gt_thread_join(file->write_behind_thread);
+    gt_thread_delete(file->write_behind_thread);
+    file->write_behind_thread = NULL;
+  }
+#endif
+}
+
+/* Hand the filled output buffer of <file> over to the write-behind thread,
+   as soon as it is done with the previous one. */
+static void file_flush_write_behind(GtFile *file)
+{
+  char *tmp;
+  size_t tmp_size;
+  gt_assert(file && file->write_behind);
+  file_join_write_behind(file);
+  tmp = file->flushbuf;
+  tmp_size = file->flushbuf_size;
+  file->flushbuf = file->outbuf;
+  file->flushbuf_size = file->outbuf_size;
+  file->flushbuf_length = file->outbuf_length;
+  file->outbuf = tmp;
+  file->outbuf_size = tmp_size;
+  file->outbuf_length = 0;
+  file->written = true;
+#ifdef GT_THREADS_ENABLED
+  /* if no thread can be created, the buffer is written directly */
+  if ((file->write_behind_thread = gt_thread_new(file_write_behind_func, file,
+                                                 NULL))) {
+    return;
+  }
+#endif
+  file_write_behind_func(file);
+}
+
+/* Make room for <nbytes> in the output buffer of <file>. */
+static void file_reserve_output(GtFile *file, size_t nbytes)
+{
+  gt_assert(file && file->write_behind);
+  if (file->outbuf_length + nbytes > file->outbuf_size && file->outbuf_length)
+    file_flush_write_behind(file);
+  if (nbytes > file->outbuf_size) {
+    file->outbuf_size = GT_FILE_DEFLATE_BLOCK_SIZE * gt_jobs;
+    if (nbytes > file->outbuf_size)
+      file->outbuf_size = nbytes;
+    file->outbuf = gt_realloc(file->outbuf, file->outbuf_size * sizeof (char));
+  }
+}
+
+static void file_write_output(GtFile *file, const void *buf, size_t nbytes)
+{
+  file_reserve_output(file, nbytes);
+  memcpy(file->outbuf + file->outbuf_length, buf, nbytes);
+  file->outbuf_length += nbytes;
+}
+
+static int vbufprintf(GtFile *file, const char *format, va_list va,
+                      int buflen)
+{
+  int len;
+  if (!buflen) {
+    /* no buffer length given -> try the remaining output buffer */
+    file_reserve_output(file, BUFSIZ);
+    len = gt_xvsnprintf(file->outbuf + file->outbuf_length,
+                        file->outbuf_size - file->outbuf_length, format, va);
+    if ((size_t) len >= file->outbuf_size - file->outbuf_length)
+      return len; /* unsuccessful trial -> return buffer length for next call */
+  }
+  else {
+    /* buffer length given -> make enough room for it */
+    file_reserve_output(file, buflen + 1);
+    len = gt_xvsnprintf(file->outbuf + file->outbuf_length, buflen + 1, format,
+                        va);
+    gt_assert(len == buflen);
+  }
+  file->outbuf_length += len;
+  return 0; /* success */
+}
+
 static int vgzprintf(gzFile file, const char *format, va_list va, int buflen)
 {
   int len;
@@ -290,6 +897,8 @@ static int xvprintf(GtFile *file, const char *format, va_list va, int buflen)
 
   if (!file) /* implies stdout */
     gt_xvfprintf(stdout, format, va);
+  else if (file->write_behind)
+    rval = vbufprintf(file, format, va, buflen);
   else {
     switch (file->mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
@@ -329,6 +938,11 @@ void gt_file_xfputc(int c, GtFile *file)
 {
   if (!file)
     return gt_xfputc(c, stdout);
+  if (file->write_behind) {
+    char cc = c;
+    file_write_output(file, &cc, 1);
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       gt_xfputc(c, file->fileptr.file);
@@ -347,6 +961,10 @@ void gt_file_xfputs(const char *cstr, GtFile *file)
 {
   if (!file)
     return gt_xfputs(cstr, stdout);
+  if (file->write_behind) {
+    file_write_output(file, cstr, strlen(cstr));
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       gt_xfputs(cstr, file->fileptr.file);
@@ -365,18 +983,24 @@ int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
 {
   int rval = -1;
   if (file) {
-    switch (file->mode) {
-      case GT_FILE_MODE_UNCOMPRESSED:
-        rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
-        break;
-      case GT_FILE_MODE_GZIP:
-        rval = gt_xgzread(file->fileptr.gzfile, buf, nbytes);
-        break;
-      case GT_FILE_MODE_BZIP2:
-        rval = gt_xbzread(file->fileptr.bzfile, buf, nbytes);
-        break;
-      default: gt_assert(0);
+    if (file->read_ahead && !file->buffered)
+      file_init_buffer(file);
+    if (file->buffered) {
+      size_t copied = 0, available;
+      while (copied < nbytes) {
+        if (file->bufptr == file->bufend && !file_fill_buffer(file))
+          break;
+        available = file->bufend - file->bufptr;
+        if (available > nbytes - copied)
+          available = nbytes - copied;
+        memcpy((char*) buf + copied, file->bufptr, available);
+        file->bufptr += available;
+        copied += available;
+      }
+      rval = copied;
     }
+    else
+      rval = file_xread_unbuffered(file, buf, nbytes);
   }
   else
     rval = gt_xfread(buf, 1, nbytes, stdin);
@@ -389,6 +1013,10 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
     gt_xfwrite(buf, 1, nbytes, stdout);
     return;
   }
+  if (file->write_behind) {
+    file_write_output(file, buf, nbytes);
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       gt_xfwrite(buf, 1, nbytes, file->fileptr.file);
@@ -406,6 +1034,17 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 void gt_file_xrewind(GtFile *file)
 {
   gt_assert(file);
+  if (file->mapped) {
+    file->bufptr = file->buffer;
+    return;
+  }
+  if (file->buffered) {
+    file->bufptr = file->bufend = file->buffer;
+    file->eof = false;
+  }
+  file_join_read_ahead(file);
+  file->decoded_length = file->pending_length = 0;
+  file->decoded_pos = 0;
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       rewind(file->fileptr.file);
@@ -423,6 +1062,16 @@ void gt_file_xrewind(GtFile *file)
 void gt_file_delete_without_handle(GtFile *file)
 {
   if (!file) return;
+  file_join_read_ahead(file);
+  file_join_write_behind(file);
+  if (file->mapped)
+    gt_fa_xmunmap(file->buffer);
+  else
+    gt_free(file->buffer);
+  gt_free(file->decoded);
+  gt_free(file->pending);
+  gt_free(file->outbuf);
+  gt_free(file->flushbuf);
   gt_free(file->orig_path);
   gt_free(file->orig_mode);
   gt_free(file);
@@ -435,13 +1084,22 @@ void gt_file_delete(GtFile *file)
     file->reference_count--;
     return;
   }
+  file_join_read_ahead(file);
+  if (file->write_behind) {
+    if (file->outbuf_length || (file->deflate_blocks && !file->written))
+      file_flush_write_behind(file);
+    file_join_write_behind(file);
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
         if (!file->is_stdin)
           gt_fa_fclose(file->fileptr.file);
       break;
     case GT_FILE_MODE_GZIP:
-        gt_fa_gzclose(file->fileptr.gzfile);
+        if (file->deflate_blocks)
+          gt_fa_fclose(file->fileptr.file);
+        else
+          gt_fa_gzclose(file->fileptr.gzfile);
       break;
     case GT_FILE_MODE_BZIP2:
         gt_fa_bzclose(file->fileptr.bzfile);
@@ -20,6 +20,7 @@
 
 #include <stdlib.h>
 #include "core/file_api.h"
+#include "core/types_api.h"
 
 typedef enum {
   GT_FILE_MODE_UNCOMPRESSED,
@@ -41,7 +42,8 @@ const char* gt_file_mode_suffix(GtFileMode mode);
 size_t      gt_file_basename_length(const char *path);
 
 /* Create a new GtFile object and open the underlying file handle, returns
-   NULL and sets <err> if the file <path> could not be opened. */
+   NULL and sets <err> if the file <path> could not be opened. A <path> of "-"
+   opened for reading denotes standard input. */
 GtFile*     gt_file_open(GtFileMode, const char *path, const char *mode,
                          GtError*);
 
@@ -56,6 +58,24 @@ GtFile*     gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
    automatically via gt_file_mode_determine(path). */
 GtFile*     gt_file_xopen(const char *path, const char *mode);
 
+/* Initializes the registry of streams peeked at by gt_file_peek(). */
+void        gt_file_init(void);
+
+/* Closes the streams peeked at but not opened again and frees the registry. */
+void        gt_file_clean(void);
+
+/* Returns true if <path> is "-" (standard input), a pipe, a socket or a
+   character device, that is, a file which can be read only once. */
+bool        gt_file_is_stream(const char *path);
+
+/* Reads up to <nbytes> from the beginning of the file <path> into <buf> and
+   returns their number, or -1 and sets <err> on error. If <path> is a stream
+   (see gt_file_is_stream()), the bytes are not consumed: the stream stays
+   open and the next gt_file_open() of <path> for reading continues it from
+   its beginning. */
+int         gt_file_peek(const char *path, void *buf, size_t nbytes,
+                         GtError *err);
+
 /* Returns the mode of the given <file>. */
 GtFileMode  gt_file_mode(const GtFile *file);
 
@@ -63,4 +83,14 @@ GtFileMode  gt_file_mode(const GtFile *file);
    Can only be used once at a time. */
 void        gt_file_unget_char(GtFile *file, char c);
 
+/* Reads the next line from <file> (which cannot be <NULL>). Sets <line> to its
+   first character and <length> to its length, including the terminating '\n'
+   (which is missing if the last line of the file is unterminated). The line is
+   not '\0'-terminated and stays valid until the next read operation on <file>.
+   Uncompressed regular files are memory mapped, so <line> points directly into
+   the file, other files are read through a block buffer.
+   Returns EOF if no line is left, 0 otherwise. */
+int         gt_file_xread_line(GtFile *file, const char **line,
+                               GtUword *length);
+
 #endif
@@ -28,6 +28,7 @@
 #include "core/cstr_api.h"
 #include "core/cstr_array.h"
 #include "core/fa.h"
+#include "core/file.h"
 #include "core/init_api.h"
 #include "core/log.h"
 #include "core/ma.h"
@@ -35,6 +36,7 @@
 #include "core/showtime.h"
 #include "core/spacepeak.h"
 #include "core/splitter.h"
+#include "core/str.h"
 #include "core/symbol.h"
 #include "core/versionfunc.h"
 #include "core/warning_api.h"
@@ -114,6 +116,8 @@ void gt_lib_init(void)
   gt_log_init();
   if (showtime) gt_showtime_enable();
   gt_symbol_init();
+  gt_str_init();
+  gt_file_init();
   gt_class_alloc_lock_init();
   gt_ya_rand_init(0);
 #ifdef HAVE_MYSQL
@@ -141,10 +145,12 @@ int gt_lib_clean(void)
     gt_spacepeak_show_space_peak(stdout);
     gt_ma_disable_global_spacepeak();
   }
+  gt_file_clean();
   fa_fptr_rval = gt_fa_check_fptr_leak();
   fa_mmap_rval = gt_fa_check_mmap_leak();
   gt_fa_clean();
   gt_symbol_clean();
+  gt_str_clean();
   gt_class_alloc_clean();
   gt_class_alloc_lock_clean();
   gt_ya_rand_clean();
@@ -0,0 +1,400 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array.h"
+#include "core/atomic.h"
+#include "core/ensure.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/unused_api.h"
+
+/* The tree layout follows the implicit interval tree of H. Li's cgranges
+   library: in a sorted array of size n, the node at index i has level k if
+   the k lowest bits of i are set and bit k is not. Its children are
+   i - 2^(k-1) and i + 2^(k-1), and the root is at 2^K - 1 for the maximal
+   level K. Each node stores the maximal end position in its subtree. */
+
+/* subtrees up to this level are scanned linearly */
+#define INTERVAL_INDEX_SCAN_LEVEL  3
+
+struct GtIntervalIndex {
+  GtArray *entries; /* NULL for static indexes */
+  const GtIntervalIndexEntry *static_entries;
+  GtUword nof_static_entries;
+  GtFree free_func;
+  GtMutex *build_lock;
+  int max_level; /* -1 if the index is empty */
+  volatile bool built;
+};
+
+typedef struct {
+  int level;
+  GtUword idx;
+  bool left_done;
+} GtIntervalIndexStackElem;
+
+GtIntervalIndex* gt_interval_index_new(GtFree free_func)
+{
+  GtIntervalIndex *ii = gt_malloc(sizeof *ii);
+  ii->entries = gt_array_new(sizeof (GtIntervalIndexEntry));
+  ii->static_entries = NULL;
+  ii->nof_static_entries = 0;
+  ii->free_func = free_func;
+  ii->build_lock = gt_mutex_new();
+  ii->max_level = -1;
+  ii->built = true;
+  return ii;
+}
+
+GtIntervalIndex* gt_interval_index_new_static(const GtIntervalIndexEntry
+                                                                       *entries,
+                                              GtUword nof_entries)
+{
+  GtIntervalIndex *ii = gt_malloc(sizeof *ii);
+  gt_assert(entries || !nof_entries);
+  ii->entries = NULL;
+  ii->static_entries = entries;
+  ii->nof_static_entries = nof_entries;
+  ii->free_func = NULL;
+  ii->build_lock = gt_mutex_new();
+  /* the root is at the highest level which fits into the array */
+  ii->max_level = -1;
+  while (nof_entries) {
+    ii->max_level++;
+    nof_entries >>= 1;
+  }
+  ii->built = true;
+  return ii;
+}
+
+static const GtIntervalIndexEntry* interval_index_get_space(const
+                                                            GtIntervalIndex *ii,
+                                                            GtUword *n)
+{
+  if (!ii->entries) {
+    *n = ii->nof_static_entries;
+    return ii->static_entries;
+  }
+  *n = gt_array_size(ii->entries);
+  return gt_array_get_space(ii->entries);
+}
+
+void gt_interval_index_add(GtIntervalIndex *ii, void *data, GtUword start,
+                           GtUword end)
+{
+  GtIntervalIndexEntry entry;
+  gt_assert(ii && ii->entries && start <= end);
+  entry.start = start;
+  entry.end = entry.max = end;
+  entry.data = data;
+  gt_array_add(ii->entries, entry);
+  ii->built = false;
+}
+
+bool gt_interval_index_remove(GtIntervalIndex *ii, void *data, GtUword start,
+                              GtUword end)
+{
+  GtIntervalIndexEntry *entries;
+  GtUword i, size;
+  gt_assert(ii && ii->entries);
+  entries = gt_array_get_space(ii->entries);
+  size = gt_array_size(ii->entries);
+  for (i = 0; i < size; i++) {
+    if (entries[i].data == data && entries[i].start == start &&
+        entries[i].end == end) {
+      if (ii->free_func)
+        ii->free_func(data);
+      gt_array_rem(ii->entries, i);
+      ii->built = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+static int interval_index_entry_cmp(const void *a, const void *b)
+{
+  const GtIntervalIndexEntry *ea = a, *eb = b;
+  if (ea->start != eb->start)
+    return ea->start < eb->start ? -1 : 1;
+  if (ea->end != eb->end)
+    return ea->end < eb->end ? -1 : 1;
+  return 0;
+}
+
+/* Returns <true> if <ii> is built, such that it can be queried. */
+static bool interval_index_is_built(GtIntervalIndex *ii)
+{
+  bool built;
+#ifdef GT_ATOMIC_ENABLED
+  if ((built = ii->built)) {
+    /* make the tree written before <built> was set visible */
+    gt_atomic_barrier();
+  }
+#else
+  gt_mutex_lock(ii->build_lock);
+  built = ii->built;
+  gt_mutex_unlock(ii->build_lock);
+#endif
+  return built;
+}
+
+static void interval_index_build(GtIntervalIndex *ii)
+{
+  GtIntervalIndexEntry *a;
+  GtUword i, n, last_i = 0, last = 0;
+  int k;
+  gt_array_sort_stable(ii->entries, interval_index_entry_cmp);
+  a = gt_array_get_space(ii->entries);
+  n = gt_array_size(ii->entries);
+  if (n == 0) {
+    ii->max_level = -1;
+    return;
+  }
+  /* leaves */
+  for (i = 0; i < n; i += 2) {
+    last_i = i;
+    a[i].max = last = a[i].end;
+  }
+  /* inner nodes, level by level; <last> is the maximum of the rightmost node
+     of the previous level, which stands in for missing right children */
+  for (k = 1; (1UL << k) <= n; k++) {
+    GtUword x = 1UL << (k - 1), i0 = (x << 1) - 1, step = x << 2;
+    for (i = i0; i < n; i += step) {
+      GtUword el = a[i - x].max,
+              er = i + x < n ? a[i + x].max : last;
+      a[i].max = MAX(a[i].end, MAX(el, er));
+    }
+    last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+    if (last_i < n && a[last_i].max > last)
+      last = a[last_i].max;
+  }
+  ii->max_level = k - 1;
+}
+
+void gt_interval_index_build(GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  if (interval_index_is_built(ii))
+    return;
+  /* concurrent queries may trigger the build at the same time */
+  gt_mutex_lock(ii->build_lock);
+  if (!ii->built) {
+    interval_index_build(ii);
+#ifdef GT_ATOMIC_ENABLED
+    gt_atomic_barrier();
+#endif
+    ii->built = true;
+  }
+  gt_mutex_unlock(ii->build_lock);
+}
+
+bool gt_interval_index_is_built(const GtIntervalIndex *ii)
+{
+  gt_assert(ii);
+  return ii->built;
+}
+
+const GtIntervalIndexEntry* gt_interval_index_get_entries(GtIntervalIndex *ii,
+                                                          GtUword *nof_entries)
+{
+  gt_assert(ii && nof_entries);
+  gt_interval_index_build(ii);
+  return interval_index_get_space(ii, nof_entries);
+}
+
+GtUword gt_interval_index_size(const GtIntervalIndex *ii)
+{
+  GtUword n;
+  gt_assert(ii);
+  (void) interval_index_get_space(ii, &n);
+  return n;
+}
+
+void gt_interval_index_find_all_overlapping(GtIntervalIndex *ii,
+                                            GtUword start, GtUword end,
+                                            GtArray *results)
+{
+  /* at most two elements per tree level are on the stack */
+  GtIntervalIndexStackElem stack[2 * 64 + 2];
+  const GtIntervalIndexEntry *a;
+  GtUword n;
+  int t = 0;
+  gt_assert(ii && start <= end && results);
+  gt_interval_index_build(ii);
+  if (ii->max_level < 0)
+    return;
+  a = interval_index_get_space(ii, &n);
+  stack[t].level = ii->max_level;
+  stack[t].idx = (1UL << ii->max_level) - 1;
+  stack[t++].left_done = false;
+  while (t > 0) {
+    GtIntervalIndexStackElem z = stack[--t];
+    if (z.level <= INTERVAL_INDEX_SCAN_LEVEL) {
+      /* small subtree, scan it in order */
+      GtUword i, i0 = z.idx >> z.level << z.level,
+              i1 = MIN(i0 + (1UL << (z.level + 1)) - 1, n);
+      for (i = i0; i < i1 && a[i].start <= end; i++) {
+        if (start <= a[i].end)
+          gt_array_add_elem(results, (void*) &a[i].data, sizeof (void*));
+      }
+    }
+    else if (!z.left_done) {
+      /* process the left subtree first, then come back to this node */
+      GtUword y = z.idx - (1UL << (z.level - 1));
+      stack[t] = z;
+      stack[t++].left_done = true;
+      if (y >= n || a[y].max >= start) {
+        stack[t].level = z.level - 1;
+        stack[t].idx = y;
+        stack[t++].left_done = false;
+      }
+    }
+    else if (z.idx < n && a[z.idx].start <= end) {
+      if (start <= a[z.idx].end)
+        gt_array_add_elem(results, (void*) &a[z.idx].data, sizeof (void*));
+      stack[t].level = z.level - 1;
+      stack[t].idx = z.idx + (1UL << (z.level - 1));
+      stack[t++].left_done = false;
+    }
+  }
+}
+
+int gt_interval_index_traverse(GtIntervalIndex *ii,
+                               GtIntervalIndexIteratorFunc func, void *info)
+{
+  const GtIntervalIndexEntry *a;
+  GtUword i, n;
+  int had_err = 0;
+  gt_assert(ii && func);
+  gt_interval_index_build(ii);
+  a = interval_index_get_space(ii, &n);
+  for (i = 0; !had_err && i < n; i++)
+    had_err = func(a[i].data, a[i].start, a[i].end, info);
+  return had_err;
+}
+
+void gt_interval_index_delete(GtIntervalIndex *ii)
+{
+  if (!ii) return;
+  if (ii->free_func) {
+    GtIntervalIndexEntry *a = gt_array_get_space(ii->entries);
+    GtUword i, n = gt_array_size(ii->entries);
+    for (i = 0; i < n; i++)
+      ii->free_func(a[i].data);
+  }
+  gt_array_delete(ii->entries);
+  gt_mutex_delete(ii->build_lock);
+  gt_free(ii);
+}
+
+#define INTERVAL_INDEX_TEST_SIZE   3000
+#define INTERVAL_INDEX_TEST_MAXPOS 100000
+#define INTERVAL_INDEX_TEST_MAXLEN 1000
+
+int gt_interval_index_unit_test(GtError *err)
+{
+  GtIntervalIndex *ii;
+  GtArray *results;
+  GtUword i, j, starts[INTERVAL_INDEX_TEST_SIZE],
+          ends[INTERVAL_INDEX_TEST_SIZE];
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* empty index */
+  ii = gt_interval_index_new(NULL);
+  results = gt_array_new(sizeof (void*));
+  gt_interval_index_find_all_overlapping(ii, 0, 10, results);
+  gt_ensure(gt_array_size(results) == 0);
+  gt_ensure(gt_interval_index_size(ii) == 0);
+
+  /* compare against a linear scan for random intervals and queries */
+  for (i = 0; i < INTERVAL_INDEX_TEST_SIZE; i++) {
+    starts[i] = gt_rand_max(INTERVAL_INDEX_TEST_MAXPOS);
+    ends[i] = starts[i] + gt_rand_max(INTERVAL_INDEX_TEST_MAXLEN);
+    gt_interval_index_add(ii, (void*) (starts + i), starts[i], ends[i]);
+  }
+  gt_ensure(!gt_interval_index_is_built(ii));
+  gt_interval_index_build(ii);
+  gt_ensure(gt_interval_index_is_built(ii));
+  gt_ensure(gt_interval_index_size(ii) == INTERVAL_INDEX_TEST_SIZE);
+  for (j = 0; !had_err && j < 1000; j++) {
+    GtUword qstart = gt_rand_max(INTERVAL_INDEX_TEST_MAXPOS),
+            qend = qstart + gt_rand_max(2 * INTERVAL_INDEX_TEST_MAXLEN),
+            nof_overlapping = 0, prev_start = 0;
+    gt_array_reset(results);
+    gt_interval_index_find_all_overlapping(ii, qstart, qend, results);
+    for (i = 0; i < INTERVAL_INDEX_TEST_SIZE; i++) {
+      if (starts[i] <= qend && qstart <= ends[i])
+        nof_overlapping++;
+    }
+    gt_ensure(gt_array_size(results) == nof_overlapping);
+    for (i = 0; !had_err && i < gt_array_size(results); i++) {
+      GtUword *s = *(GtUword**) gt_array_get(results, i);
+      GtUword idx = s - starts;
+      gt_ensure(starts[idx] <= qend && qstart <= ends[idx]);
+      gt_ensure(prev_start <= starts[idx]);
+      prev_start = starts[idx];
+    }
+  }
+
+  /* a static index on the built entries gives the same results */
+  if (!had_err) {
+    const GtIntervalIndexEntry *entries;
+    GtIntervalIndex *static_ii;
+    GtArray *static_results = gt_array_new(sizeof (void*));
+    GtUword nof_entries;
+    entries = gt_interval_index_get_entries(ii, &nof_entries);
+    gt_ensure(nof_entries == INTERVAL_INDEX_TEST_SIZE);
+    static_ii = gt_interval_index_new_static(entries, nof_entries);
+    for (j = 0; !had_err && j < 100; j++) {
+      GtUword qstart = gt_rand_max(INTERVAL_INDEX_TEST_MAXPOS),
+              qend = qstart + gt_rand_max(2 * INTERVAL_INDEX_TEST_MAXLEN);
+      gt_array_reset(results);
+      gt_array_reset(static_results);
+      gt_interval_index_find_all_overlapping(ii, qstart, qend, results);
+      gt_interval_index_find_all_overlapping(static_ii, qstart, qend,
+                                             static_results);
+      gt_ensure(gt_array_size(results) == gt_array_size(static_results));
+      gt_ensure(!memcmp(gt_array_get_space(results),
+                        gt_array_get_space(static_results),
+                        gt_array_size(results) * sizeof (void*)));
+    }
+    gt_interval_index_delete(static_ii);
+    gt_array_delete(static_results);
+  }
+
+  /* removing an interval invalidates the tree */
+  if (!had_err) {
+    gt_ensure(gt_interval_index_remove(ii, (void*) starts, starts[0],
+                                       ends[0]));
+    gt_ensure(!gt_interval_index_remove(ii, (void*) starts, starts[0],
+                                        ends[0]));
+    gt_ensure(!gt_interval_index_is_built(ii));
+    gt_array_reset(results);
+    gt_interval_index_find_all_overlapping(ii, starts[0], ends[0], results);
+    for (i = 0; !had_err && i < gt_array_size(results); i++)
+      gt_ensure(*(GtUword**) gt_array_get(results, i) != starts);
+  }
+
+  gt_array_delete(results);
+  gt_interval_index_delete(ii);
+  return had_err;
+}
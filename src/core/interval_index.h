@@ -0,0 +1,97 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef INTERVAL_INDEX_H
+#define INTERVAL_INDEX_H
+
+#include "core/array_api.h"
+#include "core/error_api.h"
+#include "core/fptr_api.h"
+
+/* A <GtIntervalIndex> stores intervals (with attached data pointers) in a
+   single array sorted by start position. An implicit augmented binary tree
+   over this array (the in-order position of a tree node is its array index)
+   answers overlap queries without any pointer chasing. The index is meant to
+   be filled in bulk and queried afterwards: it is built by
+   <gt_interval_index_build()>, and modifying it invalidates the tree, which is
+   then rebuilt on the next query. Queries are thread-safe, modifications
+   require exclusive access. */
+typedef struct GtIntervalIndex GtIntervalIndex;
+
+/* An interval stored in a <GtIntervalIndex>, exposed such that a built index
+   can be written to a file and queried in place later on (see
+   <gt_interval_index_new_static()>). */
+typedef struct {
+  GtUword start,
+          end,
+          max; /* maximal end in the subtree rooted at this entry */
+  void *data;
+} GtIntervalIndexEntry;
+
+typedef int (*GtIntervalIndexIteratorFunc)(void *data, GtUword start,
+                                           GtUword end, void *info);
+
+/* Return a new <GtIntervalIndex>. If <free_func> is given, it is applied to
+   the data pointers of all intervals when they are removed or the index is
+   deleted. */
+GtIntervalIndex* gt_interval_index_new(GtFree free_func);
+/* Return a new <GtIntervalIndex> which queries the <nof_entries> <entries>
+   of a built index (as returned by <gt_interval_index_get_entries()>) in
+   place. The <entries> are not copied and must stay valid during the lifetime
+   of the index, which cannot be modified. */
+GtIntervalIndex* gt_interval_index_new_static(const GtIntervalIndexEntry
+                                                                       *entries,
+                                              GtUword nof_entries);
+/* Add the interval from <start> to <end> (inclusive) with <data> to
+   <interval_index>. */
+void             gt_interval_index_add(GtIntervalIndex *interval_index,
+                                       void *data, GtUword start, GtUword end);
+/* Remove the interval from <start> to <end> with <data> from
+   <interval_index>, if it is contained. Returns <true> if it was removed. */
+bool             gt_interval_index_remove(GtIntervalIndex *interval_index,
+                                          void *data, GtUword start,
+                                          GtUword end);
+/* Sort the intervals of <interval_index> and build the search tree. Does
+   nothing if the index has not been modified since the last build. */
+void             gt_interval_index_build(GtIntervalIndex *interval_index);
+/* Return <true> if <interval_index> has been built and not been modified
+   since. */
+bool             gt_interval_index_is_built(const GtIntervalIndex
+                                                               *interval_index);
+/* Build <interval_index> and return its entries, the number of which is
+   stored in <nof_entries>. */
+const GtIntervalIndexEntry* gt_interval_index_get_entries(GtIntervalIndex
+                                                                *interval_index,
+                                                          GtUword *nof_entries);
+/* Return the number of intervals in <interval_index>. */
+GtUword          gt_interval_index_size(const GtIntervalIndex *interval_index);
+/* Append the data pointers of all intervals in <interval_index> which overlap
+   the range from <start> to <end> to <results>, sorted by start (and end)
+   position. */
+void             gt_interval_index_find_all_overlapping(GtIntervalIndex
+                                                                *interval_index,
+                                                        GtUword start,
+                                                        GtUword end,
+                                                        GtArray *results);
+/* Call <func> for all intervals in <interval_index>, sorted by start
+   position. Stops and returns the return value of <func> if it is not 0. */
+int              gt_interval_index_traverse(GtIntervalIndex *interval_index,
+                                            GtIntervalIndexIteratorFunc func,
+                                            void *info);
+void             gt_interval_index_delete(GtIntervalIndex *interval_index);
+int              gt_interval_index_unit_test(GtError *err);
+
+#endif
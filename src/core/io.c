@@ -16,6 +16,7 @@
 */
 
 #include <string.h>
+#include "core/file.h"
 #include "core/io.h"
 #include "core/ma.h"
 
@@ -23,7 +24,11 @@ struct GtIO {
   GtFile *fp;
   GtStr *path;
   GtUword line_number;
-  bool line_start;
+  const char *lineptr, /* characters are read line-wise from <fp> */
+             *lineend;
+  char unget_char;
+  bool line_start,
+       unget_used;
 };
 
 GtIO* gt_io_new(const char *path, const char *mode)
@@ -36,7 +41,9 @@ GtIO* gt_io_new(const char *path, const char *mode)
   io->fp = gt_file_xopen(path, mode);
   io->path = path ? gt_str_new_cstr(path) : gt_str_new_cstr("stdin");
   io->line_number = 1;
+  io->lineptr = io->lineend = NULL;
   io->line_start = true;
+  io->unget_used = false;
   return io;
 }
 
@@ -48,11 +55,27 @@ void gt_io_delete(GtIO *io)
   gt_free(io);
 }
 
+static bool io_read_line(GtIO *io)
+{
+  GtUword length;
+  if (gt_file_xread_line(io->fp, &io->lineptr, &length) == EOF)
+    return false;
+  io->lineend = io->lineptr + length;
+  return true;
+}
+
 int gt_io_get_char(GtIO *io, char *c)
 {
   int cc;
   gt_assert(io && c);
-  cc = gt_file_xfgetc(io->fp);
+  if (io->unget_used) {
+    cc = io->unget_char;
+    io->unget_used = false;
+  }
+  else if (io->lineptr < io->lineend || io_read_line(io))
+    cc = (unsigned char) *io->lineptr++;
+  else
+    cc = EOF;
   if (cc == '\n') {
     io->line_number++;
     io->line_start = true;
@@ -68,7 +91,9 @@ int gt_io_get_char(GtIO *io, char *c)
 void gt_io_unget_char(GtIO *io, char c)
 {
   gt_assert(io);
-  gt_file_unget_char(io->fp, c);
+  gt_assert(!io->unget_used); /* only one char can be unget at a time */
+  io->unget_char = c;
+  io->unget_used = true;
 }
 
 bool gt_io_line_start(const GtIO *io)
@@ -18,7 +18,9 @@
 #include <errno.h>
 #include <string.h>
 #include "core/array_api.h"
+#include "core/atomic.h"
 #include "core/compat.h"
+#include "core/ensure.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
 #include "core/multithread_api.h"
@@ -28,24 +30,53 @@
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
-/* the memory allocator class */
+/* The bookkeeping information is distributed over <MA_NUM_OF_STRIPES>
+   stripes, selected by the address of an allocation. Each stripe has its own
+   lock, such that threads allocating in parallel rarely wait for each other.
+   The allocation sizes are accounted with atomic operations (if available),
+   which keeps the space peak exact without a global lock. */
+#define MA_NUM_OF_STRIPES_LOG  6
+#define MA_NUM_OF_STRIPES      (1U << MA_NUM_OF_STRIPES_LOG)
+/* the number of bookkeeping records allocated at once */
+#define MA_INFO_BLOCK_SIZE     1024
+
+typedef struct MAInfo MAInfo;
+
+struct MAInfo {
+  size_t size;
+  const char *src_file;
+  int src_line;
+  MAInfo *next_free;
+};
+
+typedef struct MAInfoBlock MAInfoBlock;
+
+struct MAInfoBlock {
+  MAInfo infos[MA_INFO_BLOCK_SIZE];
+  MAInfoBlock *next;
+};
+
 typedef struct {
   GtHashmap *allocated_pointer;
+  GtMutex *lock;
+  GtUint64 mallocevents;
+  MAInfo *free_infos; /* cache of unused bookkeeping records */
+  MAInfoBlock *info_blocks;
+} MAStripe;
+
+/* the memory allocator class */
+typedef struct {
+  MAStripe stripes[MA_NUM_OF_STRIPES];
   bool bookkeeping,
        global_space_peak;
-  GtUint64 mallocevents;
   GtUword current_size,
                 max_size;
+#ifndef GT_ATOMIC_ENABLED
+  GtMutex *size_lock;
+#endif
 } MA;
 
 static MA *ma = NULL;
-static GtMutex *bookkeeping_lock = NULL;
-
-typedef struct {
-  size_t size;
-  const char *src_file;
-  int src_line;
-} MAInfo;
 
 typedef struct {
   bool has_leak;
@@ -96,138 +127,186 @@ static void* xrealloc(void *ptr, size_t size, GtUword current_size,
   return p;
 }
 
-static void ma_info_free(MAInfo *mainfo)
-{
-  free(mainfo);
-}
-
 void gt_ma_init(bool bookkeeping)
 {
+  unsigned int i;
   gt_assert(!ma);
   ma = xcalloc(1, sizeof (MA), 0, __FILE__, __LINE__);
   gt_assert(!ma->bookkeeping);
-  ma->allocated_pointer = gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL,
-                                               (GtFree) ma_info_free);
+  for (i = 0; i < MA_NUM_OF_STRIPES; i++) {
+    ma->stripes[i].allocated_pointer = gt_hashmap_new_no_ma(GT_HASH_DIRECT,
+                                                            NULL, NULL);
+    ma->stripes[i].lock = gt_mutex_new();
+  }
+#ifndef GT_ATOMIC_ENABLED
+  ma->size_lock = gt_mutex_new();
+#endif
   /* MA is ready to use */
   ma->bookkeeping = bookkeeping;
-  bookkeeping_lock = gt_mutex_new();
   ma->global_space_peak = false;
 }
 
+static MAStripe* get_stripe(MA *ma, const void *ptr)
+{
+  GtUint64 hash = (GtUint64) (size_t) ptr >> 4;
+  gt_assert(ma);
+  hash *= 0x9e3779b97f4a7c15ULL; /* mix the address bits */
+  return ma->stripes + (hash >> (64 - MA_NUM_OF_STRIPES_LOG));
+}
+
+/* the lock of <stripe> must be held */
+static MAInfo* stripe_info_new(MAStripe *stripe, size_t size,
+                               const char *src_file, int src_line)
+{
+  MAInfo *mainfo;
+  if (!stripe->free_infos) {
+    MAInfoBlock *block;
+    unsigned int i;
+    block = xmalloc(sizeof *block, ma->current_size, src_file, src_line);
+    for (i = 0; i < MA_INFO_BLOCK_SIZE - 1; i++)
+      block->infos[i].next_free = block->infos + i + 1;
+    block->infos[MA_INFO_BLOCK_SIZE - 1].next_free = NULL;
+    block->next = stripe->info_blocks;
+    stripe->info_blocks = block;
+    stripe->free_infos = block->infos;
+  }
+  mainfo = stripe->free_infos;
+  stripe->free_infos = mainfo->next_free;
+  mainfo->size = size;
+  mainfo->src_file = src_file;
+  mainfo->src_line = src_line;
+  return mainfo;
+}
+
+/* the lock of <stripe> must be held */
+static void stripe_info_delete(MAStripe *stripe, MAInfo *mainfo)
+{
+  mainfo->next_free = stripe->free_infos;
+  stripe->free_infos = mainfo;
+}
+
 static void add_size(MA* ma, GtUword size)
 {
+  GtUword current_size;
+#ifdef GT_ATOMIC_ENABLED
+  GtUword max_size;
+#endif
   gt_assert(ma);
-  ma->current_size += size;
+#ifdef GT_ATOMIC_ENABLED
+  current_size = gt_atomic_add(&ma->current_size, size);
+  while ((max_size = ma->max_size) < current_size &&
+         !gt_atomic_cas(&ma->max_size, max_size, current_size));
+#else
+  gt_mutex_lock(ma->size_lock);
+  current_size = ma->current_size += size;
+  if (current_size > ma->max_size)
+    ma->max_size = current_size;
+  gt_mutex_unlock(ma->size_lock);
+#endif
   if (ma->global_space_peak)
     gt_spacepeak_add(size);
-  if (ma->current_size > ma->max_size)
-    ma->max_size = ma->current_size;
 }
 
 static void subtract_size(MA *ma, GtUword size)
 {
   gt_assert(ma);
   gt_assert(ma->current_size >= size);
+#ifdef GT_ATOMIC_ENABLED
+  (void) gt_atomic_sub(&ma->current_size, size);
+#else
+  gt_mutex_lock(ma->size_lock);
   ma->current_size -= size;
+  gt_mutex_unlock(ma->size_lock);
+#endif
   if (ma->global_space_peak)
     gt_spacepeak_free(size);
 }
 
-void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
+/* register the allocation <mem> of <size> bytes */
+static void add_allocation(MA *ma, void *mem, size_t size, const char *src_file,
+                           int src_line)
+{
+  MAStripe *stripe = get_stripe(ma, mem);
+  gt_mutex_lock(stripe->lock);
+  stripe->mallocevents++;
+  gt_hashmap_add(stripe->allocated_pointer, mem,
+                 stripe_info_new(stripe, size, src_file, src_line));
+  gt_mutex_unlock(stripe->lock);
+  add_size(ma, size);
+}
+
+/* unregister the allocation <ptr>, free it if <free_ptr> is set */
+static void remove_allocation(MA *ma, void *ptr, bool free_ptr,
+                              GT_UNUSED const char *src_file,
+                              GT_UNUSED int src_line)
 {
+  MAStripe *stripe = get_stripe(ma, ptr);
   MAInfo *mainfo;
+  size_t size;
+  gt_mutex_lock(stripe->lock);
+  mainfo = gt_hashmap_get(stripe->allocated_pointer, ptr);
+#ifndef NDEBUG
+  if (!mainfo) {
+    fprintf(stderr, "bug: double free() attempted on line %d in file "
+            "\"%s\"\n", src_line, src_file);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+#endif
+  gt_assert(mainfo);
+  size = mainfo->size;
+  gt_hashmap_remove(stripe->allocated_pointer, ptr);
+  stripe_info_delete(stripe, mainfo);
+  /* free while holding the lock, <ptr> must not be handed out again before
+     it has been removed from the bookkeeping */
+  if (free_ptr)
+    free(ptr);
+  gt_mutex_unlock(stripe->lock);
+  subtract_size(ma, size);
+}
+
+void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
+{
   void *mem;
   gt_assert(ma);
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
-    mem = xmalloc(size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
-    return mem;
-  }
-  return xmalloc(size, ma->current_size, src_file, src_line);
+  mem = xmalloc(size, ma->current_size, src_file, src_line);
+  if (ma->bookkeeping)
+    add_allocation(ma, mem, size, src_file, src_line);
+  return mem;
 }
 
 void* gt_calloc_mem(size_t nmemb, size_t size, const char *src_file,
                     int src_line)
 {
-  MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = nmemb * size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
-    mem = xcalloc(nmemb, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, nmemb * size);
-    gt_mutex_unlock(bookkeeping_lock);
-    return mem;
-  }
-  return xcalloc(nmemb, size, ma->current_size, src_file, src_line);
+  mem = xcalloc(nmemb, size, ma->current_size, src_file, src_line);
+  if (ma->bookkeeping)
+    add_allocation(ma, mem, nmemb * size, src_file, src_line);
+  return mem;
 }
 
 void* gt_realloc_mem(void *ptr, size_t size, const char *src_file, int src_line)
 {
-  MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    if (ptr) {
-      mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-      gt_assert(mainfo);
-      subtract_size(ma, mainfo->size);
-      gt_hashmap_remove(ma->allocated_pointer, ptr);
-    }
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
+    if (ptr)
+      remove_allocation(ma, ptr, false, src_file, src_line);
     mem = xrealloc(ptr, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    add_allocation(ma, mem, size, src_file, src_line);
     return mem;
   }
   return xrealloc(ptr, size, ma->current_size, src_file, src_line);
 }
 
-void gt_free_mem(void *ptr, GT_UNUSED const char *src_file,
-                 GT_UNUSED int src_line)
+void gt_free_mem(void *ptr, const char *src_file, int src_line)
 {
-  MAInfo *mainfo;
   gt_assert(ma);
   if (ptr == NULL) return;
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-#ifndef NDEBUG
-    if (!gt_hashmap_get(ma->allocated_pointer, ptr)) {
-      fprintf(stderr, "bug: double free() attempted on line %d in file "
-              "\"%s\"\n", src_line, src_file);
-      exit(GT_EXIT_PROGRAMMING_ERROR);
-    }
-#endif
-    mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-    gt_assert(mainfo);
-    subtract_size(ma, mainfo->size);
-    gt_hashmap_remove(ma->allocated_pointer, ptr);
-    free(ptr);
-    gt_mutex_unlock(bookkeeping_lock);
-  }
-  else {
+  if (ma->bookkeeping)
+    remove_allocation(ma, ptr, true, src_file, src_line);
+  else
     free(ptr);
-  }
 }
 
 void gt_free_func(void *ptr)
@@ -278,23 +357,33 @@ GtUword gt_ma_get_space_current(void)
 
 void gt_ma_show_space_peak(FILE *fp)
 {
+  GtUint64 mallocevents = 0;
+  unsigned int i;
   gt_assert(ma);
+  for (i = 0; i < MA_NUM_OF_STRIPES; i++) {
+    gt_mutex_lock(ma->stripes[i].lock);
+    mallocevents += ma->stripes[i].mallocevents;
+    gt_mutex_unlock(ma->stripes[i].lock);
+  }
   fprintf(fp, "# space peak in megabytes: %.2f (in "GT_LLU" events)\n",
           GT_MEGABYTES(ma->max_size),
-          ma->mallocevents);
+          mallocevents);
 }
 
 int gt_ma_check_space_leak(void)
 {
   CheckSpaceLeakInfo info;
   GT_UNUSED int had_err;
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   info.has_leak = false;
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, check_space_leak, &info,
-                               NULL);
-  gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
-  gt_mutex_unlock(bookkeeping_lock);
+  for (i = 0; i < MA_NUM_OF_STRIPES; i++) {
+    gt_mutex_lock(ma->stripes[i].lock);
+    had_err = gt_hashmap_foreach(ma->stripes[i].allocated_pointer,
+                                 check_space_leak, &info, NULL);
+    gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
+    gt_mutex_unlock(ma->stripes[i].lock);
+  }
   if (info.has_leak)
     return -1;
   return 0;
@@ -321,22 +410,35 @@ static int print_allocation(GT_UNUSED void *key, void *value,
 void gt_ma_show_allocations(FILE *outfp)
 {
   GT_UNUSED int had_err;
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, print_allocation,
-                               outfp, NULL);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  for (i = 0; i < MA_NUM_OF_STRIPES; i++) {
+    gt_mutex_lock(ma->stripes[i].lock);
+    had_err = gt_hashmap_foreach(ma->stripes[i].allocated_pointer,
+                                 print_allocation, outfp, NULL);
+    gt_mutex_unlock(ma->stripes[i].lock);
+    gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  }
 }
 
 void gt_ma_clean(void)
 {
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   ma->bookkeeping = false;
-  gt_hashmap_delete(ma->allocated_pointer);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_mutex_delete(bookkeeping_lock);
+  for (i = 0; i < MA_NUM_OF_STRIPES; i++) {
+    MAStripe *stripe = ma->stripes + i;
+    while (stripe->info_blocks) {
+      MAInfoBlock *block = stripe->info_blocks;
+      stripe->info_blocks = block->next;
+      free(block);
+    }
+    gt_hashmap_delete(stripe->allocated_pointer);
+    gt_mutex_delete(stripe->lock);
+  }
+#ifndef GT_ATOMIC_ENABLED
+  gt_mutex_delete(ma->size_lock);
+#endif
   free(ma);
   ma = NULL;
 }
@@ -401,12 +503,20 @@ static void* test_realloc(GT_UNUSED void *data)
 
 int gt_ma_unit_test(GtError *err)
 {
+  GtUword current_size, space_peak;
   int had_err;
   gt_error_check(err);
+  current_size = gt_ma_get_space_current();
   had_err = gt_multithread(test_malloc, NULL, err);
   if (!had_err)
     had_err = gt_multithread(test_calloc, NULL, err);
   if (!had_err)
     had_err = gt_multithread(test_realloc, NULL, err);
+  /* the accounting of parallel allocations is exact */
+  if (!had_err && ma->bookkeeping) {
+    space_peak = gt_ma_get_space_peak();
+    gt_ensure(gt_ma_get_space_current() == current_size);
+    gt_ensure(space_peak >= current_size + NUMBER_OF_ALLOCS * SIZE_OF_ALLOCS);
+  }
   return had_err;
 }
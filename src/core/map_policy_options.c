@@ -0,0 +1,50 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/fa.h"
+#include "core/map_policy_options.h"
+
+GtOption* gt_map_policy_options_register(GtOptionParser *op,
+                                         GtStrArray *specs)
+{
+  GtOption *option;
+  gt_assert(op && specs);
+  option = gt_option_new_string_array("mmap",
+                                      "specify how index tables are mapped "
+                                      "into memory, as "
+                                      "[table=]advice[,advice...] where "
+                                      "table is an index file suffix like "
+                                      "suf or esq (all tables if omitted) "
+                                      "and advice is one of normal, "
+                                      "sequential, random, willneed, "
+                                      "hugepages, populate and warmup",
+                                      specs);
+  gt_option_parser_add_option(op, option);
+  return option;
+}
+
+int gt_map_policy_options_apply(const GtStrArray *specs, GtError *err)
+{
+  GtUword idx;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(specs);
+  for (idx = 0; !had_err && idx < gt_str_array_size(specs); idx++) {
+    had_err = gt_fa_set_map_policy_from_string(gt_str_array_get(specs, idx),
+                                               err);
+  }
+  return had_err;
+}
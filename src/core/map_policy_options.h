@@ -0,0 +1,36 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MAP_POLICY_OPTIONS_H
+#define MAP_POLICY_OPTIONS_H
+
+#include "core/error_api.h"
+#include "core/option_api.h"
+#include "core/str_array_api.h"
+
+/* Adds the `-mmap' option to <op>, allowing the selection of how the tables
+   of an index are mapped into memory. The arguments are written to <specs>
+   and must be applied with gt_map_policy_options_apply() before the index is
+   mapped. Returns the option. */
+GtOption* gt_map_policy_options_register(GtOptionParser *op,
+                                         GtStrArray *specs);
+
+/* Sets the map policies given in <specs>, each of the form accepted by
+   gt_fa_set_map_policy_from_string(). Returns 0 on success and -1 if a
+   policy is invalid, in which case <err> is set. */
+int       gt_map_policy_options_apply(const GtStrArray *specs, GtError *err);
+
+#endif
@@ -60,11 +60,9 @@ GtSequenceBuffer* gt_sequence_buffer_ref(GtSequenceBuffer *sb)
   return sb;
 }
 
-GtSequenceBuffer* gt_sequence_buffer_new_guess_type(const GtStrArray *seqs,
-                                                    GtError *err)
+GtSequenceBufferNewFunc gt_sequence_buffer_guess_type(const GtStrArray *seqs,
+                                                      GtError *err)
 {
-  GtFile *file;
-  GtSequenceBuffer *sb;
   char firstcontents[BUFSIZ];
   gt_assert(seqs);
   gt_error_check(err);
@@ -77,29 +75,33 @@ GtSequenceBuffer* gt_sequence_buffer_new_guess_type(const GtStrArray *seqs,
   }
 
   memset(firstcontents, 0, BUFSIZ);
-  file = gt_file_open(gt_file_mode_determine(gt_str_array_get(seqs, 0)),
-                      gt_str_array_get(seqs, 0),
-                      "rb", err);
-  if (!file)
+  /* does not consume the contents if the file is a stream */
+  if (gt_file_peek(gt_str_array_get(seqs, 0), firstcontents, BUFSIZ-1,
+                   err) < 0)
     return NULL;
-  gt_file_xread(file, &firstcontents, BUFSIZ-1);
-  gt_file_delete(file);
 
-  if (gt_sequence_buffer_embl_guess(firstcontents)) {
-    sb = gt_sequence_buffer_embl_new(seqs);
-  } else if (gt_sequence_buffer_fasta_guess(firstcontents)) {
-    sb = gt_sequence_buffer_fasta_new(seqs);
-  } else if (gt_sequence_buffer_gb_guess(firstcontents)) {
-    sb = gt_sequence_buffer_gb_new(seqs);
-    } else if (gt_sequence_buffer_fastq_guess(firstcontents)) {
-    sb = gt_sequence_buffer_fastq_new(seqs);
-  } else {
-    gt_error_set(err, "cannot guess file type of file %s -- unknown file "
-                      "contents",
-                      gt_str_array_get(seqs, 0));
+  if (gt_sequence_buffer_embl_guess(firstcontents))
+    return gt_sequence_buffer_embl_new;
+  if (gt_sequence_buffer_fasta_guess(firstcontents))
+    return gt_sequence_buffer_fasta_new;
+  if (gt_sequence_buffer_gb_guess(firstcontents))
+    return gt_sequence_buffer_gb_new;
+  if (gt_sequence_buffer_fastq_guess(firstcontents))
+    return gt_sequence_buffer_fastq_new;
+  gt_error_set(err, "cannot guess file type of file %s -- unknown file "
+                    "contents",
+                    gt_str_array_get(seqs, 0));
+  return NULL;
+}
+
+GtSequenceBuffer* gt_sequence_buffer_new_guess_type(const GtStrArray *seqs,
+                                                    GtError *err)
+{
+  GtSequenceBufferNewFunc sequence_buffer_new;
+  gt_error_check(err);
+  if (!(sequence_buffer_new = gt_sequence_buffer_guess_type(seqs, err)))
     return NULL;
-  }
-  return sb;
+  return sequence_buffer_new(seqs);
 }
 
 GtUword gt_sequence_buffer_get_file_index(GtSequenceBuffer *si)
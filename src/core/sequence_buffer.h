@@ -38,12 +38,22 @@ typedef struct GtSequenceBufferClass GtSequenceBufferClass;
 /* Increases the reference count of the <GtSequenceBuffer>. */
 GtSequenceBuffer*  gt_sequence_buffer_ref(GtSequenceBuffer*);
 
+/* Constructor of a <GtSequenceBuffer> of a certain type. */
+typedef GtSequenceBuffer* (*GtSequenceBufferNewFunc)(const GtStrArray*);
+
 /* Creates a new <GtSequenceBuffer>, choosing the appropriate type by looking
    at the first input file. All files must be of the same type.
    If NULL is returned, an error occurred. */
 GtSequenceBuffer*  gt_sequence_buffer_new_guess_type(const GtStrArray*,
                                                      GtError*);
 
+/* Returns the constructor of the <GtSequenceBuffer> type appropriate for the
+   first input file, as used by gt_sequence_buffer_new_guess_type(). This
+   allows to read subsets of the files with buffers of the same type.
+   If NULL is returned, an error occurred. */
+GtSequenceBufferNewFunc gt_sequence_buffer_guess_type(const GtStrArray*,
+                                                      GtError*);
+
 /* Fetches next character from <GtSequenceBuffer>.
    Returns 1 if a new character could be read, 0 if all files are exhausted, or
    -1 on error (see the <GtError> object for details). */
@@ -216,6 +216,12 @@ const GtSequenceBufferClass* gt_sequence_buffer_fastq_class(void)
   return &sbc;
 }
 
+bool gt_sequence_buffer_is_fastq(const GtSequenceBuffer *sb)
+{
+  gt_assert(sb);
+  return sb->c_class == gt_sequence_buffer_fastq_class();
+}
+
 bool gt_sequence_buffer_fastq_guess(const char* txt)
 {
   return (txt[0] == FASTQ_START_SYMBOL);
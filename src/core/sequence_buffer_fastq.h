@@ -32,5 +32,8 @@ const GtSequenceBufferClass* gt_sequence_buffer_fastq_class(void);
 GtSequenceBuffer*            gt_sequence_buffer_fastq_new(const GtStrArray*);
 
 bool                         gt_sequence_buffer_fastq_guess(const char* txt);
+/* Returns true if <sb> is a FastQ sequence buffer. */
+bool                         gt_sequence_buffer_is_fastq(const GtSequenceBuffer
+                                                                          *sb);
 
 #endif
@@ -0,0 +1,486 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/sequence_buffer_rep.h"
+#include "core/sequence_buffer_spool.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+
+#define GT_SEQUENCE_SPOOL_NORANGE (~((GtUword) 0))
+
+struct GtSequenceSpool {
+  FILE *symbolfp,     /* bit-packed non-special symbols */
+       *rangefp,      /* start and length of special ranges */
+       *descfp;       /* '\0'-terminated descriptions, or NULL */
+  uint64_t unit;
+  unsigned int bitspersymbol,
+               symbolsperunit,
+               symbolsinunit;
+  GtUword length,
+          rangestart,
+          rangelength;
+  GtUchar rangechar;
+  GtStr *prefix;      /* path prefix of the files, or NULL */
+  int write_errno;    /* errno of the first failed write, or 0 */
+};
+
+/* Returns a new temporary file named <spool->prefix>.spool.XXXXXX, or in the
+   default temporary directory if no prefix is set. The file is removed right
+   away, so it disappears when it is closed or the program exits. */
+static FILE* gt_sequence_spool_tmpfp(GtSequenceSpool *spool)
+{
+  FILE *fp;
+  GtStr *template;
+  if (spool->prefix == NULL)
+    return gt_xtmpfp_generic(NULL, TMPFP_OPENBINARY | TMPFP_AUTOREMOVE);
+  template = gt_str_clone(spool->prefix);
+  gt_str_append_cstr(template, ".spool.XXXXXX");
+  fp = gt_xtmpfp_generic(template, TMPFP_USETEMPLATE | TMPFP_OPENBINARY |
+                                   TMPFP_AUTOREMOVE);
+  gt_str_delete(template);
+  return fp;
+}
+
+GtSequenceSpool* gt_sequence_spool_new(const char *prefix,
+                                       unsigned int numofchars, GtError *err)
+{
+  GtSequenceSpool *spool;
+  gt_error_check(err);
+  gt_assert(numofchars > 0 && numofchars <= (unsigned int) WILDCARD);
+  if (prefix != NULL) {
+    GtStr *dirname = gt_str_new();
+    gt_file_dirname(dirname, prefix);
+    if (gt_str_length(dirname) == 0)
+      gt_str_set(dirname, ".");
+    if (access(gt_str_get(dirname), W_OK | X_OK) != 0) {
+      gt_error_set(err, "cannot create temporary files %s.spool.*: %s",
+                   prefix, strerror(errno));
+      gt_str_delete(dirname);
+      return NULL;
+    }
+    gt_str_delete(dirname);
+  }
+  spool = gt_calloc(1, sizeof (*spool));
+  if (prefix != NULL)
+    spool->prefix = gt_str_new_cstr(prefix);
+  spool->symbolfp = gt_sequence_spool_tmpfp(spool);
+  spool->rangefp = gt_sequence_spool_tmpfp(spool);
+  spool->bitspersymbol = numofchars > 1U
+                         ? gt_determinebitspervalue((GtUword) numofchars - 1)
+                         : 1U;
+  spool->symbolsperunit = (unsigned int) (sizeof (spool->unit) * CHAR_BIT)
+                          / spool->bitspersymbol;
+  return spool;
+}
+
+/* Writes to one of the files of <spool>. Failures, usually a full disk, are
+   recorded and reported by <gt_sequence_spool_flush()>, later writes are
+   skipped. */
+static void gt_sequence_spool_write(GtSequenceSpool *spool, const void *ptr,
+                                    size_t size, size_t nmemb, FILE *fp)
+{
+  if (spool->write_errno == 0 && fwrite(ptr, size, nmemb, fp) != nmemb)
+    spool->write_errno = errno ? errno : EIO;
+}
+
+static void gt_sequence_spool_flush_range(GtSequenceSpool *spool)
+{
+  /* the lowest bit of the stored length tells separators from wildcards */
+  GtUword code = (spool->rangelength << 1) |
+                 (spool->rangechar == (GtUchar) SEPARATOR ? 1UL : 0);
+  gt_sequence_spool_write(spool, &spool->rangestart, sizeof (GtUword), 1,
+                          spool->rangefp);
+  gt_sequence_spool_write(spool, &code, sizeof (code), 1, spool->rangefp);
+  spool->rangelength = 0;
+}
+
+static void gt_sequence_spool_flush_unit(GtSequenceSpool *spool)
+{
+  gt_sequence_spool_write(spool, &spool->unit, sizeof (spool->unit), 1,
+                          spool->symbolfp);
+  spool->unit = 0;
+  spool->symbolsinunit = 0;
+}
+
+void gt_sequence_spool_add(GtSequenceSpool *spool, GtUchar charcode)
+{
+  gt_assert(spool);
+  if (ISSPECIAL(charcode)) {
+    if (spool->rangelength > 0 && spool->rangechar != charcode)
+      gt_sequence_spool_flush_range(spool);
+    if (spool->rangelength == 0) {
+      spool->rangestart = spool->length;
+      spool->rangechar = charcode;
+    }
+    spool->rangelength++;
+  } else {
+    gt_assert((unsigned int) charcode < (1U << spool->bitspersymbol));
+    if (spool->rangelength > 0)
+      gt_sequence_spool_flush_range(spool);
+    spool->unit |= ((uint64_t) charcode)
+                   << (spool->symbolsinunit * spool->bitspersymbol);
+    if (++spool->symbolsinunit == spool->symbolsperunit)
+      gt_sequence_spool_flush_unit(spool);
+  }
+  spool->length++;
+}
+
+void gt_sequence_spool_add_description(GtSequenceSpool *spool,
+                                       const char *desc)
+{
+  gt_assert(spool && desc);
+  if (spool->descfp == NULL)
+    spool->descfp = gt_sequence_spool_tmpfp(spool);
+  gt_sequence_spool_write(spool, desc, sizeof (char), strlen(desc) + 1,
+                          spool->descfp);
+}
+
+GtUword gt_sequence_spool_length(const GtSequenceSpool *spool)
+{
+  gt_assert(spool);
+  return spool->length;
+}
+
+static void gt_sequence_spool_fflush(GtSequenceSpool *spool, FILE *fp)
+{
+  if (fp != NULL && fflush(fp) != 0 && spool->write_errno == 0)
+    spool->write_errno = errno ? errno : EIO;
+}
+
+/* Writes pending data of <spool> to its files. */
+static void gt_sequence_spool_write_pending(GtSequenceSpool *spool)
+{
+  if (spool->rangelength > 0)
+    gt_sequence_spool_flush_range(spool);
+  if (spool->symbolsinunit > 0)
+    gt_sequence_spool_flush_unit(spool);
+  gt_sequence_spool_fflush(spool, spool->symbolfp);
+  gt_sequence_spool_fflush(spool, spool->rangefp);
+  gt_sequence_spool_fflush(spool, spool->descfp);
+}
+
+int gt_sequence_spool_flush(GtSequenceSpool *spool, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(spool);
+  gt_sequence_spool_write_pending(spool);
+  if (spool->write_errno != 0) {
+    if (spool->prefix != NULL) {
+      gt_error_set(err, "cannot write temporary files %s.spool.*: %s",
+                   gt_str_get(spool->prefix), strerror(spool->write_errno));
+    }
+    else {
+      gt_error_set(err, "cannot write temporary files: %s",
+                   strerror(spool->write_errno));
+    }
+    return -1;
+  }
+  return 0;
+}
+
+/* Prepares <spool>, which must have been flushed successfully, for reading
+   from the start. */
+static void gt_sequence_spool_rewind(GtSequenceSpool *spool)
+{
+  gt_assert(spool);
+  gt_sequence_spool_write_pending(spool);
+  gt_assert(spool->write_errno == 0);
+  rewind(spool->symbolfp);
+  rewind(spool->rangefp);
+  if (spool->descfp != NULL)
+    rewind(spool->descfp);
+}
+
+void gt_sequence_spool_delete(GtSequenceSpool *spool)
+{
+  if (!spool) return;
+  gt_fa_xfclose(spool->symbolfp);
+  gt_fa_xfclose(spool->rangefp);
+  gt_fa_xfclose(spool->descfp);
+  gt_str_delete(spool->prefix);
+  gt_free(spool);
+}
+
+struct GtSequenceBufferSpool {
+  const GtSequenceBuffer parent_instance;
+  GtSequenceSpool **spools;
+  GtUword numofspools,
+          spoolnum,
+          pos,
+          rangestart,
+          rangeend;
+  uint64_t unit;
+  unsigned int symbolsinunit;
+  bool seqstart;
+  GtUchar rangechar;
+};
+
+#define gt_sequence_buffer_spool_cast(SB)\
+        gt_sequence_buffer_cast(gt_sequence_buffer_spool_class(), SB)
+
+static int gt_sequence_buffer_spool_next_range(GtSequenceBufferSpool *sbs,
+                                               GtError *err)
+{
+  GtSequenceSpool *spool = sbs->spools[sbs->spoolnum];
+  GtUword code;
+  if (gt_xfread_one(&sbs->rangestart, spool->rangefp) != 1) {
+    sbs->rangestart = sbs->rangeend = GT_SEQUENCE_SPOOL_NORANGE;
+    return 0;
+  }
+  if (gt_xfread_one(&code, spool->rangefp) != 1) {
+    gt_error_set(err, "unexpected end of sequence spool");
+    return -1;
+  }
+  sbs->rangeend = sbs->rangestart + (code >> 1);
+  sbs->rangechar = (code & 1UL) ? (GtUchar) SEPARATOR : (GtUchar) WILDCARD;
+  return 0;
+}
+
+/* Starts reading spool number <spoolnum> from the beginning. */
+static int gt_sequence_buffer_spool_start(GtSequenceBufferSpool *sbs,
+                                          GtUword spoolnum, GtError *err)
+{
+  gt_assert(spoolnum < sbs->numofspools);
+  sbs->spoolnum = spoolnum;
+  sbs->pos = 0;
+  sbs->unit = 0;
+  sbs->symbolsinunit = 0;
+  sbs->seqstart = true;
+  gt_sequence_spool_rewind(sbs->spools[spoolnum]);
+  return gt_sequence_buffer_spool_next_range(sbs, err);
+}
+
+/* Passes the next recorded description to the description buffer. */
+static int gt_sequence_buffer_spool_next_desc(GtSequenceBufferSpool *sbs,
+                                              GtDescBuffer *descptr,
+                                              GtError *err)
+{
+  FILE *descfp = sbs->spools[sbs->spoolnum]->descfp;
+  int cc;
+  while ((cc = getc(descfp)) != EOF && cc != '\0')
+    gt_desc_buffer_append_char(descptr, (char) cc);
+  if (cc == EOF) {
+    gt_error_set(err, "missing description in sequence spool");
+    return -1;
+  }
+  gt_desc_buffer_finish(descptr);
+  return 0;
+}
+
+static int gt_sequence_buffer_spool_advance(GtSequenceBuffer *sb, GtError *err)
+{
+  GtSequenceBufferSpool *sbs;
+  GtSequenceBufferMembers *pvt;
+  GtSequenceSpool *spool;
+  GtUword currentoutpos = 0;
+  uint64_t mask;
+  GtUchar charcode;
+  int had_err = 0;
+
+  sbs = gt_sequence_buffer_spool_cast(sb);
+  pvt = sb->pvt;
+  gt_error_check(err);
+  while (!had_err && currentoutpos < (GtUword) OUTBUFSIZE) {
+    spool = sbs->spools[sbs->spoolnum];
+    if (sbs->seqstart) {
+      sbs->seqstart = false;
+      if (pvt->descptr != NULL && spool->descfp != NULL) {
+        if ((had_err = gt_sequence_buffer_spool_next_desc(sbs, pvt->descptr,
+                                                          err)))
+          break;
+      }
+    }
+    if (sbs->pos == spool->length) {
+      if (sbs->spoolnum + 1 == sbs->numofspools) {
+        pvt->complete = true;
+        break;
+      }
+      /* the next spool starts a new sequence as if read from a new file */
+      had_err = gt_sequence_buffer_spool_start(sbs, sbs->spoolnum + 1, err);
+      pvt->outbuf[currentoutpos] = (GtUchar) SEPARATOR;
+      pvt->outbuforig[currentoutpos] = '\0';
+      currentoutpos++;
+      continue;
+    }
+    if (sbs->pos >= sbs->rangestart) {
+      gt_assert(sbs->pos < sbs->rangeend);
+      charcode = sbs->rangechar;
+      if (charcode == (GtUchar) SEPARATOR)
+        sbs->seqstart = true;
+      if (!had_err && sbs->pos + 1 == sbs->rangeend)
+        had_err = gt_sequence_buffer_spool_next_range(sbs, err);
+    } else {
+      if (sbs->symbolsinunit == 0) {
+        if (gt_xfread_one(&sbs->unit, spool->symbolfp) != 1) {
+          gt_error_set(err, "unexpected end of sequence spool");
+          had_err = -1;
+          break;
+        }
+        sbs->symbolsinunit = spool->symbolsperunit;
+      }
+      mask = (((uint64_t) 1) << spool->bitspersymbol) - 1;
+      charcode = (GtUchar) (sbs->unit & mask);
+      sbs->unit >>= spool->bitspersymbol;
+      sbs->symbolsinunit--;
+    }
+    pvt->outbuf[currentoutpos] = charcode;
+    pvt->outbuforig[currentoutpos] = '\0';
+    currentoutpos++;
+    sbs->pos++;
+  }
+  if (had_err)
+    return -1;
+  pvt->nextfree = currentoutpos;
+  pvt->counter += currentoutpos;
+  return 0;
+}
+
+static GtUword gt_sequence_buffer_spool_get_file_index(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferSpool *sbs;
+  gt_assert(sb);
+  sbs = gt_sequence_buffer_spool_cast(sb);
+  return sbs->spoolnum;
+}
+
+static void gt_sequence_buffer_spool_free(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferSpool *sbs = gt_sequence_buffer_spool_cast(sb);
+  /* the spools are owned by the caller */
+  gt_free(sbs->spools);
+}
+
+const GtSequenceBufferClass* gt_sequence_buffer_spool_class(void)
+{
+  static const GtSequenceBufferClass sbc = { sizeof (GtSequenceBufferSpool),
+                                        gt_sequence_buffer_spool_advance,
+                                        gt_sequence_buffer_spool_get_file_index,
+                                        gt_sequence_buffer_spool_free };
+  return &sbc;
+}
+
+GtSequenceBuffer* gt_sequence_buffer_spool_new(GtSequenceSpool **spools,
+                                               GtUword numofspools)
+{
+  GtSequenceBuffer *sb;
+  GtSequenceBufferSpool *sbs;
+  GT_UNUSED int rval;
+  gt_assert(spools && numofspools > 0);
+  sb = gt_sequence_buffer_create(gt_sequence_buffer_spool_class());
+  sbs = gt_sequence_buffer_spool_cast(sb);
+  sbs->spools = gt_malloc(sizeof (*sbs->spools) * numofspools);
+  memcpy(sbs->spools, spools, sizeof (*sbs->spools) * numofspools);
+  sbs->numofspools = numofspools;
+  /* reading the first range cannot fail, the spool was just flushed */
+  rval = gt_sequence_buffer_spool_start(sbs, 0, NULL);
+  gt_assert(rval == 0);
+  sb->pvt->nextread = sb->pvt->nextfree = 0;
+  sb->pvt->complete = false;
+  return sb;
+}
+
+#define GT_SEQUENCE_SPOOL_TEST_SPOOLS 3
+
+int gt_sequence_buffer_spool_unit_test(GtError *err)
+{
+  static const unsigned int numofchars[] = { 1U, 4U, 20U, 200U };
+  GtSequenceSpool *spools[GT_SEQUENCE_SPOOL_TEST_SPOOLS];
+  GtSequenceBuffer *sb;
+  GtDescBuffer *descbuffer;
+  GtUchar *seq, cc;
+  GtUword i, len, j, k, seqnum;
+  unsigned int t, replay;
+  char desc[32];
+  int had_err = 0;
+  gt_error_check(err);
+
+  for (t = 0; !had_err && t < sizeof numofchars / sizeof numofchars[0];
+       t++) {
+    /* the spools are replayed with a separator in between */
+    len = (GtUword) (gt_rand_max(3 * OUTBUFSIZE) + 1);
+    seq = gt_malloc(sizeof (*seq) * len);
+    for (i = 0; i < len; i++) {
+      switch (gt_rand_max(9)) {
+        case 0: seq[i] = (GtUchar) WILDCARD; break;
+        case 1: seq[i] = (GtUchar) SEPARATOR; break;
+        default: seq[i] = numofchars[t] > 1U
+                          ? (GtUchar) gt_rand_max(numofchars[t] - 1)
+                          : 0;
+      }
+    }
+    for (k = 0; k < GT_SEQUENCE_SPOOL_TEST_SPOOLS; k++)
+      spools[k] = gt_sequence_spool_new(NULL, numofchars[t], err);
+    seqnum = 0;
+    (void) snprintf(desc, sizeof desc, "seq"GT_WU, seqnum++);
+    gt_sequence_spool_add_description(spools[0], desc);
+    for (i = 0, k = 0; i < len; i++) {
+      if (seq[i] == (GtUchar) SEPARATOR && k + 1 < GT_SEQUENCE_SPOOL_TEST_SPOOLS
+            && gt_rand_max(len / 4) == 0) {
+        k++;
+      } else {
+        gt_sequence_spool_add(spools[k], seq[i]);
+      }
+      if (seq[i] == (GtUchar) SEPARATOR) {
+        (void) snprintf(desc, sizeof desc, "seq"GT_WU, seqnum++);
+        gt_sequence_spool_add_description(spools[k], desc);
+      }
+    }
+    /* spools which were never started contain one empty sequence */
+    seq = gt_realloc(seq,
+                     sizeof (*seq) * (len + GT_SEQUENCE_SPOOL_TEST_SPOOLS));
+    while (++k < GT_SEQUENCE_SPOOL_TEST_SPOOLS) {
+      seq[len++] = (GtUchar) SEPARATOR;
+      (void) snprintf(desc, sizeof desc, "seq"GT_WU, seqnum++);
+      gt_sequence_spool_add_description(spools[k], desc);
+    }
+    gt_ensure(gt_sequence_spool_length(spools[0]) <= len);
+
+    /* the spools can be replayed repeatedly */
+    for (replay = 0; !had_err && replay < 2U; replay++) {
+      descbuffer = gt_desc_buffer_new();
+      sb = gt_sequence_buffer_spool_new(spools, GT_SEQUENCE_SPOOL_TEST_SPOOLS);
+      gt_sequence_buffer_set_desc_buffer(sb, descbuffer);
+      seqnum = 0;
+      for (j = 0; !had_err && gt_sequence_buffer_next(sb, &cc, err) == 1;
+           j++) {
+        gt_ensure(j < len && cc == seq[j]);
+        if (!had_err && cc == (GtUchar) SEPARATOR) {
+          (void) snprintf(desc, sizeof desc, "seq"GT_WU, seqnum++);
+          gt_ensure(strcmp(gt_desc_buffer_get_next(descbuffer), desc) == 0);
+        }
+      }
+      gt_ensure(!gt_error_is_set(err));
+      gt_ensure(j == len);
+      (void) snprintf(desc, sizeof desc, "seq"GT_WU, seqnum);
+      gt_ensure(strcmp(gt_desc_buffer_get_next(descbuffer), desc) == 0);
+      gt_sequence_buffer_delete(sb);
+      gt_desc_buffer_delete(descbuffer);
+    }
+    for (k = 0; k < GT_SEQUENCE_SPOOL_TEST_SPOOLS; k++)
+      gt_sequence_spool_delete(spools[k]);
+    gt_free(seq);
+  }
+  return had_err;
+}
@@ -0,0 +1,81 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEQUENCE_BUFFER_SPOOL_H
+#define SEQUENCE_BUFFER_SPOOL_H
+
+#include "core/error_api.h"
+#include "core/sequence_buffer.h"
+
+/* A <GtSequenceSpool> records a stream of symbol codes as delivered by a
+   <GtSequenceBuffer> with a symbol map, such that the stream can be replayed
+   later without parsing the input files again. Symbols smaller than
+   <numofchars> are bit-packed (two bits per symbol for DNA), runs of
+   WILDCARD and SEPARATOR symbols are stored as ranges. Optionally, the
+   description of each sequence is recorded as well. The data is kept in
+   temporary files which are removed automatically. They need one quarter of
+   a byte per symbol for DNA and less than one byte per symbol otherwise. */
+typedef struct GtSequenceSpool GtSequenceSpool;
+
+/* Returns a new <GtSequenceSpool> for symbol codes smaller than <numofchars>
+   and the special codes WILDCARD and SEPARATOR. Its files are named
+   <prefix>.spool.XXXXXX, or are created in the default temporary directory if
+   <prefix> is NULL. Returns NULL and sets <err> if the directory of <prefix>
+   is not writable. */
+GtSequenceSpool*             gt_sequence_spool_new(const char *prefix,
+                                                   unsigned int numofchars,
+                                                   GtError *err);
+/* Appends <charcode> to <spool>. */
+void                         gt_sequence_spool_add(GtSequenceSpool *spool,
+                                                   GtUchar charcode);
+/* Appends the description <desc> of the next sequence to <spool>. Either no
+   description or one description per sequence must be added. */
+void                         gt_sequence_spool_add_description(GtSequenceSpool
+                                                               *spool,
+                                                               const char
+                                                               *desc);
+/* Writes all symbols and descriptions appended to <spool> to its files.
+   Returns 0 on success and -1 if a write failed since the creation of <spool>,
+   e.g. because the disk is full, in which case <err> is set. Must succeed
+   before <spool> is replayed. */
+int                          gt_sequence_spool_flush(GtSequenceSpool *spool,
+                                                     GtError *err);
+/* Returns the number of symbols appended to <spool>. */
+GtUword                      gt_sequence_spool_length(const GtSequenceSpool
+                                                      *spool);
+/* Deletes <spool> and its temporary files. */
+void                         gt_sequence_spool_delete(GtSequenceSpool *spool);
+
+/* implements the ``sequence buffer'' interface for replaying the symbols
+   recorded in one or more <GtSequenceSpool>s. The spools are delivered one
+   after the other, with a SEPARATOR in between, as if each spool was read from
+   a separate input file. The symbols are delivered as recorded, so no symbol
+   map must be set. Original characters are not available, a '\0' character
+   is delivered instead. If the spools contain descriptions, they are passed
+   to the description buffer, if one is set. Character distributions and file
+   lengths are not computed. After creating the buffer, no more symbols must be
+   added to the spools, and the spools must exist as long as the buffer is
+   used. Only one buffer per spool may be used at a time. */
+typedef struct GtSequenceBufferSpool GtSequenceBufferSpool;
+
+const GtSequenceBufferClass* gt_sequence_buffer_spool_class(void);
+GtSequenceBuffer*            gt_sequence_buffer_spool_new(GtSequenceSpool
+                                                          **spools,
+                                                          GtUword numofspools);
+
+int                          gt_sequence_buffer_spool_unit_test(GtError *err);
+
+#endif
@@ -16,6 +16,7 @@
 */
 
 #include <stdio.h>
+#include "core/atomic.h"
 #include "core/spacepeak.h"
 #include "core/ma.h"
 #include "core/spacecalc.h"
@@ -41,20 +42,32 @@ void gt_spacepeak_init(void)
 
 void gt_spacepeak_add(GtUword size)
 {
+#ifdef GT_ATOMIC_ENABLED
+  GtUword current, max;
+  gt_assert(peaklogger);
+  current = gt_atomic_add(&peaklogger->current, size);
+  while ((max = peaklogger->max) < current &&
+         !gt_atomic_cas(&peaklogger->max, max, current));
+#else
   gt_assert(peaklogger);
   gt_mutex_lock(peaklogger->mutex);
   peaklogger->current += size;
   if (peaklogger->current > peaklogger->max)
     peaklogger->max = peaklogger->current;
   gt_mutex_unlock(peaklogger->mutex);
+#endif
 }
 
 void gt_spacepeak_free(GtUword size)
 {
   gt_assert(peaklogger && size <= peaklogger->current);
+#ifdef GT_ATOMIC_ENABLED
+  (void) gt_atomic_sub(&peaklogger->current, size);
+#else
   gt_mutex_lock(peaklogger->mutex);
   peaklogger->current -= size;
   gt_mutex_unlock(peaklogger->mutex);
+#endif
 }
 GtUword gt_spacepeak_get_space_peak(void)
 {
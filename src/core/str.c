@@ -18,11 +18,14 @@
 #include <math.h>
 #include <string.h>
 #include "core/assert_api.h"
+#include "core/atomic.h"
 #include "core/cstr_api.h"
 #include "core/dynalloc.h"
 #include "core/ensure.h"
+#include "core/file.h"
 #include "core/ma.h"
 #include "core/str.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
@@ -33,6 +36,43 @@ struct GtStr {
   unsigned int reference_count;
 };
 
+/* strings can be shared between threads (e.g., sequence IDs of genome nodes
+   passed through a threaded stream), so reference counting is atomic or, if
+   atomic operations are not available, locked */
+#ifndef GT_ATOMIC_ENABLED
+static GtMutex *str_mutex = NULL;
+#endif
+
+void gt_str_init(void)
+{
+#ifndef GT_ATOMIC_ENABLED
+  if (!str_mutex)
+    str_mutex = gt_mutex_new();
+#endif
+}
+
+void gt_str_clean(void)
+{
+#ifndef GT_ATOMIC_ENABLED
+  gt_mutex_delete(str_mutex);
+  str_mutex = NULL;
+#endif
+}
+
+#ifndef GT_ATOMIC_ENABLED
+static void str_lock(void)
+{
+  if (str_mutex)
+    gt_mutex_lock(str_mutex);
+}
+
+static void str_unlock(void)
+{
+  if (str_mutex)
+    gt_mutex_unlock(str_mutex);
+}
+#endif
+
 GtStr* gt_str_new(void)
 {
   GtStr *s = gt_malloc(sizeof *s);      /* create new string object */
@@ -247,7 +287,13 @@ GtStr* gt_str_clone(const GtStr *s)
 GtStr* gt_str_ref(GtStr *s)
 {
   if (!s) return NULL;
+#ifdef GT_ATOMIC_ENABLED
+  (void) gt_atomic_add(&s->reference_count, 1);
+#else
+  str_lock();
   s->reference_count++; /* increase the reference counter */
+  str_unlock();
+#endif
   return s;
 }
 
@@ -255,7 +301,8 @@ GtStr* gt_str_ref(GtStr *s)
    following:
    gt_str_read_next_line uses gt_xfgetc while
    gt_str_read_next_line_generic uses gt_file_xfgetc
-   Also gt_str_read_next_line_generic does not assert <fpin> != NULL
+   Also gt_str_read_next_line_generic does not assert <fpin> != NULL and reads
+   whole lines with gt_file_xread_line() if <fpin> is given.
 */
 
 int gt_str_read_next_line(GtStr *s, FILE *fpin)
@@ -322,6 +369,23 @@ int gt_str_read_next_line_generic(GtStr *s, GtFile *fpin)
   int cc;
   char c;
   gt_assert(s);
+  if (fpin) {
+    const char *line;
+    GtUword length;
+    if (gt_file_xread_line(fpin, &line, &length) == EOF)
+      return EOF;
+    if (line[length-1] != '\n') {
+      /* last line without newline */
+      gt_str_append_cstr_nt(s, line, length);
+      return EOF;
+    }
+    length--;
+    if (length && line[length-1] == '\r')
+      length--; /* Windows newline "\r\n" */
+    gt_str_append_cstr_nt(s, line, length);
+    s->cstr[s->length] = '\0';
+    return 0;
+  }
   for (;;) {
     cc = gt_file_xfgetc(fpin);
     if (cc == EOF)
@@ -466,8 +530,23 @@ void gt_str_delete(GtStr *s)
 {
   if (!s) return;           /* return without action if 's' is NULL */
   if (s->reference_count) { /* there are multiple references to this string */
-    s->reference_count--;   /* decrement the reference counter */
-    return;                 /* return without freeing the object */
+#ifdef GT_ATOMIC_ENABLED
+    unsigned int reference_count;
+    while ((reference_count = s->reference_count)) {
+      if (gt_atomic_cas(&s->reference_count, reference_count,
+                        reference_count - 1)) {
+        return;             /* return without freeing the object */
+      }
+    }
+#else
+    str_lock();
+    if (s->reference_count) {
+      s->reference_count--; /* decrement the reference counter */
+      str_unlock();
+      return;               /* return without freeing the object */
+    }
+    str_unlock();
+#endif
   }
   gt_free(s->cstr);         /* free the stored the C string */
   gt_free(s);               /* free the actual string object */
@@ -22,6 +22,10 @@
 #include "core/file.h"
 #include "core/str_api.h"
 
+/* Initialize the lock which makes reference counting of strings thread-safe
+   where atomic operations are not available, called by <gt_lib_init()>. */
+void          gt_str_init(void);
+void          gt_str_clean(void);
 /* never returns NULL, not always '\0' terminated */
 void*         gt_str_get_mem(const GtStr*);
 /* Remove end of <s> beginning with first occurrence of <c> */
@@ -16,19 +16,124 @@
 */
 
 #include <string.h>
-#include "core/cstr_table.h"
+#include "core/atomic.h"
+#include "core/cstr_api.h"
+#include "core/hashtable.h"
+#include "core/ma.h"
 #include "core/mathsupport.h"
 #include "core/multithread_api.h"
+#include "core/str.h"
 #include "core/symbol.h"
 #include "core/unused_api.h"
 
-static GtCstrTable *symbols = NULL;
+/* The symbols are stored in a chained hash table which can be read without
+   taking a lock: entries are only ever prepended to a bucket after they have
+   been completely initialized, and when the table grows, a new table is built
+   next to the old one and published afterwards. Readers which still traverse
+   the old table see a consistent (if possibly incomplete) state, therefore the
+   replaced tables are kept until gt_symbol_clean() is called. Only adding a
+   new symbol requires the <symbol_mutex>. */
+
+#define SYMBOL_INITIAL_BUCKETS_LOG  10
+
+typedef struct SymbolEntry SymbolEntry;
+
+struct SymbolEntry {
+  const char *symbol;
+  uint32_t hash;
+  SymbolEntry *next;
+};
+
+typedef struct SymbolTable SymbolTable;
+
+struct SymbolTable {
+  SymbolEntry **buckets;
+  GtUword mask,
+          num_of_symbols;
+  SymbolTable *retired; /* the table replaced by this one */
+};
+
+static SymbolTable * volatile symbols = NULL;
 static GtMutex *symbol_mutex = NULL;
 
+static SymbolTable* symbol_table_new(GtUword num_of_buckets)
+{
+  SymbolTable *table = gt_malloc(sizeof *table);
+  table->buckets = gt_calloc(num_of_buckets, sizeof *table->buckets);
+  table->mask = num_of_buckets - 1;
+  table->num_of_symbols = 0;
+  table->retired = NULL;
+  return table;
+}
+
+static void symbol_table_delete(SymbolTable *table, bool free_symbols)
+{
+  GtUword i;
+  SymbolEntry *entry, *next;
+  if (!table) return;
+  for (i = 0; i <= table->mask; i++) {
+    for (entry = table->buckets[i]; entry; entry = next) {
+      next = entry->next;
+      if (free_symbols)
+        gt_free((char*) entry->symbol);
+      gt_free(entry);
+    }
+  }
+  gt_free(table->buckets);
+  symbol_table_delete(table->retired, false);
+  gt_free(table);
+}
+
+static const char* symbol_table_get(const SymbolTable *table,
+                                    const char *cstr, uint32_t hash)
+{
+  const SymbolEntry *entry;
+  for (entry = table->buckets[hash & table->mask]; entry; entry = entry->next) {
+    if (entry->hash == hash && !strcmp(entry->symbol, cstr))
+      return entry->symbol;
+  }
+  return NULL;
+}
+
+/* <symbol_mutex> must be held */
+static void symbol_table_insert(SymbolTable *table, const char *symbol,
+                                uint32_t hash)
+{
+  SymbolEntry *entry = gt_malloc(sizeof *entry),
+              **bucket = table->buckets + (hash & table->mask);
+  entry->symbol = symbol;
+  entry->hash = hash;
+  entry->next = *bucket;
+#ifdef GT_ATOMIC_ENABLED
+  /* the entry must be visible completely before it is linked in */
+  gt_atomic_barrier();
+#endif
+  *bucket = entry;
+  table->num_of_symbols++;
+}
+
+/* <symbol_mutex> must be held */
+static void symbol_table_grow(void)
+{
+  SymbolTable *old_table = symbols, *new_table;
+  SymbolEntry *entry;
+  GtUword i;
+  new_table = symbol_table_new(2 * (old_table->mask + 1));
+  for (i = 0; i <= old_table->mask; i++) {
+    for (entry = old_table->buckets[i]; entry; entry = entry->next)
+      symbol_table_insert(new_table, entry->symbol, entry->hash);
+  }
+  new_table->retired = old_table;
+#ifdef GT_ATOMIC_ENABLED
+  gt_atomic_barrier();
+#endif
+  symbols = new_table;
+}
+
 void gt_symbol_init(void)
 {
   if (!symbols)
-    symbols = gt_cstr_table_new();
+    symbols = symbol_table_new(1UL << SYMBOL_INITIAL_BUCKETS_LOG);
   if (!symbol_mutex)
     symbol_mutex = gt_mutex_new();
 }
@@ -36,12 +141,21 @@ void gt_symbol_init(void)
 const char* gt_symbol(const char *cstr)
 {
   const char *symbol;
+  uint32_t hash;
   if (!cstr)
     return NULL;
+  hash = gt_ht_cstr_elem_hash(&cstr);
+#ifdef GT_ATOMIC_ENABLED
+  /* fast path: most lookups are for existing symbols */
+  if ((symbol = symbol_table_get(symbols, cstr, hash)))
+    return symbol;
+#endif
   gt_mutex_lock(symbol_mutex);
-  if (!(symbol = gt_cstr_table_get(symbols, cstr))) {
-    gt_cstr_table_add(symbols, cstr);
-    symbol = gt_cstr_table_get(symbols, cstr);
+  if (!(symbol = symbol_table_get(symbols, cstr, hash))) {
+    if (symbols->num_of_symbols > symbols->mask)
+      symbol_table_grow();
+    symbol = gt_cstr_dup(cstr);
+    symbol_table_insert(symbols, symbol, hash);
   }
   gt_mutex_unlock(symbol_mutex);
   return symbol;
@@ -49,24 +163,28 @@ const char* gt_symbol(const char *cstr)
 
 void gt_symbol_clean(void)
 {
-  gt_cstr_table_delete(symbols);
+  symbol_table_delete(symbols, true);
+  symbols = NULL;
   gt_mutex_delete(symbol_mutex);
+  symbol_mutex = NULL;
 }
 
 /* we use randomly generated numbers to test the symbol mechanism */
 #define NUMBER_OF_SYMBOLS 10000
-#define MAX_SYMBOL        1000
+#define MAX_SYMBOL        5000
 
 static void* test_symbol(GT_UNUSED void *data)
 {
   GtStr *symbol;
+  GT_UNUSED const char *sym;
   GtUword i;
   symbol = gt_str_new();
   for (i = 0; i < NUMBER_OF_SYMBOLS; i++) {
     gt_str_reset(symbol);
     gt_str_append_uword(symbol, gt_rand_max(MAX_SYMBOL));
-    gt_symbol(gt_str_get(symbol));
-    gt_assert(!strcmp(gt_symbol(gt_str_get(symbol)), gt_str_get(symbol)));
+    sym = gt_symbol(gt_str_get(symbol));
+    gt_assert(!strcmp(sym, gt_str_get(symbol)));
+    gt_assert(gt_symbol(gt_str_get(symbol)) == sym);
   }
   gt_str_delete(symbol);
   return NULL;
@@ -19,7 +19,7 @@
 #include "core/array_api.h"
 #include "core/compat.h"
 #include "core/ma_api.h"
-#include "core/thread_api.h"
+#include "core/thread.h"
 #include "core/unused_api.h"
 
 unsigned int gt_jobs = 1;
@@ -76,6 +76,28 @@ GtRWLock* gt_rwlock_new(void)
   return rwlock;
 }
 
+size_t gt_rwlock_size(void)
+{
+  return sizeof (pthread_rwlock_t);
+}
+
+GtRWLock* gt_rwlock_init(void *space)
+{
+  GT_UNUSED int rval;
+  gt_assert(space);
+  rval = pthread_rwlock_init((pthread_rwlock_t*) space, NULL);
+  gt_assert(!rval);
+  return space;
+}
+
+void gt_rwlock_destroy(GtRWLock *rwlock)
+{
+  GT_UNUSED int rval;
+  gt_assert(rwlock);
+  rval = pthread_rwlock_destroy((pthread_rwlock_t*) rwlock);
+  gt_assert(!rval);
+}
+
 void gt_rwlock_delete(GtRWLock *rwlock)
 {
   GT_UNUSED int rval;
@@ -146,6 +168,42 @@ void gt_mutex_unlock_func(GtMutex *mutex)
   gt_assert(!rval);
 }
 
+GtCond* gt_cond_new(void)
+{
+  GtCond *cond;
+  GT_UNUSED int rval;
+  cond = thread_xmalloc(sizeof (pthread_cond_t), __FILE__, __LINE__);
+  /* initialize condition variable with default attributes */
+  rval = pthread_cond_init((pthread_cond_t*) cond, NULL);
+  gt_assert(!rval);
+  return cond;
+}
+
+void gt_cond_delete(GtCond *cond)
+{
+  GT_UNUSED int rval;
+  if (!cond) return;
+  rval = pthread_cond_destroy((pthread_cond_t*) cond);
+  gt_assert(!rval);
+  free(cond);
+}
+
+void gt_cond_wait(GtCond *cond, GtMutex *mutex)
+{
+  GT_UNUSED int rval;
+  gt_assert(cond && mutex);
+  rval = pthread_cond_wait((pthread_cond_t*) cond, (pthread_mutex_t*) mutex);
+  gt_assert(!rval);
+}
+
+void gt_cond_signal(GtCond *cond)
+{
+  GT_UNUSED int rval;
+  gt_assert(cond);
+  rval = pthread_cond_signal((pthread_cond_t*) cond);
+  gt_assert(!rval);
+}
+
 #else
 
 GtThread* gt_thread_new(GtThreadFunc function, void *data,
@@ -164,6 +222,21 @@ GtRWLock* gt_rwlock_new(void)
   return NULL;
 }
 
+size_t gt_rwlock_size(void)
+{
+  return 0;
+}
+
+GtRWLock* gt_rwlock_init(GT_UNUSED void *space)
+{
+  return NULL;
+}
+
+void gt_rwlock_destroy(GT_UNUSED GtRWLock *rwlock)
+{
+  return;
+}
+
 void gt_rwlock_delete(GT_UNUSED GtRWLock *rwlock)
 {
   return;
@@ -179,6 +252,26 @@ void gt_mutex_delete(GT_UNUSED GtMutex *mutex)
   return;
 }
 
+GtCond* gt_cond_new(void)
+{
+  return NULL;
+}
+
+void gt_cond_delete(GT_UNUSED GtCond *cond)
+{
+  return;
+}
+
+void gt_cond_wait(GT_UNUSED GtCond *cond, GT_UNUSED GtMutex *mutex)
+{
+  return;
+}
+
+void gt_cond_signal(GT_UNUSED GtCond *cond)
+{
+  return;
+}
+
 #endif
 
 void gt_thread_delete(GtThread *thread)
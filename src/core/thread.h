@@ -0,0 +1,47 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdlib.h>
+#include "core/thread_api.h"
+
+/* Return the number of bytes a <GtRWLock> occupies (0 if threads are
+   disabled). */
+size_t    gt_rwlock_size(void);
+/* Initialize a <GtRWLock> in the <gt_rwlock_size()> bytes at <space> (which
+   have to be suitably aligned) and return it. */
+GtRWLock* gt_rwlock_init(void *space);
+/* Destroy <rwlock> created with <gt_rwlock_init()>, without freeing its
+   memory. */
+void      gt_rwlock_destroy(GtRWLock *rwlock);
+
+/* A condition variable, to wait for a condition protected by a <GtMutex>. */
+typedef struct GtCond GtCond;
+
+/* Return a new <GtCond*> object (NULL if threads are disabled). */
+GtCond*   gt_cond_new(void);
+/* Delete the given <cond>. */
+void      gt_cond_delete(GtCond *cond);
+/* Unlock <mutex>, which must be locked by the calling thread, and wait until
+   <cond> is signaled. <mutex> is locked again before returning. Spurious
+   wakeups are possible, so the condition has to be checked again. */
+void      gt_cond_wait(GtCond *cond, GtMutex *mutex);
+/* Wake up one thread waiting for <cond>. */
+void      gt_cond_signal(GtCond *cond);
+
+#endif
@@ -0,0 +1,222 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/ensure.h"
+#include "core/minmax.h"
+#include "core/mathsupport.h"
+#include "core/twobitenc_decode.h"
+
+#if defined(__x86_64__) && \
+    (defined(__clang__) || __GNUC__ > 4 || \
+     (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define GT_TWOBITENC_DECODE_X86
+#include <immintrin.h>
+#endif
+
+/* decodes all units of <tbe> into <dest>, which has room for
+   GT_UNITSIN2BITENC characters; <map> is padded to 16 bytes */
+typedef void (*GtTwobitencDecodeFunc)(GtUchar *dest, GtTwobitencoding tbe,
+                                      const GtUchar *map, bool reverse);
+
+static void twobitenc_decode_scalar(GtUchar *dest, GtTwobitencoding tbe,
+                                    const GtUchar *map, bool reverse)
+{
+  unsigned int idx;
+
+  if (reverse) {
+    for (idx = 0; idx < (unsigned int) GT_UNITSIN2BITENC; idx++) {
+      dest[idx] = map[tbe & 3];
+      tbe >>= 2;
+    }
+  } else {
+    for (idx = (unsigned int) GT_UNITSIN2BITENC; idx > 0; idx--) {
+      dest[idx - 1] = map[tbe & 3];
+      tbe >>= 2;
+    }
+  }
+}
+
+#ifdef GT_TWOBITENC_DECODE_X86
+/* The first character of a unit is stored in the two most significant bits,
+   that is, in byte 7 of the little endian word. The byte holding each output
+   character is replicated by a shuffle and the two bits of the character are
+   masked out. As the masked values lie either in the high or in the low
+   nibble, two table lookups map them to the codes 0..3, which are finally
+   translated by <map>. */
+__attribute__((target("ssse3")))
+static void twobitenc_decode_ssse3(GtUchar *dest, GtTwobitencoding tbe,
+                                   const GtUchar *map, bool reverse)
+{
+  const __m128i lut = _mm_setr_epi8(0, 1, 2, 3, 1, 0, 0, 0,
+                                    2, 0, 0, 0, 3, 0, 0, 0),
+                lownibble = _mm_set1_epi8(0x0F),
+                mapv = _mm_loadu_si128((const __m128i *) map);
+  __m128i word = _mm_set1_epi64x((long long) tbe), idx[2], mask, v, hi, lo;
+  int half;
+
+  if (reverse) {
+    idx[0] = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    idx[1] = _mm_setr_epi8(4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+    mask = _mm_set1_epi32((int) 0xC0300C03U);
+  } else {
+    idx[0] = _mm_setr_epi8(7, 7, 7, 7, 6, 6, 6, 6, 5, 5, 5, 5, 4, 4, 4, 4);
+    idx[1] = _mm_setr_epi8(3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0);
+    mask = _mm_set1_epi32(0x030C30C0);
+  }
+  for (half = 0; half < 2; half++) {
+    v = _mm_and_si128(_mm_shuffle_epi8(word, idx[half]), mask);
+    hi = _mm_and_si128(_mm_srli_epi16(v, 4), lownibble);
+    lo = _mm_and_si128(v, lownibble);
+    v = _mm_or_si128(_mm_shuffle_epi8(lut, hi), _mm_shuffle_epi8(lut, lo));
+    _mm_storeu_si128((__m128i *) (dest + 16 * half),
+                     _mm_shuffle_epi8(mapv, v));
+  }
+}
+
+__attribute__((target("avx2")))
+static void twobitenc_decode_avx2(GtUchar *dest, GtTwobitencoding tbe,
+                                  const GtUchar *map, bool reverse)
+{
+  const __m256i lut = _mm256_setr_epi8(0, 1, 2, 3, 1, 0, 0, 0,
+                                       2, 0, 0, 0, 3, 0, 0, 0,
+                                       0, 1, 2, 3, 1, 0, 0, 0,
+                                       2, 0, 0, 0, 3, 0, 0, 0),
+                lownibble = _mm256_set1_epi8(0x0F);
+  const __m128i map128 = _mm_loadu_si128((const __m128i *) map);
+  __m256i mapv, idx, mask, v, hi, lo;
+
+  mapv = _mm256_inserti128_si256(_mm256_castsi128_si256(map128), map128, 1);
+  if (reverse) {
+    idx = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                           4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+    mask = _mm256_set1_epi32((int) 0xC0300C03U);
+  } else {
+    idx = _mm256_setr_epi8(7, 7, 7, 7, 6, 6, 6, 6, 5, 5, 5, 5, 4, 4, 4, 4,
+                           3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0);
+    mask = _mm256_set1_epi32(0x030C30C0);
+  }
+  v = _mm256_and_si256(_mm256_shuffle_epi8(_mm256_set1_epi64x((long long) tbe),
+                                           idx), mask);
+  hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lownibble);
+  lo = _mm256_and_si256(v, lownibble);
+  v = _mm256_or_si256(_mm256_shuffle_epi8(lut, hi),
+                      _mm256_shuffle_epi8(lut, lo));
+  _mm256_storeu_si256((__m256i *) dest, _mm256_shuffle_epi8(mapv, v));
+}
+#endif
+
+static GtTwobitencDecodeFunc twobitenc_decode_func(void)
+{
+#ifdef GT_TWOBITENC_DECODE_X86
+  if (__builtin_cpu_supports("avx2"))
+    return twobitenc_decode_avx2;
+  if (__builtin_cpu_supports("ssse3"))
+    return twobitenc_decode_ssse3;
+#endif
+  return twobitenc_decode_scalar;
+}
+
+static void twobitenc_decode_with(GtTwobitencDecodeFunc decode,
+                                  GtUchar *dest,
+                                  const GtTwobitencoding *twobitencoding,
+                                  GtUword startpos,
+                                  GtUword len,
+                                  const GtUchar map[4],
+                                  bool reverse)
+{
+  GtUchar map16[16] = {0}, unit[GT_UNITSIN2BITENC];
+  GtUword unitnum = GT_DIVBYUNITSIN2BITENC(startpos),
+          offset = GT_MODBYUNITSIN2BITENC(startpos),
+          done = 0, width, idx;
+
+  memcpy(map16, map, (size_t) 4);
+  while (done < len) {
+    width = MIN((GtUword) GT_UNITSIN2BITENC - offset, len - done);
+    if (width == (GtUword) GT_UNITSIN2BITENC) {
+      decode(reverse ? dest + len - done - width : dest + done,
+             twobitencoding[unitnum], map16, reverse);
+    } else {
+      decode(unit, twobitencoding[unitnum], map16, false);
+      if (reverse) {
+        for (idx = 0; idx < width; idx++)
+          dest[len - 1 - done - idx] = unit[offset + idx];
+      } else
+        memcpy(dest + done, unit + offset, (size_t) width);
+    }
+    done += width;
+    offset = 0;
+    unitnum++;
+  }
+}
+
+void gt_twobitenc_decode(GtUchar *dest,
+                         const GtTwobitencoding *twobitencoding,
+                         GtUword startpos,
+                         GtUword len,
+                         const GtUchar map[4],
+                         bool reverse)
+{
+  gt_assert(dest != NULL && twobitencoding != NULL && map != NULL);
+  twobitenc_decode_with(twobitenc_decode_func(), dest, twobitencoding,
+                        startpos, len, map, reverse);
+}
+
+int gt_twobitenc_decode_unit_test(GtError *err)
+{
+  const GtUchar maps[2][4] = {{0, 1, 2, 3}, {'t', 'g', 'c', 'a'}};
+  GtTwobitencDecodeFunc kernels[3];
+  GtTwobitencoding tbe[8];
+  GtUchar dest[8 * GT_UNITSIN2BITENC], expected;
+  GtUword startpos, len, pos, total = 8 * GT_UNITSIN2BITENC, idx;
+  unsigned int numofkernels = 0, k, m, trial;
+  bool reverse;
+  int had_err = 0;
+  gt_error_check(err);
+
+  kernels[numofkernels++] = twobitenc_decode_scalar;
+#ifdef GT_TWOBITENC_DECODE_X86
+  if (__builtin_cpu_supports("ssse3"))
+    kernels[numofkernels++] = twobitenc_decode_ssse3;
+  if (__builtin_cpu_supports("avx2"))
+    kernels[numofkernels++] = twobitenc_decode_avx2;
+#endif
+  for (idx = 0; idx < 8UL; idx++) {
+    tbe[idx] = 0;
+    for (k = 0; k < (unsigned int) sizeof (GtTwobitencoding); k++)
+      tbe[idx] = (tbe[idx] << 8) | (GtTwobitencoding) gt_rand_max(255UL);
+  }
+  for (trial = 0; !had_err && trial < 200U; trial++) {
+    startpos = gt_rand_max(total - 1);
+    len = gt_rand_max(total - startpos);
+    reverse = (trial % 2 == 1) ? true : false;
+    m = trial % 4 < 2 ? 0 : 1;
+    for (k = 0; !had_err && k < numofkernels; k++) {
+      memset(dest, 0xFF, sizeof (dest));
+      twobitenc_decode_with(kernels[k], dest, tbe, startpos, len, maps[m],
+                            reverse);
+      for (idx = 0; !had_err && idx < len; idx++) {
+        pos = startpos + idx;
+        expected = maps[m][(tbe[GT_DIVBYUNITSIN2BITENC(pos)] >>
+                            GT_MULT2(GT_UNITSIN2BITENC - 1 -
+                                     GT_MODBYUNITSIN2BITENC(pos))) & 3];
+        gt_ensure(dest[reverse ? len - 1 - idx : idx] == expected);
+      }
+      gt_ensure(len == total || dest[len] == 0xFF);
+    }
+  }
+  return had_err;
+}
@@ -0,0 +1,40 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TWOBITENC_DECODE_H
+#define TWOBITENC_DECODE_H
+
+#include <stdbool.h>
+#include "core/error_api.h"
+#include "core/intbits.h"
+
+/* Decodes the <len> characters beginning at position <startpos> of the two
+   bit encoded sequence <twobitencoding> into <dest>, replacing each two bit
+   code <c> by <map>[<c>]. If <reverse> is true, the characters are written
+   in reverse order, that is, the character at <startpos> ends up in
+   <dest>[<len>-1]. Whole <GtTwobitencoding> units are decoded at once, using
+   AVX2 or SSSE3 instructions if the CPU supports them. Special characters
+   are not handled; they must be patched by the caller. */
+void gt_twobitenc_decode(GtUchar *dest,
+                         const GtTwobitencoding *twobitencoding,
+                         GtUword startpos,
+                         GtUword len,
+                         const GtUchar map[4],
+                         bool reverse);
+
+int  gt_twobitenc_decode_unit_test(GtError *err);
+
+#endif
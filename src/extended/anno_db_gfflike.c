@@ -26,6 +26,8 @@
 #include "core/hashmap-generic.h"
 #include "core/log_api.h"
 #include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/range.h"
 #include "core/strand_api.h"
 #include "core/thread_api.h"
@@ -50,10 +52,38 @@
 #include "extended/rdb_sqlite_api.h"
 #include "extended/rdb_visitor_rep.h"
 
+/* Features are assigned to bins of a hierarchical binning scheme: the
+   smallest bin of size 2^14, 2^17, ..., 2^29 which completely contains the
+   feature, or the catch-all bin 0. An overlap query only needs to look at the
+   bins overlapping the query range on each level, which keeps range queries
+   independent of the sequence length. Positions up to 2^32-1 are binned. */
+#define GFFLIKE_NOF_BIN_LEVELS  6
+#define GFFLIKE_BIN_MAXPOS      ((GtUword) 0xffffffffUL)
+
+static const unsigned int gfflike_bin_shifts[GFFLIKE_NOF_BIN_LEVELS] =
+  { 14, 17, 20, 23, 26, 29 };
+static const GtUword gfflike_bin_offsets[GFFLIKE_NOF_BIN_LEVELS] =
+  { 37449, 4681, 585, 73, 9, 1 };
+
+/* the same assignment in SQL, used to fill in bins for old databases */
+#define GFFLIKE_BIN_SQL \
+        "CASE WHEN end > 4294967295 THEN 0 " \
+        "WHEN (start >> 14) = (end >> 14) THEN 37449 + (start >> 14) " \
+        "WHEN (start >> 17) = (end >> 17) THEN 4681 + (start >> 17) " \
+        "WHEN (start >> 20) = (end >> 20) THEN 585 + (start >> 20) " \
+        "WHEN (start >> 23) = (end >> 23) THEN 73 + (start >> 23) " \
+        "WHEN (start >> 26) = (end >> 26) THEN 9 + (start >> 26) " \
+        "WHEN (start >> 29) = (end >> 29) THEN 1 + (start >> 29) " \
+        "ELSE 0 END"
+
+/* number of top-level features inserted per transaction in bulk load mode */
+#define GFFLIKE_BULK_LOAD_BATCH_SIZE  10000
+
 struct GtAnnoDBGFFlike {
   const GtAnnoDBSchema parent_instance;
   GtRDB *db;
   GtRDBVisitor *visitor;
+  bool bulk_load;
 };
 
 typedef struct {
@@ -61,6 +91,10 @@ typedef struct {
   GtAnnoDBGFFlike *annodb;
 } GFFlikeSetupVisitor;
 
+typedef struct {
+  const GtRDBVisitor parent_instance;
+} GFFlikeIndexVisitor;
+
 typedef struct {
   const GtFeatureIndex parent_instance;
   GtHashmap *node_to_parent_array,
@@ -78,10 +112,19 @@ typedef struct {
   GtRDB *db;
   GtMutex *dblock;
   bool transaction_lock;
+  /* bulk load mode */
+  GtRDBStmt *begin_stmt,
+            *commit_stmt;
+  GtRDBVisitor *index_visitor;
+  GtUword nof_uncommitted;
+  bool bulk_load,
+       in_transaction,
+       indexes_deferred;
 } GtFeatureIndexGFFlike;
 
 const GtAnnoDBSchemaClass* gt_anno_db_gfflike_class(void);
 static const GtRDBVisitorClass* gfflike_setup_visitor_class(void);
+static const GtRDBVisitorClass* gfflike_index_visitor_class(void);
 static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 
 #define anno_db_gfflike_cast(V)\
@@ -93,6 +136,38 @@ static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 #define feature_index_gfflike_cast(V)\
         gt_feature_index_cast(feature_index_gfflike_class(), V)
 
+static GtUword gfflike_bin(GtUword start, GtUword end)
+{
+  unsigned int i;
+  gt_assert(start <= end);
+  if (end > GFFLIKE_BIN_MAXPOS)
+    return 0;
+  for (i = 0; i < GFFLIKE_NOF_BIN_LEVELS; i++) {
+    if (start >> gfflike_bin_shifts[i] == end >> gfflike_bin_shifts[i])
+      return gfflike_bin_offsets[i] + (start >> gfflike_bin_shifts[i]);
+  }
+  return 0;
+}
+
+/* Stores the first and last bin on each level which may contain features
+   overlapping <start>..<end> in <bins>. */
+static void gfflike_query_bins(GtUword *bins, GtUword start, GtUword end)
+{
+  unsigned int i;
+  gt_assert(start <= end);
+  for (i = 0; i < GFFLIKE_NOF_BIN_LEVELS; i++) {
+    if (start > GFFLIKE_BIN_MAXPOS) {
+      /* empty range, only the catch-all bin can match */
+      bins[2*i] = 1;
+      bins[2*i+1] = 0;
+    } else {
+      bins[2*i] = gfflike_bin_offsets[i] + (start >> gfflike_bin_shifts[i]);
+      bins[2*i+1] = gfflike_bin_offsets[i]
+                    + (MIN(end, GFFLIKE_BIN_MAXPOS) >> gfflike_bin_shifts[i]);
+    }
+  }
+}
+
 static int anno_db_gfflike_validate_sqlite(GtRDBSqlite *db, GtError *err,
                                            bool *check)
 {
@@ -156,7 +231,8 @@ static int anno_db_gfflike_create_tables_sqlite(GtRDBSqlite *db, GtError *err)
                            "is_multi INTEGER NOT NULL, "
                            "is_pseudo INTEGER NOT NULL, "
                            "is_marked INTEGER NOT NULL, "
-                           "multi_representative INTEGER NOT NULL)",
+                           "multi_representative INTEGER NOT NULL, "
+                           "bin INTEGER NOT NULL)",
                            0, err);
   if (!stmt || (had_err = gt_rdb_stmt_exec(stmt, err)) < 0) {
     return -1;
@@ -249,8 +325,8 @@ static int anno_db_gfflike_create_indexes_sqlite(GtRDBSqlite *db, GtError *err)
     return -1;
   } else gt_rdb_stmt_delete(stmt);
   stmt = gt_rdb_prepare((GtRDB*) db,
-                           "CREATE INDEX IF NOT EXISTS feature_seqid "
-                           "ON features (seqid)",
+                           "CREATE INDEX IF NOT EXISTS feature_bin "
+                           "ON features (seqid, bin)",
                            0,
                            err);
   if (!stmt || (had_err = gt_rdb_stmt_exec(stmt, err)) < 0) {
@@ -343,7 +419,8 @@ static int anno_db_gfflike_create_tables_mysql(GtRDBMySQL *db, GtError *err)
                            "is_multi INTEGER NOT NULL, "
                            "is_pseudo INTEGER NOT NULL, "
                            "is_marked INTEGER NOT NULL, "
-                           "multi_representative INTEGER NOT NULL)",
+                           "multi_representative INTEGER NOT NULL, "
+                           "bin INTEGER NOT NULL)",
                            0,
                            err);
   if (!stmt || (had_err = gt_rdb_stmt_exec(stmt, err)) < 0) {
@@ -459,10 +536,10 @@ static int anno_db_gfflike_create_indexes_mysql(GtRDBMySQL *db, GtError *err)
     gt_rdb_stmt_delete(stmt);
   }
 
-  if (!gt_cstr_table_get(cst, "feature_seqid")) {
+  if (!gt_cstr_table_get(cst, "feature_bin")) {
     stmt = gt_rdb_prepare((GtRDB*) db,
-                             "CREATE INDEX feature_seqid "
-                             "ON features (seqid)",
+                             "CREATE INDEX feature_bin "
+                             "ON features (seqid, bin)",
                              0,
                              err);
     if (!stmt || (had_err = gt_rdb_stmt_exec(stmt, err)) < 0) {
@@ -546,9 +623,64 @@ static int anno_db_gfflike_create_indexes_mysql(GtRDBMySQL *db, GtError *err)
   return 0;
 }
 
-int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
+/* Adds the bin column to feature tables created before features were binned
+   and assigns the bins of the stored features. <added> is set to true if the
+   column had to be added. */
+static int anno_db_gfflike_add_bins(GtRDB *db, bool *added, GtError *err)
+{
+  GtRDBStmt *stmt;
+  GtError *testerr;
+  gt_assert(db && added);
+
+  testerr = gt_error_new();
+  stmt = gt_rdb_prepare(db, "SELECT bin FROM features LIMIT 1", 0, testerr);
+  gt_error_delete(testerr);
+  *added = (stmt == NULL);
+  if (stmt) {
+    /* column exists already */
+    gt_rdb_stmt_delete(stmt);
+    return 0;
+  }
+  stmt = gt_rdb_prepare(db,
+                        "ALTER TABLE features "
+                        "ADD COLUMN bin INTEGER NOT NULL DEFAULT 0",
+                        0,
+                        err);
+  if (!stmt || gt_rdb_stmt_exec(stmt, err) < 0) {
+    gt_rdb_stmt_delete(stmt);
+    return -1;
+  }
+  gt_rdb_stmt_delete(stmt);
+  stmt = gt_rdb_prepare(db, "UPDATE features SET bin = " GFFLIKE_BIN_SQL, 0,
+                        err);
+  if (!stmt || gt_rdb_stmt_exec(stmt, err) < 0) {
+    gt_rdb_stmt_delete(stmt);
+    return -1;
+  }
+  gt_rdb_stmt_delete(stmt);
+  return 0;
+}
+
+/* Gathers the statistics the SQLite query planner needs to use the bin index
+   for range queries. */
+static int anno_db_gfflike_analyze_sqlite(GtRDBSqlite *db, GtError *err)
+{
+  GtRDBStmt *stmt;
+  gt_assert(db);
+  stmt = gt_rdb_prepare((GtRDB*) db, "ANALYZE", 0, err);
+  if (!stmt || gt_rdb_stmt_exec(stmt, err) < 0) {
+    gt_rdb_stmt_delete(stmt);
+    return -1;
+  }
+  gt_rdb_stmt_delete(stmt);
+  return 0;
+}
+
+int anno_db_gfflike_init_sqlite(GtRDBVisitor *rdbv, GtRDBSqlite *db,
                                 GtError *err)
 {
+  GFFlikeSetupVisitor *sv = gfflike_setup_visitor_cast(rdbv);
+  bool added_bins = false;
   GtCstrTable *cst = NULL;
   GtStrArray *arr = NULL;
   bool check = true;
@@ -578,16 +710,24 @@ int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
                       "tables are missing");
     had_err = -1;
   }
-  if (!had_err) {
+  if (!had_err)
+    had_err = anno_db_gfflike_add_bins((GtRDB*) db, &added_bins, err);
+  /* in bulk load mode, the indexes are created after loading */
+  if (!had_err && !sv->annodb->bulk_load) {
     had_err = anno_db_gfflike_create_indexes_sqlite(db, err);
   }
+  if (!had_err && added_bins && !sv->annodb->bulk_load) {
+    had_err = anno_db_gfflike_analyze_sqlite(db, err);
+  }
 
   return had_err;
 }
 
-int anno_db_gfflike_init_mysql(GT_UNUSED GtRDBVisitor *rdbv, GtRDBMySQL *db,
+int anno_db_gfflike_init_mysql(GtRDBVisitor *rdbv, GtRDBMySQL *db,
                                GtError *err)
 {
+  GFFlikeSetupVisitor *sv = gfflike_setup_visitor_cast(rdbv);
+  bool added_bins = false;
   GtCstrTable *cst = NULL;
   GtStrArray *arr = NULL;
   bool check = true;
@@ -616,13 +756,34 @@ int anno_db_gfflike_init_mysql(GT_UNUSED GtRDBVisitor *rdbv, GtRDBMySQL *db,
     gt_error_set(err, "corrupt database schema: tables are missing");
     had_err = -1;
   }
-  if (!had_err) {
+  if (!had_err)
+    had_err = anno_db_gfflike_add_bins((GtRDB*) db, &added_bins, err);
+  /* in bulk load mode, the indexes are created after loading */
+  if (!had_err && !sv->annodb->bulk_load) {
     had_err = anno_db_gfflike_create_indexes_mysql(db, err);
   }
 
   return had_err;
 }
 
+static int anno_db_gfflike_finish_sqlite(GT_UNUSED GtRDBVisitor *rdbv,
+                                         GtRDBSqlite *db, GtError *err)
+{
+  int had_err;
+  gt_assert(db);
+  had_err = anno_db_gfflike_create_indexes_sqlite(db, err);
+  if (!had_err)
+    had_err = anno_db_gfflike_analyze_sqlite(db, err);
+  return had_err;
+}
+
+static int anno_db_gfflike_finish_mysql(GT_UNUSED GtRDBVisitor *rdbv,
+                                        GtRDBMySQL *db, GtError *err)
+{
+  gt_assert(db);
+  return anno_db_gfflike_create_indexes_mysql(db, err);
+}
+
 void anno_db_gfflike_free(GtAnnoDBSchema *s)
 {
   GtAnnoDBGFFlike *adg = anno_db_gfflike_cast(s);
@@ -641,6 +802,44 @@ DEFINE_HASHMAP(GtUword, ul, GtFeatureNode*, node, gt_ht_ul_elem_hash,
                gt_ht_ul_elem_cmp, NULL_DESTRUCTOR, NULL_DESTRUCTOR, static,
                inline)
 
+/* In bulk load mode, insertions are grouped into large transactions. */
+static int bulk_load_begin(GtFeatureIndexGFFlike *fi, GtError *err)
+{
+  gt_assert(fi);
+  if (!fi->bulk_load || fi->in_transaction)
+    return 0;
+  gt_rdb_stmt_reset(fi->begin_stmt, err);
+  if (gt_rdb_stmt_exec(fi->begin_stmt, err) < 0)
+    return -1;
+  fi->in_transaction = true;
+  fi->nof_uncommitted = 0;
+  return 0;
+}
+
+static int bulk_load_commit(GtFeatureIndexGFFlike *fi, GtError *err)
+{
+  gt_assert(fi);
+  if (!fi->in_transaction)
+    return 0;
+  fi->in_transaction = false;
+  gt_rdb_stmt_reset(fi->commit_stmt, err);
+  return gt_rdb_stmt_exec(fi->commit_stmt, err) < 0 ? -1 : 0;
+}
+
+/* Commits the pending insertions and creates the deferred indexes. */
+static int bulk_load_finish(GtFeatureIndexGFFlike *fi, GtError *err)
+{
+  int had_err;
+  gt_assert(fi);
+  had_err = bulk_load_commit(fi, err);
+  if (!had_err && fi->indexes_deferred) {
+    had_err = gt_rdb_accept(fi->db, fi->index_visitor, err);
+    if (!had_err)
+      fi->indexes_deferred = false;
+  }
+  return had_err;
+}
+
 int gt_feature_index_gfflike_add_region_node(GtFeatureIndex *gfi,
                                              GtRegionNode *rn,
                                              GtError *err)
@@ -653,6 +852,8 @@ int gt_feature_index_gfflike_add_region_node(GtFeatureIndex *gfi,
   gt_assert(fi && rn);
   seqid = gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) rn));
   rng = gt_genome_node_get_range((GtGenomeNode*) rn);
+  if (bulk_load_begin(fi, err))
+    return -1;
   gt_rdb_stmt_reset(fi->stmts[GT_PSTMT_SEQUENCEREGION_INSERT], err);
   gt_rdb_stmt_bind_string(fi->stmts[GT_PSTMT_SEQUENCEREGION_INSERT],
                           0, seqid, err);
@@ -859,6 +1060,8 @@ static int insert_single_node(GtFeatureIndexGFFlike *fi,
                        gt_feature_node_is_pseudo(fn), err);
   gt_rdb_stmt_bind_int(fi->stmts[GT_PSTMT_FEATURE_INSERT], 11,
                        gt_feature_node_is_marked(fn), err);
+  gt_rdb_stmt_bind_ulong(fi->stmts[GT_PSTMT_FEATURE_INSERT], 12,
+                         gfflike_bin(rng.start, rng.end), err);
   rval = gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_FEATURE_INSERT], err);
   if (rval < 0) gt_error_check(err);
 
@@ -1022,12 +1225,19 @@ int gt_feature_index_gfflike_add_feature_node(GtFeatureIndex *gfi,
   gt_assert(gfi && gf);
 
   fi = feature_index_gfflike_cast(gfi);
-  had_err = insert_feature_node(fi,
-                                (GtFeatureNode*)
+  had_err = bulk_load_begin(fi, err);
+  if (!had_err) {
+    had_err = insert_feature_node(fi,
+                                  (GtFeatureNode*)
                                          gt_genome_node_ref((GtGenomeNode*) gf),
-                                err);
+                                  err);
+  }
   if (!had_err)
     gt_hashmap_add(fi->ref_nodes, gf, (void*) 1);
+  if (!had_err && fi->in_transaction &&
+      ++fi->nof_uncommitted == GFFLIKE_BULK_LOAD_BATCH_SIZE) {
+    had_err = bulk_load_commit(fi, err);
+  }
   return had_err;
 }
 
@@ -1254,6 +1464,10 @@ static int gt_feature_index_gfflike_save(GtFeatureIndex *fi,
   oci = (ObserverCallbackInfo*) fig->obs->data;
 
   gt_mutex_lock(fig->dblock);
+  if (fig->bulk_load && bulk_load_finish(fig, err)) {
+    gt_mutex_unlock(fig->dblock);
+    return -1;
+  }
   stmt_b = gt_rdb_prepare(fig->db, "BEGIN TRANSACTION;", 0, err);
   stmt_e = gt_rdb_prepare(fig->db, "END TRANSACTION;", 0, err);
   gt_rdb_stmt_exec(stmt_b, err);
@@ -1289,7 +1503,7 @@ static int gt_feature_index_gfflike_save(GtFeatureIndex *fi,
 
   gt_rdb_stmt_delete(stmt_e);
   gt_rdb_stmt_delete(stmt_b);
-  gt_mutex_lock(fig->dblock);
+  gt_mutex_unlock(fig->dblock);
 
   return had_err;
 }
@@ -1315,7 +1529,8 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
     gt_ht_ptr_elem_cmp,
     NULL,
     NULL };
-  GtHashtable *seen_as_children = gt_hashtable_new(node_hashtype);
+  GtHashtable *seen_as_children = gt_hashtable_new(node_hashtype),
+              *created = gt_hashtable_new(node_hashtype);
 
   while (!had_err && gt_rdb_stmt_exec(stmt, err) == 0) {
     GtUword id = GT_UNDEF_UWORD, multi_rep = GT_UNDEF_UWORD, *idp;
@@ -1359,8 +1574,11 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
       if (score != GT_UNDEF_DOUBLE)
         gt_feature_node_set_score(newfn, score);
 
-      /* cache node */
+      /* cache node, the cache keeps its own reference and the returned nodes
+         are owned by the index */
       ul_node_gt_hashmap_add(fi->cache_id2node, id, newfn);
+      gt_hashmap_add(fi->ref_nodes, gt_genome_node_ref(newgn), (void*) 1);
+      gt_hashtable_add(created, &newfn);
       if (!(idp = node_ul_gt_hashmap_get(fi->cache_node2id, newfn)))
       {
         node_ul_gt_hashmap_add(fi->cache_node2id, newfn, id);
@@ -1418,6 +1636,9 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
       parent = *(GtFeatureNode**) ul_node_gt_hashmap_get(fi->cache_id2node,
                                                        par_id);
       gt_assert(parent);
+      /* a cached node is already linked to all of its parents */
+      if (!gt_hashtable_get(created, &newfn))
+        continue;
       /* if a child has multiple parents, increase refcount */
       if (gt_hashtable_get(seen_as_children, &newfn)) {
         gt_genome_node_ref((GtGenomeNode*) newfn);
@@ -1427,6 +1648,9 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
     }
     if (!is_child) {
       GtGenomeNode *newgn = (GtGenomeNode*) newfn;
+      /* new top-level nodes are only referenced by the cache */
+      if (gt_hashtable_get(created, &newfn))
+        gt_genome_node_delete(newgn);
       gt_array_add(results, newgn);
     }
   }
@@ -1438,6 +1662,7 @@ static int get_nodes_for_stmt(GtFeatureIndexGFFlike *fi,
   }
   gt_array_delete(nodes);
   gt_hashtable_delete(seen_as_children);
+  gt_hashtable_delete(created);
   return had_err;
 }
 
@@ -1453,9 +1678,11 @@ GtArray* gt_feature_index_gfflike_get_features_for_seqid(GtFeatureIndex *gfi,
   fi = feature_index_gfflike_cast(gfi);
   stmt = fi->stmts[GT_PSTMT_GET_BY_SEQID_SELECT];
   a = gt_array_new(sizeof (GtFeatureNode*));
+  gt_mutex_lock(fi->dblock);
   gt_rdb_stmt_reset(stmt, err);
   gt_rdb_stmt_bind_string(stmt, 0, seqid, err);
   get_nodes_for_stmt(fi, a, stmt, err);
+  gt_mutex_unlock(fi->dblock);
   return a;
 }
 
@@ -1466,6 +1693,7 @@ int gt_feature_index_gfflike_get_features_for_range(GtFeatureIndex *gfi,
                                                     GtError *err)
 {
   GtFeatureIndexGFFlike *fi;
+  GtUword bins[2 * GFFLIKE_NOF_BIN_LEVELS], i;
   int retval;
   gt_error_check(err);
   GtRDBStmt *stmt;
@@ -1473,11 +1701,14 @@ int gt_feature_index_gfflike_get_features_for_range(GtFeatureIndex *gfi,
   gt_error_check(err);
   fi = feature_index_gfflike_cast(gfi);
   stmt = fi->stmts[GT_PSTMT_GET_RANGE_SELECT];
+  gfflike_query_bins(bins, qry_range->start, qry_range->end);
   gt_mutex_lock(fi->dblock);
   gt_rdb_stmt_reset(stmt, err);
   gt_rdb_stmt_bind_string(stmt, 0, seqid, err);
-  gt_rdb_stmt_bind_ulong(stmt, 1, qry_range->end, err);
-  gt_rdb_stmt_bind_ulong(stmt, 2, qry_range->start, err);
+  for (i = 0; i < 2 * GFFLIKE_NOF_BIN_LEVELS; i++)
+    gt_rdb_stmt_bind_ulong(stmt, 1 + i, bins[i], err);
+  gt_rdb_stmt_bind_ulong(stmt, 1 + i, qry_range->end, err);
+  gt_rdb_stmt_bind_ulong(stmt, 2 + i, qry_range->start, err);
   retval = get_nodes_for_stmt(fi, results, stmt, err);
   gt_mutex_unlock(fi->dblock);
   return retval;
@@ -1650,6 +1881,16 @@ void gt_feature_index_gfflike_delete(GtFeatureIndex *gfi)
   GtUword i;
   if (!gfi) return;
   fi = feature_index_gfflike_cast(gfi);
+  if (fi->bulk_load && fi->db) {
+    /* errors cannot be reported here, the indexes are created on the next
+       regular opening of the database if this fails */
+    GtError *finish_err = gt_error_new();
+    (void) bulk_load_finish(fi, finish_err);
+    gt_error_delete(finish_err);
+  }
+  gt_rdb_stmt_delete(fi->begin_stmt);
+  gt_rdb_stmt_delete(fi->commit_stmt);
+  gt_rdb_visitor_delete(fi->index_visitor);
   for (i=0;i<GT_PSTMT_NOF_STATEMENTS;i++) {
     gt_rdb_stmt_delete(fi->stmts[i]);
   }
@@ -1672,7 +1913,7 @@ void gt_feature_index_gfflike_delete(GtFeatureIndex *gfi)
 
 const GtFeatureIndexClass* feature_index_gfflike_class(void)
 {
-  static const GtFeatureIndexClass *fic = NULL;
+  static GtFeatureIndexClass *fic = NULL;
   if (!fic) {
     fic = gt_feature_index_class_new(sizeof (GtFeatureIndexGFFlike),
                                 gt_feature_index_gfflike_add_region_node,
@@ -1687,6 +1928,10 @@ const GtFeatureIndexClass* feature_index_gfflike_class(void)
                                 gt_feature_index_gfflike_get_range_for_seqid,
                                 gt_feature_index_gfflike_has_seqid,
                                 gt_feature_index_gfflike_delete);
+    /* queries remain serialized on the database connection, freezing only
+       flushes pending changes */
+    gt_feature_index_class_set_freeze_func(fic,
+                                           gt_feature_index_gfflike_save);
   }
   return fic;
 }
@@ -1748,10 +1993,10 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
                         "INSERT INTO features "
                         "(seqid, source, type, start, end, score, strand, "
                         "phase, is_multi, "
-                        "multi_representative, is_pseudo, is_marked) "
+                        "multi_representative, is_pseudo, is_marked, bin) "
                         "VALUES "
-                        "(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
-                         12,
+                        "(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                         13,
                          err);
   if (!r) return -1;
   r = fis->stmts[GT_PSTMT_FEATURE_UPDATE] = gt_rdb_prepare(fis->db,
@@ -1779,11 +2024,18 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
                         "     sources src, types t "
                         "WHERE s.sequenceregion_name = ?  "
                         "AND s.sequenceregion_id = f.seqid "
+                        "AND (f.bin = 0 "
+                        "     OR f.bin BETWEEN ? AND ? "
+                        "     OR f.bin BETWEEN ? AND ? "
+                        "     OR f.bin BETWEEN ? AND ? "
+                        "     OR f.bin BETWEEN ? AND ? "
+                        "     OR f.bin BETWEEN ? AND ? "
+                        "     OR f.bin BETWEEN ? AND ?) "
                         "AND (f.start <= ? AND f.end >= ?) "
                         "AND src.source_id = f.source "
                         "AND t.type_id = f.type "
                         "ORDER BY f.id ASC",
-                         3,
+                         3 + 2 * GFFLIKE_NOF_BIN_LEVELS,
                          err);
   if (!r) return -1;
   r = fis->stmts[GT_PSTMT_GET_ALL] = gt_rdb_prepare(fis->db,
@@ -1979,7 +2231,17 @@ GtFeatureIndex* anno_db_gfflike_build(GtAnnoDBSchema *schema, GtRDB *db,
     fis->obs->child_added = node_child_add_callback;
     fis->db = gt_rdb_ref(db);
 
-    if (prepstmt_init(fis, err)) {
+    if (adg->bulk_load) {
+      fis->bulk_load = true;
+      fis->indexes_deferred = true;
+      fis->index_visitor = gt_rdb_visitor_create(gfflike_index_visitor_class());
+      if (!(fis->begin_stmt = gt_rdb_prepare(db, "BEGIN", 0, err)) ||
+          !(fis->commit_stmt = gt_rdb_prepare(db, "COMMIT", 0, err))) {
+        had_err = -1;
+      }
+    }
+
+    if (had_err || prepstmt_init(fis, err)) {
       gt_feature_index_delete(fi);
       fi = NULL;
     }
@@ -2014,6 +2276,20 @@ static const GtRDBVisitorClass* gfflike_setup_visitor_class()
   return svc;
 }
 
+static const GtRDBVisitorClass* gfflike_index_visitor_class()
+{
+  static const GtRDBVisitorClass *ivc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!ivc) {
+    ivc = gt_rdb_visitor_class_new(sizeof (GFFlikeIndexVisitor),
+                                   NULL,
+                                   anno_db_gfflike_finish_sqlite,
+                                   anno_db_gfflike_finish_mysql);
+  }
+  gt_class_alloc_lock_leave();
+  return ivc;
+}
+
 static GtRDBVisitor* gfflike_setup_visitor_new(GtAnnoDBGFFlike *adb)
 {
   GtRDBVisitor *v = gt_rdb_visitor_create(gfflike_setup_visitor_class());
@@ -2031,8 +2307,17 @@ GtAnnoDBSchema* gt_anno_db_gfflike_new(void)
   return s;
 }
 
+GtAnnoDBSchema* gt_anno_db_gfflike_new_bulk_load(void)
+{
+  GtAnnoDBSchema *s = gt_anno_db_gfflike_new();
+  GtAnnoDBGFFlike *adg = anno_db_gfflike_cast(s);
+  adg->bulk_load = true;
+  return s;
+}
+
 int gt_anno_db_gfflike_unit_test(GtError *err)
 {
+  GtUword i;
   int had_err = 0, status = 0;
   GtFeatureIndex *fi = NULL;
   GtError *testerr = NULL;
@@ -2071,12 +2356,63 @@ int gt_anno_db_gfflike_unit_test(GtError *err)
   }
 
   gt_xremove(gt_str_get(tmpfilename));
-  gt_str_delete(tmpfilename);
   gt_feature_index_delete(fi);
+  fi = NULL;
   gt_anno_db_schema_delete(adb);
+  adb = NULL;
 #ifdef HAVE_SQLITE
   gt_rdb_delete((GtRDB*) rdb);
 #endif
+
+  /* bins of overlapping features are always among the query bins */
+  for (i = 0; !had_err && i < 10000; i++) {
+    GtUword bins[2 * GFFLIKE_NOF_BIN_LEVELS], bin, j,
+            start = gt_rand_max(1UL << 30),
+            end = start + gt_rand_max(1UL << gt_rand_max(29)),
+            qstart = end - gt_rand_max(end - start + 1),
+            qend = qstart + gt_rand_max(1UL << 20) + 1;
+    bool found = false;
+    bin = gfflike_bin(start, end);
+    gfflike_query_bins(bins, qstart, qend);
+    for (j = 0; !found && j < GFFLIKE_NOF_BIN_LEVELS; j++)
+      found = bins[2*j] <= bin && bin <= bins[2*j+1];
+    gt_ensure(bin == 0 || found);
+  }
+  if (!had_err) {
+    gt_ensure(gfflike_bin(1, 1) == gfflike_bin_offsets[0]);
+    gt_ensure(gfflike_bin(1, 1UL << 14) == gfflike_bin_offsets[1]);
+    gt_ensure(gfflike_bin(1, GFFLIKE_BIN_MAXPOS) == 0);
+  }
+
+#ifdef HAVE_SQLITE
+  /* run generic feature index tests in bulk load mode */
+  if (!had_err) {
+    rdb = gt_rdb_sqlite_new(gt_str_get(tmpfilename), testerr);
+    gt_ensure(rdb != NULL);
+  }
+  if (!had_err) {
+    adb = gt_anno_db_gfflike_new_bulk_load();
+    fi = gt_anno_db_schema_get_feature_index(adb, rdb, testerr);
+    gt_ensure(fi != NULL);
+  }
+  if (!had_err) {
+    status = gt_feature_index_unit_test(fi, testerr);
+    gt_ensure(status == 0);
+  }
+  if (!had_err) {
+    GtCstrTable *indexes;
+    gt_ensure(gt_feature_index_save(fi, testerr) == 0);
+    indexes = gt_rdb_get_indexes(rdb, testerr);
+    gt_ensure(indexes && gt_cstr_table_get(indexes, "feature_bin"));
+    gt_cstr_table_delete(indexes);
+  }
+  gt_feature_index_delete(fi);
+  gt_anno_db_schema_delete(adb);
+  gt_rdb_delete((GtRDB*) rdb);
+  gt_xremove(gt_str_get(tmpfilename));
+#endif
+
+  gt_str_delete(tmpfilename);
   gt_error_delete(testerr);
   return had_err;
 }
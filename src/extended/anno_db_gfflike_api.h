@@ -29,6 +29,13 @@ typedef struct GtAnnoDBGFFlike GtAnnoDBGFFlike;
 /* Creates a new <GtAnnoDBGFFlike> schema object. */
 GtAnnoDBSchema* gt_anno_db_gfflike_new(void);
 
+/* Creates a new <GtAnnoDBGFFlike> schema object for loading large amounts of
+   annotations. Feature indexes created from it insert features in large
+   transactions and only create the database indexes when
+   <gt_feature_index_save()> is called or the feature index is deleted, so
+   queries are slow until then. */
+GtAnnoDBSchema* gt_anno_db_gfflike_new_bulk_load(void);
+
 /* Retrieves all features contained in <gfi> into <results>. Returns 0 on
    success, a negative value otherwise. The message in <err> is set
    accordingly. */
@@ -0,0 +1,151 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/file.h"
+#include "core/ma_api.h"
+#include "core/str_array_api.h"
+#include "extended/binary_in_stream_api.h"
+#include "extended/binary_node_format.h"
+#include "extended/binary_node_reader.h"
+#include "extended/node_stream_api.h"
+
+struct GtBinaryInStream {
+  const GtNodeStream parent_instance;
+  GtStrArray *files;
+  GtUword next_file;
+  GtFile *fpin;
+  const char *filename;
+  GtBinaryNodeReader *reader;
+  bool stdin_argument;
+};
+
+#define binary_in_stream_cast(GS)\
+        gt_node_stream_cast(gt_binary_in_stream_class(), GS);
+
+/* Prefixes the error message in <err> with the current file name. */
+static void set_file_error(GtBinaryInStream *bis, GtError *err)
+{
+  char *msg = gt_cstr_dup(gt_error_get(err));
+  gt_error_set(err, "file \"%s\": %s", bis->filename, msg);
+  gt_free(msg);
+}
+
+static int open_next_file(GtBinaryInStream *bis, GtError *err)
+{
+  const char *path;
+  int had_err = 0;
+  gt_error_check(err);
+  if (bis->stdin_argument) {
+    path = "-";
+    bis->stdin_argument = false;
+  }
+  else
+    path = gt_str_array_get(bis->files, bis->next_file++);
+  bis->filename = strcmp(path, "-") == 0 ? "stdin" : path;
+  /* stdin is opened as a GtFile as well, which continues a stream that has
+     been peeked at by gt_binary_in_stream_is_binary_file() */
+  if (!(bis->fpin = gt_file_new(path, "r", err)))
+    had_err = -1;
+  if (!had_err) {
+    bis->reader = gt_binary_node_reader_new(bis->fpin);
+    if ((had_err = gt_binary_node_reader_read_header(bis->reader, err)))
+      set_file_error(bis, err);
+  }
+  return had_err;
+}
+
+static void close_file(GtBinaryInStream *bis)
+{
+  gt_binary_node_reader_delete(bis->reader);
+  bis->reader = NULL;
+  gt_file_delete(bis->fpin);
+  bis->fpin = NULL;
+}
+
+static int binary_in_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                 GtError *err)
+{
+  GtBinaryInStream *bis;
+  int had_err = 0;
+  gt_error_check(err);
+  bis = binary_in_stream_cast(ns);
+  *gn = NULL;
+  while (!had_err && !*gn) {
+    if (!bis->reader) {
+      if (!bis->stdin_argument &&
+          bis->next_file == gt_str_array_size(bis->files)) {
+        break; /* all files have been read */
+      }
+      had_err = open_next_file(bis, err);
+    }
+    if (!had_err) {
+      if ((had_err = gt_binary_node_reader_next(bis->reader, gn, err)))
+        set_file_error(bis, err);
+      else if (!*gn)
+        close_file(bis);
+    }
+  }
+  return had_err;
+}
+
+static void binary_in_stream_free(GtNodeStream *ns)
+{
+  GtBinaryInStream *bis = binary_in_stream_cast(ns);
+  close_file(bis);
+  gt_str_array_delete(bis->files);
+}
+
+const GtNodeStreamClass* gt_binary_in_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtBinaryInStream),
+                                   binary_in_stream_free,
+                                   binary_in_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_binary_in_stream_new(int num_of_files, const char **filenames)
+{
+  GtNodeStream *ns = gt_node_stream_create(gt_binary_in_stream_class(), false);
+  GtBinaryInStream *bis = binary_in_stream_cast(ns);
+  int i;
+  bis->files = gt_str_array_new();
+  for (i = 0; i < num_of_files; i++)
+    gt_str_array_add_cstr(bis->files, filenames[i]);
+  bis->next_file = 0;
+  bis->fpin = NULL;
+  bis->filename = NULL;
+  bis->reader = NULL;
+  bis->stdin_argument = num_of_files == 0;
+  return ns;
+}
+
+bool gt_binary_in_stream_is_binary_file(const char *filename)
+{
+  char magic[GT_BINARY_NODE_MAGIC_LENGTH];
+  gt_assert(filename);
+  /* streams are only peeked at and can be opened again afterwards */
+  return gt_file_peek(filename, magic, sizeof magic, NULL)
+           == (int) sizeof magic &&
+         !memcmp(magic, GT_BINARY_NODE_MAGIC, GT_BINARY_NODE_MAGIC_LENGTH);
+}
@@ -0,0 +1,40 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BINARY_IN_STREAM_API_H
+#define BINARY_IN_STREAM_API_H
+
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtBinaryInStream> reads files
+   written by a <GtBinaryOutStream> and returns them as a stream of
+   <GtGenomeNode> objects. */
+typedef struct GtBinaryInStream GtBinaryInStream;
+
+const GtNodeStreamClass* gt_binary_in_stream_class(void);
+/* Return a <GtBinaryInStream> object which subsequently reads the
+   <num_of_files> many binary node files denoted in <filenames>. If
+   <num_of_files> is 0 or a file name is "-", it is read from <stdin>. */
+GtNodeStream*            gt_binary_in_stream_new(int num_of_files,
+                                                 const char **filenames);
+/* Return <true> if the file denoted by <filename> is a binary node file,
+   <false> otherwise (or if it cannot be read). A <filename> of "-" denotes
+   <stdin>. Streams such as <stdin> or pipes are not consumed by the check,
+   they can still be read by a binary or GFF3 input stream afterwards. */
+bool                     gt_binary_in_stream_is_binary_file(const char
+                                                            *filename);
+
+#endif
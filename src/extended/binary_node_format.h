@@ -0,0 +1,65 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BINARY_NODE_FORMAT_H
+#define BINARY_NODE_FORMAT_H
+
+/* The binary genome node format written by <GtBinaryNodeWriter> and read by
+   <GtBinaryNodeReader>. Binary node files start with a header consisting of
+   <GT_BINARY_NODE_MAGIC> and the version byte. Every genome node is stored as a
+   record which starts with one of the record types below. All integers are
+   stored as unsigned varints (7 bits per byte, least significant group first,
+   the high bit marks continuation). Strings which occur often (sequence IDs,
+   sources, types, attribute tags, and file names) are interned: they are
+   referenced by <id + 1> into a dictionary which is built while writing and
+   reading, a reference equal to the current dictionary size + 1 defines the
+   next entry (followed by its length and content), and the reference 0 denotes
+   NULL. Other strings are stored as their length followed by their content.
+   Alternatively, the dictionary can be detached from the records (to be able
+   to read them in any order): then the records only contain references, and
+   the dictionary is stored separately as the number of strings followed by
+   the strings.
+
+   A feature node record stores the number of nodes in the feature node graph,
+   followed by the nodes in breadth-first order (the top-level node first).
+   Each node consists of its sequence ID, source, type (NULL for pseudo-nodes),
+   origin (file name and line number), start, length - 1, flags, the score (if
+   defined, as 4 bytes little endian IEEE 754), the index + 1 of its
+   multi-feature representative (if it is a multi-feature), the attributes (tag
+   and value, terminated by a NULL tag), and the indices + 1 of its children
+   (terminated by 0). */
+
+#define GT_BINARY_NODE_MAGIC         "GTNODES"
+#define GT_BINARY_NODE_MAGIC_LENGTH  7
+#define GT_BINARY_NODE_VERSION       1
+
+typedef enum {
+  GT_BINARY_NODE_FEATURE = 1,
+  GT_BINARY_NODE_REGION,
+  GT_BINARY_NODE_COMMENT,
+  GT_BINARY_NODE_META,
+  GT_BINARY_NODE_SEQUENCE,
+  GT_BINARY_NODE_EOF
+} GtBinaryNodeRecordType;
+
+#define GT_BINARY_NODE_STRAND_MASK          7U
+#define GT_BINARY_NODE_PHASE_OFFSET         3
+#define GT_BINARY_NODE_PHASE_MASK           3U
+#define GT_BINARY_NODE_SCORE_IS_DEFINED     (1U << 5)
+#define GT_BINARY_NODE_PSEUDO               (1U << 6)
+#define GT_BINARY_NODE_MULTI                (1U << 7)
+
+#endif
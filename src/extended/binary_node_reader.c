@@ -0,0 +1,631 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <inttypes.h>
+#include <string.h>
+#include "core/array.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "extended/binary_node_format.h"
+#include "extended/binary_node_reader.h"
+#include "extended/comment_node_api.h"
+#include "extended/eof_node_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/genome_node.h"
+#include "extended/meta_node_api.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
+
+#define BINARY_NODE_READER_BUFSIZE  65536
+
+struct GtBinaryNodeReader {
+  GtFile *infp; /* NULL if reading from memory */
+  unsigned char *inbuf;
+  GtUword inpos,
+          inlen;
+  GtArray *dictionary, /* the interned strings (GtStr*) */
+          *nodes,      /* the feature nodes of the current graph */
+          *infos,      /* the BinaryNodeInfo of each feature node */
+          *edges;      /* parent and child index pairs */
+  char *buf;
+  GtUword bufsize;
+};
+
+typedef struct {
+  GtStr *seqid;
+  GtUword rep; /* representative index + 1 (0 if no multi-feature) */
+  bool pseudo;
+} BinaryNodeInfo;
+
+typedef struct {
+  GtStr *filename;
+  GtUword line_number;
+} BinaryNodeOrigin;
+
+GtBinaryNodeReader* gt_binary_node_reader_new(GtFile *infp)
+{
+  GtBinaryNodeReader *bnr = gt_malloc(sizeof *bnr);
+  bnr->infp = infp;
+  bnr->inbuf = gt_malloc(BINARY_NODE_READER_BUFSIZE);
+  bnr->inpos = bnr->inlen = 0;
+  bnr->dictionary = gt_array_new(sizeof (GtStr*));
+  bnr->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  bnr->infos = gt_array_new(sizeof (BinaryNodeInfo));
+  bnr->edges = gt_array_new(sizeof (GtUword));
+  bnr->buf = NULL;
+  bnr->bufsize = 0;
+  return bnr;
+}
+
+GtBinaryNodeReader* gt_binary_node_reader_new_from_memory(const void *mem,
+                                                          GtUword length)
+{
+  GtBinaryNodeReader *bnr = gt_binary_node_reader_new(NULL);
+  gt_free(bnr->inbuf);
+  /* the input is only read, never written */
+  bnr->inbuf = (unsigned char*) mem;
+  bnr->inlen = length;
+  return bnr;
+}
+
+/* Refills the input buffer of <bnr>, returns false at the end of the input. */
+static bool fill_buffer(GtBinaryNodeReader *bnr)
+{
+  int rval;
+  if (!bnr->infp)
+    return false;
+  rval = gt_file_xread(bnr->infp, bnr->inbuf, BINARY_NODE_READER_BUFSIZE);
+  if (rval <= 0)
+    return false;
+  bnr->inpos = 0;
+  bnr->inlen = rval;
+  return true;
+}
+
+static int next_byte(GtBinaryNodeReader *bnr)
+{
+  if (bnr->inpos == bnr->inlen && !fill_buffer(bnr))
+    return EOF;
+  return bnr->inbuf[bnr->inpos++];
+}
+
+/* Copies up to <length> bytes of input to <dest>, returns the number of bytes
+   copied (which is smaller than <length> only at the end of the input). */
+static GtUword copy_bytes(GtBinaryNodeReader *bnr, void *dest, GtUword length)
+{
+  GtUword copied = 0, available;
+  while (copied < length) {
+    if (bnr->inpos == bnr->inlen && !fill_buffer(bnr))
+      break;
+    available = bnr->inlen - bnr->inpos;
+    if (available > length - copied)
+      available = length - copied;
+    memcpy((char*) dest + copied, bnr->inbuf + bnr->inpos, available);
+    bnr->inpos += available;
+    copied += available;
+  }
+  return copied;
+}
+
+static int read_byte(GtBinaryNodeReader *bnr, int *c, GtError *err)
+{
+  gt_error_check(err);
+  if ((*c = next_byte(bnr)) == EOF) {
+    gt_error_set(err, "unexpected end of binary node file");
+    return -1;
+  }
+  return 0;
+}
+
+static int read_varint(GtBinaryNodeReader *bnr, GtUword *value, GtError *err)
+{
+  unsigned int shift = 0;
+  int c, had_err;
+  gt_error_check(err);
+  *value = 0;
+  do {
+    if ((had_err = read_byte(bnr, &c, err)))
+      return had_err;
+    if (shift >= sizeof (GtUword) * 8) {
+      gt_error_set(err, "malformed integer in binary node file");
+      return -1;
+    }
+    *value |= ((GtUword) (c & 0x7f)) << shift;
+    shift += 7;
+  } while (c & 0x80);
+  return 0;
+}
+
+/* Reads <length> bytes into the buffer of <bnr> and terminates them. */
+static int read_bytes(GtBinaryNodeReader *bnr, GtUword length, GtError *err)
+{
+  gt_error_check(err);
+  if (length + 1 > bnr->bufsize) {
+    bnr->bufsize = length + 1;
+    bnr->buf = gt_realloc(bnr->buf, bnr->bufsize);
+  }
+  if (copy_bytes(bnr, bnr->buf, length) != length) {
+    gt_error_set(err, "unexpected end of binary node file");
+    return -1;
+  }
+  bnr->buf[length] = '\0';
+  return 0;
+}
+
+static int read_string(GtBinaryNodeReader *bnr, GtError *err)
+{
+  GtUword length;
+  int had_err;
+  gt_error_check(err);
+  had_err = read_varint(bnr, &length, err);
+  if (!had_err)
+    had_err = read_bytes(bnr, length, err);
+  return had_err;
+}
+
+static int read_interned(GtBinaryNodeReader *bnr, GtStr **str, GtError *err)
+{
+  GtUword ref;
+  int had_err;
+  gt_error_check(err);
+  *str = NULL;
+  if ((had_err = read_varint(bnr, &ref, err)) || !ref)
+    return had_err;
+  if (ref <= gt_array_size(bnr->dictionary)) {
+    *str = *(GtStr**) gt_array_get(bnr->dictionary, ref - 1);
+    return 0;
+  }
+  if (ref != gt_array_size(bnr->dictionary) + 1) {
+    gt_error_set(err, "invalid string reference in binary node file");
+    return -1;
+  }
+  /* the next dictionary entry is defined */
+  if (!(had_err = read_string(bnr, err))) {
+    *str = gt_str_new_cstr(bnr->buf);
+    gt_array_add(bnr->dictionary, *str);
+  }
+  return had_err;
+}
+
+static int read_origin(GtBinaryNodeReader *bnr, BinaryNodeOrigin *origin,
+                       GtError *err)
+{
+  int had_err;
+  gt_error_check(err);
+  origin->line_number = 0;
+  had_err = read_interned(bnr, &origin->filename, err);
+  if (!had_err && origin->filename)
+    had_err = read_varint(bnr, &origin->line_number, err);
+  return had_err;
+}
+
+static void set_origin(GtGenomeNode *gn, const BinaryNodeOrigin *origin)
+{
+  if (origin->filename && origin->line_number)
+    gt_genome_node_set_origin(gn, origin->filename, origin->line_number);
+}
+
+static int read_range(GtBinaryNodeReader *bnr, GtRange *range, GtError *err)
+{
+  GtUword length;
+  int had_err;
+  gt_error_check(err);
+  had_err = read_varint(bnr, &range->start, err);
+  if (!had_err)
+    had_err = read_varint(bnr, &length, err);
+  if (!had_err && range->start + length < range->start) {
+    gt_error_set(err, "invalid range in binary node file");
+    had_err = -1;
+  }
+  if (!had_err)
+    range->end = range->start + length;
+  return had_err;
+}
+
+static int read_feature_node(GtBinaryNodeReader *bnr, GtUword idx,
+                             GtUword num_of_nodes, GtError *err)
+{
+  GtStr *seqid, *source, *type, *tag;
+  GtGenomeNode *gn = NULL;
+  BinaryNodeOrigin origin;
+  GtRange range;
+  GtUword flags, rep = 0, child;
+  int c, i, had_err;
+  gt_error_check(err);
+  had_err = read_interned(bnr, &seqid, err);
+  if (!had_err)
+    had_err = read_interned(bnr, &source, err);
+  if (!had_err)
+    had_err = read_interned(bnr, &type, err);
+  if (!had_err)
+    had_err = read_origin(bnr, &origin, err);
+  if (!had_err)
+    had_err = read_range(bnr, &range, err);
+  if (!had_err)
+    had_err = read_varint(bnr, &flags, err);
+  if (!had_err && (!seqid ||
+                   (flags & GT_BINARY_NODE_STRAND_MASK)
+                   >= GT_NUM_OF_STRAND_TYPES ||
+                   (!type && !(flags & GT_BINARY_NODE_PSEUDO)) ||
+                   ((flags & GT_BINARY_NODE_PSEUDO) &&
+                    (flags & GT_BINARY_NODE_MULTI)))) {
+    gt_error_set(err, "invalid feature node in binary node file");
+    had_err = -1;
+  }
+  if (!had_err) {
+    GtStrand strand = flags & GT_BINARY_NODE_STRAND_MASK;
+    if (flags & GT_BINARY_NODE_PSEUDO)
+      gn = gt_feature_node_new_pseudo(seqid, range.start, range.end, strand);
+    else {
+      gn = gt_feature_node_new(seqid, gt_str_get(type), range.start,
+                               range.end, strand);
+    }
+    gt_array_add(bnr->nodes, gn);
+    set_origin(gn, &origin);
+    if (source)
+      gt_feature_node_set_source((GtFeatureNode*) gn, source);
+    gt_feature_node_set_phase((GtFeatureNode*) gn,
+                              (flags >> GT_BINARY_NODE_PHASE_OFFSET)
+                              & GT_BINARY_NODE_PHASE_MASK);
+  }
+  if (!had_err && (flags & GT_BINARY_NODE_SCORE_IS_DEFINED)) {
+    uint32_t bits = 0;
+    float score;
+    for (i = 0; !had_err && i < 4; i++) {
+      if (!(had_err = read_byte(bnr, &c, err)))
+        bits |= ((uint32_t) (c & 0xff)) << (8 * i);
+    }
+    if (!had_err) {
+      memcpy(&score, &bits, sizeof score);
+      gt_feature_node_set_score((GtFeatureNode*) gn, score);
+    }
+  }
+  if (!had_err && (flags & GT_BINARY_NODE_MULTI)) {
+    if (!(had_err = read_varint(bnr, &rep, err)) &&
+        (!rep || rep > num_of_nodes)) {
+      gt_error_set(err, "invalid representative in binary node file");
+      had_err = -1;
+    }
+  }
+  if (!had_err) {
+    BinaryNodeInfo info;
+    info.seqid = seqid;
+    info.rep = rep;
+    info.pseudo = (flags & GT_BINARY_NODE_PSEUDO) ? true : false;
+    gt_array_add(bnr->infos, info);
+  }
+  while (!had_err) {
+    if ((had_err = read_interned(bnr, &tag, err)) || !tag)
+      break;
+    if (!(had_err = read_string(bnr, err)) &&
+        (!gt_str_length(tag) || !bnr->buf[0] ||
+         gt_feature_node_get_attribute((GtFeatureNode*) gn,
+                                       gt_str_get(tag)))) {
+      gt_error_set(err, "invalid attribute in binary node file");
+      had_err = -1;
+    }
+    if (!had_err) {
+      gt_feature_node_add_attribute((GtFeatureNode*) gn, gt_str_get(tag),
+                                    bnr->buf);
+    }
+  }
+  while (!had_err) {
+    if ((had_err = read_varint(bnr, &child, err)) || !child)
+      break;
+    /* the top-level node cannot be a child */
+    if (child == 1 || child > num_of_nodes) {
+      gt_error_set(err, "invalid child reference in binary node file");
+      had_err = -1;
+      break;
+    }
+    gt_array_add(bnr->edges, idx);
+    child--;
+    gt_array_add(bnr->edges, child);
+  }
+  return had_err;
+}
+
+static GtFeatureNode* graph_node(GtBinaryNodeReader *bnr, GtUword idx)
+{
+  return *(GtFeatureNode**) gt_array_get(bnr->nodes, idx);
+}
+
+static BinaryNodeInfo* graph_info(GtBinaryNodeReader *bnr, GtUword idx)
+{
+  return gt_array_get(bnr->infos, idx);
+}
+
+static GtUword graph_rep(GtBinaryNodeReader *bnr, GtUword idx)
+{
+  return graph_info(bnr, idx)->rep;
+}
+
+static GtUword graph_edge(GtBinaryNodeReader *bnr, GtUword idx)
+{
+  return *(GtUword*) gt_array_get(bnr->edges, idx);
+}
+
+/* Checks that the graph read by <bnr> is a valid feature node DAG, which is
+   rooted at the top-level node. */
+static int check_feature_graph(GtBinaryNodeReader *bnr, GtError *err)
+{
+  BinaryNodeInfo *parent, *child;
+  GtUword i, e, rep, *indegree, *queue, queue_start = 0, queue_end = 0,
+          num_of_nodes = gt_array_size(bnr->nodes),
+          num_of_edges = gt_array_size(bnr->edges);
+  int had_err = 0;
+  gt_error_check(err);
+  for (i = 0; !had_err && i < num_of_nodes; i++) {
+    /* representatives have to represent themselves */
+    if ((rep = graph_rep(bnr, i)) && graph_rep(bnr, rep - 1) != rep) {
+      gt_error_set(err, "invalid representative in binary node file");
+      had_err = -1;
+    }
+  }
+  indegree = gt_calloc(num_of_nodes, sizeof (GtUword));
+  for (e = 0; !had_err && e < num_of_edges; e += 2) {
+    parent = graph_info(bnr, graph_edge(bnr, e));
+    child = graph_info(bnr, graph_edge(bnr, e + 1));
+    /* sequence IDs are interned, equal IDs are the same <GtStr> */
+    if (child->pseudo || parent->seqid != child->seqid) {
+      gt_error_set(err, "invalid child reference in binary node file");
+      had_err = -1;
+    }
+    indegree[graph_edge(bnr, e + 1)]++;
+  }
+  for (i = 1; !had_err && i < num_of_nodes; i++) {
+    if (!indegree[i]) {
+      gt_error_set(err, "unreachable feature node in binary node file");
+      had_err = -1;
+    }
+  }
+  if (!had_err) {
+    /* topological sort from the top-level node, the edges are grouped by their
+       parent in ascending order */
+    GtUword *first_edge = gt_calloc(num_of_nodes + 1, sizeof (GtUword));
+    for (e = 0; e < num_of_edges; e += 2)
+      first_edge[graph_edge(bnr, e) + 1] += 2;
+    for (i = 0; i < num_of_nodes; i++)
+      first_edge[i + 1] += first_edge[i];
+    queue = gt_malloc(num_of_nodes * sizeof (GtUword));
+    queue[queue_end++] = 0;
+    while (queue_start < queue_end) {
+      i = queue[queue_start++];
+      for (e = first_edge[i]; e < first_edge[i + 1]; e += 2) {
+        if (!--indegree[graph_edge(bnr, e + 1)])
+          queue[queue_end++] = graph_edge(bnr, e + 1);
+      }
+    }
+    gt_free(first_edge);
+    if (queue_end != num_of_nodes) {
+      gt_error_set(err, "cyclic feature node graph in binary node file");
+      had_err = -1;
+    }
+    gt_free(queue);
+  }
+  gt_free(indegree);
+  return had_err;
+}
+
+static void link_feature_graph(GtBinaryNodeReader *bnr)
+{
+  GtFeatureNode *child;
+  GtUword i, rep;
+  bool *has_parent;
+  for (i = 0; i < gt_array_size(bnr->nodes); i++) {
+    if ((rep = graph_rep(bnr, i)) == i + 1)
+      gt_feature_node_make_multi_representative(graph_node(bnr, i));
+  }
+  for (i = 0; i < gt_array_size(bnr->nodes); i++) {
+    if ((rep = graph_rep(bnr, i)) && rep != i + 1) {
+      gt_feature_node_set_multi_representative(graph_node(bnr, i),
+                                               graph_node(bnr, rep - 1));
+    }
+  }
+  has_parent = gt_calloc(gt_array_size(bnr->nodes), sizeof (bool));
+  for (i = 0; i < gt_array_size(bnr->edges); i += 2) {
+    GtUword child_idx = *(GtUword*) gt_array_get(bnr->edges, i + 1);
+    child = graph_node(bnr, child_idx);
+    /* every additional parent holds a reference of its own */
+    if (has_parent[child_idx])
+      child = (GtFeatureNode*) gt_genome_node_ref((GtGenomeNode*) child);
+    has_parent[child_idx] = true;
+    gt_feature_node_add_child(graph_node(bnr,
+                                         *(GtUword*) gt_array_get(bnr->edges,
+                                                                  i)),
+                              child);
+  }
+  gt_free(has_parent);
+}
+
+static int read_feature_graph(GtBinaryNodeReader *bnr, GtGenomeNode **gn,
+                              GtError *err)
+{
+  GtUword i, num_of_nodes;
+  int had_err;
+  gt_error_check(err);
+  gt_array_reset(bnr->nodes);
+  gt_array_reset(bnr->infos);
+  gt_array_reset(bnr->edges);
+  if (!(had_err = read_varint(bnr, &num_of_nodes, err)) && !num_of_nodes) {
+    gt_error_set(err, "empty feature node graph in binary node file");
+    had_err = -1;
+  }
+  for (i = 0; !had_err && i < num_of_nodes; i++)
+    had_err = read_feature_node(bnr, i, num_of_nodes, err);
+  if (!had_err)
+    had_err = check_feature_graph(bnr, err);
+  if (!had_err) {
+    link_feature_graph(bnr);
+    *gn = *(GtGenomeNode**) gt_array_get_first(bnr->nodes);
+  }
+  else {
+    for (i = 0; i < gt_array_size(bnr->nodes); i++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(bnr->nodes, i));
+  }
+  return had_err;
+}
+
+int gt_binary_node_reader_read_header(GtBinaryNodeReader *bnr, GtError *err)
+{
+  char header[GT_BINARY_NODE_MAGIC_LENGTH + 1];
+  gt_error_check(err);
+  gt_assert(bnr);
+  if (copy_bytes(bnr, header, sizeof header) != sizeof header ||
+      memcmp(header, GT_BINARY_NODE_MAGIC, GT_BINARY_NODE_MAGIC_LENGTH)) {
+    gt_error_set(err, "not a binary node file");
+    return -1;
+  }
+  if (header[GT_BINARY_NODE_MAGIC_LENGTH] != GT_BINARY_NODE_VERSION) {
+    gt_error_set(err, "unsupported binary node file version %d",
+                 header[GT_BINARY_NODE_MAGIC_LENGTH]);
+    return -1;
+  }
+  return 0;
+}
+
+int gt_binary_node_reader_read_dictionary(GtBinaryNodeReader *bnr,
+                                          GtError *err)
+{
+  GtUword i, num_of_strings;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(bnr);
+  had_err = read_varint(bnr, &num_of_strings, err);
+  for (i = 0; !had_err && i < num_of_strings; i++) {
+    if (!(had_err = read_string(bnr, err))) {
+      GtStr *str = gt_str_new_cstr(bnr->buf);
+      gt_array_add(bnr->dictionary, str);
+    }
+  }
+  return had_err;
+}
+
+void gt_binary_node_reader_seek(GtBinaryNodeReader *bnr, GtUword offset)
+{
+  gt_assert(bnr && !bnr->infp && offset <= bnr->inlen);
+  bnr->inpos = offset;
+}
+
+GtUword gt_binary_node_reader_get_offset(const GtBinaryNodeReader *bnr)
+{
+  gt_assert(bnr && !bnr->infp);
+  return bnr->inpos;
+}
+
+int gt_binary_node_reader_next(GtBinaryNodeReader *bnr, GtGenomeNode **gn,
+                               GtError *err)
+{
+  BinaryNodeOrigin origin;
+  GtStr *seqid;
+  GtRange range;
+  GtUword type, has_data, length;
+  int c, had_err = 0;
+  gt_error_check(err);
+  gt_assert(bnr && gn);
+  *gn = NULL;
+  if ((c = next_byte(bnr)) == EOF)
+    return 0;
+  type = c;
+  switch (type) {
+    case GT_BINARY_NODE_FEATURE:
+      had_err = read_feature_graph(bnr, gn, err);
+      break;
+    case GT_BINARY_NODE_REGION:
+      had_err = read_interned(bnr, &seqid, err);
+      if (!had_err)
+        had_err = read_origin(bnr, &origin, err);
+      if (!had_err)
+        had_err = read_range(bnr, &range, err);
+      if (!had_err && !seqid) {
+        gt_error_set(err, "invalid region node in binary node file");
+        had_err = -1;
+      }
+      if (!had_err) {
+        *gn = gt_region_node_new(seqid, range.start, range.end);
+        set_origin(*gn, &origin);
+      }
+      break;
+    case GT_BINARY_NODE_COMMENT:
+      had_err = read_origin(bnr, &origin, err);
+      if (!had_err)
+        had_err = read_string(bnr, err);
+      if (!had_err) {
+        *gn = gt_comment_node_new(bnr->buf);
+        set_origin(*gn, &origin);
+      }
+      break;
+    case GT_BINARY_NODE_META:
+      had_err = read_origin(bnr, &origin, err);
+      if (!had_err)
+        had_err = read_string(bnr, err);
+      if (!had_err) {
+        GtStr *directive = gt_str_new_cstr(bnr->buf);
+        had_err = read_varint(bnr, &has_data, err);
+        if (!had_err && has_data)
+          had_err = read_string(bnr, err);
+        if (!had_err) {
+          *gn = gt_meta_node_new(gt_str_get(directive),
+                                 has_data ? bnr->buf : NULL);
+          set_origin(*gn, &origin);
+        }
+        gt_str_delete(directive);
+      }
+      break;
+    case GT_BINARY_NODE_SEQUENCE:
+      had_err = read_origin(bnr, &origin, err);
+      if (!had_err)
+        had_err = read_string(bnr, err);
+      if (!had_err) {
+        GtStr *description = gt_str_new_cstr(bnr->buf);
+        had_err = read_varint(bnr, &length, err);
+        if (!had_err)
+          had_err = read_bytes(bnr, length, err);
+        if (!had_err) {
+          GtStr *sequence = gt_str_new();
+          gt_str_append_cstr_nt(sequence, bnr->buf, length);
+          *gn = gt_sequence_node_new(gt_str_get(description), sequence);
+          set_origin(*gn, &origin);
+          gt_str_delete(sequence);
+        }
+        gt_str_delete(description);
+      }
+      break;
+    case GT_BINARY_NODE_EOF:
+      *gn = gt_eof_node_new();
+      break;
+    default:
+      gt_error_set(err, "unknown record type %d in binary node file", c);
+      had_err = -1;
+  }
+  return had_err;
+}
+
+void gt_binary_node_reader_delete(GtBinaryNodeReader *bnr)
+{
+  GtUword i;
+  if (!bnr) return;
+  for (i = 0; i < gt_array_size(bnr->dictionary); i++)
+    gt_str_delete(*(GtStr**) gt_array_get(bnr->dictionary, i));
+  gt_array_delete(bnr->dictionary);
+  gt_array_delete(bnr->nodes);
+  gt_array_delete(bnr->infos);
+  gt_array_delete(bnr->edges);
+  gt_free(bnr->buf);
+  if (bnr->infp)
+    gt_free(bnr->inbuf);
+  gt_free(bnr);
+}
@@ -0,0 +1,69 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BINARY_NODE_READER_H
+#define BINARY_NODE_READER_H
+
+#include "core/error_api.h"
+#include "core/file_api.h"
+#include "extended/genome_node_api.h"
+
+/* A <GtBinaryNodeReader> deserializes genome nodes written by a
+   <GtBinaryNodeWriter>. */
+typedef struct GtBinaryNodeReader GtBinaryNodeReader;
+
+/* Return a new <GtBinaryNodeReader> which reads from <infp> (which is not
+   owned by the reader). The input is read ahead in blocks, <infp> should not
+   be read from otherwise. */
+GtBinaryNodeReader* gt_binary_node_reader_new(GtFile *infp);
+/* Return a new <GtBinaryNodeReader> which reads the <length> bytes at <mem>
+   (for example, a mapped file). The memory is not copied and must stay valid
+   during the lifetime of the reader. */
+GtBinaryNodeReader* gt_binary_node_reader_new_from_memory(const void *mem,
+                                                          GtUword length);
+/* Read the binary node file header from the input file of
+   <binary_node_reader>. Returns -1 and sets <err> if the input does not start
+   with a valid header, 0 otherwise. */
+int                 gt_binary_node_reader_read_header(GtBinaryNodeReader
+                                                      *binary_node_reader,
+                                                      GtError *err);
+/* Store the next genome node read by <binary_node_reader> in <gn>, or NULL if
+   the end of the input has been reached. Returns -1 and sets <err> if the
+   input is not a valid binary node file, 0 otherwise. */
+int                 gt_binary_node_reader_next(GtBinaryNodeReader
+                                               *binary_node_reader,
+                                               GtGenomeNode **gn,
+                                               GtError *err);
+/* Read a detached dictionary (written by
+   <gt_binary_node_writer_write_dictionary()>) into <binary_node_reader>, such
+   that the interned strings of records which are read afterwards can be
+   resolved. Returns -1 and sets <err> on error, 0 otherwise. */
+int                 gt_binary_node_reader_read_dictionary(GtBinaryNodeReader
+                                                          *binary_node_reader,
+                                                          GtError *err);
+/* Continue reading at <offset>. Only possible for readers which read from
+   memory. */
+void                gt_binary_node_reader_seek(GtBinaryNodeReader
+                                               *binary_node_reader,
+                                               GtUword offset);
+/* Return the offset of the next byte to be read. Only possible for readers
+   which read from memory. */
+GtUword             gt_binary_node_reader_get_offset(const GtBinaryNodeReader
+                                                     *binary_node_reader);
+void                gt_binary_node_reader_delete(GtBinaryNodeReader
+                                                 *binary_node_reader);
+
+#endif
@@ -0,0 +1,299 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <inttypes.h>
+#include <string.h>
+#include "core/array.h"
+#include "core/cstr_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "core/str_api.h"
+#include "extended/binary_node_format.h"
+#include "extended/binary_node_writer.h"
+#include "extended/comment_node_api.h"
+#include "extended/eof_node_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node_rep.h"
+#include "extended/meta_node_api.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
+
+struct GtBinaryNodeWriter {
+  GtFile *outfp;
+  GtStr *buf;
+  GtHashmap *dictionary, /* maps interned strings to their id + 1 */
+            *node_index; /* maps feature nodes to their index + 1 */
+  GtUword dictionary_size,
+          offset;      /* the number of bytes written so far */
+  GtArray *nodes,
+          *strings;    /* the interned strings in order of their ids */
+  bool detached;       /* new strings are not defined inline */
+};
+
+GtBinaryNodeWriter* gt_binary_node_writer_new(GtFile *outfp)
+{
+  GtBinaryNodeWriter *bnw = gt_malloc(sizeof *bnw);
+  bnw->outfp = outfp;
+  bnw->buf = gt_str_new();
+  bnw->dictionary = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  bnw->node_index = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
+  bnw->dictionary_size = bnw->offset = 0;
+  bnw->nodes = gt_array_new(sizeof (GtFeatureNode*));
+  bnw->strings = gt_array_new(sizeof (char*));
+  bnw->detached = false;
+  return bnw;
+}
+
+static void write_varint(GtBinaryNodeWriter *bnw, GtUword value)
+{
+  while (value >= 0x80) {
+    gt_str_append_char(bnw->buf, (char) ((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  gt_str_append_char(bnw->buf, (char) value);
+}
+
+static void write_string(GtBinaryNodeWriter *bnw, const char *cstr)
+{
+  GtUword length = strlen(cstr);
+  write_varint(bnw, length);
+  gt_str_append_cstr_nt(bnw->buf, cstr, length);
+}
+
+static void write_interned(GtBinaryNodeWriter *bnw, const char *cstr)
+{
+  GtUword id;
+  char *dup;
+  if (!cstr) {
+    write_varint(bnw, 0);
+    return;
+  }
+  if ((id = (GtUword) gt_hashmap_get(bnw->dictionary, cstr))) {
+    write_varint(bnw, id);
+    return;
+  }
+  /* define a new dictionary entry */
+  id = ++bnw->dictionary_size;
+  dup = gt_cstr_dup(cstr);
+  gt_hashmap_add(bnw->dictionary, dup, (void*) id);
+  gt_array_add(bnw->strings, dup);
+  write_varint(bnw, id);
+  if (!bnw->detached)
+    write_string(bnw, cstr);
+}
+
+static void write_origin(GtBinaryNodeWriter *bnw, GtGenomeNode *gn)
+{
+  if (gn->filename) {
+    write_interned(bnw, gt_str_get(gn->filename));
+    write_varint(bnw, gn->line_number);
+  }
+  else
+    write_interned(bnw, NULL); /* generated node */
+}
+
+static void write_attribute(const char *tag, const char *value, void *data)
+{
+  GtBinaryNodeWriter *bnw = data;
+  write_interned(bnw, tag);
+  write_string(bnw, value);
+}
+
+static GtUword add_feature_node(GtBinaryNodeWriter *bnw, GtFeatureNode *fn)
+{
+  GtUword idx;
+  if (!(idx = (GtUword) gt_hashmap_get(bnw->node_index, fn))) {
+    gt_array_add(bnw->nodes, fn);
+    idx = gt_array_size(bnw->nodes);
+    gt_hashmap_add(bnw->node_index, fn, (void*) idx);
+  }
+  return idx;
+}
+
+static void write_feature_node(GtBinaryNodeWriter *bnw, GtFeatureNode *fn)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *child;
+  GtRange range;
+  unsigned int flags;
+  range = gt_genome_node_get_range((GtGenomeNode*) fn);
+  write_interned(bnw, gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*)
+                                                          fn)));
+  write_interned(bnw, gt_feature_node_has_source(fn)
+                      ? gt_feature_node_get_source(fn) : NULL);
+  write_interned(bnw, gt_feature_node_is_pseudo(fn)
+                      ? NULL : gt_feature_node_get_type(fn));
+  write_origin(bnw, (GtGenomeNode*) fn);
+  write_varint(bnw, range.start);
+  write_varint(bnw, range.end - range.start);
+  flags = gt_feature_node_get_strand(fn);
+  flags |= gt_feature_node_get_phase(fn) << GT_BINARY_NODE_PHASE_OFFSET;
+  if (gt_feature_node_score_is_defined(fn))
+    flags |= GT_BINARY_NODE_SCORE_IS_DEFINED;
+  if (gt_feature_node_is_pseudo(fn))
+    flags |= GT_BINARY_NODE_PSEUDO;
+  if (gt_feature_node_is_multi(fn))
+    flags |= GT_BINARY_NODE_MULTI;
+  write_varint(bnw, flags);
+  if (gt_feature_node_score_is_defined(fn)) {
+    float score = gt_feature_node_get_score(fn);
+    uint32_t bits;
+    int i;
+    memcpy(&bits, &score, sizeof bits);
+    for (i = 0; i < 4; i++)
+      gt_str_append_char(bnw->buf, (char) ((bits >> (8 * i)) & 0xff));
+  }
+  if (gt_feature_node_is_multi(fn)) {
+    /* a representative outside of the written graph cannot be referenced, the
+       node becomes its own representative in this case */
+    GtFeatureNode *rep = gt_feature_node_get_multi_representative(fn);
+    GtUword rep_idx = (GtUword) gt_hashmap_get(bnw->node_index, rep);
+    write_varint(bnw, rep_idx ? rep_idx : add_feature_node(bnw, fn));
+  }
+  gt_feature_node_foreach_attribute(fn, write_attribute, bnw);
+  write_interned(bnw, NULL);
+  fni = gt_feature_node_iterator_new_direct(fn);
+  while ((child = gt_feature_node_iterator_next(fni)))
+    write_varint(bnw, add_feature_node(bnw, child));
+  gt_feature_node_iterator_delete(fni);
+  write_varint(bnw, 0);
+}
+
+static void write_feature_graph(GtBinaryNodeWriter *bnw, GtFeatureNode *root)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn, *child;
+  GtUword i;
+  gt_array_reset(bnw->nodes);
+  gt_hashmap_reset(bnw->node_index);
+  /* number the nodes in breadth-first order, each node only once */
+  add_feature_node(bnw, root);
+  for (i = 0; i < gt_array_size(bnw->nodes); i++) {
+    fn = *(GtFeatureNode**) gt_array_get(bnw->nodes, i);
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni)))
+      add_feature_node(bnw, child);
+    gt_feature_node_iterator_delete(fni);
+  }
+  write_varint(bnw, gt_array_size(bnw->nodes));
+  for (i = 0; i < gt_array_size(bnw->nodes); i++) {
+    write_feature_node(bnw,
+                       *(GtFeatureNode**) gt_array_get(bnw->nodes, i));
+  }
+}
+
+void gt_binary_node_writer_write_header(GtBinaryNodeWriter *bnw)
+{
+  char header[GT_BINARY_NODE_MAGIC_LENGTH + 1];
+  gt_assert(bnw);
+  memcpy(header, GT_BINARY_NODE_MAGIC, GT_BINARY_NODE_MAGIC_LENGTH);
+  header[GT_BINARY_NODE_MAGIC_LENGTH] = GT_BINARY_NODE_VERSION;
+  gt_file_xwrite(bnw->outfp, header, sizeof header);
+  bnw->offset += sizeof header;
+}
+
+void gt_binary_node_writer_detach_dictionary(GtBinaryNodeWriter *bnw)
+{
+  gt_assert(bnw);
+  bnw->detached = true;
+}
+
+void gt_binary_node_writer_write_dictionary(GtBinaryNodeWriter *bnw)
+{
+  GtUword i;
+  gt_assert(bnw && bnw->detached);
+  gt_str_reset(bnw->buf);
+  write_varint(bnw, gt_array_size(bnw->strings));
+  for (i = 0; i < gt_array_size(bnw->strings); i++)
+    write_string(bnw, *(char**) gt_array_get(bnw->strings, i));
+  gt_file_xwrite(bnw->outfp, gt_str_get_mem(bnw->buf),
+                 gt_str_length(bnw->buf));
+  bnw->offset += gt_str_length(bnw->buf);
+}
+
+GtUword gt_binary_node_writer_get_offset(const GtBinaryNodeWriter *bnw)
+{
+  gt_assert(bnw);
+  return bnw->offset;
+}
+
+void gt_binary_node_writer_write(GtBinaryNodeWriter *bnw, GtGenomeNode *gn)
+{
+  GtFeatureNode *fn;
+  GtMetaNode *mn;
+  GtSequenceNode *sn;
+  GtCommentNode *cn;
+  gt_assert(bnw && gn);
+  gt_str_reset(bnw->buf);
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    write_varint(bnw, GT_BINARY_NODE_FEATURE);
+    write_feature_graph(bnw, fn);
+  }
+  else if (gt_region_node_try_cast(gn)) {
+    GtRange range = gt_genome_node_get_range(gn);
+    write_varint(bnw, GT_BINARY_NODE_REGION);
+    write_interned(bnw, gt_str_get(gt_genome_node_get_seqid(gn)));
+    write_origin(bnw, gn);
+    write_varint(bnw, range.start);
+    write_varint(bnw, range.end - range.start);
+  }
+  else if ((cn = gt_comment_node_try_cast(gn))) {
+    write_varint(bnw, GT_BINARY_NODE_COMMENT);
+    write_origin(bnw, gn);
+    write_string(bnw, gt_comment_node_get_comment(cn));
+  }
+  else if ((mn = gt_meta_node_try_cast(gn))) {
+    const char *data = gt_meta_node_get_data(mn);
+    write_varint(bnw, GT_BINARY_NODE_META);
+    write_origin(bnw, gn);
+    write_string(bnw, gt_meta_node_get_directive(mn));
+    /* the meta data is optional */
+    if (data) {
+      write_varint(bnw, 1);
+      write_string(bnw, data);
+    }
+    else
+      write_varint(bnw, 0);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn))) {
+    GtUword length = gt_sequence_node_get_sequence_length(sn);
+    write_varint(bnw, GT_BINARY_NODE_SEQUENCE);
+    write_origin(bnw, gn);
+    write_string(bnw, gt_sequence_node_get_description(sn));
+    write_varint(bnw, length);
+    gt_str_append_cstr_nt(bnw->buf, gt_sequence_node_get_sequence(sn),
+                          length);
+  }
+  else {
+    gt_assert(gt_eof_node_try_cast(gn));
+    write_varint(bnw, GT_BINARY_NODE_EOF);
+  }
+  gt_file_xwrite(bnw->outfp, gt_str_get_mem(bnw->buf),
+                 gt_str_length(bnw->buf));
+  bnw->offset += gt_str_length(bnw->buf);
+}
+
+void gt_binary_node_writer_delete(GtBinaryNodeWriter *bnw)
+{
+  if (!bnw) return;
+  gt_array_delete(bnw->strings);
+  gt_array_delete(bnw->nodes);
+  gt_hashmap_delete(bnw->node_index);
+  gt_hashmap_delete(bnw->dictionary);
+  gt_str_delete(bnw->buf);
+  gt_free(bnw);
+}
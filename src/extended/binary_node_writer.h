@@ -0,0 +1,57 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BINARY_NODE_WRITER_H
+#define BINARY_NODE_WRITER_H
+
+#include "core/file_api.h"
+#include "extended/genome_node_api.h"
+
+/* A <GtBinaryNodeWriter> serializes genome nodes into the compact binary
+   format described in `extended/binary_node_format.h`. */
+typedef struct GtBinaryNodeWriter GtBinaryNodeWriter;
+
+/* Return a new <GtBinaryNodeWriter> which writes to <outfp> (which is not
+   owned by the writer). */
+GtBinaryNodeWriter* gt_binary_node_writer_new(GtFile *outfp);
+/* Write the binary node file header to the output file of
+   <binary_node_writer>. */
+void                gt_binary_node_writer_write_header(GtBinaryNodeWriter
+                                                       *binary_node_writer);
+/* Write <gn> (including all nodes reachable from it, if it is a feature node)
+   to the output file of <binary_node_writer>. User data and observers are not
+   written. */
+void                gt_binary_node_writer_write(GtBinaryNodeWriter
+                                                *binary_node_writer,
+                                                GtGenomeNode *gn);
+/* Stop defining interned strings inline in the records written by
+   <binary_node_writer> from now on. The records can then be read in any order
+   after the dictionary (written by <gt_binary_node_writer_write_dictionary()>)
+   has been read. */
+void                gt_binary_node_writer_detach_dictionary(GtBinaryNodeWriter
+                                                          *binary_node_writer);
+/* Write all interned strings of <binary_node_writer> as a detached dictionary,
+   which has to be enabled with <gt_binary_node_writer_detach_dictionary()>
+   before the first record is written. */
+void                gt_binary_node_writer_write_dictionary(GtBinaryNodeWriter
+                                                          *binary_node_writer);
+/* Return the number of bytes written by <binary_node_writer> so far. */
+GtUword             gt_binary_node_writer_get_offset(const GtBinaryNodeWriter
+                                                     *binary_node_writer);
+void                gt_binary_node_writer_delete(GtBinaryNodeWriter
+                                                 *binary_node_writer);
+
+#endif
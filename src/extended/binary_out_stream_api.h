@@ -0,0 +1,34 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BINARY_OUT_STREAM_API_H
+#define BINARY_OUT_STREAM_API_H
+
+#include "core/file_api.h"
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtBinaryOutStream> writes the
+   nodes passed through it in a compact binary format, which can be read back
+   much faster than GFF3 with a <GtBinaryInStream>. */
+typedef struct GtBinaryOutStream GtBinaryOutStream;
+
+const GtNodeStreamClass* gt_binary_out_stream_class(void);
+/* Create a <GtBinaryOutStream*> which uses <in_stream> as input.
+   It writes the nodes passed through it in binary format to <outfp>. */
+GtNodeStream*            gt_binary_out_stream_new(GtNodeStream *in_stream,
+                                                  GtFile *outfp);
+
+#endif
@@ -17,6 +17,7 @@
 
 #include <string.h>
 #include "core/assert_api.h"
+#include "core/atomic.h"
 #include "core/class_alloc.h"
 #include "core/array.h"
 #include "core/ensure.h"
@@ -46,15 +47,17 @@ struct GtFeatureIndexClass {
   GtFeatureIndexGetRangeForSeqidFunc get_range_for_seqid;
   GtFeatureIndexGetOrigRangeForSeqidFunc get_orig_range_for_seqid;
   GtFeatureIndexHasSeqidFunc has_seqid;
+  GtFeatureIndexFreezeFunc freeze;
   GtFeatureIndexFreeFunc free;
 };
 
 struct GtFeatureIndexMembers {
   unsigned int reference_count;
   GtRWLock *lock;
+  volatile bool frozen;
 };
 
-const GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
+GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
                                          GtFeatureIndexAddRegionNodeFunc
                                                  add_region_node,
                                          GtFeatureIndexAddFeatureNodeFunc
@@ -93,10 +96,52 @@ const GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
   c_class->get_range_for_seqid = get_range_for_seqid;
   c_class->get_orig_range_for_seqid = get_orig_range_for_seqid;
   c_class->has_seqid = has_seqid;
+  c_class->freeze = NULL;
   c_class->free = free;
   return c_class;
 }
 
+void gt_feature_index_class_set_freeze_func(GtFeatureIndexClass *fic,
+                                            GtFeatureIndexFreezeFunc freeze)
+{
+  gt_assert(fic);
+  fic->freeze = freeze;
+}
+
+/* Frozen indexes are queried without taking the read lock, if a memory
+   barrier is available. Returns <true> if the lock was taken and must be
+   released afterwards. */
+static bool feature_index_rdlock(GT_UNUSED const GtFeatureIndex *fi)
+{
+#ifdef GT_ATOMIC_ENABLED
+  if (fi->pvt->frozen) {
+    /* make the data written by the freeze function visible */
+    gt_atomic_barrier();
+    return false;
+  }
+#endif
+  gt_rwlock_rdlock(fi->pvt->lock);
+  return true;
+}
+
+static void feature_index_rdunlock(GT_UNUSED const GtFeatureIndex *fi,
+                                   bool locked)
+{
+  if (locked)
+    gt_rwlock_unlock(fi->pvt->lock);
+}
+
+static int feature_index_check_mutable(const GtFeatureIndex *fi,
+                                       GtError *err)
+{
+  gt_error_check(err);
+  if (fi->pvt->frozen) {
+    gt_error_set(err, "feature index is frozen and cannot be modified");
+    return -1;
+  }
+  return 0;
+}
+
 GtFeatureIndex* gt_feature_index_create(const GtFeatureIndexClass *fic)
 {
   GtFeatureIndex *fi;
@@ -142,8 +187,10 @@ int  gt_feature_index_add_region_node(GtFeatureIndex *feature_index,
   int ret;
   gt_assert(feature_index && feature_index->c_class && region_node);
   gt_rwlock_wrlock(feature_index->pvt->lock);
-  ret = feature_index->c_class->add_region_node(feature_index, region_node,
-                                                err);
+  if (!(ret = feature_index_check_mutable(feature_index, err))) {
+    ret = feature_index->c_class->add_region_node(feature_index, region_node,
+                                                  err);
+  }
   gt_rwlock_unlock(feature_index->pvt->lock);
   return ret;
 }
@@ -155,8 +202,10 @@ int  gt_feature_index_add_feature_node(GtFeatureIndex *feature_index,
   int ret;
   gt_assert(feature_index && feature_index->c_class && feature_node);
   gt_rwlock_wrlock(feature_index->pvt->lock);
-  ret = feature_index->c_class->add_feature_node(feature_index, feature_node,
-                                                 err);
+  if (!(ret = feature_index_check_mutable(feature_index, err))) {
+    ret = feature_index->c_class->add_feature_node(feature_index, feature_node,
+                                                   err);
+  }
   gt_rwlock_unlock(feature_index->pvt->lock);
   return ret;
 }
@@ -167,7 +216,8 @@ int  gt_feature_index_remove_node(GtFeatureIndex *feature_index,
   int ret;
   gt_assert(feature_index && feature_index->c_class && node);
   gt_rwlock_wrlock(feature_index->pvt->lock);
-  ret = feature_index->c_class->remove_node(feature_index, node, err);
+  if (!(ret = feature_index_check_mutable(feature_index, err)))
+    ret = feature_index->c_class->remove_node(feature_index, node, err);
   gt_rwlock_unlock(feature_index->pvt->lock);
   return ret;
 }
@@ -188,11 +238,11 @@ int gt_feature_index_add_gff3file(GtFeatureIndex *feature_index,
     gt_array_add(tmp, gn);
   if (!had_err) {
     GtNodeVisitor *feature_visitor = gt_feature_visitor_new(feature_index);
-    for (i=0;i<gt_array_size(tmp);i++) {
+    for (i=0;!had_err && i<gt_array_size(tmp);i++) {
       gn = *(GtGenomeNode**) gt_array_get(tmp, i);
-      /* no need to lock, add_*_node() is synchronized */
-      had_err = gt_genome_node_accept(gn, feature_visitor, NULL);
-      gt_assert(!had_err); /* cannot happen */
+      /* no need to lock, add_*_node() is synchronized; adding fails for
+         read-only indexes */
+      had_err = gt_genome_node_accept(gn, feature_visitor, err);
     }
     gt_node_visitor_delete(feature_visitor);
   }
@@ -208,10 +258,11 @@ GtArray* gt_feature_index_get_features_for_seqid(GtFeatureIndex *fi,
                                                  GtError *err)
 {
   GtArray *arr;
+  bool locked;
   gt_assert(fi && fi->c_class && seqid);
-  gt_rwlock_rdlock(fi->pvt->lock);
+  locked = feature_index_rdlock(fi);
   arr = fi->c_class->get_features_for_seqid(fi, seqid, err);
-  gt_rwlock_unlock(fi->pvt->lock);
+  feature_index_rdunlock(fi, locked);
   return arr;
 }
 
@@ -221,13 +272,14 @@ int gt_feature_index_get_features_for_range(GtFeatureIndex *feature_index,
                                             const GtRange *range, GtError *err)
 {
   int ret;
+  bool locked;
   gt_assert(feature_index && feature_index->c_class && results && seqid &&
             range);
   gt_assert(gt_range_length(range) > 0);
-  gt_rwlock_rdlock(feature_index->pvt->lock);
+  locked = feature_index_rdlock(feature_index);
   ret = feature_index->c_class->get_features_for_range(feature_index, results,
                                                        seqid, range, err);
-  gt_rwlock_unlock(feature_index->pvt->lock);
+  feature_index_rdunlock(feature_index, locked);
   return ret;
 }
 
@@ -236,10 +288,11 @@ char* gt_feature_index_get_first_seqid(const GtFeatureIndex
                                               GtError *err)
 {
   const char *str;
+  bool locked;
   gt_assert(feature_index && feature_index->c_class);
-  gt_rwlock_rdlock(feature_index->pvt->lock);
+  locked = feature_index_rdlock(feature_index);
   str = feature_index->c_class->get_first_seqid(feature_index, err);
-  gt_rwlock_unlock(feature_index->pvt->lock);
+  feature_index_rdunlock(feature_index, locked);
   return (char*) str;
 }
 
@@ -249,19 +302,50 @@ int gt_feature_index_save(GtFeatureIndex *feature_index, GtError *err)
   gt_assert(feature_index && feature_index->c_class);
   gt_assert(feature_index->c_class->save_func);
   gt_rwlock_wrlock(feature_index->pvt->lock);
-  ret = feature_index->c_class->save_func(feature_index, err);
+  /* frozen indexes have been saved by gt_feature_index_freeze() */
+  ret = feature_index->pvt->frozen
+          ? 0
+          : feature_index->c_class->save_func(feature_index, err);
   gt_rwlock_unlock(feature_index->pvt->lock);
   return ret;
 }
 
+int gt_feature_index_freeze(GtFeatureIndex *feature_index, GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(feature_index && feature_index->c_class);
+  gt_rwlock_wrlock(feature_index->pvt->lock);
+  if (!feature_index->pvt->frozen) {
+    if (feature_index->c_class->freeze)
+      had_err = feature_index->c_class->freeze(feature_index, err);
+    if (!had_err) {
+#ifdef GT_ATOMIC_ENABLED
+      /* publish the finalized index before queries stop locking */
+      gt_atomic_barrier();
+#endif
+      feature_index->pvt->frozen = true;
+    }
+  }
+  gt_rwlock_unlock(feature_index->pvt->lock);
+  return had_err;
+}
+
+bool gt_feature_index_is_frozen(const GtFeatureIndex *feature_index)
+{
+  gt_assert(feature_index);
+  return feature_index->pvt->frozen;
+}
+
 GtStrArray* gt_feature_index_get_seqids(const GtFeatureIndex *feature_index,
                                         GtError *err)
 {
   GtStrArray *strarr;
+  bool locked;
   gt_assert(feature_index && feature_index->c_class);
-  gt_rwlock_rdlock(feature_index->pvt->lock);
+  locked = feature_index_rdlock(feature_index);
   strarr = feature_index->c_class->get_seqids(feature_index, err);
-  gt_rwlock_unlock(feature_index->pvt->lock);
+  feature_index_rdunlock(feature_index, locked);
   return strarr;
 }
 
@@ -271,11 +355,12 @@ int  gt_feature_index_get_range_for_seqid(GtFeatureIndex *feature_index,
                                           GtError *err)
 {
   int ret;
+  bool locked;
   gt_assert(feature_index && feature_index->c_class && range && seqid);
-  gt_rwlock_rdlock(feature_index->pvt->lock);
+  locked = feature_index_rdlock(feature_index);
   ret = feature_index->c_class->get_range_for_seqid(feature_index, range,
                                                     seqid, err);
-  gt_rwlock_unlock(feature_index->pvt->lock);
+  feature_index_rdunlock(feature_index, locked);
   return ret;
 }
 
@@ -285,11 +370,12 @@ int  gt_feature_index_get_orig_range_for_seqid(GtFeatureIndex *feature_index,
                                                GtError *err)
 {
   int ret;
+  bool locked;
   gt_assert(feature_index && feature_index->c_class && range && seqid);
-  gt_rwlock_rdlock(feature_index->pvt->lock);
+  locked = feature_index_rdlock(feature_index);
   ret = feature_index->c_class->get_orig_range_for_seqid(feature_index, range,
                                                          seqid, err);
-  gt_rwlock_unlock(feature_index->pvt->lock);
+  feature_index_rdunlock(feature_index, locked);
   return ret;
 }
 
@@ -299,11 +385,12 @@ int  gt_feature_index_has_seqid(const GtFeatureIndex *feature_index,
                                 GtError *err)
 {
   int ret;
+  bool locked;
   gt_assert(feature_index && feature_index->c_class && seqid);
-  gt_rwlock_rdlock(feature_index->pvt->lock);
+  locked = feature_index_rdlock(feature_index);
   ret = feature_index->c_class->has_seqid(feature_index, has_seqid,
                                           seqid, err);
-  gt_rwlock_unlock(feature_index->pvt->lock);
+  feature_index_rdunlock(feature_index, locked);
   return ret;
 }
 
@@ -413,6 +500,21 @@ static void* gt_feature_index_unit_test_query(void *data)
     }
   }
 
+  /* query all features of the sequence concurrently with range queries */
+  if (!had_err) {
+    GtArray *all;
+    if (!(all = gt_feature_index_get_features_for_seqid(shm->fi,
+                                                        GT_FI_TEST_SEQID,
+                                                        err))) {
+      had_err = -1;
+    }
+    else {
+      if (gt_array_size(all) != GT_FI_TEST_FEATURES_PER_THREAD * gt_jobs)
+        had_err = -1;
+      gt_array_delete(all);
+    }
+  }
+
   if (had_err) {
     gt_mutex_lock(shm->mutex);
     shm->error_count++;
@@ -490,6 +592,31 @@ int gt_feature_index_unit_test(GtFeatureIndex *fi, GtError *err)
     gt_multithread(gt_feature_index_unit_test_query, &sh, err);
   gt_ensure(sh.error_count == 0);
 
+  /* test lock-free parallel query on the frozen index */
+  gt_ensure(!gt_feature_index_is_frozen(fi));
+  if (!had_err) {
+    rval = gt_feature_index_freeze(fi, err);
+    gt_ensure(rval == 0);
+    gt_ensure(gt_feature_index_is_frozen(fi));
+  }
+  if (!had_err)
+    gt_multithread(gt_feature_index_unit_test_query, &sh, err);
+  gt_ensure(sh.error_count == 0);
+
+  /* frozen indexes cannot be modified */
+  if (!had_err) {
+    GtError *testerr = gt_error_new();
+    GtFeatureNode *fn;
+    fn = gt_feature_node_cast(gt_feature_node_new(seqid, "gene",
+                                                  GT_FI_TEST_START,
+                                                  GT_FI_TEST_START + 1,
+                                                  GT_STRAND_FORWARD));
+    gt_ensure(gt_feature_index_add_feature_node(fi, fn, testerr) == -1);
+    gt_ensure(gt_error_is_set(testerr));
+    gt_genome_node_delete((GtGenomeNode*) fn);
+    gt_error_delete(testerr);
+  }
+
   gt_mutex_delete(sh.mutex);
   gt_error_delete(sh.err);
   gt_str_array_delete(seqids);
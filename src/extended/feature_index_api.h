@@ -31,7 +31,12 @@
    place is left to the discretion of the implementing class.
 
    Output from a <gt_feature_index_get_features_*()> method should always
-   be sorted by feature start position. */
+   be sorted by feature start position.
+
+   All methods may be called concurrently from several threads; by default
+   queries share a read lock and modifications are serialized against them.
+   After loading, an index can be frozen with <gt_feature_index_freeze()>.
+   It is read-only from then on, and queries on it take no locks at all. */
 typedef struct GtFeatureIndex GtFeatureIndex;
 
 /* Add <region_node> to <feature_index>. */
@@ -96,6 +101,17 @@ int         gt_feature_index_has_seqid(const GtFeatureIndex *feature_index,
    must be defined, otherwise the method fails with an assertion (for example,
    the memory based feature index does not have a save function) . */
 int         gt_feature_index_save(GtFeatureIndex *feature_index, GtError *err);
+/* Finalizes <feature_index> for concurrent read-only use, e.g. by building all
+   search structures in advance. Afterwards, all query methods may be called
+   from any number of threads without locking, while adding or removing nodes
+   fails with an error. Pending changes are saved as by
+   <gt_feature_index_save()>. Freezing a frozen index does nothing.
+   Returns 0 on success and -1 on error, in which case <err> is set and
+   <feature_index> is not frozen. */
+int         gt_feature_index_freeze(GtFeatureIndex *feature_index,
+                                    GtError *err);
+/* Returns <true> if <feature_index> has been frozen. */
+bool        gt_feature_index_is_frozen(const GtFeatureIndex *feature_index);
 /* Deletes the <feature_index> and all its referenced features. */
 void        gt_feature_index_delete(GtFeatureIndex*);
 
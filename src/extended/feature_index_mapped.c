@@ -0,0 +1,1296 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "core/array.h"
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/file.h"
+#include "core/fileutils_api.h"
+#include "core/hashmap.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/multithread_api.h"
+#include "core/str_array_api.h"
+#include "core/unused_api.h"
+#include "core/xposix.h"
+#include "extended/binary_node_format.h"
+#include "extended/binary_node_reader.h"
+#include "extended/binary_node_writer.h"
+#include "extended/eof_node_api.h"
+#include "extended/feature_index_mapped.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node.h"
+#include "extended/meta_node_api.h"
+#include "extended/region_node_api.h"
+
+/* A feature index file consists of
+   - the header: <FEATURE_INDEX_MAPPED_MAGIC>, the version, and the size of a
+     <GtUword>,
+   - the top-level features, each stored as a feature record of the binary
+     node format (see `extended/binary_node_format.h`) with a detached
+     dictionary,
+   - the dictionary,
+   - the sequence IDs (each terminated by '\0'), padded to a multiple of the
+     word size,
+   - for each sequence region, the <GtIntervalIndexEntry> array of a built
+     <GtIntervalIndex>, whose data pointers are the file offsets of the
+     feature records,
+   - the <FeatureIndexMappedRegion> table, sorted by sequence ID,
+   - the <FeatureIndexMappedTrailer>.
+   All offsets are relative to the start of the file.
+
+   Changes to an index file are appended to its delta file (the index file
+   name followed by <FEATURE_INDEX_MAPPED_DELTA_SUFFIX>), which consists of
+   segments. Each segment is a complete binary node file, terminated by an EOF
+   record. A feature record adds the top-level feature, replacing all earlier
+   versions with the same ID, and a meta record with directive
+   <FEATURE_INDEX_MAPPED_DELTA_REMOVE> removes the feature with the ID given
+   as its data. */
+
+#define FEATURE_INDEX_MAPPED_MAGIC         "GTFIDX"
+#define FEATURE_INDEX_MAPPED_MAGIC_LENGTH  6
+#define FEATURE_INDEX_MAPPED_HEADER_LENGTH 8
+#define FEATURE_INDEX_MAPPED_VERSION       1
+#define FEATURE_INDEX_MAPPED_BYTE_ORDER    ((GtUword) 0x01020304UL)
+
+#define FEATURE_INDEX_MAPPED_DELTA_SUFFIX   ".delta"
+#define FEATURE_INDEX_MAPPED_DELTA_REMOVE   "remove"
+#define FEATURE_INDEX_MAPPED_COMPACT_SUFFIX ".compact"
+
+typedef struct {
+  GtUword seqid,       /* offset of the sequence ID */
+          entries,     /* offset of the interval index entries */
+          nof_entries;
+  GtRange range,       /* the range covered by the features */
+          orig_range;  /* the range of the sequence region */
+} FeatureIndexMappedRegion;
+
+typedef struct {
+  GtUword dictionary,  /* offset of the dictionary */
+          regions,     /* offset of the region table */
+          nof_regions,
+          first_region,
+          byte_order;
+} FeatureIndexMappedTrailer;
+
+struct GtFeatureIndexMapped {
+  const GtFeatureIndex parent_instance;
+  char *map;
+  size_t maplen;
+  const FeatureIndexMappedRegion *regions;
+  GtUword nof_regions,
+          first_region,
+          records_end;
+  GtIntervalIndex **indexes;
+  GtBinaryNodeReader *reader;
+  GtHashmap *nodes; /* maps record offsets to the decoded features */
+  GtMutex *decode_lock;
+  bool all_decoded; /* set when frozen, <nodes> is read-only afterwards */
+  /* the changes read from the delta file, NULL if there are none */
+  GtFeatureIndex *delta;   /* the current versions of added features */
+  GtHashmap *delta_nodes,  /* maps IDs to the features in <delta> */
+            *shadowed;     /* IDs of base features replaced or removed */
+};
+
+#define gt_feature_index_mapped_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_mapped_class(), FI)
+
+static const FeatureIndexMappedRegion* find_region(const GtFeatureIndexMapped
+                                                                          *fim,
+                                                   const char *seqid)
+{
+  GtUword left = 0, right = fim->nof_regions;
+  while (left < right) {
+    GtUword mid = left + (right - left) / 2;
+    int cmp = strcmp(fim->map + fim->regions[mid].seqid, seqid);
+    if (!cmp)
+      return fim->regions + mid;
+    if (cmp < 0)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return NULL;
+}
+
+/* Returns the ID of the top-level feature <fn> (of its first component if
+   <fn> is a pseudo-feature), or NULL if it has none. */
+static const char* feature_id(GtFeatureNode *fn)
+{
+  if (gt_feature_node_is_pseudo(fn)) {
+    GtFeatureNodeIterator *fni = gt_feature_node_iterator_new_direct(fn);
+    fn = gt_feature_node_iterator_next(fni);
+    gt_feature_node_iterator_delete(fni);
+    if (!fn)
+      return NULL;
+  }
+  return gt_feature_node_get_attribute(fn, "ID");
+}
+
+/* Returns true if the base feature <gn> has been replaced or removed by the
+   delta file. */
+static bool is_shadowed(const GtFeatureIndexMapped *fim, GtGenomeNode *gn)
+{
+  const char *id;
+  if (!fim->shadowed)
+    return false;
+  id = feature_id((GtFeatureNode*) gn);
+  return id && gt_hashmap_get(fim->shadowed, id);
+}
+
+static bool delta_has_seqid(const GtFeatureIndexMapped *fim,
+                            const char *seqid)
+{
+  bool has_seqid = false;
+  if (fim->delta)
+    (void) gt_feature_index_has_seqid(fim->delta, &has_seqid, seqid, NULL);
+  return has_seqid;
+}
+
+static GtIntervalIndex* region_index(const GtFeatureIndexMapped *fim,
+                                     const FeatureIndexMappedRegion *region)
+{
+  return fim->indexes[region - fim->regions];
+}
+
+/* Returns the feature stored at <offset>, which is decoded on first use. */
+static GtGenomeNode* decode_feature(GtFeatureIndexMapped *fim, GtUword offset,
+                                    GtError *err)
+{
+  GtGenomeNode *gn;
+  gt_error_check(err);
+  if (fim->all_decoded) {
+    if (!(gn = gt_hashmap_get(fim->nodes, (void*) offset)))
+      gt_error_set(err, "invalid feature offset in feature index file");
+    return gn;
+  }
+  gt_mutex_lock(fim->decode_lock);
+  if (!(gn = gt_hashmap_get(fim->nodes, (void*) offset))) {
+    int had_err = 0;
+    if (offset < FEATURE_INDEX_MAPPED_HEADER_LENGTH ||
+        offset >= fim->records_end) {
+      gt_error_set(err, "invalid feature offset in feature index file");
+      had_err = -1;
+    }
+    if (!had_err) {
+      gt_binary_node_reader_seek(fim->reader, offset);
+      had_err = gt_binary_node_reader_next(fim->reader, &gn, err);
+    }
+    if (!had_err && (!gn || !gt_feature_node_try_cast(gn))) {
+      gt_error_set(err, "invalid feature record in feature index file");
+      gt_genome_node_delete(gn);
+      had_err = -1;
+    }
+    if (!had_err)
+      gt_hashmap_add(fim->nodes, (void*) offset, gn);
+    else
+      gn = NULL;
+  }
+  gt_mutex_unlock(fim->decode_lock);
+  return gn;
+}
+
+static int gt_feature_index_mapped_add_region_node(GT_UNUSED GtFeatureIndex
+                                                                          *gfi,
+                                                   GT_UNUSED GtRegionNode *rn,
+                                                   GtError *err)
+{
+  gt_error_check(err);
+  gt_error_set(err, "feature index file is read-only");
+  return -1;
+}
+
+static int gt_feature_index_mapped_add_feature_node(GT_UNUSED GtFeatureIndex
+                                                                          *gfi,
+                                                    GT_UNUSED GtFeatureNode *fn,
+                                                    GtError *err)
+{
+  gt_error_check(err);
+  gt_error_set(err, "feature index file is read-only");
+  return -1;
+}
+
+static int gt_feature_index_mapped_remove_node(GT_UNUSED GtFeatureIndex *gfi,
+                                               GT_UNUSED GtFeatureNode *fn,
+                                               GtError *err)
+{
+  gt_error_check(err);
+  gt_error_set(err, "feature index file is read-only");
+  return -1;
+}
+
+typedef struct {
+  GtFeatureIndexMapped *fim;
+  GtArray *features;
+  GtError *err;
+} FeatureIndexMappedCollectInfo;
+
+static int collect_features(void *data, GT_UNUSED GtUword start,
+                            GT_UNUSED GtUword end, void *info)
+{
+  FeatureIndexMappedCollectInfo *ci = info;
+  GtGenomeNode *gn;
+  if (!(gn = decode_feature(ci->fim, (GtUword) data, ci->err)))
+    return -1;
+  if (!is_shadowed(ci->fim, gn))
+    gt_array_add(ci->features, gn);
+  return 0;
+}
+
+static GtArray* gt_feature_index_mapped_get_features_for_seqid(GtFeatureIndex
+                                                                          *gfi,
+                                                               const char
+                                                                         *seqid,
+                                                               GtError *err)
+{
+  FeatureIndexMappedCollectInfo ci;
+  const FeatureIndexMappedRegion *region;
+  GtFeatureIndexMapped *fim;
+  gt_error_check(err);
+  gt_assert(gfi && seqid);
+  fim = gt_feature_index_mapped_cast(gfi);
+  ci.fim = fim;
+  ci.features = gt_array_new(sizeof (GtFeatureNode*));
+  ci.err = err;
+  if ((region = find_region(fim, seqid)) &&
+      gt_interval_index_traverse(region_index(fim, region), collect_features,
+                                 &ci)) {
+    gt_array_delete(ci.features);
+    return NULL;
+  }
+  if (delta_has_seqid(fim, seqid)) {
+    GtArray *added;
+    if (!(added = gt_feature_index_get_features_for_seqid(fim->delta, seqid,
+                                                          err))) {
+      gt_array_delete(ci.features);
+      return NULL;
+    }
+    gt_array_add_array(ci.features, added);
+    gt_array_delete(added);
+  }
+  return ci.features;
+}
+
+static int decode_features(void *data, GT_UNUSED GtUword start,
+                           GT_UNUSED GtUword end, void *info)
+{
+  FeatureIndexMappedCollectInfo *ci = info;
+  return decode_feature(ci->fim, (GtUword) data, ci->err) ? 0 : -1;
+}
+
+/* Decodes all features in advance, such that queries need not synchronize
+   on the decoder. */
+static int gt_feature_index_mapped_freeze(GtFeatureIndex *gfi, GtError *err)
+{
+  FeatureIndexMappedCollectInfo ci;
+  GtFeatureIndexMapped *fim;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi);
+  fim = gt_feature_index_mapped_cast(gfi);
+  ci.fim = fim;
+  ci.features = NULL;
+  ci.err = err;
+  for (i = 0; !had_err && i < fim->nof_regions; i++) {
+    had_err = gt_interval_index_traverse(fim->indexes[i], decode_features,
+                                         &ci);
+  }
+  if (!had_err && fim->delta)
+    had_err = gt_feature_index_freeze(fim->delta, err);
+  if (!had_err)
+    fim->all_decoded = true;
+  return had_err;
+}
+
+static int gt_genome_node_cmp_range_start(const void *v1, const void *v2)
+{
+  GtGenomeNode *n1, *n2;
+  n1 = *(GtGenomeNode**) v1;
+  n2 = *(GtGenomeNode**) v2;
+  return gt_genome_node_compare(&n1, &n2);
+}
+
+static int gt_feature_index_mapped_get_features_for_range(GtFeatureIndex *gfi,
+                                                          GtArray *results,
+                                                          const char *seqid,
+                                                          const GtRange
+                                                                     *qry_range,
+                                                          GtError *err)
+{
+  const FeatureIndexMappedRegion *region;
+  GtFeatureIndexMapped *fim;
+  GtArray *offsets;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi && results);
+
+  fim = gt_feature_index_mapped_cast(gfi);
+  region = find_region(fim, seqid);
+  if (!region && !delta_has_seqid(fim, seqid)) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  offsets = gt_array_new(sizeof (void*));
+  if (region) {
+    gt_interval_index_find_all_overlapping(region_index(fim, region),
+                                           qry_range->start, qry_range->end,
+                                           offsets);
+  }
+  for (i = 0; !had_err && i < gt_array_size(offsets); i++) {
+    GtGenomeNode *gn = decode_feature(fim,
+                                      (GtUword) *(void**) gt_array_get(offsets,
+                                                                       i),
+                                      err);
+    if (!gn)
+      had_err = -1;
+    else if (!is_shadowed(fim, gn))
+      gt_array_add(results, gn);
+  }
+  gt_array_delete(offsets);
+  if (!had_err && delta_has_seqid(fim, seqid)) {
+    had_err = gt_feature_index_get_features_for_range(fim->delta, results,
+                                                      seqid, qry_range, err);
+  }
+  if (!had_err)
+    gt_array_sort(results, gt_genome_node_cmp_range_start);
+  return had_err;
+}
+
+static char* gt_feature_index_mapped_get_first_seqid(const GtFeatureIndex *gfi,
+                                                     GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi);
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  if (!fim->nof_regions)
+    return fim->delta ? gt_feature_index_get_first_seqid(fim->delta, err)
+                      : NULL;
+  return gt_cstr_dup(fim->map + fim->regions[fim->first_region].seqid);
+}
+
+static GtStrArray* gt_feature_index_mapped_get_seqids(const GtFeatureIndex
+                                                                          *gfi,
+                                                      GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtStrArray *seqids, *added;
+  GtUword i;
+  gt_assert(gfi);
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  seqids = gt_str_array_new();
+  for (i = 0; i < fim->nof_regions; i++)
+    gt_str_array_add_cstr(seqids, fim->map + fim->regions[i].seqid);
+  if (fim->delta) {
+    if (!(added = gt_feature_index_get_seqids(fim->delta, err))) {
+      gt_str_array_delete(seqids);
+      return NULL;
+    }
+    for (i = 0; i < gt_str_array_size(added); i++) {
+      if (!find_region(fim, gt_str_array_get(added, i)))
+        gt_str_array_add_cstr(seqids, gt_str_array_get(added, i));
+    }
+    gt_str_array_delete(added);
+  }
+  return seqids;
+}
+
+static int gt_feature_index_mapped_get_range_for_seqid(GtFeatureIndex *gfi,
+                                                       GtRange *range,
+                                                       const char *seqid,
+                                                       GtError *err)
+{
+  const FeatureIndexMappedRegion *region;
+  GtFeatureIndexMapped *fim;
+  GtRange delta_range;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+  fim = gt_feature_index_mapped_cast(gfi);
+  region = find_region(fim, seqid);
+  if (delta_has_seqid(fim, seqid)) {
+    if (gt_feature_index_get_range_for_seqid(fim->delta, &delta_range, seqid,
+                                             err)) {
+      return -1;
+    }
+    *range = region ? gt_range_join(&region->range, &delta_range)
+                    : delta_range;
+    return 0;
+  }
+  if (!region) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  *range = region->range;
+  return 0;
+}
+
+static int gt_feature_index_mapped_get_orig_range_for_seqid(GtFeatureIndex
+                                                                          *gfi,
+                                                            GtRange *range,
+                                                            const char *seqid,
+                                                            GtError *err)
+{
+  const FeatureIndexMappedRegion *region;
+  GtFeatureIndexMapped *fim;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (!(region = find_region(fim, seqid))) {
+    if (delta_has_seqid(fim, seqid)) {
+      return gt_feature_index_get_orig_range_for_seqid(fim->delta, range,
+                                                       seqid, err);
+    }
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    return -1;
+  }
+  *range = region->orig_range;
+  return 0;
+}
+
+static int gt_feature_index_mapped_has_seqid(const GtFeatureIndex *gfi,
+                                             bool *has_seqid,
+                                             const char *seqid,
+                                             GT_UNUSED GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  gt_assert(gfi && has_seqid && seqid);
+  fim = gt_feature_index_mapped_cast((GtFeatureIndex*) gfi);
+  *has_seqid = find_region(fim, seqid) != NULL || delta_has_seqid(fim, seqid);
+  return 0;
+}
+
+static void gt_feature_index_mapped_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexMapped *fim;
+  GtUword i;
+  if (!gfi) return;
+  fim = gt_feature_index_mapped_cast(gfi);
+  if (fim->indexes) {
+    for (i = 0; i < fim->nof_regions; i++)
+      gt_interval_index_delete(fim->indexes[i]);
+    gt_free(fim->indexes);
+  }
+  gt_hashmap_delete(fim->nodes);
+  gt_feature_index_delete(fim->delta);
+  gt_hashmap_delete(fim->delta_nodes);
+  gt_hashmap_delete(fim->shadowed);
+  gt_binary_node_reader_delete(fim->reader);
+  gt_mutex_delete(fim->decode_lock);
+  if (fim->map)
+    gt_fa_xmunmap(fim->map);
+}
+
+const GtFeatureIndexClass* gt_feature_index_mapped_class(void)
+{
+  static GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexMapped),
+                             gt_feature_index_mapped_add_region_node,
+                             gt_feature_index_mapped_add_feature_node,
+                             gt_feature_index_mapped_remove_node,
+                             gt_feature_index_mapped_get_features_for_seqid,
+                             gt_feature_index_mapped_get_features_for_range,
+                             gt_feature_index_mapped_get_first_seqid,
+                             NULL,
+                             gt_feature_index_mapped_get_seqids,
+                             gt_feature_index_mapped_get_range_for_seqid,
+                             gt_feature_index_mapped_get_orig_range_for_seqid,
+                             gt_feature_index_mapped_has_seqid,
+                             gt_feature_index_mapped_delete);
+    gt_feature_index_class_set_freeze_func(fic,
+                                           gt_feature_index_mapped_freeze);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+/* Checks that <offset> is aligned and that <num> elements of <size> bytes
+   starting there fit into the first <len> bytes of the file. */
+static bool valid_table(GtUword offset, GtUword num, size_t size, size_t len)
+{
+  return offset % sizeof (GtUword) == 0 && offset <= len &&
+         num <= (len - offset) / size;
+}
+
+static int feature_index_mapped_check(GtFeatureIndexMapped *fim,
+                                      const char *filename, GtError *err)
+{
+  const FeatureIndexMappedTrailer *trailer;
+  GtUword i, tables_len;
+  gt_error_check(err);
+  if (fim->maplen < FEATURE_INDEX_MAPPED_HEADER_LENGTH + sizeof *trailer ||
+      memcmp(fim->map, FEATURE_INDEX_MAPPED_MAGIC,
+             FEATURE_INDEX_MAPPED_MAGIC_LENGTH)) {
+    gt_error_set(err, "file \"%s\" is not a feature index file", filename);
+    return -1;
+  }
+  if (fim->map[FEATURE_INDEX_MAPPED_MAGIC_LENGTH]
+      != FEATURE_INDEX_MAPPED_VERSION) {
+    gt_error_set(err, "unsupported version %d of feature index file \"%s\"",
+                 fim->map[FEATURE_INDEX_MAPPED_MAGIC_LENGTH], filename);
+    return -1;
+  }
+  tables_len = fim->maplen - sizeof *trailer;
+  trailer = (const FeatureIndexMappedTrailer*) (fim->map + tables_len);
+  if (fim->map[FEATURE_INDEX_MAPPED_MAGIC_LENGTH + 1] != sizeof (GtUword) ||
+      tables_len % sizeof (GtUword) ||
+      trailer->byte_order != FEATURE_INDEX_MAPPED_BYTE_ORDER) {
+    gt_error_set(err, "feature index file \"%s\" was written on a machine with "
+                 "a different word size or byte order", filename);
+    return -1;
+  }
+  if (trailer->dictionary < FEATURE_INDEX_MAPPED_HEADER_LENGTH ||
+      trailer->dictionary > tables_len ||
+      !valid_table(trailer->regions, trailer->nof_regions,
+                   sizeof (FeatureIndexMappedRegion), tables_len) ||
+      (trailer->nof_regions && trailer->first_region >= trailer->nof_regions)) {
+    gt_error_set(err, "feature index file \"%s\" is corrupt", filename);
+    return -1;
+  }
+  fim->regions = (const FeatureIndexMappedRegion*) (fim->map
+                                                    + trailer->regions);
+  fim->nof_regions = trailer->nof_regions;
+  fim->first_region = trailer->first_region;
+  fim->records_end = trailer->dictionary;
+  for (i = 0; i < fim->nof_regions; i++) {
+    const FeatureIndexMappedRegion *region = fim->regions + i;
+    if (region->seqid < trailer->dictionary || region->seqid >= tables_len ||
+        !memchr(fim->map + region->seqid, '\0', tables_len - region->seqid) ||
+        !valid_table(region->entries, region->nof_entries,
+                     sizeof (GtIntervalIndexEntry), tables_len) ||
+        (i > 0 && strcmp(fim->map + fim->regions[i-1].seqid,
+                         fim->map + region->seqid) >= 0)) {
+      gt_error_set(err, "feature index file \"%s\" is corrupt", filename);
+      return -1;
+    }
+  }
+  fim->reader = gt_binary_node_reader_new_from_memory(fim->map, tables_len);
+  gt_binary_node_reader_seek(fim->reader, trailer->dictionary);
+  return gt_binary_node_reader_read_dictionary(fim->reader, err);
+}
+
+/* Applies the delta record <gn> to the changes of <fim>. */
+static int apply_delta_record(GtFeatureIndexMapped *fim, GtGenomeNode *gn,
+                              GtError *err)
+{
+  GtFeatureNode *fn = NULL, *old;
+  GtRegionNode *rn;
+  GtMetaNode *mn;
+  const char *id = NULL;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if ((rn = gt_region_node_try_cast(gn)))
+    return gt_feature_index_add_region_node(fim->delta, rn, err);
+  if ((fn = gt_feature_node_try_cast(gn)))
+    id = feature_id(fn);
+  else if ((mn = gt_meta_node_try_cast(gn)) &&
+           !strcmp(gt_meta_node_get_directive(mn),
+                   FEATURE_INDEX_MAPPED_DELTA_REMOVE)) {
+    id = gt_meta_node_get_data(mn);
+  }
+  else {
+    gt_error_set(err, "invalid record in feature index delta file");
+    return -1;
+  }
+  if (!id) {
+    gt_error_set(err, "feature without ID in feature index delta file");
+    return -1;
+  }
+
+  /* hide all earlier versions of the feature */
+  if (!gt_hashmap_get(fim->shadowed, id)) {
+    char *key = gt_cstr_dup(id);
+    gt_hashmap_add(fim->shadowed, key, key);
+  }
+  if ((old = gt_hashmap_get(fim->delta_nodes, id))) {
+    had_err = gt_feature_index_remove_node(fim->delta, old, err);
+    if (!had_err)
+      gt_hashmap_remove(fim->delta_nodes, id);
+  }
+  if (!had_err && fn) {
+    had_err = gt_feature_index_add_feature_node(fim->delta, fn, err);
+    if (!had_err)
+      gt_hashmap_add(fim->delta_nodes, gt_cstr_dup(id), fn);
+  }
+  return had_err;
+}
+
+static void delta_filename(GtStr *path, const char *filename)
+{
+  gt_str_set(path, filename);
+  gt_str_append_cstr(path, FEATURE_INDEX_MAPPED_DELTA_SUFFIX);
+}
+
+/* Reads the delta file belonging to the index file <filename>, if any. */
+static int feature_index_mapped_read_delta(GtFeatureIndexMapped *fim,
+                                           const char *filename, GtError *err)
+{
+  GtBinaryNodeReader *bnr;
+  GtGenomeNode *gn;
+  GtStr *path;
+  char *map = NULL;
+  size_t len = 0, pos = 0;
+  int had_err = 0;
+  gt_error_check(err);
+
+  path = gt_str_new();
+  delta_filename(path, filename);
+  if (!gt_file_exists(gt_str_get(path)) ||
+      gt_file_size(gt_str_get(path)) == 0) {
+    gt_str_delete(path);
+    return 0;
+  }
+  if (!(map = gt_fa_mmap_read(gt_str_get(path), &len, err)))
+    had_err = -1;
+  if (!had_err) {
+    fim->delta = gt_feature_index_memory_new();
+    fim->delta_nodes = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+    fim->shadowed = gt_hashmap_new(GT_HASH_STRING, gt_free_func, NULL);
+  }
+  while (!had_err && pos < len) {
+    bnr = gt_binary_node_reader_new_from_memory(map + pos, len - pos);
+    had_err = gt_binary_node_reader_read_header(bnr, err);
+    while (!had_err) {
+      had_err = gt_binary_node_reader_next(bnr, &gn, err);
+      if (!had_err && !gn) {
+        /* an interrupted append leaves a segment without EOF record */
+        gt_error_set(err, "delta file \"%s\" ends in an incomplete segment",
+                     gt_str_get(path));
+        had_err = -1;
+      }
+      if (!had_err && gt_eof_node_try_cast(gn)) {
+        gt_genome_node_delete(gn);
+        break;
+      }
+      if (!had_err)
+        had_err = apply_delta_record(fim, gn, err);
+      gt_genome_node_delete(gn);
+    }
+    pos += gt_binary_node_reader_get_offset(bnr);
+    gt_binary_node_reader_delete(bnr);
+  }
+  if (map)
+    gt_fa_xmunmap(map);
+  gt_str_delete(path);
+  return had_err;
+}
+
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename, GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureIndex *fi;
+  GtUword i;
+  gt_error_check(err);
+  gt_assert(filename);
+  fi = gt_feature_index_create(gt_feature_index_mapped_class());
+  fim = gt_feature_index_mapped_cast(fi);
+  fim->nodes = gt_hashmap_new(GT_HASH_DIRECT, NULL,
+                              (GtFree) gt_genome_node_delete);
+  fim->decode_lock = gt_mutex_new();
+  if (!(fim->map = gt_fa_mmap_read(filename, &fim->maplen, err)) ||
+      feature_index_mapped_check(fim, filename, err)) {
+    gt_feature_index_delete(fi);
+    return NULL;
+  }
+  /* the interval indexes are queried in place */
+  fim->indexes = gt_malloc(fim->nof_regions * sizeof (GtIntervalIndex*));
+  for (i = 0; i < fim->nof_regions; i++) {
+    fim->indexes[i] = gt_interval_index_new_static(
+                                      (const GtIntervalIndexEntry*)
+                                      (fim->map + fim->regions[i].entries),
+                                      fim->regions[i].nof_entries);
+  }
+  if (feature_index_mapped_read_delta(fim, filename, err)) {
+    gt_feature_index_delete(fi);
+    return NULL;
+  }
+  return fi;
+}
+
+static int cmp_cstr(const void *a, const void *b)
+{
+  return strcmp(*(const char**) a, *(const char**) b);
+}
+
+static void write_padding(GtFile *outfp, GtUword *offset)
+{
+  static const char zeros[sizeof (GtUword)] = { 0 };
+  GtUword padding = (sizeof (GtUword) - *offset % sizeof (GtUword))
+                    % sizeof (GtUword);
+  if (padding) {
+    gt_file_xwrite(outfp, (void*) zeros, padding);
+    *offset += padding;
+  }
+}
+
+int gt_feature_index_mapped_write(GtFeatureIndex *feature_index,
+                                  const char *filename, GtError *err)
+{
+  FeatureIndexMappedTrailer trailer;
+  FeatureIndexMappedRegion *regions = NULL;
+  GtIntervalIndex **indexes = NULL;
+  GtBinaryNodeWriter *bnw = NULL;
+  GtStrArray *seqid_array;
+  GtArray *seqids;
+  GtFile *outfp = NULL;
+  char header[FEATURE_INDEX_MAPPED_HEADER_LENGTH], *first_seqid = NULL;
+  GtUword i, j, offset = 0, nof_regions = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(feature_index && filename);
+
+  /* the regions are stored in the order of their sequence IDs */
+  seqids = gt_array_new(sizeof (const char*));
+  if (!(seqid_array = gt_feature_index_get_seqids(feature_index, err)))
+    had_err = -1;
+  if (!had_err) {
+    for (i = 0; i < gt_str_array_size(seqid_array); i++) {
+      const char *seqid = gt_str_array_get(seqid_array, i);
+      gt_array_add(seqids, seqid);
+    }
+    gt_array_sort(seqids, cmp_cstr);
+    nof_regions = gt_array_size(seqids);
+    regions = gt_calloc(nof_regions, sizeof *regions);
+    indexes = gt_calloc(nof_regions, sizeof *indexes);
+    if (!(outfp = gt_file_open(GT_FILE_MODE_UNCOMPRESSED, filename, "wb",
+                               err))) {
+      had_err = -1;
+    }
+  }
+
+  if (!had_err) {
+    memset(header, 0, sizeof header);
+    memcpy(header, FEATURE_INDEX_MAPPED_MAGIC,
+           FEATURE_INDEX_MAPPED_MAGIC_LENGTH);
+    header[FEATURE_INDEX_MAPPED_MAGIC_LENGTH] = FEATURE_INDEX_MAPPED_VERSION;
+    header[FEATURE_INDEX_MAPPED_MAGIC_LENGTH + 1] = sizeof (GtUword);
+    gt_file_xwrite(outfp, header, sizeof header);
+    bnw = gt_binary_node_writer_new(outfp);
+    gt_binary_node_writer_detach_dictionary(bnw);
+  }
+
+  /* feature records */
+  for (i = 0; !had_err && i < nof_regions; i++) {
+    const char *seqid = *(const char**) gt_array_get(seqids, i);
+    GtArray *features;
+    if (!(features = gt_feature_index_get_features_for_seqid(feature_index,
+                                                             seqid, err))) {
+      had_err = -1;
+      break;
+    }
+    indexes[i] = gt_interval_index_new(NULL);
+    for (j = 0; j < gt_array_size(features); j++) {
+      GtGenomeNode *gn = *(GtGenomeNode**) gt_array_get(features, j);
+      GtRange range = gt_genome_node_get_range(gn);
+      offset = FEATURE_INDEX_MAPPED_HEADER_LENGTH
+               + gt_binary_node_writer_get_offset(bnw);
+      gt_binary_node_writer_write(bnw, gn);
+      gt_interval_index_add(indexes[i], (void*) offset, range.start,
+                            range.end);
+    }
+    gt_array_delete(features);
+    had_err = gt_feature_index_get_range_for_seqid(feature_index,
+                                                   &regions[i].range, seqid,
+                                                   err);
+    regions[i].orig_range = regions[i].range;
+    if (!had_err) {
+      had_err = gt_feature_index_get_orig_range_for_seqid(feature_index,
+                                                         &regions[i].orig_range,
+                                                          seqid, err);
+    }
+  }
+
+  if (!had_err) {
+    /* dictionary */
+    trailer.dictionary = FEATURE_INDEX_MAPPED_HEADER_LENGTH
+                         + gt_binary_node_writer_get_offset(bnw);
+    gt_binary_node_writer_write_dictionary(bnw);
+    offset = FEATURE_INDEX_MAPPED_HEADER_LENGTH
+             + gt_binary_node_writer_get_offset(bnw);
+    /* sequence IDs */
+    for (i = 0; i < nof_regions; i++) {
+      const char *seqid = *(const char**) gt_array_get(seqids, i);
+      GtUword length = strlen(seqid) + 1;
+      regions[i].seqid = offset;
+      gt_file_xwrite(outfp, (void*) seqid, length);
+      offset += length;
+    }
+    write_padding(outfp, &offset);
+    /* interval index entries */
+    for (i = 0; i < nof_regions; i++) {
+      const GtIntervalIndexEntry *entries;
+      entries = gt_interval_index_get_entries(indexes[i],
+                                              &regions[i].nof_entries);
+      regions[i].entries = offset;
+      gt_file_xwrite(outfp, (void*) entries,
+                     regions[i].nof_entries * sizeof *entries);
+      offset += regions[i].nof_entries * sizeof *entries;
+    }
+    /* region table and trailer */
+    trailer.regions = offset;
+    trailer.nof_regions = nof_regions;
+    trailer.first_region = 0;
+    trailer.byte_order = FEATURE_INDEX_MAPPED_BYTE_ORDER;
+    if (nof_regions)
+      gt_file_xwrite(outfp, regions, nof_regions * sizeof *regions);
+    first_seqid = gt_feature_index_get_first_seqid(feature_index, err);
+    for (i = 0; first_seqid && i < nof_regions; i++) {
+      if (!strcmp(*(const char**) gt_array_get(seqids, i), first_seqid))
+        trailer.first_region = i;
+    }
+    gt_free(first_seqid);
+    gt_file_xwrite(outfp, &trailer, sizeof trailer);
+  }
+
+  if (indexes) {
+    for (i = 0; i < nof_regions; i++)
+      gt_interval_index_delete(indexes[i]);
+  }
+  gt_free(indexes);
+  gt_free(regions);
+  gt_binary_node_writer_delete(bnw);
+  gt_file_delete(outfp);
+  gt_array_delete(seqids);
+  gt_str_array_delete(seqid_array);
+  return had_err;
+}
+
+int gt_feature_index_mapped_append_delta(const char *filename,
+                                        GtArray *features,
+                                        GtStrArray *removed_ids,
+                                        GtError *err)
+{
+  GtBinaryNodeWriter *bnw;
+  GtGenomeNode *gn;
+  GtFile *outfp;
+  GtStr *path;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  if (!gt_file_exists(filename)) {
+    gt_error_set(err, "feature index file \"%s\" does not exist", filename);
+    return -1;
+  }
+  for (i = 0; !had_err && features && i < gt_array_size(features); i++) {
+    gn = *(GtGenomeNode**) gt_array_get(features, i);
+    if (!gt_feature_node_try_cast(gn) || !feature_id((GtFeatureNode*) gn)) {
+      gt_error_set(err, "top-level feature on line %u in file \"%s\" has no "
+                   "ID and cannot be added to a feature index delta",
+                   gt_genome_node_get_line_number(gn),
+                   gt_genome_node_get_filename(gn));
+      had_err = -1;
+    }
+  }
+  if (had_err)
+    return had_err;
+
+  path = gt_str_new();
+  delta_filename(path, filename);
+  if (!(outfp = gt_file_open(GT_FILE_MODE_UNCOMPRESSED, gt_str_get(path),
+                             "ab", err))) {
+    gt_str_delete(path);
+    return -1;
+  }
+  /* removals come first, such that removing and adding an ID in the same
+     segment replaces the feature */
+  bnw = gt_binary_node_writer_new(outfp);
+  gt_binary_node_writer_write_header(bnw);
+  for (i = 0; removed_ids && i < gt_str_array_size(removed_ids); i++) {
+    gn = gt_meta_node_new(FEATURE_INDEX_MAPPED_DELTA_REMOVE,
+                          gt_str_array_get(removed_ids, i));
+    gt_binary_node_writer_write(bnw, gn);
+    gt_genome_node_delete(gn);
+  }
+  for (i = 0; features && i < gt_array_size(features); i++)
+    gt_binary_node_writer_write(bnw, *(GtGenomeNode**) gt_array_get(features,
+                                                                    i));
+  gn = gt_eof_node_new();
+  gt_binary_node_writer_write(bnw, gn);
+  gt_genome_node_delete(gn);
+  gt_binary_node_writer_delete(bnw);
+  gt_file_delete(outfp);
+  gt_str_delete(path);
+  return had_err;
+}
+
+int gt_feature_index_mapped_compact(const char *filename, GtError *err)
+{
+  GtFeatureIndexMapped *fim;
+  GtFeatureIndex *fi;
+  GtStr *path, *tmppath;
+  bool has_delta;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  if (!(fi = gt_feature_index_mapped_new(filename, err)))
+    return -1;
+  fim = gt_feature_index_mapped_cast(fi);
+  has_delta = fim->delta != NULL;
+  path = gt_str_new();
+  delta_filename(path, filename);
+  tmppath = gt_str_new_cstr(filename);
+  gt_str_append_cstr(tmppath, FEATURE_INDEX_MAPPED_COMPACT_SUFFIX);
+  if (has_delta)
+    had_err = gt_feature_index_mapped_write(fi, gt_str_get(tmppath), err);
+  gt_feature_index_delete(fi);
+
+  /* the new index already contains the changes, so a crash before the delta
+     file is removed only makes them be applied twice, which is harmless */
+  if (!had_err && has_delta && rename(gt_str_get(tmppath), filename)) {
+    gt_error_set(err, "could not rename \"%s\" to \"%s\": %s",
+                 gt_str_get(tmppath), filename, strerror(errno));
+    had_err = -1;
+  }
+  if (!had_err && gt_file_exists(gt_str_get(path)) &&
+      unlink(gt_str_get(path))) {
+    gt_error_set(err, "could not remove delta file \"%s\": %s",
+                 gt_str_get(path), strerror(errno));
+    had_err = -1;
+  }
+  if (had_err && gt_file_exists(gt_str_get(tmppath)))
+    (void) unlink(gt_str_get(tmppath));
+  gt_str_delete(tmppath);
+  gt_str_delete(path);
+  return had_err;
+}
+
+#define FEATURE_INDEX_MAPPED_TEST_NOF_FEATURES  500
+#define FEATURE_INDEX_MAPPED_TEST_MAXPOS        100000
+#define FEATURE_INDEX_MAPPED_TEST_MAXLEN        2000
+
+static GtGenomeNode* delta_test_gene(GtStr *seqid, const char *id,
+                                     GtUword start, GtUword end)
+{
+  GtGenomeNode *gene;
+  gene = gt_feature_node_new(seqid, "gene", start, end, GT_STRAND_FORWARD);
+  if (id)
+    gt_feature_node_add_attribute((GtFeatureNode*) gene, "ID", id);
+  return gene;
+}
+
+/* Checks that querying the whole of <seqid> in <fi> gives features starting at
+   the <nof_starts> positions in <starts>. */
+static int delta_test_query(GtFeatureIndex *fi, const char *seqid,
+                            const GtUword *starts, GtUword nof_starts,
+                            GtError *err)
+{
+  GtArray *results;
+  GtRange range = {1, 100000};
+  GtUword i;
+  int had_err = 0;
+  results = gt_array_new(sizeof (GtFeatureNode*));
+  gt_ensure(!gt_feature_index_get_features_for_range(fi, results, seqid,
+                                                     &range, err));
+  gt_ensure(gt_array_size(results) == nof_starts);
+  for (i = 0; !had_err && i < nof_starts; i++) {
+    GtGenomeNode *gn = *(GtGenomeNode**) gt_array_get(results, i);
+    gt_ensure(gt_genome_node_get_start(gn) == starts[i]);
+  }
+  gt_array_delete(results);
+  return had_err;
+}
+
+static int feature_index_mapped_delta_test(GtError *err)
+{
+  static const GtUword base_starts[] = { 100, 300, 500 },
+                       merged_starts[] = { 100, 550, 1000 };
+  GtFeatureIndex *fi, *fim = NULL;
+  GtGenomeNode *gn;
+  GtArray *features;
+  GtStrArray *removed;
+  GtStr *seqid, *seqid9, *filename, *deltafile;
+  GtError *testerr;
+  GtRange range;
+  FILE *fp;
+  GtUword i;
+  bool has_seqid;
+  int had_err = 0;
+  gt_error_check(err);
+
+  fi = gt_feature_index_memory_new();
+  seqid = gt_str_new_cstr("seq1");
+  seqid9 = gt_str_new_cstr("seq9");
+  for (i = 0; i < 3; i++) {
+    char id[3] = { 'g', '1' + i, '\0' };
+    gn = delta_test_gene(seqid, id, base_starts[i], base_starts[i] + 100);
+    gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn, err);
+    gt_genome_node_delete(gn);
+  }
+  filename = gt_str_new();
+  fp = gt_xtmpfp(filename);
+  gt_fa_xfclose(fp);
+  deltafile = gt_str_new();
+  delta_filename(deltafile, gt_str_get(filename));
+  gt_ensure(!gt_feature_index_mapped_write(fi, gt_str_get(filename), err));
+  gt_feature_index_delete(fi);
+
+  /* first segment: remove g2, move g3, add g4 on a new sequence region */
+  features = gt_array_new(sizeof (GtGenomeNode*));
+  removed = gt_str_array_new();
+  if (!had_err) {
+    gt_str_array_add_cstr(removed, "g2");
+    gn = delta_test_gene(seqid, "g3", 550, 700);
+    gt_array_add(features, gn);
+    gn = delta_test_gene(seqid9, "g4", 10, 20);
+    gt_array_add(features, gn);
+    gt_ensure(!gt_feature_index_mapped_append_delta(gt_str_get(filename),
+                                                    features, removed, err));
+  }
+  if (!had_err) {
+    fim = gt_feature_index_mapped_new(gt_str_get(filename), err);
+    gt_ensure(fim);
+  }
+  if (!had_err) {
+    static const GtUword starts[] = { 100, 550 }, starts9[] = { 10 };
+    gt_ensure(!delta_test_query(fim, "seq1", starts, 2, err));
+    gt_ensure(!delta_test_query(fim, "seq9", starts9, 1, err));
+    gt_ensure(!gt_feature_index_has_seqid(fim, &has_seqid, "seq9", err));
+    gt_ensure(has_seqid);
+    gt_ensure(!gt_feature_index_get_range_for_seqid(fim, &range, "seq1", err));
+    gt_ensure(range.start == 100 && range.end == 700);
+  }
+  gt_feature_index_delete(fim);
+  fim = NULL;
+  for (i = 0; i < gt_array_size(features); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(features, i));
+  gt_array_reset(features);
+  gt_str_array_reset(removed);
+
+  /* second segment: add g2 again, remove g4 */
+  if (!had_err) {
+    gt_str_array_add_cstr(removed, "g4");
+    gn = delta_test_gene(seqid, "g2", 1000, 1100);
+    gt_array_add(features, gn);
+    gt_ensure(!gt_feature_index_mapped_append_delta(gt_str_get(filename),
+                                                    features, removed, err));
+  }
+  if (!had_err) {
+    fim = gt_feature_index_mapped_new(gt_str_get(filename), err);
+    gt_ensure(fim);
+  }
+  if (!had_err) {
+    gt_ensure(!delta_test_query(fim, "seq1", merged_starts, 3, err));
+    gt_ensure(!delta_test_query(fim, "seq9", NULL, 0, err));
+    gt_ensure(!gt_feature_index_freeze(fim, err));
+    gt_ensure(!delta_test_query(fim, "seq1", merged_starts, 3, err));
+  }
+  gt_feature_index_delete(fim);
+  fim = NULL;
+  for (i = 0; i < gt_array_size(features); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(features, i));
+  gt_array_reset(features);
+
+  /* features without ID are rejected */
+  if (!had_err) {
+    gn = delta_test_gene(seqid, NULL, 1, 10);
+    gt_array_add(features, gn);
+    testerr = gt_error_new();
+    gt_ensure(gt_feature_index_mapped_append_delta(gt_str_get(filename),
+                                                   features, NULL, testerr));
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_delete(testerr);
+    gt_genome_node_delete(gn);
+    gt_array_reset(features);
+  }
+
+  /* compaction writes the merged index and removes the delta file */
+  if (!had_err) {
+    gt_ensure(!gt_feature_index_mapped_compact(gt_str_get(filename), err));
+    gt_ensure(!gt_file_exists(gt_str_get(deltafile)));
+  }
+  if (!had_err) {
+    fim = gt_feature_index_mapped_new(gt_str_get(filename), err);
+    gt_ensure(fim);
+  }
+  if (!had_err) {
+    gt_ensure(!((GtFeatureIndexMapped*) gt_feature_index_mapped_cast(fim))
+                 ->delta);
+    gt_ensure(!delta_test_query(fim, "seq1", merged_starts, 3, err));
+  }
+  gt_feature_index_delete(fim);
+  fim = NULL;
+
+  /* an incomplete segment is detected */
+  if (!had_err) {
+    fp = gt_fa_xfopen(gt_str_get(deltafile), "wb");
+    fwrite(GT_BINARY_NODE_MAGIC, 1, GT_BINARY_NODE_MAGIC_LENGTH, fp);
+    fputc(GT_BINARY_NODE_VERSION, fp);
+    gt_fa_xfclose(fp);
+    testerr = gt_error_new();
+    fim = gt_feature_index_mapped_new(gt_str_get(filename), testerr);
+    gt_ensure(!fim);
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_delete(testerr);
+    gt_xunlink(gt_str_get(deltafile));
+  }
+
+  gt_xunlink(gt_str_get(filename));
+  gt_array_delete(features);
+  gt_str_array_delete(removed);
+  gt_str_delete(deltafile);
+  gt_str_delete(filename);
+  gt_str_delete(seqid9);
+  gt_str_delete(seqid);
+  return had_err;
+}
+
+int gt_feature_index_mapped_unit_test(GtError *err)
+{
+  GtFeatureIndex *fi, *fim = NULL;
+  GtStrArray *seqids = NULL;
+  GtStr *seqid, *filename;
+  GtArray *results, *ref_results;
+  GtError *testerr;
+  GtRange range;
+  FILE *fp;
+  GtUword i, j, k;
+  bool has_seqid;
+  int had_err = 0;
+  gt_error_check(err);
+
+  fi = gt_feature_index_memory_new();
+  seqid = gt_str_new_cstr("seq2");
+  for (i = 0; i < FEATURE_INDEX_MAPPED_TEST_NOF_FEATURES; i++) {
+    GtGenomeNode *gene, *exon;
+    GtUword start = gt_rand_max(FEATURE_INDEX_MAPPED_TEST_MAXPOS) + 1,
+            end = start + gt_rand_max(FEATURE_INDEX_MAPPED_TEST_MAXLEN);
+    gene = gt_feature_node_new(seqid, "gene", start, end, GT_STRAND_FORWARD);
+    gt_feature_node_add_attribute((GtFeatureNode*) gene, "Name", "foo");
+    exon = gt_feature_node_new(seqid, "exon", start, end, GT_STRAND_FORWARD);
+    gt_feature_node_add_child((GtFeatureNode*) gene, (GtFeatureNode*) exon);
+    gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gene, err);
+    gt_genome_node_delete(gene);
+  }
+  {
+    GtStr *seqid1 = gt_str_new_cstr("seq1");
+    GtGenomeNode *rn = gt_region_node_new(seqid1, 1, 1000);
+    gt_feature_index_add_region_node(fi, (GtRegionNode*) rn, err);
+    gt_genome_node_delete(rn);
+    gt_str_delete(seqid1);
+  }
+
+  filename = gt_str_new();
+  fp = gt_xtmpfp(filename);
+  gt_fa_xfclose(fp);
+  gt_ensure(!gt_feature_index_mapped_write(fi, gt_str_get(filename), err));
+  if (!had_err) {
+    fim = gt_feature_index_mapped_new(gt_str_get(filename), err);
+    gt_ensure(fim);
+  }
+
+  /* sequence regions */
+  if (!had_err) {
+    char *first_seqid = gt_feature_index_get_first_seqid(fim, err);
+    gt_ensure(!strcmp(first_seqid, "seq2"));
+    gt_free(first_seqid);
+    seqids = gt_feature_index_get_seqids(fim, err);
+    gt_ensure(gt_str_array_size(seqids) == 2);
+    gt_ensure(!strcmp(gt_str_array_get(seqids, 0), "seq1"));
+    gt_ensure(!strcmp(gt_str_array_get(seqids, 1), "seq2"));
+    gt_ensure(!gt_feature_index_has_seqid(fim, &has_seqid, "seq1", err));
+    gt_ensure(has_seqid);
+    gt_ensure(!gt_feature_index_has_seqid(fim, &has_seqid, "seq3", err));
+    gt_ensure(!has_seqid);
+    gt_ensure(!gt_feature_index_get_orig_range_for_seqid(fim, &range, "seq1",
+                                                         err));
+    gt_ensure(range.start == 1 && range.end == 1000);
+  }
+
+  /* range queries give the same features as the memory index, before and
+     after freezing both indexes */
+  results = gt_array_new(sizeof (GtFeatureNode*));
+  ref_results = gt_array_new(sizeof (GtFeatureNode*));
+  for (k = 0; !had_err && k < 2; k++) {
+    if (k == 1) {
+      gt_ensure(!gt_feature_index_freeze(fi, err));
+      gt_ensure(!gt_feature_index_freeze(fim, err));
+    }
+    for (j = 0; !had_err && j < 100; j++) {
+      range.start = gt_rand_max(FEATURE_INDEX_MAPPED_TEST_MAXPOS) + 1;
+      range.end = range.start + gt_rand_max(FEATURE_INDEX_MAPPED_TEST_MAXLEN);
+      gt_array_reset(results);
+      gt_array_reset(ref_results);
+      gt_ensure(!gt_feature_index_get_features_for_range(fi, ref_results,
+                                                         "seq2", &range, err));
+      gt_ensure(!gt_feature_index_get_features_for_range(fim, results, "seq2",
+                                                         &range, err));
+      gt_ensure(gt_array_size(results) == gt_array_size(ref_results));
+      for (i = 0; !had_err && i < gt_array_size(results); i++) {
+        GtFeatureNode *fn = *(GtFeatureNode**) gt_array_get(results, i),
+                      *ref = *(GtFeatureNode**) gt_array_get(ref_results, i);
+        GtRange r = gt_genome_node_get_range((GtGenomeNode*) fn),
+                ref_r = gt_genome_node_get_range((GtGenomeNode*) ref);
+        gt_ensure(!gt_range_compare(&r, &ref_r));
+        gt_ensure(!strcmp(gt_feature_node_get_attribute(fn, "Name"), "foo"));
+        gt_ensure(gt_feature_node_number_of_children(fn) == 1);
+      }
+    }
+  }
+
+  /* the index cannot be modified */
+  if (!had_err) {
+    GtGenomeNode *gn = gt_feature_node_new(seqid, "gene", 1, 10,
+                                           GT_STRAND_FORWARD);
+    testerr = gt_error_new();
+    gt_ensure(gt_feature_index_add_feature_node(fim, (GtFeatureNode*) gn,
+                                                testerr));
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_delete(testerr);
+    gt_genome_node_delete(gn);
+  }
+
+  /* other files are rejected */
+  if (!had_err) {
+    GtFeatureIndex *invalid;
+    fp = gt_fa_xfopen(gt_str_get(filename), "w");
+    fputs("##gff-version 3\n", fp);
+    gt_fa_xfclose(fp);
+    testerr = gt_error_new();
+    invalid = gt_feature_index_mapped_new(gt_str_get(filename), testerr);
+    gt_ensure(!invalid);
+    gt_ensure(gt_error_is_set(testerr));
+    gt_error_delete(testerr);
+  }
+
+  if (!had_err)
+    had_err = feature_index_mapped_delta_test(err);
+
+  gt_xunlink(gt_str_get(filename));
+  gt_array_delete(results);
+  gt_array_delete(ref_results);
+  gt_str_array_delete(seqids);
+  gt_feature_index_delete(fim);
+  gt_feature_index_delete(fi);
+  gt_str_delete(filename);
+  gt_str_delete(seqid);
+  return had_err;
+}
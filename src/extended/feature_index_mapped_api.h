@@ -0,0 +1,63 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef FEATURE_INDEX_MAPPED_API_H
+#define FEATURE_INDEX_MAPPED_API_H
+
+#include "core/array_api.h"
+#include "core/str_array_api.h"
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexMapped> class implements a read-only <GtFeatureIndex> on
+   top of an index file written by <gt_feature_index_mapped_write()>. The file
+   is memory mapped, so opening it does not depend on the number of features
+   it contains, and processes on the same host share its pages. Features are
+   decoded when they are first returned by a query and kept until the index is
+   deleted. Index files depend on the byte order and word size of the machine
+   they were written on.
+   An index file can be updated without rewriting it by appending delta
+   segments with <gt_feature_index_mapped_append_delta()>. The changes of all
+   segments are read into memory when the index is opened and merged into the
+   results of all queries. <gt_feature_index_mapped_compact()> merges them
+   into the index file. */
+typedef struct GtFeatureIndexMapped GtFeatureIndexMapped;
+
+/* Opens the feature index file <filename> and returns a <GtFeatureIndex> for
+   it. Returns NULL and sets <err> if the file could not be mapped or is not a
+   valid feature index file. */
+GtFeatureIndex* gt_feature_index_mapped_new(const char *filename,
+                                            GtError *err);
+/* Writes all sequence regions and features of <feature_index> to the feature
+   index file <filename>. Returns -1 and sets <err> on error, 0 otherwise. */
+int             gt_feature_index_mapped_write(GtFeatureIndex *feature_index,
+                                              const char *filename,
+                                              GtError *err);
+/* Appends a delta segment to the feature index file <filename>: the features
+   with the IDs in <removed_ids> are removed, and the top-level features in
+   <features> (an array of <GtGenomeNode*>) are added, replacing earlier
+   versions with the same ID. All <features> must have an ID. Either array may
+   be NULL. Returns -1 and sets <err> on error, 0 otherwise. */
+int             gt_feature_index_mapped_append_delta(const char *filename,
+                                                     GtArray *features,
+                                                     GtStrArray *removed_ids,
+                                                     GtError *err);
+/* Rewrites the feature index file <filename> with all changes from its delta
+   segments and removes them. Returns -1 and sets <err> on error, 0
+   otherwise. */
+int             gt_feature_index_mapped_compact(const char *filename,
+                                                GtError *err);
+
+#endif
@@ -24,7 +24,7 @@
 #include "core/cstr_api.h"
 #include "core/ensure.h"
 #include "core/hashmap.h"
-#include "core/interval_tree.h"
+#include "core/interval_index.h"
 #include "core/ma.h"
 #include "core/minmax.h"
 #include "core/range.h"
@@ -51,14 +51,14 @@ struct GtFeatureIndexMemory {
         gt_feature_index_cast(gt_feature_index_memory_class(), FI)
 
 typedef struct {
-  GtIntervalTree *features;
+  GtIntervalIndex *features;
   GtRegionNode *region;
   GtRange dyn_range;
 } RegionInfo;
 
 static void region_info_delete(RegionInfo *info)
 {
-  gt_interval_tree_delete(info->features);
+  gt_interval_index_delete(info->features);
   if (info->region)
     gt_genome_node_delete((GtGenomeNode*)info->region);
   gt_free(info);
@@ -77,10 +77,10 @@ int gt_feature_index_memory_add_region_node(GtFeatureIndex *gfi,
   if (!gt_hashmap_get(fi->regions, seqid)) {
     info = gt_calloc(1, sizeof (RegionInfo));
     info->region = (GtRegionNode*) gt_genome_node_ref((GtGenomeNode*) rn);
-    info->features = gt_interval_tree_new((GtFree)
-                                          gt_genome_node_delete);
+    info->features = gt_interval_index_new((GtFree) gt_genome_node_delete);
     info->dyn_range.start = ~0UL;
     info->dyn_range.end   = 0;
+    seqid = gt_cstr_dup(seqid);
     gt_hashmap_add(fi->regions, seqid, info);
     if (fi->nof_region_nodes++ == 0)
       fi->firstseqid = seqid;
@@ -97,7 +97,6 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
   GtFeatureIndexMemory *fi;
   GtRange node_range;
   RegionInfo *info;
-  GtIntervalTreeNode *new_node;
   gt_assert(gfi && fn);
 
   fi = gt_feature_index_memory_cast(gfi);
@@ -116,40 +115,24 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
   {
     info = gt_calloc(1, sizeof (RegionInfo));
     info->region = NULL;
-    info->features = gt_interval_tree_new((GtFree)
-                                          gt_genome_node_delete);
+    info->features = gt_interval_index_new((GtFree) gt_genome_node_delete);
     info->dyn_range.start = ~0UL;
     info->dyn_range.end   = 0;
+    seqid = gt_cstr_dup(seqid);
     gt_hashmap_add(fi->regions, seqid, info);
     if (fi->nof_region_nodes++ == 0)
       fi->firstseqid = seqid;
   }
 
-  /* add node to the appropriate array in the hashtable */
-  new_node = gt_interval_tree_node_new(gn, node_range.start, node_range.end);
-  gt_interval_tree_insert(info->features, new_node);
+  /* add node to the appropriate index in the hashtable, the search tree is
+     (re)built on the next query */
+  gt_interval_index_add(info->features, gn, node_range.start, node_range.end);
   /* update dynamic range */
   info->dyn_range.start = MIN(info->dyn_range.start, node_range.start);
   info->dyn_range.end = MAX(info->dyn_range.end, node_range.end);
   return 0;
 }
 
-typedef struct {
-  GtIntervalTreeNode *node;
-  GtGenomeNode *genome_node;
-} GtFeatureIndexMemoryByPtrExtractInfo;
-
-static int gt_feature_index_memory_get_itreenode_by_ptr(GtIntervalTreeNode *n,
-                                                        void *data)
-{
-  GtFeatureIndexMemoryByPtrExtractInfo *i =
-                                   (GtFeatureIndexMemoryByPtrExtractInfo*) data;
-  if (i->genome_node == gt_interval_tree_node_get_data(n)) {
-    i->node = n;
-  }
-  return 0;
-}
-
 int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
                                         GtFeatureNode *gn,
                                         GT_UNUSED GtError *err)
@@ -157,7 +140,6 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
   char* seqid;
   GtFeatureIndexMemory *fi;
   GtRange node_range;
-  GtFeatureIndexMemoryByPtrExtractInfo info;
   RegionInfo *rinfo;
   gt_assert(gfi && gn);
 
@@ -169,24 +151,16 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
   rinfo = (RegionInfo*) gt_hashmap_get(fi->regions, seqid);
   if (!rinfo)
     return 0;
-  info.genome_node = (GtGenomeNode*) gn;
-  info.node = NULL;
-
-  gt_interval_tree_iterate_overlapping(rinfo->features,
-                                   gt_feature_index_memory_get_itreenode_by_ptr,
-                                   node_range.start,
-                                   node_range.end,
-                                   &info);
-
-  if (info.node)
-    gt_interval_tree_remove(rinfo->features, info.node);
+  (void) gt_interval_index_remove(rinfo->features, gn, node_range.start,
+                                  node_range.end);
   return 0;
 }
 
-static int collect_features_from_itree(GtIntervalTreeNode *node, void *data)
+static int collect_features_from_index(void *data, GT_UNUSED GtUword start,
+                                       GT_UNUSED GtUword end, void *info)
 {
-  GtArray *a = (GtArray*) data;
-  GtGenomeNode *gn = (GtGenomeNode*) gt_interval_tree_node_get_data(node);
+  GtArray *a = (GtArray*) info;
+  GtGenomeNode *gn = (GtGenomeNode*) data;
   gt_array_add(a, gn);
   return 0;
 }
@@ -204,11 +178,10 @@ GtArray* gt_feature_index_memory_get_features_for_seqid(GtFeatureIndex *gfi,
   a = gt_array_new(sizeof (GtFeatureNode*));
   ri = (RegionInfo*) gt_hashmap_get(fi->regions, seqid);
   if (ri) {
-    had_err = gt_interval_tree_traverse(ri->features,
-                                        collect_features_from_itree,
-                                        a);
+    had_err = gt_interval_index_traverse(ri->features,
+                                         collect_features_from_index, a);
   }
-  gt_assert(!had_err);   /* collect_features_from_itree() is sane */
+  gt_assert(!had_err);   /* collect_features_from_index() is sane */
   return a;
 }
 
@@ -237,8 +210,8 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
     gt_error_set(err, "feature index does not contain the given sequence id");
     return -1;
   }
-  gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
-                                        qry_range->end, results);
+  gt_interval_index_find_all_overlapping(ri->features, qry_range->start,
+                                         qry_range->end, results);
   gt_array_sort(results, gt_genome_node_cmp_range_start);
   return 0;
 }
@@ -351,6 +324,25 @@ int gt_feature_index_memory_has_seqid(const GtFeatureIndex *gfi,
   return 0;
 }
 
+static int build_region_index(GT_UNUSED void *key, void *value,
+                              GT_UNUSED void *data, GT_UNUSED GtError *err)
+{
+  RegionInfo *info = (RegionInfo*) value;
+  gt_assert(info);
+  gt_interval_index_build(info->features);
+  return 0;
+}
+
+static int gt_feature_index_memory_freeze(GtFeatureIndex *gfi, GtError *err)
+{
+  GtFeatureIndexMemory *fi;
+  gt_error_check(err);
+  gt_assert(gfi);
+  fi = gt_feature_index_memory_cast(gfi);
+  /* build all search trees now, such that no query has to */
+  return gt_hashmap_foreach(fi->regions, build_region_index, NULL, err);
+}
+
 void gt_feature_index_memory_delete(GtFeatureIndex *gfi)
 {
   GtFeatureIndexMemory *fi;
@@ -362,7 +354,7 @@ void gt_feature_index_memory_delete(GtFeatureIndex *gfi)
 
 const GtFeatureIndexClass* gt_feature_index_memory_class(void)
 {
-  static const GtFeatureIndexClass *fic = NULL;
+  static GtFeatureIndexClass *fic = NULL;
   gt_class_alloc_lock_enter();
   if (!fic) {
     fic = gt_feature_index_class_new(sizeof (GtFeatureIndexMemory),
@@ -378,6 +370,8 @@ const GtFeatureIndexClass* gt_feature_index_memory_class(void)
                      gt_feature_index_memory_get_orig_range_for_seqid,
                      gt_feature_index_memory_has_seqid,
                      gt_feature_index_memory_delete);
+    gt_feature_index_class_set_freeze_func(fic,
+                                           gt_feature_index_memory_freeze);
   }
   gt_class_alloc_lock_leave();
   return fic;
@@ -390,7 +384,9 @@ GtFeatureIndex* gt_feature_index_memory_new(void)
   fi = gt_feature_index_create(gt_feature_index_memory_class());
   fim = gt_feature_index_memory_cast(fi);
   fim->nof_nodes = 0;
-  fim->regions = gt_hashmap_new(GT_HASH_STRING, NULL,
+  /* the sequence IDs are copied, the features they come from can be
+     removed */
+  fim->regions = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
                                 (GtFree) region_info_delete);
   fim->nodes_in_index = gt_hashmap_new(GT_HASH_DIRECT, NULL, NULL);
   return fi;
@@ -411,7 +407,9 @@ int gt_feature_index_memory_unit_test(GtError *err)
   had_err = gt_feature_index_unit_test(fi, err);
   gt_ensure(status == 0);
 
-  /* run subclass specific tests */
+  /* run subclass specific tests, the generic tests froze the index */
+  gt_feature_index_delete(fi);
+  fi = gt_feature_index_memory_new();
   testerr = gt_error_new();
   fn = gt_feature_node_cast(gt_feature_node_new_standard_gene());
   gt_ensure(!gt_feature_index_add_feature_node(fi, fn, testerr));
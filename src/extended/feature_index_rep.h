@@ -55,6 +55,7 @@ typedef int         (*GtFeatureIndexHasSeqidFunc)(const GtFeatureIndex*,
                                                   bool*,
                                                   const char*,
                                                   GtError*);
+typedef int         (*GtFeatureIndexFreezeFunc)(GtFeatureIndex*, GtError*);
 typedef void        (*GtFeatureIndexFreeFunc)(GtFeatureIndex*);
 
 typedef struct GtFeatureIndexMembers GtFeatureIndexMembers;
@@ -64,7 +65,7 @@ struct GtFeatureIndex {
   GtFeatureIndexMembers *pvt;
 };
 
-const GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
+GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
                                          GtFeatureIndexAddRegionNodeFunc
                                                  add_region_node,
                                          GtFeatureIndexAddFeatureNodeFunc
@@ -89,6 +90,11 @@ const GtFeatureIndexClass* gt_feature_index_class_new(size_t size,
                                                  has_seqid,
                                          GtFeatureIndexFreeFunc
                                                  free);
+/* Set the function called by <gt_feature_index_freeze()> to finalize the
+   index such that it can be queried without locking. */
+void            gt_feature_index_class_set_freeze_func(GtFeatureIndexClass*,
+                                                       GtFeatureIndexFreezeFunc
+                                                                        freeze);
 GtFeatureIndex* gt_feature_index_create(const GtFeatureIndexClass*);
 void*           gt_feature_index_cast(const GtFeatureIndexClass*,
                                       GtFeatureIndex*);
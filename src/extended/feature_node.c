@@ -86,7 +86,7 @@ static void feature_node_free(GtGenomeNode *gn)
   GtFeatureNode *fn = gt_feature_node_cast(gn);
   gt_str_delete(fn->seqid);
   gt_str_delete(fn->source);
-  gt_tag_value_map_delete(fn->attributes);
+  gt_tag_value_map_delete_in_arena(fn->attributes, gn->arena);
   if (fn->children) {
     GtDlistelem *dlistelem;
     for (dlistelem = gt_dlist_first(fn->children);
@@ -231,15 +231,13 @@ static void set_tree_status(unsigned int *bit_field, TreeStatus tree_status)
   *bit_field |= tree_status << TREE_STATUS_OFFSET;
 }
 
-GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
-                                  GtUword start, GtUword end,
-                                  GtStrand strand)
+static GtGenomeNode* feature_node_init(GtGenomeNode *gn, GtStr *seqid,
+                                       const char *type, GtUword start,
+                                       GtUword end, GtStrand strand)
 {
-  GtGenomeNode *gn;
   GtFeatureNode *fn;
   gt_assert(seqid && type);
   gt_assert(start <= end);
-  gn = gt_genome_node_create(gt_feature_node_class());
   fn = gt_feature_node_cast(gn);
   fn->seqid       = gt_str_ref(seqid);
   fn->source      = NULL;
@@ -261,6 +259,24 @@ GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
   return gn;
 }
 
+GtGenomeNode* gt_feature_node_new(GtStr *seqid, const char *type,
+                                  GtUword start, GtUword end,
+                                  GtStrand strand)
+{
+  return feature_node_init(gt_genome_node_create(gt_feature_node_class()),
+                           seqid, type, start, end, strand);
+}
+
+GtGenomeNode* gt_feature_node_new_in_arena(GtStr *seqid, const char *type,
+                                           GtUword start, GtUword end,
+                                           GtStrand strand, GtArena *arena)
+{
+  return feature_node_init(gt_genome_node_create_in_arena(
+                                                   gt_feature_node_class(),
+                                                   arena),
+                           seqid, type, start, end, strand);
+}
+
 GtGenomeNode* gt_feature_node_new_pseudo(GtStr *seqid, GtUword start,
                                          GtUword end, GtStrand strand)
 {
@@ -671,9 +687,12 @@ void gt_feature_node_add_attribute(GtFeatureNode *fn,
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(strlen(attr_value)); /* attribute value cannot be empty */
   if (!fn->attributes)
-    fn->attributes = gt_tag_value_map_new(attr_name, attr_value);
-  else
-    gt_tag_value_map_add(&fn->attributes, attr_name, attr_value);
+    fn->attributes = gt_tag_value_map_new_in_arena(attr_name, attr_value,
+                                                   fn->parent_instance.arena);
+  else {
+    gt_tag_value_map_add_in_arena(&fn->attributes, attr_name, attr_value,
+                                  fn->parent_instance.arena);
+  }
   if (fn->observer && fn->observer->attribute_changed) {
     fn->observer->attribute_changed(fn, true, attr_name, attr_value,
                                     fn->observer->data);
@@ -688,9 +707,12 @@ void gt_feature_node_set_attribute(GtFeatureNode *fn,
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(strlen(attr_value)); /* attribute value cannot be empty */
   if (!fn->attributes)
-    fn->attributes = gt_tag_value_map_new(attr_name, attr_value);
-  else
-    gt_tag_value_map_set(&fn->attributes, attr_name, attr_value);
+    fn->attributes = gt_tag_value_map_new_in_arena(attr_name, attr_value,
+                                                   fn->parent_instance.arena);
+  else {
+    gt_tag_value_map_set_in_arena(&fn->attributes, attr_name, attr_value,
+                                  fn->parent_instance.arena);
+  }
   if (fn->observer && fn->observer->attribute_changed) {
     fn->observer->attribute_changed(fn, false, attr_name, attr_value,
                                     fn->observer->data);
@@ -704,10 +726,13 @@ void gt_feature_node_remove_attribute(GtFeatureNode *fn,
   gt_assert(strlen(attr_name)); /* attribute name cannot be empty */
   gt_assert(fn->attributes); /* attribute list must exist already */
   if (gt_tag_value_map_size(fn->attributes) == 1) {
-    gt_tag_value_map_delete(fn->attributes);
+    gt_tag_value_map_delete_in_arena(fn->attributes,
+                                     fn->parent_instance.arena);
     fn->attributes = NULL;
-  } else
-    gt_tag_value_map_remove(&fn->attributes, attr_name);
+  } else {
+    gt_tag_value_map_remove_in_arena(&fn->attributes, attr_name,
+                                     fn->parent_instance.arena);
+  }
   if (fn->observer && fn->observer->attribute_deleted) {
     fn->observer->attribute_deleted(fn, attr_name, fn->observer->data);
   }
@@ -1100,8 +1125,14 @@ void gt_feature_node_add_child(GtFeatureNode *parent, GtFeatureNode *child)
   /* pseudo-features have to be top-level */
   gt_assert(!gt_feature_node_is_pseudo((GtFeatureNode*) child));
   /* create children list on demand */
-  if (!parent->children)
-    parent->children = gt_dlist_new((GtCompare) gt_genome_node_cmp);
+  if (!parent->children) {
+    if (parent->parent_instance.arena) {
+      parent->children = gt_dlist_new_in_arena((GtCompare) gt_genome_node_cmp,
+                                               parent->parent_instance.arena);
+    }
+    else
+      parent->children = gt_dlist_new((GtCompare) gt_genome_node_cmp);
+  }
   gt_dlist_add(parent->children, child); /* XXX: check for cycles */
   /* update tree status of <parent> */
   set_tree_status(&parent->bit_field, TREE_STATUS_UNDETERMINED);
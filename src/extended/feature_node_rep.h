@@ -29,8 +29,8 @@ struct GtFeatureNode {
   const char *type;
   GtRange range;
   float score;
-  GtTagValueMap attributes; /* stores the attributes; created on demand */
   unsigned int bit_field;
+  GtTagValueMap attributes; /* stores the attributes; created on demand */
   GtDlist *children; /* created on demand */
   GtFeatureNode *representative;
   GtFeatureNodeObserver *observer;
@@ -26,6 +26,7 @@
 #include "core/msort.h"
 #include "core/parseutils_api.h"
 #include "core/queue_api.h"
+#include "core/thread.h"
 #include "core/unused_api.h"
 #include "extended/eof_node_api.h"
 #include "extended/genome_node_rep.h"
@@ -91,6 +92,11 @@ static int compare_genome_node_type(GtGenomeNode *gn_a, GtGenomeNode *gn_b)
   mn_a = gt_meta_node_try_cast(gn_a);
   mn_b = gt_meta_node_try_cast(gn_b);
 
+  /* nodes of the same class (except meta nodes) are of equal rank, this saves
+     the class lookups below for the common case of comparing two features */
+  if (!mn_a && gn_a->c_class == gn_b->c_class)
+    return 0;
+
   if (mn_a && !mn_b)
     return -1;
   if (!mn_a && mn_b)
@@ -212,23 +218,46 @@ static int compare_genome_nodes_with_delta(GtGenomeNode *gn_a,
   return gt_range_compare_with_delta(&range_a, &range_b, delta);
 }
 
-GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
+static GtGenomeNode* genome_node_init(GtGenomeNode *gn,
+                                      const GtGenomeNodeClass *gnc)
 {
-  GtGenomeNode *gn;
-  gt_assert(gnc && gnc->size);
-  gn                     = gt_malloc(gnc->size);
   gn->c_class            = gnc;
+  gn->arena              = NULL;
   gn->filename           = NULL; /* means the node is generated */
   gn->line_number        = 0;
   gn->reference_count    = 0;
   gn->userdata           = NULL;
   gn->userdata_nof_items = 0;
+  return gn;
+}
+
+GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
+{
+  GtGenomeNode *gn;
+  gt_assert(gnc && gnc->size);
+  gn = genome_node_init(gt_malloc(gnc->size), gnc);
 #ifdef GT_THREADS_ENABLED
   gn->lock              = gt_rwlock_new();
 #endif
   return gn;
 }
 
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass *gnc,
+                                             GtArena *arena)
+{
+  GtGenomeNode *gn;
+  gt_assert(gnc && gnc->size && arena);
+  /* the lock is stored right behind the node to save a separate allocation */
+  gt_assert(gnc->size % sizeof (void*) == 0);
+  gn = genome_node_init(gt_arena_malloc(arena, gnc->size + gt_rwlock_size()),
+                        gnc);
+  gn->arena = arena;
+#ifdef GT_THREADS_ENABLED
+  gn->lock = gt_rwlock_init((char*) gn + gnc->size);
+#endif
+  return gn;
+}
+
 void gt_genome_node_set_origin(GtGenomeNode *gn, GtStr *filename,
                                unsigned int line_number)
 {
@@ -536,6 +565,13 @@ void gt_genome_node_delete(GtGenomeNode *gn)
   if (gn->userdata)
     gt_hashmap_delete(gn->userdata);
   gt_rwlock_unlock(gn->lock);
+  if (gn->arena) {
+#ifdef GT_THREADS_ENABLED
+    gt_rwlock_destroy(gn->lock);
+#endif
+    gt_arena_free(gn->arena, gn, gn->c_class->size + gt_rwlock_size());
+    return;
+  }
 #ifdef GT_THREADS_ENABLED
   gt_rwlock_delete(gn->lock);
 #endif
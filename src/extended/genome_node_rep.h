@@ -19,6 +19,7 @@
 #define GENOME_NODE_REP_H
 
 #include <stdio.h>
+#include "core/arena.h"
 #include "core/dlist.h"
 #include "core/hashmap.h"
 #include "core/thread_api.h"
@@ -52,6 +53,7 @@ struct GtGenomeNode
   const GtGenomeNodeClass *c_class;
   GtStr *filename;
   GtHashmap *userdata; /* created on demand */
+  GtArena *arena; /* the node is allocated from here, if set */
   /* GtGenomeNodes are very space critical, therefore we can justify a bit
      ifdef-hell here... */
 #ifdef GT_THREADS_ENABLED
@@ -71,5 +73,8 @@ const GtGenomeNodeClass* gt_genome_node_class_new(size_t size,
                                        GtGenomeNodeChangeSeqidFunc change_seqid,
                                        GtGenomeNodeAcceptFunc accept);
 GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass*);
+/* Like <gt_genome_node_create()>, but the node is allocated from <arena>. */
+GtGenomeNode* gt_genome_node_create_in_arena(const GtGenomeNodeClass*,
+                                             GtArena *arena);
 
 #endif
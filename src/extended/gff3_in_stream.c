@@ -155,6 +155,29 @@ void gt_gff3_in_stream_fix_region_boundaries(GtGFF3InStream *is)
              gt_tidy_region_node_stream_new(is->last_stream);
 }
 
+void gt_gff3_in_stream_enable_parallel_mode(GtGFF3InStream *is)
+{
+  gt_assert(is);
+  gt_gff3_in_stream_plain_enable_parallel_mode((GtGFF3InStreamPlain*)
+                                               is->gff3_in_stream_plain);
+}
+
+void gt_gff3_in_stream_set_parallel_chunk_size(GtGFF3InStream *is,
+                                               GtUword chunk_size)
+{
+  gt_assert(is);
+  gt_gff3_in_stream_plain_set_parallel_chunk_size((GtGFF3InStreamPlain*)
+                                                  is->gff3_in_stream_plain,
+                                                  chunk_size);
+}
+
+void gt_gff3_in_stream_enable_arena(GtGFF3InStream *is)
+{
+  gt_assert(is);
+  gt_gff3_in_stream_plain_enable_arena((GtGFF3InStreamPlain*)
+                                       is->gff3_in_stream_plain);
+}
+
 GtNodeStream* gt_gff3_in_stream_new_unsorted(int num_of_files,
                                              const char **filenames)
 {
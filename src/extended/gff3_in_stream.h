@@ -33,5 +33,17 @@ int                      gt_gff3_in_stream_set_offsetfile(GtNodeStream*, GtStr*,
 void                     gt_gff3_in_stream_disable_add_ids(GtNodeStream*);
 void                     gt_gff3_in_stream_fix_region_boundaries(
                                                                GtGFF3InStream*);
+/* Parse the input files in <gt_jobs> parallel threads (see
+   <gt_gff3_in_stream_plain_enable_parallel_mode()>). */
+void                     gt_gff3_in_stream_enable_parallel_mode(
+                                                               GtGFF3InStream*);
+/* Set the chunk size of the parallel mode (see
+   <gt_gff3_in_stream_plain_set_parallel_chunk_size()>). */
+void                     gt_gff3_in_stream_set_parallel_chunk_size(
+                                                             GtGFF3InStream*,
+                                                             GtUword chunk_size);
+/* Allocate the delivered feature nodes from an arena (see
+   <gt_gff3_in_stream_plain_enable_arena()>). */
+void                     gt_gff3_in_stream_enable_arena(GtGFF3InStream*);
 
 #endif
@@ -19,15 +19,27 @@
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
 #include "core/cstr_table.h"
+#include "core/file.h"
 #include "core/fileutils_api.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
 #include "core/queue.h"
 #include "core/progressbar.h"
 #include "core/str_array.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_defines.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/gff3_parser.h"
 #include "extended/node_stream_api.h"
 
+/* In parallel mode, the input is split into chunks of at least this size which
+   end with a terminator line (see
+   <gt_gff3_in_stream_plain_set_parallel_chunk_size()>). */
+#define GFF3_PARALLEL_CHUNK_SIZE  (1UL << 20)
+/* If no terminator line is found within this many times the chunk size, the
+   rest of the file is parsed sequentially. */
+#define GFF3_PARALLEL_MAX_CHUNKS  64
+
 struct GtGFF3InStreamPlain {
   const GtNodeStream parent_instance;
   GtUword next_file;
@@ -37,14 +49,40 @@ struct GtGFF3InStreamPlain {
        stdin_argument,
        stdin_processed,
        file_is_open,
-       progress_bar;
+       progress_bar,
+       checkids,
+       parallel,
+       parse_serially, /* parse rest of current file sequentially */
+       eof_read;
   GtFile *fpin;
   GtUint64 line_number;
+  GtUword chunk_size;
   GtQueue *genome_node_buffer;
   GtGFF3Parser *gff3_parser;
   GtCstrTable *used_types;
+  GtError *chunk_err; /* error in a parallel chunk, reported after its
+                         predecessors have been delivered */
 };
 
+typedef struct {
+  GtStr *buffer,      /* newline separated lines */
+        *filenamestr; /* private copy, reference counting is not thread-safe */
+  GtUint64 line_number;
+  GtGFF3Parser *parser; /* a clone of the stream parser or NULL */
+  GtQueue *genome_nodes;
+  GtCstrTable *used_types;
+  GtError *err;
+  int had_err;
+  bool eof;
+} GFF3Chunk;
+
+typedef struct {
+  GtArray *chunks;
+  GtUword next_chunk,
+          num_of_chunks;
+  GtMutex *mutex;
+} GFF3ChunkQueue;
+
 #define gff3_in_stream_plain_cast(NS)\
         gt_node_stream_cast(gt_gff3_in_stream_plain_class(), NS)
 
@@ -71,6 +109,232 @@ static int buffer_is_sorted(void **elem, void *info, GtError *err)
   return 0;
 }
 
+static GFF3Chunk* gff3_chunk_new(GtStr *filenamestr, GtUint64 line_number)
+{
+  GFF3Chunk *chunk = gt_calloc(1, sizeof *chunk);
+  chunk->buffer = gt_str_new();
+  chunk->filenamestr = gt_str_clone(filenamestr);
+  chunk->line_number = line_number;
+  chunk->genome_nodes = gt_queue_new();
+  chunk->used_types = gt_cstr_table_new();
+  chunk->err = gt_error_new();
+  return chunk;
+}
+
+static void gff3_chunk_delete(GFF3Chunk *chunk)
+{
+  if (!chunk) return;
+  while (gt_queue_size(chunk->genome_nodes))
+    gt_genome_node_delete(gt_queue_get(chunk->genome_nodes));
+  gt_queue_delete(chunk->genome_nodes);
+  gt_cstr_table_delete(chunk->used_types);
+  gt_gff3_parser_delete(chunk->parser);
+  gt_error_delete(chunk->err);
+  gt_str_delete(chunk->filenamestr);
+  gt_str_delete(chunk->buffer);
+  gt_free(chunk);
+}
+
+static bool line_has_prefix(const char *line, GtUword length,
+                            const char *prefix)
+{
+  size_t prefix_length = strlen(prefix);
+  return length >= prefix_length && memcmp(line, prefix, prefix_length) == 0;
+}
+
+/* Read the next chunks of the current file into <chunks>. Returns true if the
+   last chunk has to be parsed by the stream parser itself, because it changes
+   the parser state. Such a chunk always ends the batch of chunks. */
+static bool gff3_in_stream_plain_read_chunks(GtGFF3InStreamPlain *is,
+                                             GtArray *chunks,
+                                             GtStr *filenamestr)
+{
+  GFF3Chunk *chunk = NULL;
+  const char *line;
+  GtUword length;
+  bool stateful = false;
+  int cc;
+
+  for (;;) {
+    if (!chunk) {
+      chunk = gff3_chunk_new(filenamestr, is->line_number);
+      gt_array_add(chunks, chunk);
+    }
+    if ((cc = gt_file_xfgetc(is->fpin)) == EOF) {
+      chunk->eof = is->eof_read = true;
+      break;
+    }
+    gt_file_unget_char(is->fpin, cc);
+    if (cc == '>') {
+      /* FASTA sequences are read directly from the file */
+      is->parse_serially = stateful = true;
+      break;
+    }
+    if (gt_file_xread_line(is->fpin, &line, &length) == EOF ||
+        line[length-1] != '\n') {
+      /* like the serial parser, ignore an unterminated last line */
+      chunk->eof = is->eof_read = true;
+      break;
+    }
+    length--;
+    if (length && line[length-1] == '\r')
+      length--;
+    is->line_number++;
+    gt_str_append_cstr_nt(chunk->buffer, line, length);
+    gt_str_append_char(chunk->buffer, '\n');
+    if (is->line_number == 1 ||
+        line_has_prefix(line, length, GT_GFF_SEQUENCE_REGION) ||
+        line_has_prefix(line, length, GT_GVF_VERSION_PREFIX)) {
+      stateful = true;
+    }
+    if ((length == strlen(GT_GFF_FASTA_DIRECTIVE) &&
+         line_has_prefix(line, length, GT_GFF_FASTA_DIRECTIVE)) ||
+        gt_str_length(chunk->buffer) >=
+          GFF3_PARALLEL_MAX_CHUNKS * is->chunk_size) {
+      is->parse_serially = stateful = true;
+      break;
+    }
+    if (line_has_prefix(line, length, GT_GFF_TERMINATOR) &&
+        gt_str_length(chunk->buffer) >= is->chunk_size) {
+      /* all nodes are complete after a terminator, the chunk ends here */
+      if (stateful || gt_array_size(chunks) == gt_jobs)
+        break;
+      chunk = NULL;
+    }
+  }
+
+  return stateful;
+}
+
+static void* gff3_in_stream_plain_parse_chunks(void *data)
+{
+  GFF3ChunkQueue *chunk_queue = data;
+  GFF3Chunk *chunk;
+  gt_assert(chunk_queue);
+
+  for (;;) {
+    gt_mutex_lock(chunk_queue->mutex);
+    if (chunk_queue->next_chunk == chunk_queue->num_of_chunks) {
+      gt_mutex_unlock(chunk_queue->mutex);
+      return NULL;
+    }
+    chunk = *(GFF3Chunk**) gt_array_get(chunk_queue->chunks,
+                                        chunk_queue->next_chunk++);
+    gt_mutex_unlock(chunk_queue->mutex);
+    chunk->had_err = gt_gff3_parser_parse_buffer(chunk->parser,
+                                                 chunk->genome_nodes,
+                                                 chunk->used_types,
+                                                 chunk->filenamestr,
+                                                 &chunk->line_number,
+                                                 gt_str_get_mem(chunk->buffer),
+                                                 gt_str_length(chunk->buffer),
+                                                 chunk->eof, chunk->err);
+  }
+  return NULL;
+}
+
+static void add_used_types(GtCstrTable *used_types, GtCstrTable *new_types)
+{
+  GtStrArray *types = gt_cstr_table_get_all(new_types);
+  GtUword i;
+  for (i = 0; i < gt_str_array_size(types); i++) {
+    if (!gt_cstr_table_get(used_types, gt_str_array_get(types, i)))
+      gt_cstr_table_add(used_types, gt_str_array_get(types, i));
+  }
+  gt_str_array_delete(types);
+}
+
+/* Parse the next chunks of the current file in parallel and add the resulting
+   nodes to the buffer in their original order. */
+static int gff3_in_stream_plain_parse_parallel(GtGFF3InStreamPlain *is,
+                                               int *status_code,
+                                               GtStr *filenamestr,
+                                               GtError *err)
+{
+  GFF3ChunkQueue chunk_queue;
+  GFF3Chunk *chunk;
+  GtArray *chunks;
+  GtUword i;
+  bool stateful;
+  int had_err = 0, serial_status_code;
+
+  gt_error_check(err);
+
+  if (is->eof_read) {
+    *status_code = gt_queue_size(is->genome_node_buffer) ? 0 : EOF;
+    return 0;
+  }
+
+  chunks = gt_array_new(sizeof (GFF3Chunk*));
+  stateful = gff3_in_stream_plain_read_chunks(is, chunks, filenamestr);
+
+  /* parse the chunks which do not depend on the parser state in parallel */
+  chunk_queue.chunks = chunks;
+  chunk_queue.next_chunk = 0;
+  chunk_queue.num_of_chunks = gt_array_size(chunks) - (stateful ? 1 : 0);
+  for (i = 0; i < chunk_queue.num_of_chunks; i++) {
+    chunk = *(GFF3Chunk**) gt_array_get(chunks, i);
+    chunk->parser = gt_gff3_parser_new_clone(is->gff3_parser);
+  }
+  chunk_queue.mutex = gt_mutex_new();
+  had_err = gt_multithread(gff3_in_stream_plain_parse_chunks, &chunk_queue,
+                           err);
+  gt_mutex_delete(chunk_queue.mutex);
+
+  /* parse the last chunk with the stream parser, if necessary */
+  if (!had_err && stateful) {
+    chunk = *(GFF3Chunk**) gt_array_get_last(chunks);
+    chunk->had_err = gt_gff3_parser_parse_buffer(is->gff3_parser,
+                                                 chunk->genome_nodes,
+                                                 chunk->used_types,
+                                                 chunk->filenamestr,
+                                                 &chunk->line_number,
+                                                 gt_str_get_mem(chunk->buffer),
+                                                 gt_str_length(chunk->buffer),
+                                                 chunk->eof, chunk->err);
+  }
+
+  /* deliver the nodes in their original order, an error is reported after all
+     nodes of the preceding chunks */
+  for (i = 0; !had_err && i < gt_array_size(chunks); i++) {
+    chunk = *(GFF3Chunk**) gt_array_get(chunks, i);
+    if (chunk->had_err) {
+      gt_error_set(is->chunk_err, "%s", gt_error_get(chunk->err));
+      break;
+    }
+    while (gt_queue_size(chunk->genome_nodes)) {
+      gt_queue_add(is->genome_node_buffer,
+                   gt_queue_get(chunk->genome_nodes));
+    }
+    add_used_types(is->used_types, chunk->used_types);
+  }
+
+  /* if the last chunk ended before a terminator line because the rest of the
+     file is parsed sequentially, its nodes can still get children: continue
+     with the stream parser until they are complete, as in sequential mode */
+  if (!had_err && is->parse_serially && !is->eof_read &&
+      !gt_error_is_set(is->chunk_err)) {
+    had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                &serial_status_code,
+                                                is->genome_node_buffer,
+                                                is->used_types, filenamestr,
+                                                &is->line_number, is->fpin,
+                                                err);
+  }
+
+  for (i = 0; i < gt_array_size(chunks); i++)
+    gff3_chunk_delete(*(GFF3Chunk**) gt_array_get(chunks, i));
+  gt_array_delete(chunks);
+
+  if (!had_err && gt_error_is_set(is->chunk_err) &&
+      !gt_queue_size(is->genome_node_buffer)) {
+    gt_error_set(err, "%s", gt_error_get(is->chunk_err));
+    had_err = -1;
+  }
+  *status_code = gt_queue_size(is->genome_node_buffer) ? 0 : EOF;
+  return had_err;
+}
+
 static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                                      GtError *err)
 {
@@ -89,6 +353,16 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
   /* the buffer is empty or has one element */
   gt_assert(gt_queue_size(is->genome_node_buffer) <= 1);
 
+  if (gt_error_is_set(is->chunk_err)) {
+    /* deliver the remaining node before the error of a parallel chunk */
+    if (gt_queue_size(is->genome_node_buffer)) {
+      *gn = gt_queue_get(is->genome_node_buffer);
+      return 0;
+    }
+    gt_error_set(err, "%s", gt_error_get(is->chunk_err));
+    return -1;
+  }
+
   for (;;) {
     /* open file if necessary */
     if (!is->file_is_open) {
@@ -103,7 +377,7 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
             had_err = -1;
             break;
           }
-          is->fpin = gt_file_xopen(NULL, "r");
+          is->fpin = gt_file_xopen("-", "r");
           is->file_is_open = true;
           is->stdin_argument = true;
         }
@@ -117,7 +391,8 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
       else {
         if (is->stdin_processed)
           break;
-        is->fpin = NULL;
+        /* opened by name, to continue stdin if it has been peeked at */
+        is->fpin = gt_file_xopen("-", "r");
         is->file_is_open = true;
       }
       is->line_number = 0;
@@ -126,7 +401,8 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
         printf("processing file \"%s\"\n", gt_str_array_size(is->files)
                ? gt_str_array_get(is->files, is->next_file-1) : "stdin");
       }
-      if (!had_err && is->fpin && is->progress_bar) {
+      if (!had_err && gt_str_array_size(is->files) && is->progress_bar &&
+          !gt_file_is_stream(gt_str_array_get(is->files, is->next_file-1))) {
         gt_progressbar_start(&is->line_number,
                             gt_file_number_of_lines(gt_str_array_get(is->files,
                                                              is->next_file-1)));
@@ -138,22 +414,34 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
     filenamestr = gt_str_array_size(is->files)
                   ? gt_str_array_get_str(is->files, is->next_file-1)
                   : is->stdinstr;
-    /* read two nodes */
-    had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
-                                                is->genome_node_buffer,
-                                                is->used_types, filenamestr,
-                                                &is->line_number, is->fpin,
-                                                err);
-    if (had_err)
-      break;
-    if (status_code != EOF) {
-      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
+    if (is->parallel && !is->checkids && !is->parse_serially) {
+      /* read a batch of nodes */
+      had_err = gff3_in_stream_plain_parse_parallel(is, &status_code,
+                                                    filenamestr, err);
+      if (had_err)
+        break;
+    }
+    else {
+      /* read two nodes */
+      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                  &status_code,
                                                   is->genome_node_buffer,
                                                   is->used_types, filenamestr,
                                                   &is->line_number, is->fpin,
                                                   err);
       if (had_err)
         break;
+      if (status_code != EOF) {
+        had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser,
+                                                    &status_code,
+                                                    is->genome_node_buffer,
+                                                    is->used_types,
+                                                    filenamestr,
+                                                    &is->line_number,
+                                                    is->fpin, err);
+        if (had_err)
+          break;
+      }
     }
 
     if (status_code == EOF) {
@@ -162,6 +450,8 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
       gt_file_delete(is->fpin);
       is->fpin = NULL;
       is->file_is_open = false;
+      is->parse_serially = false;
+      is->eof_read = false;
       gt_gff3_parser_reset(is->gff3_parser);
       if (!gt_str_array_size(is->files)) {
         is->stdin_processed = true;
@@ -203,6 +493,7 @@ static void gff3_in_stream_plain_free(GtNodeStream *ns)
   gt_queue_delete(gff3_in_stream_plain->genome_node_buffer);
   gt_gff3_parser_delete(gff3_in_stream_plain->gff3_parser);
   gt_cstr_table_delete(gff3_in_stream_plain->used_types);
+  gt_error_delete(gff3_in_stream_plain->chunk_err);
   gt_file_delete(gff3_in_stream_plain->fpin);
 }
 
@@ -232,12 +523,15 @@ static GtNodeStream* gff3_in_stream_plain_new(GtStrArray *files,
   gff3_in_stream_plain->genome_node_buffer  = gt_queue_new();
   gff3_in_stream_plain->gff3_parser         = gt_gff3_parser_new(NULL);
   gff3_in_stream_plain->used_types          = gt_cstr_table_new();
+  gff3_in_stream_plain->chunk_err           = gt_error_new();
+  gff3_in_stream_plain->chunk_size          = GFF3_PARALLEL_CHUNK_SIZE;
   return ns;
 }
 
 void gt_gff3_in_stream_plain_check_id_attributes(GtGFF3InStreamPlain *is)
 {
   gt_assert(is);
+  is->checkids = true;
   gt_gff3_parser_check_id_attributes(is->gff3_parser);
 }
 
@@ -260,6 +554,28 @@ void gt_gff3_in_stream_plain_show_progress_bar(GtGFF3InStreamPlain *is)
   is->progress_bar = true;
 }
 
+void gt_gff3_in_stream_plain_enable_parallel_mode(GtGFF3InStreamPlain *is)
+{
+  gt_assert(is);
+  is->parallel = true;
+}
+
+void gt_gff3_in_stream_plain_set_parallel_chunk_size(GtGFF3InStreamPlain *is,
+                                                     GtUword chunk_size)
+{
+  gt_assert(is && chunk_size);
+  is->chunk_size = chunk_size;
+}
+
+void gt_gff3_in_stream_plain_enable_arena(GtGFF3InStreamPlain *is)
+{
+  GtArena *arena;
+  gt_assert(is);
+  arena = gt_arena_new();
+  gt_gff3_parser_set_arena(is->gff3_parser, arena);
+  gt_arena_delete(arena);
+}
+
 void gt_gff3_in_stream_plain_set_type_checker(GtNodeStream *ns,
                                               GtTypeChecker *type_checker)
 {
@@ -40,6 +40,20 @@ void          gt_gff3_in_stream_plain_do_not_check_region_boundaries(
 void          gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream*);
 void          gt_gff3_in_stream_plain_enable_strict_mode(GtNodeStream*);
 void          gt_gff3_in_stream_plain_show_progress_bar(GtGFF3InStreamPlain*);
+/* Parse chunks of the input files which are separated by terminator lines in
+   <gt_jobs> parallel threads. The delivered nodes are the same as in the
+   sequential mode. Has no effect if ID attributes are checked. */
+void          gt_gff3_in_stream_plain_enable_parallel_mode(
+                                                          GtGFF3InStreamPlain*);
+/* Split the input into chunks of at least <chunk_size> bytes in parallel mode
+   (default 1 MB). If no terminator line is found within 64 times
+   <chunk_size> bytes, the rest of the file is parsed sequentially. */
+void          gt_gff3_in_stream_plain_set_parallel_chunk_size(
+                                                           GtGFF3InStreamPlain*,
+                                                           GtUword chunk_size);
+/* Allocate the delivered feature nodes from an arena, which saves memory if
+   many nodes are kept alive at the same time (e.g., for sorting). */
+void          gt_gff3_in_stream_plain_enable_arena(GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_set_type_checker(GtNodeStream*,
                                                        GtTypeChecker*);
 void          gt_gff3_in_stream_plain_set_xrf_checker(GtNodeStream*,
@@ -30,6 +30,7 @@
 #include "core/queue.h"
 #include "core/splitter.h"
 #include "core/symbol_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
@@ -59,13 +60,16 @@ struct GtGFF3Parser {
        tidy,
        fasta_parsing, /* parser is in FASTA parsing mode */
        eof_emitted,
-       gvf_mode;
+       gvf_mode,
+       is_clone; /* offset mapping and checker lock belong to another parser */
   GtGenomeNode *gff3_pragma;
   GtWord offset;
   GtMapping *offset_mapping;
   GtOrphanage *orphanage;
   GtTypeChecker *type_checker;
   GtXRFChecker *xrf_checker;
+  GtMutex *checker_lock; /* serializes checker access among cloned parsers */
+  GtArena *arena; /* feature nodes are allocated from here, if set */
   unsigned int last_terminator; /* line number of the last terminator */
 };
 
@@ -96,6 +100,20 @@ static void simple_sequence_region_delete(SimpleSequenceRegion *ssr)
   gt_free(ssr);
 }
 
+static void gff3_parser_lock_checkers(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  if (parser->checker_lock)
+    gt_mutex_lock(parser->checker_lock);
+}
+
+static void gff3_parser_unlock_checkers(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  if (parser->checker_lock)
+    gt_mutex_unlock(parser->checker_lock);
+}
+
 GtGFF3Parser* gt_gff3_parser_new(GtTypeChecker *type_checker)
 {
   GtGFF3Parser *parser;
@@ -154,6 +172,13 @@ void gt_gff3_parser_set_type_checker(GtGFF3Parser *parser,
   parser->type_checker = gt_type_checker_ref(type_checker);
 }
 
+void gt_gff3_parser_set_arena(GtGFF3Parser *parser, GtArena *arena)
+{
+  gt_assert(parser && arena);
+  gt_arena_delete(parser->arena);
+  parser->arena = gt_arena_ref(arena);
+}
+
 int gt_gff3_parser_set_offsetfile(GtGFF3Parser *parser, GtStr *offsetfile,
                                   GtError *err)
 {
@@ -219,8 +244,10 @@ static int add_offset_if_necessary(GtRange *range, GtGFF3Parser *parser,
   }
   else if (parser->offset_mapping) {
     GtWord offset;
+    gff3_parser_lock_checkers(parser);
     had_err = gt_mapping_map_integer(parser->offset_mapping, &offset, seqid,
                                      err);
+    gff3_parser_unlock_checkers(parser);
     if (!had_err)
       had_err = offset_possible(range, offset, filename, line_number, err);
     if (!had_err)
@@ -721,8 +748,8 @@ static void join_roots(GtArray *roots, GtFeatureInfo *feature_info,
 static int process_child(GtGenomeNode *child, GtSplitter *parent_splitter,
                          GtFeatureInfo *feature_info, bool strict,
                          unsigned int last_terminator,
-                         GtTypeChecker *type_checker, GtQueue *genome_nodes,
-                         GtError *err)
+                         GtTypeChecker *type_checker, GtMutex *checker_lock,
+                         GtQueue *genome_nodes, GtError *err)
 {
   GtStrArray *valid_parents;
   GtGenomeNode* parent_gf;
@@ -771,10 +798,17 @@ static int process_child(GtGenomeNode *child, GtSplitter *parent_splitter,
     }
     if (!had_err && type_checker) {
       const char *parent_type, *child_type;
+      bool is_partof;
       /* check partof relationships */
       parent_type = gt_feature_node_get_type((GtFeatureNode*) parent_gf);
       child_type = gt_feature_node_get_type((GtFeatureNode*) child);
-      if (!gt_type_checker_is_partof(type_checker, parent_type, child_type)) {
+      if (checker_lock)
+        gt_mutex_lock(checker_lock);
+      is_partof = gt_type_checker_is_partof(type_checker, parent_type,
+                                            child_type);
+      if (checker_lock)
+        gt_mutex_unlock(checker_lock);
+      if (!is_partof) {
         gt_error_set(err, "the child feature with type '%s' on line %u in file "
                      "\"%s\" is not part-of parent feature with type '%s' "
                      "given on line %u (according to type checker '%s')",
@@ -874,7 +908,7 @@ static int process_parent_attr(char *parent_attr, GtGenomeNode *feature_node,
       had_err = process_child(feature_node, parent_splitter,
                               parser->feature_info, parser->strict,
                               parser->last_terminator, parser->type_checker,
-                              genome_nodes, err);
+                              parser->checker_lock, genome_nodes, err);
     }
     else {
       gt_assert(!parser->strict);
@@ -1388,18 +1422,26 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
       else if (!strcmp(attr_tag, GT_GFF_DBXREF)
                  || !strcmp(attr_tag, GT_GFF_ONTOLOGY_TERM)) {
         if (parser->xrf_checker) {
-          if (!gt_xrf_checker_is_valid(parser->xrf_checker, attr_value, err)) {
+          bool is_valid;
+          gff3_parser_lock_checkers(parser);
+          is_valid = gt_xrf_checker_is_valid(parser->xrf_checker, attr_value,
+                                             err);
+          gff3_parser_unlock_checkers(parser);
+          if (!is_valid)
             had_err = -1;
-          }
         }
       }
       else if (parser->type_checker && !strcmp(attr_tag, GT_GFF_GAP)) {
         GtGapStr *gs = NULL;
         GtRange rng = gt_genome_node_get_range(feature_node);
-        if (gt_type_checker_is_a(parser->type_checker,
-                                 gt_symbol("protein_match"),
-                                 gt_feature_node_get_type((GtFeatureNode*)
-                                                          feature_node))) {
+        bool is_protein_match;
+        gff3_parser_lock_checkers(parser);
+        is_protein_match = gt_type_checker_is_a(parser->type_checker,
+                                                gt_symbol("protein_match"),
+                                                gt_feature_node_get_type(
+                                                 (GtFeatureNode*) feature_node));
+        gff3_parser_unlock_checkers(parser);
+        if (is_protein_match) {
           gs = gt_gap_str_new_protein(attr_value, err);
         } else {
           gs = gt_gap_str_new_nucleotide(attr_value, err);
@@ -1551,8 +1593,13 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* parse the feature type */
   if (!had_err) {
-    if (parser->type_checker &&
-        !gt_type_checker_is_valid(parser->type_checker, type)) {
+    bool is_valid = true;
+    if (parser->type_checker) {
+      gff3_parser_lock_checkers(parser);
+      is_valid = gt_type_checker_is_valid(parser->type_checker, type);
+      gff3_parser_unlock_checkers(parser);
+    }
+    if (!is_valid) {
       gt_error_set(err, "type \"%s\" on line %u in file \"%s\" is not a valid "
                    "one", type, line_number, filename);
       had_err = -1;
@@ -1614,8 +1661,15 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
 
   /* create the feature */
   if (!had_err) {
-    feature_node = gt_feature_node_new(seqid_str, type, range.start, range.end,
-                                       gt_strand_value);
+    if (parser->arena) {
+      feature_node = gt_feature_node_new_in_arena(seqid_str, type, range.start,
+                                                  range.end, gt_strand_value,
+                                                  parser->arena);
+    }
+    else {
+      feature_node = gt_feature_node_new(seqid_str, type, range.start,
+                                         range.end, gt_strand_value);
+    }
     gt_genome_node_set_origin(feature_node, filenamestr, line_number);
   }
 
@@ -1763,8 +1817,8 @@ static int gff3_parser_parse_fasta_entry(GtQueue *genome_nodes,
 
 static int process_orphans(GtOrphanage *orphanage, GtFeatureInfo *feature_info,
                            bool strict, unsigned int last_terminator,
-                           GtTypeChecker *type_checker, GtQueue *genome_nodes,
-                           GtError *err)
+                           GtTypeChecker *type_checker, GtMutex *checker_lock,
+                           GtQueue *genome_nodes, GtError *err)
 {
   GtGenomeNode *orphan;
   int had_err = 0;
@@ -1796,7 +1850,8 @@ static int process_orphans(GtOrphanage *orphanage, GtFeatureInfo *feature_info,
     }
     if (!had_err) {
       had_err = process_child(orphan, splitter, feature_info, strict,
-                              last_terminator, type_checker, genome_nodes, err);
+                              last_terminator, type_checker, checker_lock,
+                              genome_nodes, err);
     }
     gt_splitter_delete(splitter);
     gt_free(parent_attr_dup);
@@ -2012,7 +2067,8 @@ static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
     if (!parser->strict) {
       had_err = process_orphans(parser->orphanage, parser->feature_info,
                                 parser->strict, parser->last_terminator,
-                                parser->type_checker, genome_nodes, err);
+                                parser->type_checker, parser->checker_lock,
+                                genome_nodes, err);
     }
     parser->incomplete_node = false;
     if (!parser->checkids)
@@ -2102,74 +2158,65 @@ static int parse_meta_gff3_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
   return had_err;
 }
 
-int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
-                                      GtQueue *genome_nodes,
-                                      GtCstrTable *used_types,
-                                      GtStr *filenamestr,
-                                      GtUint64 *line_number,
-                                      GtFile *fpin, GtError *err)
+/* Processes a single GFF3 <line>. <complete> is set to true, if the nodes
+   parsed so far are complete and the caller can stop reading lines. */
+static int parse_line(GtGFF3Parser *parser, GtQueue *genome_nodes,
+                      GtCstrTable *used_types, char *line, size_t line_length,
+                      GtStr *filenamestr, GtUint64 *line_number, GtFile *fpin,
+                      bool *complete, GtError *err)
 {
-  size_t line_length;
-  GtStr *line_buffer;
-  char *line;
   const char *filename;
-  int rval, had_err = 0;
+  int had_err = 0;
 
   gt_error_check(err);
-  gt_assert(status_code && genome_nodes && used_types);
+  gt_assert(complete);
 
   filename = gt_str_get(filenamestr);
-
-  /* init */
-  line_buffer = gt_str_new();
-
-  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
-    (*line_number)++;
-
-    if (*line_number == 1) {
-      had_err = parse_first_gff3_line(line, filename, genome_nodes, filenamestr,
-                                      line_number, &parser->gvf_mode,
-                                      parser->tidy, err);
-      if (had_err == -1) /* error */
-        break;
-      if (had_err == 1) { /* line processed */
-        gt_str_reset(line_buffer);
-        had_err = 0;
-        continue;
-      }
-      gt_assert(had_err == 0); /* line not processed */
-    }
-    if (line_length == 0) {
-      gt_warning("skipping blank line "GT_LLU" in file \"%s\"", *line_number,
-                 filename);
-    }
-    else if (parser->fasta_parsing || line[0] == '>') {
-      parser->fasta_parsing = true;
-      had_err = gff3_parser_parse_fasta_entry(genome_nodes, line, filenamestr,
-                                              *line_number, fpin, err);
-      break;
-    }
-    else if (line[0] == '#') {
-      had_err = parse_meta_gff3_line(parser, genome_nodes, line, line_length,
-                                     filenamestr, *line_number, err);
-      if (had_err ||
-          (!parser->incomplete_node && gt_queue_size(genome_nodes))) {
-        break;
-      }
-    }
-    else {
-      had_err = parse_gff3_feature_line(parser, genome_nodes, used_types, line,
-                                        line_length, filenamestr, *line_number,
-                                        err);
-      if (had_err || (!parser->incomplete_node && gt_queue_size(genome_nodes)))
-        break;
-    }
-    gt_str_reset(line_buffer);
+  *complete = false;
+
+  if (*line_number == 1) {
+    had_err = parse_first_gff3_line(line, filename, genome_nodes, filenamestr,
+                                    line_number, &parser->gvf_mode,
+                                    parser->tidy, err);
+    if (had_err == -1) /* error */
+      return had_err;
+    if (had_err == 1) /* line processed */
+      return 0;
+    gt_assert(had_err == 0); /* line not processed */
+  }
+  if (line_length == 0) {
+    gt_warning("skipping blank line "GT_LLU" in file \"%s\"", *line_number,
+               filename);
+  }
+  else if (parser->fasta_parsing || line[0] == '>') {
+    parser->fasta_parsing = true;
+    had_err = gff3_parser_parse_fasta_entry(genome_nodes, line, filenamestr,
+                                            *line_number, fpin, err);
+    *complete = true;
+  }
+  else if (line[0] == '#') {
+    had_err = parse_meta_gff3_line(parser, genome_nodes, line, line_length,
+                                   filenamestr, *line_number, err);
+    if (!parser->incomplete_node && gt_queue_size(genome_nodes))
+      *complete = true;
   }
+  else {
+    had_err = parse_gff3_feature_line(parser, genome_nodes, used_types, line,
+                                      line_length, filenamestr, *line_number,
+                                      err);
+    if (!parser->incomplete_node && gt_queue_size(genome_nodes))
+      *complete = true;
+  }
+  return had_err;
+}
 
-  if (!had_err && rval == EOF && *line_number == 0) {
+/* Performs the checks necessary after a bunch of lines has been parsed and
+   appends the EOF node, if the end of the file has been reached. */
+static int finish_parsing(GtGFF3Parser *parser, GtQueue *genome_nodes,
+                          GtStr *filenamestr, GtUint64 line_number, bool eof,
+                          int had_err, GtError *err)
+{
+  if (!had_err && eof && line_number == 0) {
     if (parser->tidy) {
       gt_warning("GFF3 file \"%s\" is empty", gt_str_get(filenamestr));
     } else {
@@ -2181,20 +2228,54 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   if (!had_err && !parser->strict) {
     had_err = process_orphans(parser->orphanage, parser->feature_info,
                               parser->strict, parser->last_terminator,
-                              parser->type_checker, genome_nodes, err);
+                              parser->type_checker, parser->checker_lock,
+                              genome_nodes, err);
   }
 
   if (had_err) {
     while (gt_queue_size(genome_nodes))
       gt_genome_node_delete(gt_queue_get(genome_nodes));
   }
-  else if (rval == EOF && !parser->eof_emitted) {
+  else if (eof && !parser->eof_emitted) {
     GtGenomeNode *eofn = gt_eof_node_new();
-    gt_genome_node_set_origin(eofn, filenamestr, *line_number+1);
+    gt_genome_node_set_origin(eofn, filenamestr, line_number+1);
     gt_queue_add(genome_nodes, eofn);
     parser->eof_emitted = true;
   }
 
+  return had_err;
+}
+
+int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
+                                      GtQueue *genome_nodes,
+                                      GtCstrTable *used_types,
+                                      GtStr *filenamestr,
+                                      GtUint64 *line_number,
+                                      GtFile *fpin, GtError *err)
+{
+  GtStr *line_buffer;
+  bool complete = false;
+  int rval, had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(status_code && genome_nodes && used_types);
+
+  /* init */
+  line_buffer = gt_str_new();
+
+  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
+    (*line_number)++;
+    had_err = parse_line(parser, genome_nodes, used_types,
+                         gt_str_get(line_buffer), gt_str_length(line_buffer),
+                         filenamestr, line_number, fpin, &complete, err);
+    if (had_err || complete)
+      break;
+    gt_str_reset(line_buffer);
+  }
+
+  had_err = finish_parsing(parser, genome_nodes, filenamestr, *line_number,
+                           rval == EOF, had_err, err);
+
   gt_str_delete(line_buffer);
   if (gt_queue_size(genome_nodes))
     *status_code = 0; /* at least one node was created */
@@ -2203,6 +2284,84 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   return had_err;
 }
 
+int gt_gff3_parser_parse_buffer(GtGFF3Parser *parser, GtQueue *genome_nodes,
+                                GtCstrTable *used_types, GtStr *filenamestr,
+                                GtUint64 *line_number, char *buffer,
+                                GtUword length, bool eof, GtError *err)
+{
+  char *line = buffer, *line_end;
+  bool complete;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(parser && genome_nodes && used_types && (buffer || !length));
+
+  while (!had_err && line < buffer + length) {
+    line_end = memchr(line, '\n', buffer + length - line);
+    gt_assert(line_end);
+    *line_end = '\0';
+    (*line_number)++;
+    /* the buffer must not contain FASTA entries, they are read from a file */
+    gt_assert(!parser->fasta_parsing && line[0] != '>');
+    had_err = parse_line(parser, genome_nodes, used_types, line,
+                         line_end - line, filenamestr, line_number, NULL,
+                         &complete, err);
+    line = line_end + 1;
+  }
+
+  return finish_parsing(parser, genome_nodes, filenamestr, *line_number, eof,
+                        had_err, err);
+}
+
+static int copy_sequence_region(GT_UNUSED void *key, void *value, void *data,
+                                GT_UNUSED GtError *err)
+{
+  SimpleSequenceRegion *ssr = value, *ssr_copy;
+  GtHashmap *seqid_to_ssr_mapping = data;
+  gt_error_check(err);
+  gt_assert(ssr && seqid_to_ssr_mapping);
+  /* pseudo regions do not carry any information */
+  if (!ssr->pseudo) {
+    ssr_copy = simple_sequence_region_new(gt_str_get(ssr->seqid_str),
+                                          ssr->range, ssr->line_number);
+    ssr_copy->is_circular = ssr->is_circular;
+    gt_hashmap_add(seqid_to_ssr_mapping, gt_str_get(ssr_copy->seqid_str),
+                   ssr_copy);
+  }
+  return 0;
+}
+
+GtGFF3Parser* gt_gff3_parser_new_clone(GtGFF3Parser *parser)
+{
+  GtGFF3Parser *clone;
+  GT_UNUSED int had_err;
+  gt_assert(parser && !parser->is_clone);
+  clone = gt_gff3_parser_new(parser->type_checker);
+  if (parser->xrf_checker)
+    gt_gff3_parser_set_xrf_checker(clone, parser->xrf_checker);
+  clone->checkids = parser->checkids;
+  clone->checkregions = parser->checkregions;
+  clone->strict = parser->strict;
+  clone->tidy = parser->tidy;
+  clone->gvf_mode = parser->gvf_mode;
+  if (parser->arena)
+    gt_gff3_parser_set_arena(clone, parser->arena);
+  clone->offset = parser->offset;
+  clone->last_terminator = parser->last_terminator;
+  /* the offset mapping and the checkers are shared with <parser> */
+  if (!parser->checker_lock)
+    parser->checker_lock = gt_mutex_new();
+  clone->checker_lock = parser->checker_lock;
+  clone->offset_mapping = parser->offset_mapping;
+  clone->is_clone = true;
+  /* copy the sequence regions defined so far */
+  had_err = gt_hashmap_foreach(parser->seqid_to_ssr_mapping,
+                               copy_sequence_region,
+                               clone->seqid_to_ssr_mapping, NULL);
+  gt_assert(!had_err); /* copy_sequence_region() is sane */
+  return clone;
+}
+
 void gt_gff3_parser_reset(GtGFF3Parser *parser)
 {
   gt_assert(parser);
@@ -2221,9 +2380,13 @@ void gt_gff3_parser_delete(GtGFF3Parser *parser)
   gt_feature_info_delete(parser->feature_info);
   gt_hashmap_delete(parser->seqid_to_ssr_mapping);
   gt_hashmap_delete(parser->source_to_str_mapping);
-  gt_mapping_delete(parser->offset_mapping);
+  if (!parser->is_clone) {
+    gt_mapping_delete(parser->offset_mapping);
+    gt_mutex_delete(parser->checker_lock);
+  }
   gt_orphanage_delete(parser->orphanage);
   gt_type_checker_delete(parser->type_checker);
   gt_xrf_checker_delete(parser->xrf_checker);
+  gt_arena_delete(parser->arena);
   gt_free(parser);
 }
@@ -18,9 +18,12 @@
 #ifndef GFF3_PARSER_H
 #define GFF3_PARSER_H
 
+#include "core/arena.h"
 #include "extended/gff3_parser_api.h"
 
 void gt_gff3_parser_enable_strict_mode(GtGFF3Parser*);
+/* Allocate the feature nodes created by <gff3_parser> from <arena>. */
+void gt_gff3_parser_set_arena(GtGFF3Parser *gff3_parser, GtArena *arena);
 int  gt_gff3_parser_set_offsetfile(GtGFF3Parser*, GtStr*, GtError*);
 int  gt_gff3_parser_parse_target_attributes(const char *values,
                                             GtUword *num_of_targets,
@@ -40,4 +43,21 @@ void gt_gff3_parser_build_target_str(GtStr *target, GtStrArray *target_ids,
                                      GtArray *target_ranges,
                                      GtArray *target_strands);
 
+/* Use <gff3_parser> to parse all lines contained in <buffer> of the given
+   <length>. Every line in <buffer> must be terminated by a newline character,
+   the lines are modified during parsing and must not contain FASTA sequences.
+   The created genome nodes are stored in <genome_nodes>, the other parameters
+   are used as in <gt_gff3_parser_parse_genome_nodes()>. If <eof> is true,
+   <buffer> is considered to end the file. */
+int  gt_gff3_parser_parse_buffer(GtGFF3Parser *gff3_parser,
+                                 GtQueue *genome_nodes,
+                                 GtCstrTable *used_types, GtStr *filenamestr,
+                                 GtUint64 *line_number, char *buffer,
+                                 GtUword length, bool eof, GtError *err);
+/* Return a new <GtGFF3Parser> which uses the same settings and checkers as
+   <gff3_parser> and knows the sequence regions defined in it so far. Clones of
+   the same <gff3_parser> can parse in parallel threads, but must be deleted
+   before <gff3_parser>. */
+GtGFF3Parser* gt_gff3_parser_new_clone(GtGFF3Parser *gff3_parser);
+
 #endif
@@ -15,25 +15,231 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/fa.h"
+#include "core/ma_api.h"
+#include "extended/binary_node_reader.h"
+#include "extended/binary_node_writer.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
 #include "extended/node_stream_api.h"
+#include "extended/sequence_node_api.h"
 #include "extended/sort_stream.h"
 
+/* estimated memory footprint of a genome node (without its strings) */
+#define SORT_STREAM_NODE_SIZE  256
+/* maximal number of runs which are merged at once */
+#define SORT_STREAM_MAX_RUNS   64
+
+typedef struct {
+  GtFile *file;
+  GtBinaryNodeReader *reader;
+  GtGenomeNode *head;
+} SortStreamRun;
+
 struct GtSortStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
-  GtUword idx;
-  GtArray *nodes;
+  GtUword idx,
+          memlimit,
+          memused;
+  GtArray *nodes,
+          *runs;
+  GtGenomeNode *lookahead;
   bool sorted;
 };
 
 #define gt_sort_stream_cast(GS)\
         gt_node_stream_cast(gt_sort_stream_class(), GS);
 
+static void add_attribute_size(const char *tag, const char *value,
+                               void *data)
+{
+  GtUword *size = data;
+  *size += strlen(tag) + strlen(value) + 2;
+}
+
+static GtUword estimate_node_size(GtGenomeNode *gn)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn, *child;
+  GtSequenceNode *sn;
+  GtUword size = 0;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    fni = gt_feature_node_iterator_new(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      size += SORT_STREAM_NODE_SIZE;
+      gt_feature_node_foreach_attribute(child, add_attribute_size, &size);
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn)))
+    size = SORT_STREAM_NODE_SIZE + gt_sequence_node_get_sequence_length(sn);
+  else
+    size = SORT_STREAM_NODE_SIZE;
+  return size;
+}
+
+static int run_advance(SortStreamRun *run, GtError *err)
+{
+  gt_error_check(err);
+  return gt_binary_node_reader_next(run->reader, &run->head, err);
+}
+
+static void run_delete(SortStreamRun *run)
+{
+  gt_genome_node_delete(run->head);
+  gt_binary_node_reader_delete(run->reader);
+  gt_file_delete(run->file);
+}
+
+/* Creates a new (anonymous) temporary run file and a <writer> for it. */
+static SortStreamRun create_run(GtBinaryNodeWriter **writer)
+{
+  SortStreamRun run;
+  run.file = gt_file_new_from_fileptr(gt_xtmpfp_generic(NULL,
+                                                        TMPFP_OPENBINARY |
+                                                        TMPFP_AUTOREMOVE));
+  run.reader = NULL;
+  run.head = NULL;
+  *writer = gt_binary_node_writer_new(run.file);
+  return run;
+}
+
+/* Rewinds the <run> written by <writer> and adds it to the runs. */
+static int finish_run(GtSortStream *sort_stream, SortStreamRun *run,
+                      GtBinaryNodeWriter *writer, GtError *err)
+{
+  gt_error_check(err);
+  gt_binary_node_writer_delete(writer);
+  gt_file_xrewind(run->file);
+  run->reader = gt_binary_node_reader_new(run->file);
+  gt_array_add(sort_stream->runs, *run);
+  return run_advance(gt_array_get_last(sort_stream->runs), err);
+}
+
+/* Returns the next node in sorted order, merging the runs on disk and the
+   nodes kept in memory. On equal nodes, earlier runs (and the nodes in memory,
+   which have been read last, after all runs) win, which makes the merge
+   stable. */
+static GtGenomeNode* merge_next(GtSortStream *sort_stream, GtError *err,
+                                int *had_err)
+{
+  SortStreamRun *run, *min_run = NULL;
+  GtGenomeNode *node;
+  GtUword i;
+  gt_error_check(err);
+  for (i = 0; i < gt_array_size(sort_stream->runs); i++) {
+    run = gt_array_get(sort_stream->runs, i);
+    if (run->head &&
+        (!min_run || gt_genome_node_cmp(run->head, min_run->head) < 0)) {
+      min_run = run;
+    }
+  }
+  if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+    node = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
+                                          sort_stream->idx);
+    if (!min_run || gt_genome_node_cmp(node, min_run->head) < 0) {
+      sort_stream->idx++;
+      return node;
+    }
+  }
+  if (!min_run)
+    return NULL;
+  node = min_run->head;
+  min_run->head = NULL;
+  *had_err = run_advance(min_run, err);
+  return node;
+}
+
+static void delete_runs(GtSortStream *sort_stream)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(sort_stream->runs); i++)
+    run_delete(gt_array_get(sort_stream->runs, i));
+  gt_array_reset(sort_stream->runs);
+}
+
+static void reset_nodes(GtSortStream *sort_stream)
+{
+  GtUword i;
+  for (i = sort_stream->idx; i < gt_array_size(sort_stream->nodes); i++) {
+    gt_genome_node_delete(*(GtGenomeNode**)
+                          gt_array_get(sort_stream->nodes, i));
+  }
+  gt_array_reset(sort_stream->nodes);
+  sort_stream->idx = 0;
+}
+
+/* Merges all runs into a single one to bound the number of open files. */
+static int merge_runs(GtSortStream *sort_stream, GtError *err)
+{
+  GtBinaryNodeWriter *writer;
+  SortStreamRun run;
+  GtGenomeNode *node;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(!gt_array_size(sort_stream->nodes));
+  run = create_run(&writer);
+  while (!had_err && (node = merge_next(sort_stream, err, &had_err))) {
+    gt_binary_node_writer_write(writer, node);
+    gt_genome_node_delete(node);
+  }
+  delete_runs(sort_stream);
+  if (!had_err)
+    had_err = finish_run(sort_stream, &run, writer, err);
+  else {
+    gt_binary_node_writer_delete(writer);
+    gt_file_delete(run.file);
+  }
+  return had_err;
+}
+
+/* Sorts the nodes in memory and writes them to a new run. */
+static int spill_nodes(GtSortStream *sort_stream, GtError *err)
+{
+  GtBinaryNodeWriter *writer;
+  SortStreamRun run;
+  GtUword i;
+  int had_err;
+  gt_error_check(err);
+  gt_genome_nodes_sort_stable(sort_stream->nodes);
+  run = create_run(&writer);
+  for (i = 0; i < gt_array_size(sort_stream->nodes); i++) {
+    gt_binary_node_writer_write(writer, *(GtGenomeNode**)
+                                        gt_array_get(sort_stream->nodes, i));
+  }
+  reset_nodes(sort_stream);
+  sort_stream->memused = 0;
+  had_err = finish_run(sort_stream, &run, writer, err);
+  if (!had_err && gt_array_size(sort_stream->runs) >= SORT_STREAM_MAX_RUNS)
+    had_err = merge_runs(sort_stream, err);
+  return had_err;
+}
+
+static GtGenomeNode* next_sorted(GtSortStream *sort_stream, GtError *err,
+                                 int *had_err)
+{
+  GtGenomeNode *node;
+  gt_error_check(err);
+  if ((node = sort_stream->lookahead)) {
+    sort_stream->lookahead = NULL;
+    return node;
+  }
+  if (gt_array_size(sort_stream->runs))
+    return merge_next(sort_stream, err, had_err);
+  if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
+    return *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
+                                          sort_stream->idx++);
+  }
+  return NULL;
+}
+
 static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -49,8 +255,16 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                            err)) && node) {
       if ((eofn = gt_eof_node_try_cast(node)))
         gt_genome_node_delete(node); /* get rid of EOF nodes */
-      else
+      else {
         gt_array_add(sort_stream->nodes, node);
+        if (sort_stream->memlimit) {
+          sort_stream->memused += estimate_node_size(node);
+          if (sort_stream->memused > sort_stream->memlimit &&
+              (had_err = spill_nodes(sort_stream, err))) {
+            break;
+          }
+        }
+      }
     }
     if (!had_err) {
       gt_genome_nodes_sort_stable(sort_stream->nodes);
@@ -60,20 +274,17 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
 
   if (!had_err) {
     gt_assert(sort_stream->sorted);
-    if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                           sort_stream->idx);
-      sort_stream->idx++;
+    if ((*gn = next_sorted(sort_stream, err, &had_err))) {
       /* join region nodes with the same sequence ID */
       if (gt_region_node_try_cast(*gn)) {
         GtRange range_a, range_b;
-        while (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-          node = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                                sort_stream->idx);
+        while (!had_err &&
+               (node = next_sorted(sort_stream, err, &had_err))) {
           if (!gt_region_node_try_cast(node) ||
               gt_str_cmp(gt_genome_node_get_seqid(*gn),
                          gt_genome_node_get_seqid(node))) {
             /* the next node is not a region node with the same ID */
+            sort_stream->lookahead = node;
             break;
           }
           range_a = gt_genome_node_get_range(*gn);
@@ -81,15 +292,20 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
           range_a = gt_range_join(&range_a, &range_b);
           gt_genome_node_set_range(*gn, &range_a);
           gt_genome_node_delete(node);
-          sort_stream->idx++;
         }
       }
-      return 0;
+      if (had_err) {
+        gt_genome_node_delete(*gn);
+        *gn = NULL;
+      }
+      return had_err;
     }
   }
 
   if (!had_err) {
     gt_array_reset(sort_stream->nodes);
+    sort_stream->idx = 0;
+    delete_runs(sort_stream);
     *gn = NULL;
   }
 
@@ -98,13 +314,12 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
 
 static void gt_sort_stream_free(GtNodeStream *ns)
 {
-  GtUword i;
   GtSortStream *sort_stream = gt_sort_stream_cast(ns);
-  for (i = sort_stream->idx; i < gt_array_size(sort_stream->nodes); i++) {
-    gt_genome_node_delete(*(GtGenomeNode**)
-                          gt_array_get(sort_stream->nodes, i));
-  }
+  gt_genome_node_delete(sort_stream->lookahead);
+  reset_nodes(sort_stream);
   gt_array_delete(sort_stream->nodes);
+  delete_runs(sort_stream);
+  gt_array_delete(sort_stream->runs);
   gt_node_stream_delete(sort_stream->in_stream);
 }
 
@@ -129,6 +344,16 @@ GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream)
   sort_stream->in_stream = gt_node_stream_ref(in_stream);
   sort_stream->sorted = false;
   sort_stream->idx = 0;
+  sort_stream->memlimit = 0;
+  sort_stream->memused = 0;
   sort_stream->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->runs = gt_array_new(sizeof (SortStreamRun));
+  sort_stream->lookahead = NULL;
   return ns;
 }
+
+void gt_sort_stream_set_memlimit(GtSortStream *sort_stream, GtUword memlimit)
+{
+  gt_assert(sort_stream);
+  sort_stream->memlimit = memlimit;
+}
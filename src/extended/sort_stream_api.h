@@ -27,5 +27,12 @@ typedef struct GtSortStream GtSortStream;
 /* Create a <GtSortStream*> which sorts the genome nodes it retrieves from
    <in_stream> and returns them unmodified, but in sorted order. */
 GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream);
+/* Limit the memory used by <sort_stream> for the nodes it keeps in memory to
+   approximately <memlimit> bytes. Whenever the limit is exceeded, the nodes
+   read so far are sorted and written to a temporary file in a compact binary
+   format. The sorted runs are merged afterwards, the output is the same as
+   without a memory limit. A <memlimit> of 0 (the default) means unlimited. */
+void          gt_sort_stream_set_memlimit(GtSortStream *sort_stream,
+                                          GtUword memlimit);
 
 #endif
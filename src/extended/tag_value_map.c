@@ -29,7 +29,16 @@
    tag\0value\0tag\0value\0\0
 */
 
-GtTagValueMap gt_tag_value_map_new(const char *tag, const char *value)
+static GtTagValueMap map_realloc(GtTagValueMap map, size_t old_size,
+                                 size_t new_size, GtArena *arena)
+{
+  if (arena)
+    return gt_arena_realloc(arena, map, old_size, new_size);
+  return gt_realloc(map, new_size);
+}
+
+GtTagValueMap gt_tag_value_map_new_in_arena(const char *tag, const char *value,
+                                            GtArena *arena)
 {
   GtTagValueMap map;
   size_t tag_len, value_len;
@@ -37,13 +46,19 @@ GtTagValueMap gt_tag_value_map_new(const char *tag, const char *value)
   tag_len = strlen(tag);
   value_len = strlen(value);
   gt_assert(tag_len && value_len);
-  map = gt_malloc((tag_len + 1 + value_len + 1 + 1) * sizeof *map);
+  map = map_realloc(NULL, 0, (tag_len + 1 + value_len + 1 + 1) * sizeof *map,
+                    arena);
   memcpy(map, tag, tag_len + 1);
   memcpy(map + tag_len + 1, value, value_len + 1);
   map[tag_len + 1 + value_len + 1] = '\0';
   return map;
 }
 
+GtTagValueMap gt_tag_value_map_new(const char *tag, const char *value)
+{
+  return gt_tag_value_map_new_in_arena(tag, value, NULL);
+}
+
 /* Stores map length in <map_len> if the return value equals NULL (i.e., if not
    value has been found) and <map_len> does not equal NULL. */
 static char* get_value(const GtTagValueMap map, const char *tag,
@@ -115,8 +130,8 @@ static size_t get_map_nof_items(const GtTagValueMap map)
   return nof_items;
 }
 
-void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
-                          const char *value)
+void gt_tag_value_map_add_in_arena(GtTagValueMap *map, const char *tag,
+                                   const char *value, GtArena *arena)
 {
   size_t tag_len, value_len, map_len = 0;
   GT_UNUSED const char *tag_already_used;
@@ -128,14 +143,22 @@ void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
   tag_already_used = get_value(*map, tag, &map_len);
   gt_assert(!tag_already_used); /* map does not contain given <tag> already */
   /* allocate additional space */
-  *map = gt_realloc(*map, map_len + tag_len + 1 + value_len + 1 + 1);
+  *map = map_realloc(*map, map_len + 1,
+                     map_len + tag_len + 1 + value_len + 1 + 1, arena);
   /* store new tag/value pair */
   memcpy(*map + map_len, tag, tag_len + 1);
   memcpy(*map + map_len + tag_len + 1, value, value_len + 1);
   (*map)[map_len + tag_len + 1 + value_len + 1] = '\0';
 }
 
-void gt_tag_value_map_remove(GtTagValueMap *map, const char *tag)
+void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
+                          const char *value)
+{
+  gt_tag_value_map_add_in_arena(map, tag, value, NULL);
+}
+
+void gt_tag_value_map_remove_in_arena(GtTagValueMap *map, const char *tag,
+                                      GtArena *arena)
 {
   size_t tag_len, value_len, map_len;
   char *value;
@@ -150,12 +173,18 @@ void gt_tag_value_map_remove(GtTagValueMap *map, const char *tag)
   /* move memory from end position of value to start position of tag */
   memmove(value - tag_len - 1, value + value_len + 1,
           map_len - ((size_t) value - (size_t) *map + value_len));
-  *map = gt_realloc(*map, map_len - (tag_len + 1 + value_len + 1) + 1);
+  *map = map_realloc(*map, map_len + 1,
+                     map_len - (tag_len + 1 + value_len + 1) + 1, arena);
   gt_assert((*map)[map_len - (tag_len + 1 + value_len + 1)] == '\0');
 }
 
-void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
-                          const char *new_value)
+void gt_tag_value_map_remove(GtTagValueMap *map, const char *tag)
+{
+  gt_tag_value_map_remove_in_arena(map, tag, NULL);
+}
+
+void gt_tag_value_map_set_in_arena(GtTagValueMap *map, const char *tag,
+                                   const char *new_value, GtArena *arena)
 {
   size_t old_value_len, new_value_len, map_len = 0;
   char *old_value;
@@ -166,7 +195,7 @@ void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
   /* determine current map length */
   old_value = get_value(*map, tag, &map_len);
   if (!old_value)
-    return gt_tag_value_map_add(map, tag, new_value);
+    return gt_tag_value_map_add_in_arena(map, tag, new_value, arena);
   /* tag already used -> replace it */
   old_value_len = strlen(old_value);
   map_len = get_map_len(*map);
@@ -174,13 +203,15 @@ void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
     memcpy(old_value, new_value, new_value_len);
     memmove(old_value + new_value_len, old_value + old_value_len,
             map_len - ((size_t) old_value - (size_t) *map + old_value_len) + 1);
-    *map = gt_realloc(*map, map_len - (old_value_len - new_value_len) + 1);
+    *map = map_realloc(*map, map_len + 1,
+                       map_len - (old_value_len - new_value_len) + 1, arena);
   }
   else if (new_value_len == old_value_len) {
     memcpy(old_value, new_value, new_value_len);
   }
   else { /* (new_value_len > old_value_len)  */
-    *map = gt_realloc(*map, map_len + (new_value_len - old_value_len) + 1);
+    *map = map_realloc(*map, map_len + 1,
+                       map_len + (new_value_len - old_value_len) + 1, arena);
     /* determine old_value again, realloc() might have moved it */
     old_value = get_value(*map, tag, &map_len);
     gt_assert(old_value);
@@ -191,6 +222,12 @@ void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
   gt_assert((*map)[map_len - old_value_len + new_value_len] == '\0');
 }
 
+void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
+                          const char *new_value)
+{
+  gt_tag_value_map_set_in_arena(map, tag, new_value, NULL);
+}
+
 const char* gt_tag_value_map_get(const GtTagValueMap map, const char *tag)
 {
   gt_assert(map && tag && strlen(tag));
@@ -400,11 +437,33 @@ int gt_tag_value_map_unit_test(GtError *err)
     gt_tag_value_map_delete(map);
   }
 
+  /* test map allocated from an arena */
+  if (!had_err) {
+    GtArena *arena = gt_arena_new();
+    GtTagValueMap map = gt_tag_value_map_new_in_arena("tag 1", "foo", arena);
+    gt_tag_value_map_add_in_arena(&map, "tag 2", "bar", arena);
+    gt_tag_value_map_set_in_arena(&map, "tag 1", "a much longer value", arena);
+    gt_tag_value_map_remove_in_arena(&map, "tag 2", arena);
+    gt_ensure(gt_tag_value_map_size(map) == 1);
+    gt_ensure(!strcmp(gt_tag_value_map_get(map, "tag 1"),
+                      "a much longer value"));
+    gt_arena_delete(arena);
+    gt_tag_value_map_delete_in_arena(map, arena);
+  }
+
   return had_err;
 }
 
-void gt_tag_value_map_delete(GtTagValueMap map)
+void gt_tag_value_map_delete_in_arena(GtTagValueMap map, GtArena *arena)
 {
   if (!map) return;
-  gt_free(map);
+  if (arena)
+    gt_arena_free(arena, map, get_map_len(map) + 1);
+  else
+    gt_free(map);
+}
+
+void gt_tag_value_map_delete(GtTagValueMap map)
+{
+  gt_tag_value_map_delete_in_arena(map, NULL);
 }
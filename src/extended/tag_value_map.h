@@ -18,8 +18,25 @@
 #ifndef TAG_VALUE_MAP_H
 #define TAG_VALUE_MAP_H
 
+#include "core/arena.h"
 #include "extended/tag_value_map_api.h"
 
+/* The following functions are like their counterparts without the
+   <_in_arena> suffix, but the map is allocated from <arena> (if it is not
+   <NULL>). All modifications of a map have to use the same <arena>. */
+GtTagValueMap gt_tag_value_map_new_in_arena(const char *tag, const char *value,
+                                            GtArena *arena);
+void          gt_tag_value_map_add_in_arena(GtTagValueMap *tag_value_map,
+                                            const char *tag, const char *value,
+                                            GtArena *arena);
+void          gt_tag_value_map_set_in_arena(GtTagValueMap *tag_value_map,
+                                            const char *tag, const char *value,
+                                            GtArena *arena);
+void          gt_tag_value_map_remove_in_arena(GtTagValueMap *tag_value_map,
+                                               const char *tag,
+                                               GtArena *arena);
+void          gt_tag_value_map_delete_in_arena(GtTagValueMap tag_value_map,
+                                               GtArena *arena);
 void          gt_tag_value_map_show(const GtTagValueMap);
 int           gt_tag_value_map_unit_test(GtError*);
 
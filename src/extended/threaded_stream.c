@@ -0,0 +1,280 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/assert_api.h"
+#include "core/atomic.h"
+#include "core/class_alloc_lock.h"
+#include "core/ma.h"
+#include "core/thread.h"
+#include "core/unused_api.h"
+#include "extended/genome_node.h"
+#include "extended/threaded_stream.h"
+
+/* maximal number of nodes read ahead by the stream thread */
+#define THREADED_STREAM_QUEUE_SIZE  1024
+
+struct GtThreadedStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+#ifdef GT_THREADS_ENABLED
+  /* bounded single-producer single-consumer queue: <thread> appends at <tail>,
+     the downstream stage takes nodes from <head>. Both counters only grow,
+     each is advanced by one side only and read by the other. */
+  GtGenomeNode **queue;
+  GtUword head,
+          tail,
+          done, /* set by <thread> after the last node has been queued */
+          stop, /* set to make <thread> return early */
+          producer_waiting, /* <thread> waits for <slot_free> */
+          consumer_waiting; /* the downstream stage waits for <node_ready> */
+#ifndef GT_ATOMIC_ENABLED
+  GtMutex *mutex;
+#endif
+  /* only a side which has to wait takes <wait_mutex>, the other side signals
+     the condition if it sees the corresponding waiting flag */
+  GtMutex *wait_mutex;
+  GtCond *slot_free,
+         *node_ready;
+  GtThread *thread;
+  GtError *thread_err;
+  int had_err;
+#endif
+};
+
+#define gt_threaded_stream_cast(GS)\
+        gt_node_stream_cast(gt_threaded_stream_class(), GS);
+
+#ifdef GT_THREADS_ENABLED
+
+/* Return the value of <*counter>, which may be advanced by the other thread. */
+static GtUword threaded_stream_get(GT_UNUSED GtThreadedStream *ts,
+                                   GtUword *counter)
+{
+  GtUword value;
+#ifdef GT_ATOMIC_ENABLED
+  value = gt_atomic_add(counter, 0);
+#else
+  gt_mutex_lock(ts->mutex);
+  value = *counter;
+  gt_mutex_unlock(ts->mutex);
+#endif
+  return value;
+}
+
+/* Advance <*counter>. All writes before are visible to the other thread once
+   it sees the new value. */
+static void threaded_stream_inc(GT_UNUSED GtThreadedStream *ts,
+                                GtUword *counter)
+{
+#ifdef GT_ATOMIC_ENABLED
+  (void) gt_atomic_add(counter, 1);
+#else
+  gt_mutex_lock(ts->mutex);
+  (*counter)++;
+  gt_mutex_unlock(ts->mutex);
+#endif
+}
+
+/* Decrease <*counter>, see <threaded_stream_inc()>. */
+static void threaded_stream_dec(GT_UNUSED GtThreadedStream *ts,
+                                GtUword *counter)
+{
+#ifdef GT_ATOMIC_ENABLED
+  (void) gt_atomic_sub(counter, 1);
+#else
+  gt_mutex_lock(ts->mutex);
+  (*counter)--;
+  gt_mutex_unlock(ts->mutex);
+#endif
+}
+
+/* Wake up the other side if it is waiting for <cond>, as indicated by
+   <*waiting>. Must be called after the state it waits for has changed. */
+static void threaded_stream_wake(GtThreadedStream *ts, GtUword *waiting,
+                                 GtCond *cond)
+{
+  if (threaded_stream_get(ts, waiting)) {
+    gt_mutex_lock(ts->wait_mutex);
+    gt_cond_signal(cond);
+    gt_mutex_unlock(ts->wait_mutex);
+  }
+}
+
+static bool threaded_stream_is_full(GtThreadedStream *ts)
+{
+  return ts->tail - threaded_stream_get(ts, &ts->head)
+         == THREADED_STREAM_QUEUE_SIZE;
+}
+
+static bool threaded_stream_is_empty(GtThreadedStream *ts)
+{
+  return ts->head == threaded_stream_get(ts, &ts->tail);
+}
+
+static void* threaded_stream_thread_func(void *data)
+{
+  GtThreadedStream *ts = data;
+  GtGenomeNode *gn;
+  gt_assert(ts);
+  while (!threaded_stream_get(ts, &ts->stop)) {
+    if ((ts->had_err = gt_node_stream_next(ts->in_stream, &gn,
+                                           ts->thread_err)) || !gn) {
+      break;
+    }
+    /* wait for a free slot */
+    if (threaded_stream_is_full(ts)) {
+      gt_mutex_lock(ts->wait_mutex);
+      threaded_stream_inc(ts, &ts->producer_waiting);
+      while (threaded_stream_is_full(ts) &&
+             !threaded_stream_get(ts, &ts->stop)) {
+        gt_cond_wait(ts->slot_free, ts->wait_mutex);
+      }
+      threaded_stream_dec(ts, &ts->producer_waiting);
+      gt_mutex_unlock(ts->wait_mutex);
+      if (threaded_stream_get(ts, &ts->stop)) {
+        gt_genome_node_delete(gn);
+        return NULL;
+      }
+    }
+    ts->queue[ts->tail % THREADED_STREAM_QUEUE_SIZE] = gn;
+    threaded_stream_inc(ts, &ts->tail);
+    threaded_stream_wake(ts, &ts->consumer_waiting, ts->node_ready);
+  }
+  threaded_stream_inc(ts, &ts->done);
+  threaded_stream_wake(ts, &ts->consumer_waiting, ts->node_ready);
+  return NULL;
+}
+
+static int gt_threaded_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                   GtError *err)
+{
+  GtThreadedStream *ts;
+  gt_error_check(err);
+  ts = gt_threaded_stream_cast(ns);
+
+  /* the thread is started on demand and runs until the input is consumed */
+  if (!ts->thread && !threaded_stream_get(ts, &ts->done) &&
+      !(ts->thread = gt_thread_new(threaded_stream_thread_func, ts, err))) {
+    return -1;
+  }
+
+  /* wait for the next node */
+  if (threaded_stream_is_empty(ts) && !threaded_stream_get(ts, &ts->done)) {
+    gt_mutex_lock(ts->wait_mutex);
+    threaded_stream_inc(ts, &ts->consumer_waiting);
+    while (threaded_stream_is_empty(ts) &&
+           !threaded_stream_get(ts, &ts->done)) {
+      gt_cond_wait(ts->node_ready, ts->wait_mutex);
+    }
+    threaded_stream_dec(ts, &ts->consumer_waiting);
+    gt_mutex_unlock(ts->wait_mutex);
+  }
+  /* no node is queued after <done> has been set */
+  if (threaded_stream_is_empty(ts)) {
+    gt_assert(threaded_stream_get(ts, &ts->done));
+    if (ts->had_err) {
+      gt_error_set(err, "%s", gt_error_get(ts->thread_err));
+      return -1;
+    }
+    *gn = NULL;
+    return 0;
+  }
+  *gn = ts->queue[ts->head % THREADED_STREAM_QUEUE_SIZE];
+  threaded_stream_inc(ts, &ts->head);
+  threaded_stream_wake(ts, &ts->producer_waiting, ts->slot_free);
+  return 0;
+}
+
+static void gt_threaded_stream_free(GtNodeStream *ns)
+{
+  GtThreadedStream *ts = gt_threaded_stream_cast(ns);
+  if (ts->thread) {
+    threaded_stream_inc(ts, &ts->stop);
+    threaded_stream_wake(ts, &ts->producer_waiting, ts->slot_free);
+    gt_thread_join(ts->thread);
+    gt_thread_delete(ts->thread);
+  }
+  for (; ts->head != ts->tail; ts->head++)
+    gt_genome_node_delete(ts->queue[ts->head % THREADED_STREAM_QUEUE_SIZE]);
+  gt_free(ts->queue);
+#ifndef GT_ATOMIC_ENABLED
+  gt_mutex_delete(ts->mutex);
+#endif
+  gt_cond_delete(ts->node_ready);
+  gt_cond_delete(ts->slot_free);
+  gt_mutex_delete(ts->wait_mutex);
+  gt_error_delete(ts->thread_err);
+  gt_node_stream_delete(ts->in_stream);
+}
+
+#else
+
+/* without threads the nodes are just passed through */
+static int gt_threaded_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                   GtError *err)
+{
+  GtThreadedStream *ts;
+  gt_error_check(err);
+  ts = gt_threaded_stream_cast(ns);
+  return gt_node_stream_next(ts->in_stream, gn, err);
+}
+
+static void gt_threaded_stream_free(GtNodeStream *ns)
+{
+  GtThreadedStream *ts = gt_threaded_stream_cast(ns);
+  gt_node_stream_delete(ts->in_stream);
+}
+
+#endif
+
+const GtNodeStreamClass* gt_threaded_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtThreadedStream),
+                                   gt_threaded_stream_free,
+                                   gt_threaded_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_threaded_stream_new(GtNodeStream *in_stream)
+{
+  GtNodeStream *ns;
+  GtThreadedStream *ts;
+  gt_assert(in_stream);
+  ns = gt_node_stream_create(gt_threaded_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ts = gt_threaded_stream_cast(ns);
+  ts->in_stream = gt_node_stream_ref(in_stream);
+#ifdef GT_THREADS_ENABLED
+  ts->queue = gt_malloc(THREADED_STREAM_QUEUE_SIZE * sizeof (GtGenomeNode*));
+  ts->head = ts->tail = ts->done = ts->stop = 0;
+  ts->producer_waiting = ts->consumer_waiting = 0;
+#ifndef GT_ATOMIC_ENABLED
+  ts->mutex = gt_mutex_new();
+#endif
+  ts->wait_mutex = gt_mutex_new();
+  ts->slot_free = gt_cond_new();
+  ts->node_ready = gt_cond_new();
+  ts->thread = NULL;
+  ts->thread_err = gt_error_new();
+  ts->had_err = 0;
+#endif
+  return ns;
+}
@@ -0,0 +1,33 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef THREADED_STREAM_H
+#define THREADED_STREAM_H
+
+#include "extended/node_stream_api.h"
+
+/* Implements the <GtNodeStream> interface. A <GtThreadedStream> runs its
+   <in_stream> (and everything upstream of it) on a separate thread, which
+   passes the nodes to the downstream stages through a bounded queue.
+   Errors of the <in_stream> are reported after all nodes which have been
+   read before the error. Without thread support the nodes are passed through
+   directly. The stream must be deleted before the stages upstream of it. */
+typedef struct GtThreadedStream GtThreadedStream;
+
+const GtNodeStreamClass* gt_threaded_stream_class(void);
+GtNodeStream*            gt_threaded_stream_new(GtNodeStream *in_stream);
+
+#endif
@@ -100,12 +100,15 @@ extern "C" {
 #include "extended/array_in_stream_api.h"
 #include "extended/array_out_stream_api.h"
 #include "extended/bed_in_stream_api.h"
+#include "extended/binary_in_stream_api.h"
+#include "extended/binary_out_stream_api.h"
 #include "extended/comment_node_api.h"
 #include "extended/csa_stream_api.h"
 #include "extended/cds_stream_api.h"
 #include "extended/eof_node_api.h"
 #include "extended/extract_feature_stream_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_in_stream_api.h"
 #include "extended/feature_node_api.h"
@@ -168,6 +171,7 @@ extern "C" {
 #include "annotationsketch/canvas_cairo_file_api.h"
 #include "annotationsketch/color_api.h"
 #include "annotationsketch/custom_track_api.h"
+#include "annotationsketch/custom_track_density_api.h"
 #include "annotationsketch/custom_track_gc_content_api.h"
 #include "annotationsketch/custom_track_script_wrapper_api.h"
 #include "annotationsketch/diagram_api.h"
@@ -178,6 +182,7 @@ extern "C" {
 #include "annotationsketch/style_api.h"
 #include "annotationsketch/text_width_calculator_api.h"
 #include "annotationsketch/text_width_calculator_cairo_api.h"
+#include "annotationsketch/tile_renderer_api.h"
 #endif
 
 #ifdef __cplusplus
@@ -19,6 +19,7 @@
 #include "core/unused_api.h"
 #include "core/ma.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_node.h"
 #include "extended/luahelper.h"
@@ -37,6 +38,51 @@ static int feature_index_memory_lua_new(lua_State *L)
   return 1;
 }
 
+static int feature_index_mapped_lua_new(lua_State *L)
+{
+  GtFeatureIndex **feature_index;
+  const char *filename;
+  GtError *err;
+  filename = luaL_checkstring(L, 1);
+  feature_index = lua_newuserdata(L, sizeof (GtFeatureIndex*));
+  gt_assert(feature_index);
+  err = gt_error_new();
+  if (!(*feature_index = gt_feature_index_mapped_new(filename, err)))
+    return gt_lua_error(L, err);
+  gt_error_delete(err);
+  luaL_getmetatable(L, FEATURE_INDEX_METATABLE);
+  lua_setmetatable(L, -2);
+  return 1;
+}
+
+static int feature_index_lua_write_mapped(lua_State *L)
+{
+  GtFeatureIndex **fi;
+  const char *filename;
+  GtError *err;
+  gt_assert(L);
+  fi = check_feature_index(L, 1);
+  filename = luaL_checkstring(L, 2);
+  err = gt_error_new();
+  if (gt_feature_index_mapped_write(*fi, filename, err))
+    return gt_lua_error(L, err);
+  gt_error_delete(err);
+  return 0;
+}
+
+static int feature_index_lua_freeze(lua_State *L)
+{
+  GtFeatureIndex **fi;
+  GtError *err;
+  gt_assert(L);
+  fi = check_feature_index(L, 1);
+  err = gt_error_new();
+  if (gt_feature_index_freeze(*fi, err))
+    return gt_lua_error(L, err);
+  gt_error_delete(err);
+  return 0;
+}
+
 static int feature_index_lua_add_region_node(lua_State *L)
 {
   GtFeatureIndex **fi;
@@ -260,6 +306,7 @@ static int feature_index_lua_delete(lua_State *L)
 
 static const struct luaL_Reg feature_index_lib_f [] = {
   { "feature_index_memory_new", feature_index_memory_lua_new },
+  { "feature_index_mapped_new", feature_index_mapped_lua_new },
   { NULL, NULL }
 };
 
@@ -273,6 +320,8 @@ static const struct luaL_Reg feature_index_lib_m [] = {
   { "get_seqids", feature_index_lua_get_seqids },
   { "get_range_for_seqid", feature_index_lua_get_range_for_seqid },
   { "has_seqid", feature_index_lua_has_seqid },
+  { "write_mapped", feature_index_lua_write_mapped },
+  { "freeze", feature_index_lua_freeze },
   { NULL, NULL }
 };
 
@@ -26,6 +26,10 @@
    -- Returns a new FeatureIndex object storing the index in memory.
    function feature_index_memory_new()
 
+   -- Returns a new read-only FeatureIndex object for the feature index file
+   -- <filename> (see feature_index:write_mapped()).
+   function feature_index_mapped_new(filename)
+
    -- Add all features from all sequence regions contained in <gff3file> to
    -- <feature_index>.
    function feature_index:add_gff3file(gff3file)
@@ -53,6 +57,14 @@
    -- Returns the range covered by features of sequence ID <seqid> in
    -- <feature_index>.
    function feature_index:get_range_for_seqid(seqid)
+
+   -- Writes the contents of <feature_index> to the feature index file
+   -- <filename>, which can be opened with feature_index_mapped_new().
+   function feature_index:write_mapped(filename)
+
+   -- Makes <feature_index> read-only, such that it can be queried
+   -- concurrently without locking.
+   function feature_index:freeze()
 */
 int gt_lua_open_feature_index(lua_State*);
 
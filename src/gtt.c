@@ -17,6 +17,7 @@
 
 #include "gtt.h"
 #include "core/alphabet.h"
+#include "core/arena.h"
 #include "core/array.h"
 #include "core/array2dim_api.h"
 #include "core/array2dim_sparse.h"
@@ -42,17 +43,20 @@
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/hashtable.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport.h"
 #include "core/md5_seqid.h"
 #include "core/quality.h"
 #include "core/queue.h"
 #include "core/sequence_buffer.h"
+#include "core/sequence_buffer_spool.h"
 #include "core/splitter.h"
 #include "core/symbol.h"
 #include "core/tokenizer.h"
 #include "core/trans_table.h"
 #include "core/translator.h"
+#include "core/twobitenc_decode.h"
 #include "extended/alignment.h"
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/compressed_bitsequence.h"
@@ -62,6 +66,7 @@
 #include "extended/evaluator.h"
 #include "extended/feature_in_stream.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_mapped.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
@@ -169,12 +174,14 @@
 #include "tools/gt_wtree.h"
 #ifndef WITHOUT_CAIRO
 #include "annotationsketch/block.h"
+#include "annotationsketch/custom_track_density.h"
 #include "annotationsketch/diagram.h"
 #include "annotationsketch/gt_sketch.h"
 #include "annotationsketch/gt_sketch_page.h"
 #include "annotationsketch/image_info.h"
 #include "annotationsketch/rec_map.h"
 #include "annotationsketch/style.h"
+#include "annotationsketch/tile_renderer.h"
 #include "annotationsketch/track.h"
 #endif
 
@@ -282,6 +289,7 @@ GtHashmap* gtt_unit_tests(void)
 
   gt_hashmap_add(unit_tests, "alphabet class", gt_alphabet_unit_test);
   gt_hashmap_add(unit_tests, "alignment class", gt_alignment_unit_test);
+  gt_hashmap_add(unit_tests, "arena class", gt_arena_unit_test);
   gt_hashmap_add(unit_tests, "array class", gt_array_unit_test);
   gt_hashmap_add(unit_tests, "array example", gt_array_example);
   gt_hashmap_add(unit_tests, "array2dim example", gt_array2dim_example);
@@ -325,6 +333,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "feature node iterator example",
                                              gt_feature_node_iterator_example);
   gt_hashmap_add(unit_tests, "feature node class", gt_feature_node_unit_test);
+  gt_hashmap_add(unit_tests, "mapped feature index class",
+                                             gt_feature_index_mapped_unit_test);
   gt_hashmap_add(unit_tests, "feature in stream class",
                                                 gt_feature_in_stream_unit_test);
   gt_hashmap_add(unit_tests, "genome node class", gt_genome_node_unit_test);
@@ -336,6 +346,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
+  gt_hashmap_add(unit_tests, "interval index class",
+                 gt_interval_index_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "intset classes", gt_intset_unit_test);
   gt_hashmap_add(unit_tests, "karlin altschul class",
@@ -365,6 +377,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "safearith module", gt_safearith_unit_test);
   gt_hashmap_add(unit_tests, "sequence buffer class",
                                                   gt_sequence_buffer_unit_test);
+  gt_hashmap_add(unit_tests, "sequence buffer spool class",
+                 gt_sequence_buffer_spool_unit_test);
   gt_hashmap_add(unit_tests, "splicedseq class", gt_splicedseq_unit_test);
   gt_hashmap_add(unit_tests, "splitter class", gt_splitter_unit_test);
   gt_hashmap_add(unit_tests, "string class", gt_str_unit_test);
@@ -376,10 +390,14 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "tokenizer class", gt_tokenizer_unit_test);
   gt_hashmap_add(unit_tests, "translator class", gt_translator_unit_test);
   gt_hashmap_add(unit_tests, "transtable class", gt_trans_table_unit_test);
+  gt_hashmap_add(unit_tests, "two bit encoding decoder",
+                 gt_twobitenc_decode_unit_test);
   gt_hashmap_add(unit_tests, "uint64hashtable", gt_uint64hashtable_unit_test);
   gt_hashmap_add(unit_tests, "xdrop", gt_xdrop_unit_test);
 #ifndef WITHOUT_CAIRO
   gt_hashmap_add(unit_tests, "block class", gt_block_unit_test);
+  gt_hashmap_add(unit_tests, "density custom track class",
+                 gt_custom_track_density_unit_test);
   gt_hashmap_add(unit_tests, "diagram class", gt_diagram_unit_test);
   gt_hashmap_add(unit_tests, "style class", gt_style_unit_test);
   gt_hashmap_add(unit_tests, "element class", gt_element_unit_test);
@@ -387,6 +405,8 @@ GtHashmap* gtt_unit_tests(void)
                                              gt_feature_index_memory_unit_test);
   gt_hashmap_add(unit_tests, "imageinfo class", gt_image_info_unit_test);
   gt_hashmap_add(unit_tests, "line class", gt_line_unit_test);
+  gt_hashmap_add(unit_tests, "tile renderer class",
+                 gt_tile_renderer_unit_test);
   gt_hashmap_add(unit_tests, "track class", gt_track_unit_test);
 #endif
 #if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
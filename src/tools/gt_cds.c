@@ -23,6 +23,7 @@
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
+#include "extended/threaded_stream.h"
 #include "extended/gtdatahelp.h"
 #include "extended/seqid2file.h"
 #include "tools/gt_cds.h"
@@ -34,6 +35,7 @@ typedef struct {
   bool start_codon,
        final_stop_codon,
        generic_start_codons,
+       pipeline,
        verbose;
   GtSeqid2FileInfo *s2fi;
   GtOutputFileInfo *ofi;
@@ -97,6 +99,12 @@ static GtOptionParser* gt_cds_option_parser_new(void *tool_arguments)
   /* -seqfile, -matchdesc, -usedesc and -regionmapping */
   gt_seqid2file_register_options(op, arguments->s2fi);
 
+  /* -pipeline */
+  option = gt_option_new_bool("pipeline", "run the input stream and the "
+                              "CDS stream on separate threads",
+                              &arguments->pipeline, false);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -113,7 +121,9 @@ static GtOptionParser* gt_cds_option_parser_new(void *tool_arguments)
 static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
                          void *tool_arguments, GtError *err)
 {
-  GtNodeStream *gff3_in_stream, *cds_stream = NULL, *gff3_out_stream = NULL;
+  GtNodeStream *gff3_in_stream, *cds_stream = NULL, *gff3_out_stream = NULL,
+               *threaded_in_stream = NULL, *threaded_cds_stream = NULL,
+               *last_stream;
   CDSArguments *arguments = tool_arguments;
   GtRegionMapping *region_mapping;
   int had_err = 0;
@@ -125,6 +135,13 @@ static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
   gff3_in_stream = gt_gff3_in_stream_new_sorted(argv[parsed_args]);
   if (arguments->verbose && arguments->outfp)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+  last_stream = gff3_in_stream;
+
+  /* run the input stream on a separate thread (if necessary) */
+  if (arguments->pipeline) {
+    threaded_in_stream = gt_threaded_stream_new(last_stream);
+    last_stream = threaded_in_stream;
+  }
 
   /* create region mapping */
   region_mapping = gt_seqid2file_region_mapping_new(arguments->s2fi, err);
@@ -133,14 +150,21 @@ static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
 
   if (!had_err) {
     /* create CDS stream */
-    cds_stream = gt_cds_stream_new(gff3_in_stream, region_mapping,
+    cds_stream = gt_cds_stream_new(last_stream, region_mapping,
                                    arguments->minorflen, GT_CDS_SOURCE_TAG,
                                    arguments->start_codon,
                                    arguments->final_stop_codon,
                                    arguments->generic_start_codons);
+    last_stream = cds_stream;
+
+    /* run the CDS stream on a separate thread (if necessary) */
+    if (arguments->pipeline) {
+      threaded_cds_stream = gt_threaded_stream_new(last_stream);
+      last_stream = threaded_cds_stream;
+    }
 
     /* create gff3 output stream */
-    gff3_out_stream = gt_gff3_out_stream_new(cds_stream, arguments->outfp);
+    gff3_out_stream = gt_gff3_out_stream_new(last_stream, arguments->outfp);
 
     /* pull the features through the stream and free them afterwards */
     had_err = gt_node_stream_pull(gff3_out_stream, err);
@@ -148,7 +172,9 @@ static int gt_cds_runner(GT_UNUSED int argc, const char **argv, int parsed_args,
 
   /* free */
   gt_node_stream_delete(gff3_out_stream);
+  gt_node_stream_delete(threaded_cds_stream);
   gt_node_stream_delete(cds_stream);
+  gt_node_stream_delete(threaded_in_stream);
   gt_node_stream_delete(gff3_in_stream);
 
   return had_err;
@@ -23,6 +23,7 @@
 #include "core/encseq_options.h"
 #include "core/fasta_separator.h"
 #include "core/log_api.h"
+#include "core/minmax.h"
 #include "core/readmode.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -175,13 +176,37 @@ int gt_encseq_decode_arguments_check(GT_UNUSED int rest_argc,
   return had_err;
 }
 
+#define GT_ENCSEQ_DECODE_BUFSIZE 65536UL
+
+/* writes the <len> characters of <encseq> beginning at position <startpos> in
+   readmode <rm> to stdout, block by block, replacing separators by
+   <sepchar> */
+static void output_range(GtEncseq *encseq, GtReadmode rm, GtUword startpos,
+                         GtUword len, char sepchar, char *buffer)
+{
+  GtUword width, idx;
+
+  while (len > 0) {
+    width = MIN(len, GT_ENCSEQ_DECODE_BUFSIZE);
+    gt_encseq_extract_decoded_with_readmode(encseq, buffer, rm, startpos,
+                                            startpos + width - 1);
+    for (idx = 0; idx < width; idx++) {
+      if (buffer[idx] == (char) SEPARATOR)
+        buffer[idx] = sepchar;
+    }
+    gt_xfwrite(buffer, 1, (size_t) width, stdout);
+    startpos += width;
+    len -= width;
+  }
+}
+
 static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
                            const char *filename, GtError *err)
 {
   GtUword i, j, sfrom, sto;
   int had_err = 0;
   bool has_desc;
-  GtEncseqReader *esr;
+  char *buffer = NULL;
   gt_assert(encseq);
 
   if (!(has_desc = gt_encseq_has_description_support(encseq)))
@@ -257,8 +282,6 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
       gt_xfputc(GT_FASTA_SEPARATOR, stdout);
       gt_xfwrite(desc, 1, desclen, stdout);
       gt_xfputc('\n', stdout);
-      /* XXX: make this more efficient by writing in a buffer first and then
-         showing the result */
       if (args->singlechars) {
         for (j = 0; j < len; j++) {
            gt_xfputc(gt_encseq_get_decoded_char(encseq,
@@ -267,11 +290,10 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
                      stdout);
         }
       } else {
-        esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, startpos);
-        for (j = 0; j < len; j++) {
-           gt_xfputc(gt_encseq_reader_next_decoded_char(esr), stdout);
-        }
-        gt_encseq_reader_delete(esr);
+        if (buffer == NULL)
+          buffer = gt_malloc(sizeof (*buffer) * GT_ENCSEQ_DECODE_BUFSIZE);
+        output_range(encseq, args->rm, startpos, len, (char) SEPARATOR,
+                     buffer);
       }
       gt_xfputc('\n', stdout);
     }
@@ -301,20 +323,14 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
           gt_xfputc(cc, stdout);
         }
       } else {
-        esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, from);
-        if (esr) {
-          for (j = from; j <= to; j++) {
-            char cc = gt_encseq_reader_next_decoded_char(esr);
-            if (cc == (char) SEPARATOR)
-              cc = gt_str_get(args->sepchar)[0];
-            gt_xfputc(cc, stdout);
-          }
-          gt_encseq_reader_delete(esr);
-        }
+        buffer = gt_malloc(sizeof (*buffer) * GT_ENCSEQ_DECODE_BUFSIZE);
+        output_range(encseq, args->rm, from, to - from + 1,
+                     gt_str_get(args->sepchar)[0], buffer);
       }
       gt_xfputc('\n', stdout);
     }
   }
+  gt_free(buffer);
   return had_err;
 }
 
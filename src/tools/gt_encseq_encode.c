@@ -16,11 +16,13 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/alphabet.h"
 #include "core/basename_api.h"
 #include "core/ma.h"
 #include "core/encseq.h"
 #include "core/encseq_options.h"
+#include "core/file.h"
 #include "core/fileutils.h"
 #include "core/logger_api.h"
 #include "core/str_array_api.h"
@@ -62,7 +64,14 @@ static GtOptionParser* gt_encseq_encode_option_parser_new(void *tool_arguments)
   op = gt_option_parser_new("sequence_file [sequence_file "
                             "[sequence_file ...]]",
                             "Encode sequence files (FASTA/FASTQ, GenBank, "
-                            "EMBL) efficiently.");
+                            "EMBL) efficiently.\nUse '-' to read from stdin. "
+                            "Pipes and stdin are read only once, this "
+                            "requires\nan explicit alphabet and excludes "
+                            "option -lossless.\nUnless -lossless is used, "
+                            "the symbols read are kept in temporary files\n"
+                            "indexname.spool.* next to the index, which need "
+                            "a quarter of a byte per\nsymbol for DNA and less "
+                            "than a byte per symbol otherwise.");
 
   /* -showstats */
   option = gt_option_new_bool("showstats",
@@ -140,6 +149,11 @@ static void show_encoded_statistics(GtStrArray *infiles, const char *indexname)
   gt_assert(infiles);
   for (i=0; i < gt_str_array_size(infiles);i ++) {
     seqfile = gt_str_array_get(infiles, i);
+    if (gt_file_is_stream(seqfile)) {
+      printf("size of input stream %s is unknown, cannot compare it to "
+             "encoded size\n", seqfile);
+      return;
+    }
     orig_size += gt_file_size(seqfile);
   }
   enc_size += index_size(indexname, GT_ALPHABETFILESUFFIX);
@@ -173,6 +187,10 @@ static int gt_encseq_encode_runner(GT_UNUSED int argc, const char **argv,
       gt_error_set(err,"if more than one input file is given, then "
                        "option -indexname is mandatory");
       had_err = -1;
+    } else if (strcmp(gt_str_array_get(infiles, 0UL), "-") == 0) {
+      gt_error_set(err,"if the input is read from stdin, then option "
+                       "-indexname is mandatory");
+      had_err = -1;
     } else {
       char *basenameptr;
       basenameptr = gt_basename(gt_str_array_get(infiles, 0UL));
@@ -26,6 +26,7 @@
 #include "extended/gff3_in_stream.h"
 #include "extended/gtdatahelp.h"
 #include "extended/seqid2file.h"
+#include "extended/threaded_stream.h"
 #include "tools/gt_extractfeat.h"
 
 typedef struct {
@@ -35,7 +36,8 @@ typedef struct {
        target,
        verbose,
        showcoords,
-       retainids;
+       retainids,
+       pipeline;
   unsigned int gcode;
   GtStr *type;
   GtSeqid2FileInfo *s2fi;
@@ -139,6 +141,11 @@ static GtOptionParser* gt_extractfeat_option_parser_new(void *tool_arguments)
   /* -seqfile, -matchdesc, -usedesc and -regionmapping */
   gt_seqid2file_register_options(op, arguments->s2fi);
 
+  /* -pipeline */
+  option = gt_option_new_bool("pipeline", "run the input stream on a separate "
+                              "thread", &arguments->pipeline, false);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -160,7 +167,8 @@ static int gt_extractfeat_runner(GT_UNUSED int argc, const char **argv,
                                  int parsed_args, void *tool_arguments,
                                  GtError *err)
 {
-  GtNodeStream *gff3_in_stream = NULL, *extract_feature_stream = NULL;
+  GtNodeStream *gff3_in_stream = NULL, *extract_feature_stream = NULL,
+               *threaded_in_stream = NULL, *last_stream = NULL;
   GtExtractFeatArguments *arguments = tool_arguments;
   GtRegionMapping *region_mapping;
   GtTransTable *ttable = NULL;
@@ -174,6 +182,13 @@ static int gt_extractfeat_runner(GT_UNUSED int argc, const char **argv,
     gff3_in_stream = gt_gff3_in_stream_new_sorted(argv[parsed_args]);
     if (arguments->verbose)
       gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+    last_stream = gff3_in_stream;
+
+    /* run the input stream on a separate thread (if necessary) */
+    if (arguments->pipeline) {
+      threaded_in_stream = gt_threaded_stream_new(last_stream);
+      last_stream = threaded_in_stream;
+    }
 
     /* create region mapping */
     region_mapping = gt_seqid2file_region_mapping_new(arguments->s2fi, err);
@@ -184,7 +199,7 @@ static int gt_extractfeat_runner(GT_UNUSED int argc, const char **argv,
   if (!had_err) {
     /* create extract feature stream */
     extract_feature_stream =
-      gt_extract_feature_stream_new(gff3_in_stream,
+      gt_extract_feature_stream_new(last_stream,
                                     region_mapping,
                                     gt_str_get(arguments->type),
                                     arguments->join,
@@ -221,6 +236,7 @@ static int gt_extractfeat_runner(GT_UNUSED int argc, const char **argv,
 
   /* free */
   gt_node_stream_delete(extract_feature_stream);
+  gt_node_stream_delete(threaded_in_stream);
   gt_node_stream_delete(gff3_in_stream);
   gt_trans_table_delete(ttable);
 
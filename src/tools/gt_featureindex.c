@@ -18,14 +18,22 @@
 #include <string.h>
 #include "core/fileutils_api.h"
 #include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/multithread_api.h"
 #include "core/password_entry.h"
 #include "core/str_api.h"
+#include "core/str_array_api.h"
+#include "core/thread_api.h"
+#include "core/timer_api.h"
 #include "core/unused_api.h"
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/anno_db_schema_api.h"
+#include "extended/array_out_stream_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
 #include "extended/feature_node.h"
 #include "extended/feature_stream_api.h"
+#include "extended/gff3_in_stream_api.h"
 #include "extended/gff3_visitor.h"
 #include "extended/rdb_api.h"
 #ifdef HAVE_MYSQL
@@ -38,6 +46,7 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_MAPPED_BACKEND_STRING "mapped"
 
 typedef struct {
   GtRange qry_rng;
@@ -47,12 +56,17 @@ typedef struct {
         *host,
         *user,
         *pass,
-        *database;
+        *database,
+        *add;
+  GtStrArray *remove;
   int port;
+  GtUword benchmark,
+          querywidth;
   bool verbose,
        retain,
        child_callback_check,
-       attributes_callback_check;
+       attributes_callback_check,
+       compact;
   GtOption *rngopt;
 } GtFeatureindexArguments;
 
@@ -65,6 +79,8 @@ static void* gt_featureindex_arguments_new(void)
   arguments->host = gt_str_new();
   arguments->user = gt_str_new();
   arguments->database = gt_str_new();
+  arguments->add = gt_str_new();
+  arguments->remove = gt_str_array_new();
   return arguments;
 }
 
@@ -79,6 +95,8 @@ static void gt_featureindex_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->user);
   gt_str_delete(arguments->pass);
   gt_str_delete(arguments->database);
+  gt_str_delete(arguments->add);
+  gt_str_array_delete(arguments->remove);
   gt_option_delete(arguments->rngopt);
   gt_free(arguments);
 }
@@ -87,7 +105,8 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 {
   GtFeatureindexArguments *arguments = tool_arguments;
   GtOptionParser *op;
-  GtOption *option, *backend_option, *filenameoption;
+  GtOption *option, *backend_option, *filenameoption, *add_option,
+           *remove_option, *compact_option;
   static const char *backends[] = {
 #ifdef HAVE_SQLITE
     GT_SQLITE_BACKEND_STRING,
@@ -95,6 +114,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_MAPPED_BACKEND_STRING,
     NULL
   };
   gt_assert(arguments);
@@ -126,7 +146,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
                                         "|" GT_MYSQL_BACKEND_STRING
 #endif
-                                        "]",
+                                        "|" GT_MAPPED_BACKEND_STRING "]",
                                         arguments->backend, backends[0],
                                         backends);
   gt_option_parser_add_option(op, backend_option);
@@ -134,7 +154,7 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and mapped backends only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
@@ -164,6 +184,33 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   gt_option_is_mandatory(filenameoption);
 #endif
 
+  /* -add */
+  add_option = gt_option_new_filename("add", "add the top-level features in "
+                                      "the given GFF3 file to the index, "
+                                      "replacing features with the same ID "
+                                      "(mapped backend only)\n"
+                                      "the changes are appended to a delta "
+                                      "file next to the index",
+                                      arguments->add);
+  gt_option_parser_add_option(op, add_option);
+
+  /* -remove */
+  remove_option = gt_option_new_string_array("remove", "remove the top-level "
+                                             "features with the given IDs "
+                                             "from the index (mapped backend "
+                                             "only)",
+                                             arguments->remove);
+  gt_option_parser_add_option(op, remove_option);
+
+  /* -compact */
+  compact_option = gt_option_new_bool("compact", "merge the delta file into "
+                                      "the index and remove it (mapped "
+                                      "backend only)",
+                                      &arguments->compact, false);
+  gt_option_parser_add_option(op, compact_option);
+  gt_option_exclude(compact_option, add_option);
+  gt_option_exclude(compact_option, remove_option);
+
   option = gt_option_new_bool("child_check", "test callbacks for "
                                              "child node addition",
                               &arguments->child_callback_check, false);
@@ -176,6 +223,19 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
   gt_option_is_development_option(option);
 
+  option = gt_option_new_uword("benchmark", "freeze the index, run given "
+                               "number of random range queries in parallel "
+                               "(see -j) and report the query throughput",
+                               &arguments->benchmark, 0);
+  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(option);
+
+  option = gt_option_new_uword_min("querywidth", "width of the range queries "
+                                   "run by -benchmark",
+                                   &arguments->querywidth, 10000, 1);
+  gt_option_parser_add_option(op, option);
+  gt_option_is_development_option(option);
+
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
 
@@ -183,80 +243,78 @@ static GtOptionParser* gt_featureindex_option_parser_new(void *tool_arguments)
 }
 
 static int gt_featureindex_arguments_check(GT_UNUSED int rest_argc,
-                                           GT_UNUSED void *tool_arguments,
-                                           GT_UNUSED GtError *err)
+                                           void *tool_arguments,
+                                           GtError *err)
 {
-  GT_UNUSED GtFeatureindexArguments *arguments = tool_arguments;
+  GtFeatureindexArguments *arguments = tool_arguments;
   int had_err = 0;
   gt_error_check(err);
   gt_assert(arguments);
 
+  if ((gt_str_length(arguments->add) > 0 ||
+       gt_str_array_size(arguments->remove) > 0 || arguments->compact) &&
+      strcmp(gt_str_get(arguments->backend), GT_MAPPED_BACKEND_STRING) != 0) {
+    gt_error_set(err, "options -add, -remove and -compact require -backend "
+                      GT_MAPPED_BACKEND_STRING);
+    had_err = -1;
+  }
+
   return had_err;
 }
 
-static int gt_featureindex_runner(GT_UNUSED int argc,
-                                  GT_UNUSED const char **argv,
-                                  GT_UNUSED int parsed_args,
-                                  void *tool_arguments,
+/* Appends the changes given by -add and -remove as a delta segment to the
+   mapped index file. */
+static int gt_featureindex_update(GtFeatureindexArguments *arguments,
                                   GtError *err)
 {
-  GtFeatureindexArguments *arguments = tool_arguments;
-  GtFeatureIndex *fi = NULL;
-  GtArray *results = NULL;
-  GtRange rng;
-  GtRDB *rdb = NULL;
-  GtAnnoDBSchema *adbs = NULL;
-  GtNodeVisitor *gff3visitor = NULL;
-  GtGenomeNode *regn = NULL;
-  GtUword i = 0;
+  GtNodeStream *in_stream = NULL, *array_out_stream = NULL;
+  GtArray *features;
+  const char *addfile;
+  GtUword i;
   int had_err = 0;
-
   gt_error_check(err);
-  gt_assert(arguments);
 
-#ifdef HAVE_SQLITE
-  if (!had_err) {
-    if (strcmp(gt_str_get(arguments->backend),
-               GT_SQLITE_BACKEND_STRING) == 0) {
-      if (!gt_file_exists(gt_str_get(arguments->filename))) {
-        gt_error_set(err, "file '%s' does not exist",
-                     gt_str_get(arguments->filename));
-        had_err = -1;
-      }
-      if (!had_err) {
-        rdb = gt_rdb_sqlite_new(gt_str_get(arguments->filename), err);
-        if (!rdb)
-          had_err = -1;
-      }
+  features = gt_array_new(sizeof (GtGenomeNode*));
+  if (gt_str_length(arguments->add) > 0) {
+    addfile = gt_str_get(arguments->add);
+    in_stream = gt_gff3_in_stream_new_unsorted(1, &addfile);
+    if (!(array_out_stream = gt_array_out_stream_new(in_stream, features,
+                                                     err))) {
+      had_err = -1;
     }
+    if (!had_err)
+      had_err = gt_node_stream_pull(array_out_stream, err);
   }
-#endif
-#ifdef HAVE_MYSQL
   if (!had_err) {
-    if (strcmp(gt_str_get(arguments->backend),
-                      GT_MYSQL_BACKEND_STRING) == 0) {
-      arguments->pass = gt_get_password("password: ", err);
-      rdb = gt_rdb_mysql_new(gt_str_get(arguments->host),
-                             arguments->port,
-                             gt_str_get(arguments->database),
-                             gt_str_get(arguments->user),
-                             gt_str_get(arguments->pass),
-                             err);
-      if (!rdb)
-        had_err = -1;
-    }
+    had_err = gt_feature_index_mapped_append_delta(
+                                              gt_str_get(arguments->filename),
+                                              features, arguments->remove,
+                                              err);
+  }
+  if (!had_err && arguments->verbose) {
+    printf("added "GT_WU" and removed "GT_WU" features\n",
+           gt_array_size(features), gt_str_array_size(arguments->remove));
   }
-#endif
-  if (!had_err)
-    adbs = gt_anno_db_gfflike_new();
 
-  if (!had_err && !adbs)
-    had_err = -1;
+  for (i = 0; i < gt_array_size(features); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(features, i));
+  gt_array_delete(features);
+  gt_node_stream_delete(array_out_stream);
+  gt_node_stream_delete(in_stream);
+  return had_err;
+}
 
-  if (!had_err) {
-    fi = gt_anno_db_schema_get_feature_index(adbs, rdb, err);
-    had_err = fi ? 0 : -1;
-  }
+static int gt_featureindex_query(GtFeatureIndex *fi,
+                                 GtFeatureindexArguments *arguments,
+                                 GtError *err)
+{
+  GtArray *results = NULL;
+  GtRange rng;
+  GtNodeVisitor *gff3visitor = NULL;
+  GtGenomeNode *regn = NULL;
+  GtUword i = 0;
+  int had_err = 0;
+  gt_error_check(err);
 
   if (!had_err && gt_str_length(arguments->seqid) == 0) {
     char *firstseqid = gt_feature_index_get_first_seqid(fi, err);
@@ -316,12 +374,242 @@ static int gt_featureindex_runner(GT_UNUSED int argc,
         }
       }
       gt_genome_node_accept(gn, gff3visitor, err);
-      gt_genome_node_delete(gn);
     }
   }
 
   gt_array_delete(results);
   gt_node_visitor_delete(gff3visitor);
+  return had_err;
+}
+
+typedef struct {
+  const char *seqid;
+  GtRange rng;
+} GtFeatureindexQuery;
+
+typedef struct {
+  GtFeatureIndex *fi;
+  GtArray *queries;
+  GtMutex *mutex;
+  unsigned int next_thread;
+  GtUword nof_results;
+  GtError *err;
+  int had_err;
+} GtFeatureindexBenchmarkInfo;
+
+/* Runs the share of the benchmark queries belonging to the calling thread. */
+static void* gt_featureindex_benchmark_thread(void *data)
+{
+  GtFeatureindexBenchmarkInfo *bi = data;
+  GtArray *results;
+  GtError *err;
+  GtUword i, from, to, nof_results = 0;
+  unsigned int thread;
+  int had_err = 0;
+
+  gt_mutex_lock(bi->mutex);
+  thread = bi->next_thread++;
+  gt_mutex_unlock(bi->mutex);
+  from = thread * gt_array_size(bi->queries) / gt_jobs;
+  to = (thread + 1) * gt_array_size(bi->queries) / gt_jobs;
+
+  results = gt_array_new(sizeof (GtGenomeNode*));
+  err = gt_error_new();
+  for (i = from; !had_err && i < to; i++) {
+    GtFeatureindexQuery *q = gt_array_get(bi->queries, i);
+    gt_array_reset(results);
+    had_err = gt_feature_index_get_features_for_range(bi->fi, results,
+                                                      q->seqid, &q->rng, err);
+    nof_results += gt_array_size(results);
+  }
+
+  gt_mutex_lock(bi->mutex);
+  bi->nof_results += nof_results;
+  if (had_err && !bi->had_err) {
+    gt_error_set(bi->err, "%s", gt_error_get(err));
+    bi->had_err = had_err;
+  }
+  gt_mutex_unlock(bi->mutex);
+  gt_error_delete(err);
+  gt_array_delete(results);
+  return NULL;
+}
+
+static int gt_featureindex_benchmark(GtFeatureIndex *fi,
+                                     GtFeatureindexArguments *arguments,
+                                     GtError *err)
+{
+  GtFeatureindexBenchmarkInfo bi;
+  GtStrArray *seqids = NULL;
+  GtArray *ranges;
+  GtTimer *timer;
+  GtUword i;
+  double seconds;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* query the given sequence region or all of them */
+  if (gt_str_length(arguments->seqid) > 0) {
+    bool has_seqid;
+    seqids = gt_str_array_new();
+    gt_str_array_add(seqids, arguments->seqid);
+    had_err = gt_feature_index_has_seqid(fi, &has_seqid,
+                                         gt_str_get(arguments->seqid), err);
+    if (!had_err && !has_seqid) {
+      gt_error_set(err, "feature index does not contain sequence region '%s'",
+                   gt_str_get(arguments->seqid));
+      had_err = -1;
+    }
+  }
+  else if (!(seqids = gt_feature_index_get_seqids(fi, err)))
+    had_err = -1;
+  if (!had_err && gt_str_array_size(seqids) == 0) {
+    gt_error_set(err, "feature index does not contain any sequence regions");
+    had_err = -1;
+  }
+
+  ranges = gt_array_new(sizeof (GtRange));
+  for (i = 0; !had_err && i < gt_str_array_size(seqids); i++) {
+    GtRange rng;
+    had_err = gt_feature_index_get_range_for_seqid(fi, &rng,
+                                                   gt_str_array_get(seqids, i),
+                                                   err);
+    gt_array_add(ranges, rng);
+  }
+
+  /* the queries are drawn in advance to measure the index only */
+  bi.queries = gt_array_new(sizeof (GtFeatureindexQuery));
+  for (i = 0; !had_err && i < arguments->benchmark; i++) {
+    GtFeatureindexQuery q;
+    GtUword idx = gt_str_array_size(seqids) > 1
+                    ? gt_rand_max(gt_str_array_size(seqids) - 1)
+                    : 0;
+    GtRange *rng = gt_array_get(ranges, idx);
+    q.seqid = gt_str_array_get(seqids, idx);
+    q.rng.start = rng->start;
+    if (gt_range_length(rng) > 1)
+      q.rng.start += gt_rand_max(gt_range_length(rng) - 1);
+    q.rng.end = q.rng.start + arguments->querywidth - 1;
+    gt_array_add(bi.queries, q);
+  }
+
+  if (!had_err)
+    had_err = gt_feature_index_freeze(fi, err);
+
+  if (!had_err) {
+    bi.fi = fi;
+    bi.mutex = gt_mutex_new();
+    bi.next_thread = 0;
+    bi.nof_results = 0;
+    bi.err = err;
+    bi.had_err = 0;
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+    had_err = gt_multithread(gt_featureindex_benchmark_thread, &bi, err);
+    gt_timer_stop(timer);
+    if (!had_err)
+      had_err = bi.had_err;
+    if (!had_err) {
+      seconds = (double) gt_timer_elapsed_usec(timer) / 1000000.0;
+      printf("queries: "GT_WU"\n", gt_array_size(bi.queries));
+      printf("features: "GT_WU"\n", bi.nof_results);
+      printf("threads: %u\n", gt_jobs);
+      printf("time: %.3f s\n", seconds);
+      printf("queries per second: %.0f\n",
+             seconds > 0 ? gt_array_size(bi.queries) / seconds : 0);
+    }
+    gt_timer_delete(timer);
+    gt_mutex_delete(bi.mutex);
+  }
+
+  gt_array_delete(bi.queries);
+  gt_array_delete(ranges);
+  gt_str_array_delete(seqids);
+  return had_err;
+}
+
+static int gt_featureindex_runner(GT_UNUSED int argc,
+                                  GT_UNUSED const char **argv,
+                                  GT_UNUSED int parsed_args,
+                                  void *tool_arguments,
+                                  GtError *err)
+{
+  GtFeatureindexArguments *arguments = tool_arguments;
+  GtFeatureIndex *fi = NULL;
+  GtRDB *rdb = NULL;
+  GtAnnoDBSchema *adbs = NULL;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  /* updates and compaction work on the index file directly */
+  if (gt_str_length(arguments->add) > 0 ||
+      gt_str_array_size(arguments->remove) > 0) {
+    return gt_featureindex_update(arguments, err);
+  }
+  if (arguments->compact)
+    return gt_feature_index_mapped_compact(gt_str_get(arguments->filename),
+                                           err);
+
+#ifdef HAVE_SQLITE
+  if (!had_err) {
+    if (strcmp(gt_str_get(arguments->backend),
+               GT_SQLITE_BACKEND_STRING) == 0) {
+      if (!gt_file_exists(gt_str_get(arguments->filename))) {
+        gt_error_set(err, "file '%s' does not exist",
+                     gt_str_get(arguments->filename));
+        had_err = -1;
+      }
+      if (!had_err) {
+        rdb = gt_rdb_sqlite_new(gt_str_get(arguments->filename), err);
+        if (!rdb)
+          had_err = -1;
+      }
+    }
+  }
+#endif
+#ifdef HAVE_MYSQL
+  if (!had_err) {
+    if (strcmp(gt_str_get(arguments->backend),
+                      GT_MYSQL_BACKEND_STRING) == 0) {
+      arguments->pass = gt_get_password("password: ", err);
+      rdb = gt_rdb_mysql_new(gt_str_get(arguments->host),
+                             arguments->port,
+                             gt_str_get(arguments->database),
+                             gt_str_get(arguments->user),
+                             gt_str_get(arguments->pass),
+                             err);
+      if (!rdb)
+        had_err = -1;
+    }
+  }
+#endif
+  if (!had_err && strcmp(gt_str_get(arguments->backend),
+                         GT_MAPPED_BACKEND_STRING) == 0) {
+    fi = gt_feature_index_mapped_new(gt_str_get(arguments->filename), err);
+    if (!fi)
+      had_err = -1;
+  }
+
+  if (!had_err && !fi) {
+    adbs = gt_anno_db_gfflike_new();
+    if (!adbs)
+      had_err = -1;
+  }
+
+  if (!had_err && !fi) {
+    fi = gt_anno_db_schema_get_feature_index(adbs, rdb, err);
+    had_err = fi ? 0 : -1;
+  }
+
+  if (!had_err) {
+    if (arguments->benchmark)
+      had_err = gt_featureindex_benchmark(fi, arguments, err);
+    else
+      had_err = gt_featureindex_query(fi, arguments, err);
+  }
+
   gt_rdb_delete(rdb);
   gt_anno_db_schema_delete(adbs);
 
@@ -19,9 +19,13 @@
 #include "core/ma.h"
 #include "core/option_api.h"
 #include "core/output_file_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
+#include "core/unused_api.h"
 #include "core/versionfunc.h"
 #include "extended/add_introns_stream_api.h"
+#include "extended/binary_in_stream_api.h"
+#include "extended/binary_out_stream_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_defines.h"
 #include "extended/gff3_in_stream.h"
@@ -34,6 +38,7 @@
 #include "extended/merge_feature_stream_api.h"
 #include "extended/set_source_visitor_api.h"
 #include "extended/sort_stream.h"
+#include "extended/threaded_stream.h"
 #include "extended/typecheck_info.h"
 #include "extended/visitor_stream_api.h"
 #include "extended/xrfcheck_info.h"
@@ -53,9 +58,14 @@ typedef struct {
        strict,
        tidy,
        show,
-       fixboundaries;
+       fixboundaries,
+       pipeline,
+       binary;
   GtWord offset;
-  GtStr *offsetfile, *newsource;
+  GtStr *offsetfile, *newsource, *memlimitarg;
+  GtOption *refoptionmemlimit;
+  GtUword memlimit,
+          chunksize;
   GtUword width;
   GtTypecheckInfo *tci;
   GtXRFCheckInfo *xci;
@@ -68,6 +78,7 @@ static void* gt_gff3_arguments_new(void)
   GFF3Arguments *arguments = gt_calloc(1, sizeof *arguments);
   arguments->newsource = gt_str_new();
   arguments->offsetfile = gt_str_new();
+  arguments->memlimitarg = gt_str_new();
   arguments->tci = gt_typecheck_info_new();
   arguments->xci = gt_xrfcheck_info_new();
   arguments->ofi = gt_output_file_info_new();
@@ -84,6 +95,8 @@ static void gt_gff3_arguments_delete(void *tool_arguments)
   gt_typecheck_info_delete(arguments->tci);
   gt_xrfcheck_info_delete(arguments->xci);
   gt_str_delete(arguments->offsetfile);
+  gt_option_delete(arguments->refoptionmemlimit);
+  gt_str_delete(arguments->memlimitarg);
   gt_free(arguments);
 }
 
@@ -104,10 +117,20 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   /* -sort */
   sort_option = gt_option_new_bool("sort", "sort the GFF3 features (memory "
                                    "consumption is proportional to the input "
-                                   "file size(s))",
+                                   "file size(s), unless -memlimit is used)",
                                    &arguments->sort, false);
   gt_option_parser_add_option(op, sort_option);
 
+  /* -memlimit */
+  option = gt_option_new_string("memlimit", "limit the memory used for "
+                                "sorting (e.g., 512MB or 2GB), the features "
+                                "are sorted in runs on disk which are merged "
+                                "afterwards",
+                                arguments->memlimitarg, NULL);
+  gt_option_imply(option, sort_option);
+  gt_option_parser_add_option(op, option);
+  arguments->refoptionmemlimit = gt_option_ref(option);
+
   /* -sortlines */
   sortlines_option = gt_option_new_bool("sortlines", "sort the GFF3 features "
                                         "on a strict line basis (not sorted as"
@@ -226,6 +249,28 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                               true);
   gt_option_parser_add_option(op, option);
 
+  /* -binary */
+  option = gt_option_new_bool("binary", "write the output in a compact binary "
+                              "format instead of GFF3, binary files given as "
+                              "input are recognized automatically and read "
+                              "without parsing", &arguments->binary, false);
+  gt_option_exclude(option, sortlines_option);
+  gt_option_exclude(option, sortnum_option);
+  gt_option_parser_add_option(op, option);
+
+  /* -pipeline */
+  option = gt_option_new_bool("pipeline", "run the input stream and the "
+                              "processing stages on separate threads",
+                              &arguments->pipeline, false);
+  gt_option_parser_add_option(op, option);
+
+  /* -chunksize */
+  option = gt_option_new_uword("chunksize", "minimal size of the input chunks "
+                               "parsed in parallel in bytes (0 for the "
+                               "default of 1MB)", &arguments->chunksize, 0);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -243,74 +288,123 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   return op;
 }
 
+static int gt_gff3_arguments_check(GT_UNUSED int rest_argc,
+                                   void *tool_arguments, GtError *err)
+{
+  GFF3Arguments *arguments = tool_arguments;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(arguments);
+  if (gt_option_is_set(arguments->refoptionmemlimit)) {
+    had_err = gt_option_parse_spacespec(&arguments->memlimit, "memlimit",
+                                        arguments->memlimitarg, err);
+  }
+  return had_err;
+}
+
 static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
                           void *tool_arguments, GtError *err)
 {
   GFF3Arguments *arguments = tool_arguments;
   GtTypeChecker *type_checker = NULL;
   GtXRFChecker *xrf_checker = NULL;
-  GtNodeStream *gff3_in_stream,
+  GtNodeStream *gff3_in_stream = NULL,
+               *binary_in_stream = NULL,
                *sort_stream = NULL,
                *load_stream = NULL,
                *merge_feature_stream = NULL,
                *add_introns_stream = NULL,
                *set_source_stream = NULL,
+               *threaded_in_stream = NULL,
+               *threaded_stream = NULL,
                *gff3_out_stream = NULL,
                *last_stream;
-  int had_err = 0;
+  int i, had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
 
-  /* create a gff3 input stream */
-  gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
-                                                  argv + parsed_args);
-  if (arguments->verbose && arguments->outfp)
-    gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
-  if (arguments->checkids)
-    gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*) gff3_in_stream);
-  if (!arguments->addids)
-    gt_gff3_in_stream_disable_add_ids(gff3_in_stream);
-
-  last_stream = gff3_in_stream;
-
-  /* set different type checker if necessary */
-  if (gt_typecheck_info_option_used(arguments->tci)) {
-    type_checker = gt_typecheck_info_create_type_checker(arguments->tci, err);
-    if (!type_checker)
-      had_err = -1;
-    if (!had_err)
-      gt_gff3_in_stream_set_type_checker(gff3_in_stream, type_checker);
+  /* create a binary input stream (if all input files are binary, or stdin is
+     binary if no file is given) */
+  for (i = parsed_args; i < argc; i++) {
+    if (!gt_binary_in_stream_is_binary_file(argv[i]))
+      break;
   }
-
-  /* set XRF checker if necessary */
-  if (gt_xrfcheck_info_option_used(arguments->xci)) {
-    xrf_checker = gt_xrfcheck_info_create_xrf_checker(arguments->xci, err);
-    if (!xrf_checker)
-      had_err = -1;
-    if (!had_err)
-      gt_gff3_in_stream_set_xrf_checker(gff3_in_stream, xrf_checker);
+  if ((parsed_args < argc && i == argc) ||
+      (parsed_args == argc && gt_binary_in_stream_is_binary_file("-"))) {
+    binary_in_stream = gt_binary_in_stream_new(argc - parsed_args,
+                                               argv + parsed_args);
+    last_stream = binary_in_stream;
   }
+  else {
+    /* create a gff3 input stream */
+    gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
+                                                    argv + parsed_args);
+    if (arguments->verbose && arguments->outfp)
+      gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
+    if (arguments->checkids)
+      gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*) gff3_in_stream);
+    if (!arguments->addids)
+      gt_gff3_in_stream_disable_add_ids(gff3_in_stream);
+    if (gt_jobs > 1)
+      gt_gff3_in_stream_enable_parallel_mode((GtGFF3InStream*) gff3_in_stream);
+    if (arguments->chunksize) {
+      gt_gff3_in_stream_set_parallel_chunk_size((GtGFF3InStream*)
+                                                gff3_in_stream,
+                                                arguments->chunksize);
+    }
+    /* all nodes are kept in memory, allocate them in bulk */
+    if (arguments->sort || arguments->sortlines || arguments->sortnum ||
+        arguments->load) {
+      gt_gff3_in_stream_enable_arena((GtGFF3InStream*) gff3_in_stream);
+    }
 
-  /* set offset (if necessary) */
-  if (!had_err && arguments->offset != GT_UNDEF_WORD)
-    gt_gff3_in_stream_set_offset(gff3_in_stream, arguments->offset);
+    last_stream = gff3_in_stream;
 
-  /* set offsetfile (if necessary) */
-  if (!had_err && gt_str_length(arguments->offsetfile)) {
-    had_err = gt_gff3_in_stream_set_offsetfile(gff3_in_stream,
-                                               arguments->offsetfile, err);
-  }
+    /* set different type checker if necessary */
+    if (gt_typecheck_info_option_used(arguments->tci)) {
+      type_checker = gt_typecheck_info_create_type_checker(arguments->tci, err);
+      if (!type_checker)
+        had_err = -1;
+      if (!had_err)
+        gt_gff3_in_stream_set_type_checker(gff3_in_stream, type_checker);
+    }
+
+    /* set XRF checker if necessary */
+    if (gt_xrfcheck_info_option_used(arguments->xci)) {
+      xrf_checker = gt_xrfcheck_info_create_xrf_checker(arguments->xci, err);
+      if (!xrf_checker)
+        had_err = -1;
+      if (!had_err)
+        gt_gff3_in_stream_set_xrf_checker(gff3_in_stream, xrf_checker);
+    }
 
-  /* enable strict mode (if necessary) */
-  if (!had_err && arguments->strict)
-    gt_gff3_in_stream_enable_strict_mode((GtGFF3InStream*) gff3_in_stream);
-  /* enable tidy mode (if necessary) */
-  if (!had_err && arguments->tidy)
-    gt_gff3_in_stream_enable_tidy_mode((GtGFF3InStream*) gff3_in_stream);
+    /* set offset (if necessary) */
+    if (!had_err && arguments->offset != GT_UNDEF_WORD)
+      gt_gff3_in_stream_set_offset(gff3_in_stream, arguments->offset);
 
-  if (!had_err && arguments->fixboundaries)
-    gt_gff3_in_stream_fix_region_boundaries((GtGFF3InStream*) gff3_in_stream);
+    /* set offsetfile (if necessary) */
+    if (!had_err && gt_str_length(arguments->offsetfile)) {
+      had_err = gt_gff3_in_stream_set_offsetfile(gff3_in_stream,
+                                                 arguments->offsetfile, err);
+    }
+
+    /* enable strict mode (if necessary) */
+    if (!had_err && arguments->strict)
+      gt_gff3_in_stream_enable_strict_mode((GtGFF3InStream*) gff3_in_stream);
+    /* enable tidy mode (if necessary) */
+    if (!had_err && arguments->tidy)
+      gt_gff3_in_stream_enable_tidy_mode((GtGFF3InStream*) gff3_in_stream);
+
+    if (!had_err && arguments->fixboundaries)
+      gt_gff3_in_stream_fix_region_boundaries((GtGFF3InStream*) gff3_in_stream);
+  }
+
+  /* run the input stream on a separate thread (if necessary) */
+  if (!had_err && arguments->pipeline) {
+    threaded_in_stream = gt_threaded_stream_new(last_stream);
+    last_stream = threaded_in_stream;
+  }
 
   /* create load stream (if necessary) */
   if (!had_err && arguments->load) {
@@ -322,6 +416,10 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   if (!had_err && (arguments->sort || arguments->sortlines ||
                    arguments->sortnum)) {
     sort_stream = gt_sort_stream_new(last_stream);
+    if (arguments->memlimit) {
+      gt_sort_stream_set_memlimit((GtSortStream*) sort_stream,
+                                  arguments->memlimit);
+    }
     last_stream = sort_stream;
   }
 
@@ -347,9 +445,17 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
     last_stream = set_source_stream;
   }
 
+  /* run the processing stages on a separate thread (if necessary) */
+  if (!had_err && arguments->pipeline && last_stream != threaded_in_stream) {
+    threaded_stream = gt_threaded_stream_new(last_stream);
+    last_stream = threaded_stream;
+  }
+
   /* create gff3 output stream */
   if (!had_err && arguments->show) {
-    if (arguments->sortlines) {
+    if (arguments->binary)
+      gff3_out_stream = gt_binary_out_stream_new(last_stream, arguments->outfp);
+    else if (arguments->sortlines) {
       gff3_out_stream = gt_gff3_linesorted_out_stream_new(last_stream,
                                                           arguments->outfp);
       gt_gff3_linesorted_out_stream_set_fasta_width(
@@ -385,12 +491,16 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
 
   /* free */
   gt_node_stream_delete(gff3_out_stream);
+  /* stop the stream threads before the stages they are running are freed */
+  gt_node_stream_delete(threaded_stream);
+  gt_node_stream_delete(threaded_in_stream);
   gt_node_stream_delete(sort_stream);
   gt_node_stream_delete(load_stream);
   gt_node_stream_delete(merge_feature_stream);
   gt_node_stream_delete(add_introns_stream);
   gt_node_stream_delete(set_source_stream);
   gt_node_stream_delete(gff3_in_stream);
+  gt_node_stream_delete(binary_in_stream);
   gt_type_checker_delete(type_checker);
   gt_xrf_checker_delete(xrf_checker);
 
@@ -402,6 +512,6 @@ GtTool* gt_gff3(void)
   return gt_tool_new(gt_gff3_arguments_new,
                      gt_gff3_arguments_delete,
                      gt_gff3_option_parser_new,
-                     NULL,
+                     gt_gff3_arguments_check,
                      gt_gff3_runner);
 }
@@ -24,6 +24,8 @@
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/bed_in_stream.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_mapped_api.h"
+#include "extended/feature_index_memory_api.h"
 #include "extended/feature_stream_api.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gtf_in_stream.h"
@@ -37,6 +39,7 @@
 
 #define GT_SQLITE_BACKEND_STRING "sqlite"
 #define GT_MYSQL_BACKEND_STRING  "mysql"
+#define GT_MAPPED_BACKEND_STRING "mapped"
 
 typedef struct {
   GtStr *backend,
@@ -88,6 +91,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
     GT_MYSQL_BACKEND_STRING,
 #endif
+    GT_MAPPED_BACKEND_STRING,
     NULL
   };
   static const char *inputs[] = {
@@ -116,7 +120,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
 #ifdef HAVE_MYSQL
                                         "|" GT_MYSQL_BACKEND_STRING
 #endif
-                                        "]",
+                                        "|" GT_MAPPED_BACKEND_STRING "]",
                                         arguments->backend, backends[0],
                                         backends);
   gt_option_parser_add_option(op, backend_option);
@@ -130,7 +134,7 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
   /* -filename */
   filenameoption = gt_option_new_string("filename",
                                         "filename for feature database "
-                                        "(sqlite backend only)",
+                                        "(sqlite and mapped backends only)",
                                         arguments->filename, NULL);
   gt_option_parser_add_option(op, filenameoption);
 
@@ -190,11 +194,21 @@ static int gt_mkfeatureindex_runner(int argc,
   GtRDB *rdb = NULL;
   GtAnnoDBSchema *adb = NULL;
   GtFeatureIndex *fis = NULL;
+  bool mapped;
   int had_err = 0;
 
   gt_error_check(err);
   gt_assert(arguments);
 
+  mapped = strcmp(gt_str_get(arguments->backend),
+                  GT_MAPPED_BACKEND_STRING) == 0;
+  if (mapped && gt_file_exists(gt_str_get(arguments->filename))
+        && !arguments->force) {
+    gt_error_set(err, "file \"%s\" exists already. use option -force to "
+                 "overwrite", gt_str_get(arguments->filename));
+    had_err = -1;
+  }
+
 #ifdef HAVE_SQLITE
   if (strcmp(gt_str_get(arguments->backend),
              GT_SQLITE_BACKEND_STRING) == 0) {
@@ -229,11 +243,18 @@ static int gt_mkfeatureindex_runner(int argc,
   }
 #endif
 
-  adb = gt_anno_db_gfflike_new();
-  if (!had_err && !adb)
-    had_err = -1;
+  /* the mapped index is collected in memory and written in one go */
+  if (!had_err && mapped)
+    fis = gt_feature_index_memory_new();
 
-  if (!had_err) {
+  if (!had_err && !mapped) {
+    /* the database is freshly filled, so defer index creation */
+    adb = gt_anno_db_gfflike_new_bulk_load();
+    if (!adb)
+      had_err = -1;
+  }
+
+  if (!had_err && !mapped) {
     fis = gt_anno_db_schema_get_feature_index(adb, rdb, err);
     if (!fis)
       had_err = -1;
@@ -264,6 +285,13 @@ static int gt_mkfeatureindex_runner(int argc,
     feature_stream = gt_feature_stream_new(in_stream, fis);
     had_err = gt_node_stream_pull(feature_stream, err);
   }
+  if (!had_err && mapped) {
+    had_err = gt_feature_index_mapped_write(fis,
+                                            gt_str_get(arguments->filename),
+                                            err);
+  }
+  if (!had_err && !mapped)
+    had_err = gt_feature_index_save(fis, err);
   gt_node_stream_delete(feature_stream);
   gt_node_stream_delete(in_stream);
   gt_feature_index_delete(fis);
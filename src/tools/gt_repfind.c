@@ -21,6 +21,7 @@
 #include "core/log_api.h"
 #include "core/logger.h"
 #include "core/ma_api.h"
+#include "core/map_policy_options.h"
 #include "core/option_api.h"
 #include "core/str_api.h"
 #include "core/tool_api.h"
@@ -67,7 +68,8 @@ typedef struct
            *refextendxdropoption,
            *refextendgreedyoption,
            *ref_op_evalue;
-  GtStrArray *display_args;
+  GtStrArray *display_args,
+             *mmap_specs;
   double evalue_threshold;
 } GtMaxpairsoptions;
 
@@ -193,6 +195,7 @@ static void *gt_repfind_arguments_new(void)
   arguments->cam_string = gt_str_new();
   arguments->query_files = gt_str_array_new();
   arguments->display_args = gt_str_array_new();
+  arguments->mmap_specs = gt_str_array_new();
   return arguments;
 }
 
@@ -209,6 +212,7 @@ static void gt_repfind_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->cam_string);
   gt_str_array_delete(arguments->query_files);
   gt_str_array_delete(arguments->display_args);
+  gt_str_array_delete(arguments->mmap_specs);
   gt_option_delete(arguments->refforwardoption);
   gt_option_delete(arguments->refseedlengthoption);
   gt_option_delete(arguments->refuserdefinedleastlengthoption);
@@ -230,7 +234,7 @@ static GtOptionParser *gt_repfind_option_parser_new(void *tool_arguments)
            *check_extend_symmetry_option, *xdropbelowoption, *historyoption,
            *percmathistoryoption, *errorpercentageoption, *optiontrimstat,
            *optionnoxpolish, *verify_alignment_option, *option_query_indexname,
-           *op_evalue;
+           *op_evalue, *mmapoption;
   GtMaxpairsoptions *arguments = tool_arguments;
 
   op = gt_option_parser_new("[options] -ii indexname",
@@ -452,11 +456,14 @@ static GtOptionParser *gt_repfind_option_parser_new(void *tool_arguments)
                                   false);
   gt_option_parser_add_option(op, scanoption);
 
+  mmapoption = gt_map_policy_options_register(op, arguments->mmap_specs);
+
   option = gt_option_new_verbose(&arguments->beverbose);
   gt_option_parser_add_option(op, option);
 
   gt_option_exclude(option_query_files,sampleoption);
   gt_option_exclude(option_query_files,scanoption);
+  gt_option_exclude(scanoption,mmapoption);
   gt_option_exclude(option_query_files,spmoption);
   gt_option_exclude(option_query_files,option_query_indexname);
   gt_option_exclude(sampleoption,spmoption);
@@ -481,7 +488,7 @@ static GtOptionParser *gt_repfind_option_parser_new(void *tool_arguments)
 
 static int gt_repfind_arguments_check(GT_UNUSED int rest_argc,
                                       void *tool_arguments,
-                                      GT_UNUSED GtError *err)
+                                      GtError *err)
 {
   GtMaxpairsoptions *arguments = tool_arguments;
 
@@ -516,7 +523,7 @@ static int gt_repfind_arguments_check(GT_UNUSED int rest_argc,
   {
     arguments->evalue_threshold = DBL_MAX;
   }
-  return 0;
+  return gt_map_policy_options_apply(arguments->mmap_specs,err);
 }
 
 static int gt_generic_extend_selfmatch_xdrop_with_output(
@@ -26,6 +26,7 @@
 #include "core/encseq_api.h"
 #include "core/error_api.h"
 #include "core/ma_api.h"
+#include "core/map_policy_options.h"
 #include "core/mathsupport.h"
 #include "core/minmax.h"
 #include "core/parseutils_api.h"
@@ -85,7 +86,8 @@ typedef struct {
   GtUword se_alignlength;
   GtUword se_minidentity;
   double se_evalue_threshold;
-  GtStrArray *display_args;
+  GtStrArray *display_args,
+             *mmap_specs;
   bool norev;
   bool nofwd;
   bool benchmark;
@@ -116,6 +118,7 @@ static void* gt_seed_extend_arguments_new(void)
   arguments->splt_string = gt_str_new();
   arguments->kmplt_string = gt_str_new();
   arguments->display_args = gt_str_array_new();
+  arguments->mmap_specs = gt_str_array_new();
   return arguments;
 }
 
@@ -139,6 +142,7 @@ static void gt_seed_extend_arguments_delete(void *tool_arguments)
     gt_option_delete(arguments->se_ref_op_maxmat);
     gt_option_delete(arguments->ref_diagband_statistics);
     gt_str_array_delete(arguments->display_args);
+    gt_str_array_delete(arguments->mmap_specs);
     gt_free(arguments);
   }
 }
@@ -637,6 +641,9 @@ static GtOptionParser* gt_seed_extend_option_parser_new(void *tool_arguments)
                               true);
   gt_option_parser_add_option(op, option);
 
+  /* -mmap */
+  gt_map_policy_options_register(op, arguments->mmap_specs);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -731,6 +738,9 @@ static int gt_seed_extend_arguments_check(int rest_argc, void *tool_arguments,
   {
     gt_str_set(arguments->diagband_statistics_arg,"");
   }
+  if (!had_err) {
+    had_err = gt_map_policy_options_apply(arguments->mmap_specs, err);
+  }
   /* no extra arguments */
   if (!had_err && rest_argc > 0) {
     gt_error_set(err, "too many arguments (-help shows correct usage)");
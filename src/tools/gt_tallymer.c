@@ -21,6 +21,7 @@
 #include "core/format64.h"
 #include "core/intbits.h"
 #include "core/logger.h"
+#include "core/map_policy_options.h"
 #include "core/ma_api.h"
 #include "core/option_api.h"
 #include "core/str.h"
@@ -793,7 +794,8 @@ typedef struct
   GtStr *str_inputindex;
   GtStrArray *queryfilenames;
   GtStr *strandspec;
-  GtStrArray *showmodespec;
+  GtStrArray *showmodespec,
+             *mmapspecs;
   unsigned int strand,
                showmode;
   bool verbose,
@@ -808,6 +810,7 @@ static void *gt_tyr_search_arguments_new(void)
   arguments->strandspec = gt_str_new();
   arguments->queryfilenames = gt_str_array_new();
   arguments->showmodespec = gt_str_array_new();
+  arguments->mmapspecs = gt_str_array_new();
   arguments->showmode = 0;
   arguments->strand = 0;
   return arguments;
@@ -825,6 +828,7 @@ static void gt_tyr_search_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->strandspec);
   gt_str_array_delete(arguments->queryfilenames);
   gt_str_array_delete(arguments->showmodespec);
+  gt_str_array_delete(arguments->mmapspecs);
   gt_free(arguments);
 }
 
@@ -866,6 +870,8 @@ static GtOptionParser *gt_tyr_search_option_parser_new(void *tool_arguments)
                                       arguments->showmodespec);
   gt_option_parser_add_option(op, option);
 
+  gt_map_policy_options_register(op, arguments->mmapspecs);
+
   option = gt_option_new_bool("test", "perform tests to verify program "
                                       "correctness", &arguments->performtest,
                                       false);
@@ -926,6 +932,10 @@ static int gt_tyr_search_arguments_check(int rest_argc,
   {
     return -1;
   }
+  if (gt_map_policy_options_apply(arguments->mmapspecs,err) != 0)
+  {
+    return -1;
+  }
   return 0;
 }
 
@@ -0,0 +1,66 @@
+--[[
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+]]
+
+-- testing the Lua bindings for mapped FeatureIndex files
+
+function usage()
+  io.stderr:write(string.format("Usage: %s testdata_dir\n", arg[0]))
+  io.stderr:write("Test the mapped FeatureIndex bindings.\n")
+  os.exit(1)
+end
+
+if #arg == 1 then
+  testdata = arg[1]
+else
+  usage()
+end
+
+-- write the index file
+feature_index = gt.feature_index_memory_new()
+feature_index:add_gff3file(testdata.."/gff3_file_1_short.txt")
+feature_index:write_mapped("tmp.fidx")
+
+-- read it back
+mapped_index = gt.feature_index_mapped_new("tmp.fidx")
+assert(mapped_index:get_first_seqid() == "ctg123")
+assert(#mapped_index:get_seqids() == 1)
+range = mapped_index:get_range_for_seqid("ctg123")
+features = mapped_index:get_features_for_range("ctg123", range)
+assert(#features == #feature_index:get_features_for_seqid("ctg123"))
+gff3_visitor = gt.gff3_visitor_new()
+for i,feature in ipairs(features) do
+  feature:accept(gff3_visitor)
+end
+
+-- the index is read-only
+rval, err = pcall(GenomeTools_feature_index.add_gff3file, mapped_index,
+                  testdata.."/gff3_file_1_short.txt")
+assert(not rval)
+assert(string.find(err, "read%-only"))
+
+-- frozen indexes answer queries but cannot be modified
+feature_index:freeze()
+assert(#feature_index:get_features_for_range("ctg123", range) == #features)
+rval, err = pcall(GenomeTools_feature_index.add_gff3file, feature_index,
+                  testdata.."/gff3_file_1_short.txt")
+assert(not rval)
+assert(string.find(err, "frozen"))
+
+-- other files are rejected
+rval, err = pcall(gt.feature_index_mapped_new,
+                  testdata.."/gff3_file_1_short.txt")
+assert(not rval)
+assert(string.find(err, "not a feature index file"))
@@ -12,6 +12,16 @@ require 'fileutils'
   end
 end
 
+Name "gt cds -pipeline"
+Keywords "gt_cds pipeline"
+Test do
+  FileUtils.copy "#{$testdata}gt_cds_test_1.fas", "."
+  run_test "#{$bin}gt cds -pipeline -minorflen 1 -startcodon yes " \
+           "-seqfile gt_cds_test_1.fas -matchdesc " \
+           "#{$testdata}gt_cds_test_1.in"
+  run "diff #{last_stdout} #{$testdata}gt_cds_test_1.out"
+end
+
 Name "gt cds error message"
 Keywords "gt_cds"
 Test do
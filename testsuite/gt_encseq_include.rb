@@ -45,6 +45,95 @@ Test do
   grep(last_stderr, /if more than one input file is given/)
 end
 
+["foobar.fas", "fastq_long.fastq", "U89959_genomic.fas"].each do |file|
+  Name "gt encseq encode from stdin (#{file})"
+  Keywords "encseq gt_encseq_encode stdin stream"
+  Test do
+    run "#{$bin}gt encseq encode -dna -indexname file #{$testdata}#{file}"
+    run "#{$bin}gt encseq decode file > file.fas"
+    run "cat #{$testdata}#{file} | " + \
+        "#{$bin}gt encseq encode -dna -indexname stdin -"
+    run "#{$bin}gt encseq decode stdin"
+    run "diff #{last_stdout} file.fas"
+    ["des", "sds", "md5"].each do |suffix|
+      run "cmp file.#{suffix} stdin.#{suffix}"
+    end
+  end
+
+  Name "gt encseq encode from pipes (#{file})"
+  Keywords "encseq gt_encseq_encode stream"
+  Test do
+    run "#{$bin}gt encseq encode -dna -indexname file " + \
+        "#{$testdata}#{file} #{$testdata}#{file}"
+    run "#{$bin}gt encseq decode file > file.fas"
+    run "mkfifo first.fifo second.fifo"
+    run "cat #{$testdata}#{file} > first.fifo & " + \
+        "cat #{$testdata}#{file} > second.fifo & " + \
+        "#{$bin}gt -j 2 encseq encode -dna -indexname pipe " + \
+        "first.fifo second.fifo"
+    run "#{$bin}gt encseq decode pipe"
+    run "diff #{last_stdout} file.fas"
+  end
+end
+
+Name "gt encseq encode from stdin (failures)"
+Keywords "encseq gt_encseq_encode stdin stream"
+Test do
+  run_test "#{$bin}gt encseq encode -dna - < #{$testdata}foobar.fas", \
+           :retval => 1
+  grep(last_stderr, /option -indexname is mandatory/)
+  run_test "#{$bin}gt encseq encode -indexname foo - " + \
+           "< #{$testdata}foobar.fas", :retval => 1
+  grep(last_stderr, /cannot guess alphabet of input stream/)
+  run_test "#{$bin}gt encseq encode -dna -lossless -indexname foo - " + \
+           "< #{$testdata}foobar.fas", :retval => 1
+  grep(last_stderr, /lossless encoding is not possible/)
+  run_test "#{$bin}gt encseq encode -dna -indexname foo - - " + \
+           "< #{$testdata}foobar.fas", :retval => 1
+  grep(last_stderr, /given more than once/)
+end
+
+Name "gt encseq encode spool next to index"
+Keywords "encseq gt_encseq_encode spool"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname missing/foo " + \
+           "#{$testdata}Atinsert.fna", :retval => 1
+  grep(last_stderr, /cannot create temporary files missing\/foo.spool/)
+  run_test "#{$bin}gt encseq encode -indexname foo #{$testdata}Atinsert.fna"
+  run "ls foo.spool.* | wc -l"
+  grep(last_stdout, /^0$/)
+end
+
+[["-dna", ["Atinsert.fna", "Duplicate.fna", "RandomN.fna",
+           "U89959_genomic.fas", "U89959_ests.fas"]],
+ ["-dna", ["fastq_long.fastq", "test1.fastq", "description_test.fastq",
+           "fastq_long.fastq"]],
+ ["-protein", ["sw100K1.fsa", "sw100K2.fsa"]]].each do |alpha, files|
+  Name "gt encseq encode parallel (#{files.first} ...)"
+  Keywords "encseq gt_encseq_encode parallel"
+  Test do
+    filelist = files.map { |file| "#{$testdata}#{file}" }.join(" ")
+    [1, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} encseq encode #{alpha} -ssp -des -sds " + \
+               "-md5 -indexname j#{jobs} #{filelist}"
+    end
+    ["esq", "ssp", "des", "sds", "md5"].each do |suffix|
+      run "cmp j1.#{suffix} j4.#{suffix}"
+    end
+  end
+end
+
+Name "gt encseq encode parallel (mixed formats)"
+Keywords "encseq gt_encseq_encode parallel"
+Test do
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} encseq encode -dna -indexname mixed " + \
+             "#{$testdata}foobar.fas #{$testdata}fastq_long.fastq", \
+             :retval => 1
+    grep(last_stderr, /illegal character '@'/)
+  end
+end
+
 Name "gt encseq decode lossless without ois"
 Keywords "encseq gt_encseq_decode lossless"
 Test do
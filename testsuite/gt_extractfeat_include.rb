@@ -338,3 +338,13 @@ Test do
     :retval => 1
   grep(last_stderr, "could match more than one sequence")
 end
+
+Name "gt extractfeat -pipeline"
+Keywords "gt_extractfeat pipeline"
+Test do
+  FileUtils.copy "#{$testdata}gt_extractfeat_succ_1.fas", "."
+  run_test "#{$bin}gt extractfeat -pipeline -type gene " \
+    "-seqfile gt_extractfeat_succ_1.fas " \
+    "-matchdesc #{$testdata}gt_extractfeat_succ_1.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_extractfeat_succ_1.out"
+end
@@ -65,4 +65,82 @@ if not $arguments["nordb"] then
     end
   end
 
+  FEATUREINDEX_TEST_FILES.each do |file|
+    Name "gt featureindex mapped vs. db (#{File.basename(file)})"
+    Keywords "gt_featureindex mapped"
+    Test do
+      run "#{$bin}gt seqids #{file}"
+      seqids = File.open(last_stdout).readlines
+      run "#{$bin}gt mkfeatureindex -filename tmp.db #{file}", :maxtime => 1200
+      run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fidx #{file}"
+      seqids.each do |seqid|
+        seqid.chomp!
+        run "#{$bin}gt featureindex -seqid #{seqid} -retain no -filename tmp.db | grep -v '^##sequence-region' > db.gff3"
+        run "#{$bin}gt featureindex -seqid #{seqid} -retain no -backend mapped -filename tmp.fidx | grep -v '^##sequence-region' > mapped.gff3"
+        run "diff db.gff3 mapped.gff3"
+      end
+    end
+  end
+
+  Name "gt featureindex mapped (existing file)"
+  Keywords "gt_featureindex mapped"
+  Test do
+    run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fidx #{$testdata}/eden.gff3"
+    run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fidx #{$testdata}/eden.gff3", :retval => 1
+    grep(last_stderr, /exists already/)
+    run "#{$bin}gt mkfeatureindex -force -backend mapped -filename tmp.fidx #{$testdata}/eden.gff3"
+  end
+
+  Name "gt featureindex mapped (corrupt file)"
+  Keywords "gt_featureindex mapped"
+  Test do
+    File.open("corrupt.fidx", "w") do |file|
+      file.write("sdfnhsnl")
+    end
+    run "#{$bin}gt featureindex -backend mapped -filename corrupt.fidx", :retval => 1
+    grep(last_stderr, /not a feature index file/)
+  end
+
+  Name "gt featureindex mapped (delta and compaction)"
+  Keywords "gt_featureindex mapped delta"
+  Test do
+    run "#{$bin}gt mkfeatureindex -backend mapped -filename tmp.fidx #{$testdata}/eden.gff3"
+    run "#{$bin}gt featureindex -backend mapped -filename tmp.fidx -seqid ctg123 -retain no > orig.gff3"
+    run "#{$bin}gt featureindex -backend mapped -filename tmp.fidx -remove gene00001"
+    run "#{$bin}gt featureindex -backend mapped -filename tmp.fidx -seqid ctg123 -retain no"
+    grep(last_stdout, /gene00001/, true)
+    run "#{$bin}gt featureindex -backend mapped -filename tmp.fidx -add #{$testdata}/eden.gff3"
+    run "#{$bin}gt featureindex -backend mapped -filename tmp.fidx -seqid ctg123 -retain no > delta.gff3"
+    run "diff orig.gff3 delta.gff3"
+    run "#{$bin}gt featureindex -backend mapped -filename tmp.fidx -compact"
+    if File.exist?("tmp.fidx.delta") then
+      raise TestFailedError
+    end
+    run "#{$bin}gt featureindex -backend mapped -filename tmp.fidx -seqid ctg123 -retain no > compact.gff3"
+    run "diff orig.gff3 compact.gff3"
+  end
+
+  Name "gt featureindex delta (wrong backend)"
+  Keywords "gt_featureindex mapped delta"
+  Test do
+    run "#{$bin}gt featureindex -backend sqlite -filename tmp.db -compact", :retval => 1
+    grep(last_stderr, /require -backend mapped/)
+  end
+
+  ["sqlite", "mapped"].each do |backend|
+    Name "gt featureindex -benchmark (#{backend})"
+    Keywords "gt_featureindex benchmark"
+    Test do
+      run "#{$bin}gt mkfeatureindex -backend #{backend} -filename tmp.idx " +
+          "#{$testdata}/encode_known_genes_Mar07.gff3", :maxtime => 1200
+      run "#{$bin}gt -j 4 featureindex -backend #{backend} -filename tmp.idx " +
+          "-benchmark 1000 -querywidth 50000"
+      grep(last_stdout, /^queries: 1000$/)
+      grep(last_stdout, /^threads: 4$/)
+      run "#{$bin}gt featureindex -backend #{backend} -filename tmp.idx " +
+          "-benchmark 10 -seqid foo", :retval => 1
+      grep(last_stderr, /does not contain sequence region 'foo'/)
+    end
+  end
+
 end
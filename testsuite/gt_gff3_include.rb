@@ -1584,6 +1584,162 @@ def large_gff3_test(name, file)
   end
 end
 
+Name "gt gff3 parallel parsing"
+Keywords "gt_gff3 parallel"
+Test do
+  run_test "#{$bin}gt gff3 -sort -tidy #{$testdata}encode_known_genes_Mar07.gff3 > 1"
+  run_test "#{$bin}gt -j 4 gff3 -sort -tidy #{$testdata}encode_known_genes_Mar07.gff3 > 2"
+  run "diff 1 2"
+end
+
+Name "gt gff3 parallel parsing (multiple files)"
+Keywords "gt_gff3 parallel"
+Test do
+  run_test "#{$bin}gt gff3 -typecheck so #{$testdata}encode_known_genes_Mar07.gff3 #{$testdata}standard_fasta_example.gff3 > 1"
+  run_test "#{$bin}gt -j 4 gff3 -typecheck so #{$testdata}encode_known_genes_Mar07.gff3 #{$testdata}standard_fasta_example.gff3 > 2"
+  run "diff 1 2"
+end
+
+Name "gt gff3 parallel parsing (error)"
+Keywords "gt_gff3 parallel"
+Test do
+  run_test("#{$bin}gt -j 4 gff3 #{$testdata}gt_gff3_prob_1.gff3", :retval => 1)
+  grep last_stderr, "was not defined"
+end
+
+# Writes <num_of_genes> terminated genes to <filename>, which gives several
+# parallel chunks after the first one (that is parsed by the stream parser).
+# If <error_gene> is given, the mRNA of this gene refers to an undefined parent.
+# Returns the line number of this mRNA.
+def write_parallel_gff3(filename, num_of_genes, error_gene = nil)
+  line_number = 0
+  error_line = nil
+  File.open(filename, "w") do |fp|
+    fp.puts "##gff-version 3"
+    line_number += 1
+    num_of_genes.times do |i|
+      start = 1000 * i + 1
+      parent = (i == error_gene) ? "undefined#{i}" : "gene#{i}"
+      fp.puts "ctg1\ttest\tgene\t#{start}\t#{start + 899}\t.\t+\t.\t" +
+              "ID=gene#{i}"
+      fp.puts "ctg1\ttest\tmRNA\t#{start}\t#{start + 899}\t.\t+\t.\t" +
+              "ID=mRNA#{i};Parent=#{parent}"
+      fp.puts "ctg1\ttest\texon\t#{start}\t#{start + 299}\t.\t+\t.\t" +
+              "Parent=mRNA#{i}"
+      fp.puts "ctg1\ttest\texon\t#{start + 600}\t#{start + 899}\t.\t+\t" +
+              ".\tParent=mRNA#{i}"
+      fp.puts "###"
+      error_line = line_number + 2 if i == error_gene
+      line_number += 5
+    end
+  end
+  error_line
+end
+
+Name "gt gff3 parallel parsing (several chunks)"
+Keywords "gt_gff3 parallel"
+Test do
+  write_parallel_gff3("parallel.gff3", 25000)
+  run_test "#{$bin}gt gff3 -sort parallel.gff3 > 1"
+  run_test "#{$bin}gt -j 4 gff3 -sort parallel.gff3 > 2"
+  run "diff 1 2"
+  run_test "#{$bin}gt -j 2 gff3 -sort parallel.gff3 > 3"
+  run "diff 1 3"
+end
+
+Name "gt gff3 parallel parsing (error in later chunk)"
+Keywords "gt_gff3 parallel"
+Test do
+  error_line = write_parallel_gff3("parallel_error.gff3", 25000, 18000)
+  run_test("#{$bin}gt gff3 parallel_error.gff3", :retval => 1)
+  run "mv #{last_stderr} serial.err"
+  grep "serial.err", "on line #{error_line} in file \"parallel_error.gff3\""
+  run_test("#{$bin}gt -j 4 gff3 parallel_error.gff3", :retval => 1)
+  grep last_stderr, "Parent \"undefined18000\" on line #{error_line} in " +
+                    "file \"parallel_error.gff3\" was not defined"
+  run "diff #{last_stderr} serial.err"
+end
+
+Name "gt gff3 parallel parsing (unterminated part above chunk limit)"
+Keywords "gt_gff3 parallel"
+Test do
+  # with a chunk size of 1000 bytes, parallel parsing switches to sequential
+  # parsing after 64000 bytes without a terminator, the exons following later
+  # must still be attached to their mRNAs
+  File.open("unterminated.gff3", "w") do |fp|
+    fp.puts "##gff-version 3"
+    fp.puts "##sequence-region ctg1 1 4000000"
+    3000.times do |i|
+      start = 1000 * i + 1
+      fp.puts "ctg1\ttest\tgene\t#{start}\t#{start + 899}\t.\t+\t.\t" +
+              "ID=gene#{i}"
+      fp.puts "ctg1\ttest\tmRNA\t#{start}\t#{start + 899}\t.\t+\t.\t" +
+              "ID=mRNA#{i};Parent=gene#{i}"
+      fp.puts "###" if i < 200
+    end
+    (200...3000).each do |i|
+      start = 1000 * i + 1
+      fp.puts "ctg1\ttest\texon\t#{start}\t#{start + 299}\t.\t+\t.\t" +
+              "Parent=mRNA#{i}"
+    end
+  end
+  run_test "#{$bin}gt gff3 unterminated.gff3 > 1"
+  run_test "#{$bin}gt -j 4 gff3 -chunksize 1000 unterminated.gff3 > 2"
+  run "diff 1 2"
+  run_test "#{$bin}gt -j 2 gff3 -chunksize 1000 unterminated.gff3 > 3"
+  run "diff 1 3"
+end
+
+Name "gt gff3 -pipeline"
+Keywords "gt_gff3 pipeline"
+Test do
+  run_test "#{$bin}gt gff3 -sort -addintrons #{$testdata}standard_gene_as_tree.gff3"
+  run "mv #{last_stdout} serial.gff3"
+  run_test "#{$bin}gt gff3 -pipeline -sort -addintrons " +
+           "#{$testdata}standard_gene_as_tree.gff3"
+  run "diff #{last_stdout} serial.gff3"
+end
+
+Name "gt gff3 -pipeline (error)"
+Keywords "gt_gff3 pipeline"
+Test do
+  run_test("#{$bin}gt gff3 -pipeline #{$testdata}gt_gff3_prob_1.gff3",
+           :retval => 1)
+  grep last_stderr, "was not defined"
+end
+
+Name "gt gff3 parallel compressed output (-gzip)"
+Keywords "gt_gff3 parallel"
+Test do
+  run_test "#{$bin}gt -j 4 gff3 -gzip -o out.gff3.gz -sort #{$testdata}dynbuf.gff3"
+  run "gzip -t out.gff3.gz"
+  run_test "#{$bin}gt gff3 out.gff3.gz | diff #{$testdata}dynbuf.gff3 -"
+end
+
+Name "gt gff3 parallel compressed output (-bzip2)"
+Keywords "gt_gff3 parallel"
+Test do
+  run_test "#{$bin}gt -j 4 gff3 -bzip2 -o out.gff3.bz2 -sort #{$testdata}dynbuf.gff3"
+  run_test "#{$bin}gt gff3 out.gff3.bz2 | diff #{$testdata}dynbuf.gff3 -"
+end
+
+Name "gt gff3 parallel compressed output (several blocks)"
+Keywords "gt_gff3 parallel"
+Test do
+  run_test "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3",
+           :maxtime => 600
+  run "mv #{last_stdout} serial.gff3"
+  [2, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} gff3 -gzip -force -o out.gff3.gz -sort " +
+             "#{$testdata}encode_known_genes_Mar07.gff3", :maxtime => 600
+    run "gzip -t out.gff3.gz"
+    run "gzip -dc out.gff3.gz | diff serial.gff3 -"
+    run_test "#{$bin}gt -j #{jobs} gff3 -bzip2 -force -o out.gff3.bz2 -sort " +
+             "#{$testdata}encode_known_genes_Mar07.gff3", :maxtime => 600
+    run "bzip2 -dc out.gff3.bz2 | diff serial.gff3 -"
+  end
+end
+
 if $gttestdata then
   large_gff3_test("maker", "maker/maker.gff3")
   large_gff3_test("Saccharomyces cerevisiae", "sgd/saccharomyces_cerevisiae.gff")
@@ -1623,3 +1779,90 @@ if $gttestdata then
     run      "diff #{last_stdout} #{$gttestdata}gff3testruns/ensembl.gff3"
   end
 end
+
+Name "gt gff3 -memlimit"
+Keywords "gt_gff3 memlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} inmemory.gff3"
+  run_test "#{$bin}gt gff3 -sort -memlimit 1MB " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} inmemory.gff3"
+end
+
+Name "gt gff3 -memlimit (invalid)"
+Keywords "gt_gff3 memlimit"
+Test do
+  run_test("#{$bin}gt gff3 -sort -memlimit 1KB " +
+           "#{$testdata}standard_gene_as_tree.gff3",
+           :retval => 1)
+  grep last_stderr, "memlimit"
+end
+
+["all_node_types.gff3", "standard_fasta_example.gff3",
+ "cds_feature_with_multiple_parents_tidied.gff3",
+ "multi_feature_orphan_succ.gff3",
+ "encode_known_genes_Mar07.gff3"].each do |file|
+  Name "gt gff3 -binary (#{file})"
+  Keywords "gt_gff3 binary"
+  Test do
+    run_test "#{$bin}gt gff3 -retainids #{$testdata}#{file}"
+    run "mv #{last_stdout} text.gff3"
+    run_test "#{$bin}gt gff3 -binary -o out.bin #{$testdata}#{file}"
+    run_test "#{$bin}gt gff3 -retainids out.bin"
+    run "diff #{last_stdout} text.gff3"
+  end
+end
+
+Name "gt gff3 -binary (multiple files)"
+Keywords "gt_gff3 binary"
+Test do
+  run_test "#{$bin}gt gff3 #{$testdata}standard_gene_as_tree.gff3 " +
+           "#{$testdata}gt_gff3_test_3.gff3"
+  run "mv #{last_stdout} text.gff3"
+  run_test "#{$bin}gt gff3 -binary -o 1.bin " +
+           "#{$testdata}standard_gene_as_tree.gff3"
+  run_test "#{$bin}gt gff3 -binary -gzip -o 2.bin.gz " +
+           "#{$testdata}gt_gff3_test_3.gff3"
+  run_test "#{$bin}gt gff3 1.bin 2.bin.gz"
+  run "diff #{last_stdout} text.gff3"
+end
+
+Name "gt gff3 -binary (truncated input)"
+Keywords "gt_gff3 binary"
+Test do
+  run_test "#{$bin}gt gff3 -binary -o out.bin " +
+           "#{$testdata}standard_gene_as_tree.gff3"
+  run "head -c 100 out.bin > truncated.bin"
+  run_test("#{$bin}gt gff3 truncated.bin", :retval => 1)
+  grep last_stderr, "unexpected end of binary node file"
+end
+
+Name "gt gff3 -binary (stdin and pipes)"
+Keywords "gt_gff3 binary"
+Test do
+  run_test "#{$bin}gt gff3 #{$testdata}standard_gene_as_tree.gff3"
+  run "mv #{last_stdout} text.gff3"
+  run_test "#{$bin}gt gff3 -binary -o out.bin " +
+           "#{$testdata}standard_gene_as_tree.gff3"
+  run_test "#{$bin}gt gff3 - < out.bin"
+  run "diff #{last_stdout} text.gff3"
+  run_test "#{$bin}gt gff3 < out.bin"
+  run "diff #{last_stdout} text.gff3"
+  run_test "cat out.bin | #{$bin}gt gff3 /dev/stdin"
+  run "diff #{last_stdout} text.gff3"
+end
+
+Name "gt gff3 (GFF3 from stdin and pipes)"
+Keywords "gt_gff3 binary"
+Test do
+  run_test "#{$bin}gt gff3 #{$testdata}standard_gene_as_tree.gff3"
+  run "mv #{last_stdout} text.gff3"
+  run_test "cat #{$testdata}standard_gene_as_tree.gff3 | " +
+           "#{$bin}gt gff3 /dev/stdin"
+  run "diff #{last_stdout} text.gff3"
+  run_test "cat #{$testdata}standard_gene_as_tree.gff3 | #{$bin}gt gff3 -"
+  run "diff #{last_stdout} text.gff3"
+  run_test "#{$bin}gt gff3 < #{$testdata}standard_gene_as_tree.gff3"
+  run "diff #{last_stdout} text.gff3"
+end
@@ -255,6 +255,22 @@ Test do
   run "#{$bin}gt repfind -samples 1000 -l 6 -ii sfx",:maxtime => 600
 end
 
+Name "gt repfind -mmap"
+Keywords "gt_repfind mmap"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}Atinsert.fna " +
+           "-indexname sfx -dna -tis -suf -lcp -ssp -pl"
+  run_test "#{$bin}gt repfind -l 8 -ii sfx " +
+           "-mmap suf=sequential,willneed lcp=random esq=warmup,populate"
+  run "grep -v '^#' #{last_stdout}"
+  run "diff -w #{last_stdout} #{$testdata}repfind-result/Atinsert-8-8"
+  run_test "#{$bin}gt repfind -l 8 -ii sfx -mmap suf=sequential,random",
+           :retval => 1
+  grep(last_stderr, /exclude each other/)
+  run_test "#{$bin}gt repfind -l 8 -ii sfx -mmap suf=foo", :retval => 1
+  grep(last_stderr, /illegal advice/)
+end
+
 if $gttestdata then
   extendexception = ["hs5hcmvcg.fna","Wildcards.fna","at1MB"]
   repfindtestfiles.each do |reffile|
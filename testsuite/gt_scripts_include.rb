@@ -169,6 +169,14 @@ Test do
   run "grep -v '^##sequence-region' #{$testdata}gff3_file_1_short_sorted.txt | diff #{last_stdout} -"
 end
 
+Name "mapped feature_index bindings"
+Keywords "gt_scripts"
+Test do
+  run_test "#{$bin}gt #{$testdata}gtscripts/feature_index_mapped.lua #{$testdata}"
+  run "env LC_ALL=C sort #{last_stdout}"
+  run "grep -v '^##sequence-region' #{$testdata}gff3_file_1_short_sorted.txt | diff #{last_stdout} -"
+end
+
 if not $arguments["nocairo"] then
   Name "AnnotationSketch (general bindings)"
   Keywords "gt_scripts"
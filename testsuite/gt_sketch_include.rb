@@ -157,6 +157,51 @@ Test do
            :maxtime => 600
 end
 
+Name "gt sketch -regions"
+Keywords "gt_sketch batch"
+Test do
+  run "mkdir images"
+  File.open("regions.bed", "w") do |f|
+    f.puts "track name=genes"
+    f.puts "ctg123\t999\t9000\tgene1"
+    f.puts "ctg123\t9999\t20000"
+  end
+  File.open("regions.txt", "w") do |f|
+    f.puts "ctg123:1000-9000"
+    f.puts "ctg123:10000-20000"
+  end
+  run_test "#{$bin}gt -j 2 sketch -regions regions.bed images " + \
+           "#{$testdata}gff3_file_1_short.txt", :maxtime => 600
+  run "test -e images/gene1.png"
+  run "test -e images/ctg123_10000-20000.png"
+  run_test "#{$bin}gt sketch -format pdf -regions regions.txt images " + \
+           "#{$testdata}gff3_file_1_short.txt", :maxtime => 600
+  run "test -e images/ctg123_1000-9000.pdf"
+  run "test -e images/ctg123_10000-20000.pdf"
+end
+
+Name "gt sketch -regions (invalid region)"
+Keywords "gt_sketch batch"
+Test do
+  run "mkdir images"
+  File.open("regions.txt", "w") do |f|
+    f.puts "ctg123:1000-9000"
+    f.puts "ctg123_1000"
+  end
+  run_test("#{$bin}gt sketch -regions regions.txt images " + \
+           "#{$testdata}gff3_file_1_short.txt", :maxtime => 600,
+           :retval => 1)
+  grep(last_stderr, "line 2 in file 'regions.txt'")
+end
+
+Name "gt sketch -regions (-seqid excluded)"
+Keywords "gt_sketch batch"
+Test do
+  run "touch regions.txt"
+  run_test("#{$bin}gt sketch -regions regions.txt -seqid ctg123 . " + \
+           "#{$testdata}gff3_file_1_short.txt", :retval => 1)
+end
+
 Name "gt sketch runtime Lua failures"
 Keywords "gt_sketch lua"
 Test do